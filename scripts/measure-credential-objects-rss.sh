@@ -0,0 +1,157 @@
+#!/bin/bash
+# Compare daemon RSS with VirtualCredentialObjects on and off
+#
+# Starts the built daemon on a private session bus with a throwaway config and
+# a credential cache seeded with N credentials for one offline device. Once
+# GetManagedObjects() lists all N credentials, VmRSS of the daemon is read from
+# /proc. No YubiKey, pcscd or KWallet access is needed.
+#
+# Requirements:
+#   - sqlite3
+#   - dbus-run-session and dbus-send (dbus package)
+#
+# Usage:
+#   ./scripts/measure-credential-objects-rss.sh [build_dir] [counts...]
+#
+# Example:
+#   ./scripts/measure-credential-objects-rss.sh build
+#   ./scripts/measure-credential-objects-rss.sh build 0 100 1000
+
+set -e  # Exit on error
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+NC='\033[0m' # No Color
+
+SCRIPT_PATH="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)/$(basename "${BASH_SOURCE[0]}")"
+PROJECT_ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+
+DEVICE_ID="deadbeef00000001"
+DEVICE_SERIAL=99000001
+SERVICE="pl.jkolo.yubikey.oath.daemon"
+MANAGER_PATH="/pl/jkolo/yubikey/oath"
+TIMEOUT_SECONDS=30
+
+# Runs inside dbus-run-session: start the daemon, wait for N credentials, print VmRSS in kB
+measure() {
+    local daemon=$1
+    local count=$2
+
+    "$daemon" >/dev/null 2>&1 &
+    local pid=$!
+
+    local published=-1
+    local reply
+    for _ in $(seq $((TIMEOUT_SECONDS * 10))); do
+        sleep 0.1
+        reply=$(dbus-send --session --print-reply --dest="$SERVICE" "$MANAGER_PATH" \
+                    org.freedesktop.DBus.ObjectManager.GetManagedObjects 2>/dev/null) || continue
+        # Device object first - with N = 0 an empty reply is not enough
+        grep -q "object path \"${MANAGER_PATH}/devices/${DEVICE_SERIAL}\"" <<< "$reply" || continue
+        published=$(grep -c "object path \"[^\"]*/credentials/" <<< "$reply" || true)
+        if [ "$published" -eq "$count" ]; then
+            break
+        fi
+    done
+
+    if [ "$published" -ne "$count" ]; then
+        kill "$pid" 2>/dev/null || true
+        echo "error: daemon published $published of $count credentials" >&2
+        exit 1
+    fi
+
+    # Let deferred work (coalesced signals, snapshot rebuild) settle before reading
+    sleep 1
+    awk '/^VmRSS:/ { print $2 }' "/proc/$pid/status"
+
+    kill "$pid" 2>/dev/null || true
+    wait "$pid" 2>/dev/null || true
+}
+
+if [ "$1" = "--measure" ]; then
+    measure "$2" "$3"
+    exit 0
+fi
+
+BUILD_DIR="${1:-build}"
+shift || true
+COUNTS=("$@")
+if [ ${#COUNTS[@]} -eq 0 ]; then
+    COUNTS=(0 32 256 1024)
+fi
+
+DAEMON="${BUILD_DIR}/bin/yubikey-oath-daemon"
+if [ ! -x "$DAEMON" ]; then
+    echo -e "${RED}Error: daemon not found at ${DAEMON}${NC}"
+    echo "Build the project first, e.g. cmake --build ${BUILD_DIR}"
+    exit 1
+fi
+DAEMON="$(cd "$(dirname "$DAEMON")" && pwd)/$(basename "$DAEMON")"
+
+for tool in sqlite3 dbus-run-session dbus-send; do
+    if ! command -v "$tool" &> /dev/null; then
+        echo -e "${RED}Error: $tool is not installed${NC}"
+        exit 1
+    fi
+done
+
+# Fresh XDG dirs with the cache enabled and N cached credentials
+prepare() {
+    local dir=$1
+    local count=$2
+    local virtual=$3
+
+    mkdir -p "$dir/config" "$dir/data/krunner-yubikey" "$dir/cache"
+    cat > "$dir/config/yubikey-oathrc" <<EOF
+[General]
+EnableCredentialsCache=true
+ShowNotifications=false
+VirtualCredentialObjects=${virtual}
+EOF
+
+    # Schema matches OathDatabase::createTables()
+    sqlite3 "$dir/data/krunner-yubikey/devices.db" <<EOF
+CREATE TABLE devices (device_id TEXT PRIMARY KEY, device_name TEXT NOT NULL,
+    requires_password INTEGER NOT NULL DEFAULT 0, last_seen TEXT, created_at TEXT NOT NULL,
+    firmware_version TEXT, device_model INTEGER, serial_number INTEGER, form_factor INTEGER);
+CREATE TABLE credentials (id INTEGER PRIMARY KEY AUTOINCREMENT, device_id TEXT NOT NULL,
+    credential_name TEXT NOT NULL, issuer TEXT, account TEXT, period INTEGER DEFAULT 30,
+    algorithm INTEGER DEFAULT 1, digits INTEGER DEFAULT 6, type INTEGER DEFAULT 2,
+    requires_touch INTEGER DEFAULT 0,
+    FOREIGN KEY (device_id) REFERENCES devices(device_id) ON DELETE CASCADE,
+    UNIQUE(device_id, credential_name));
+INSERT INTO devices (device_id, device_name, created_at, serial_number)
+    VALUES ('${DEVICE_ID}', 'RSS benchmark', datetime('now'), ${DEVICE_SERIAL});
+WITH RECURSIVE n(i) AS (SELECT 1 WHERE ${count} > 0 UNION ALL SELECT i + 1 FROM n WHERE i < ${count})
+INSERT INTO credentials (device_id, credential_name, issuer, account)
+    SELECT '${DEVICE_ID}', 'Issuer' || i || ':user' || i || '@example.com', 'Issuer' || i,
+           'user' || i || '@example.com' FROM n;
+EOF
+}
+
+run() {
+    local count=$1
+    local virtual=$2
+    local dir
+    dir=$(mktemp -d)
+
+    prepare "$dir" "$count" "$virtual"
+    XDG_CONFIG_HOME="$dir/config" XDG_DATA_HOME="$dir/data" XDG_CACHE_HOME="$dir/cache" \
+        QT_QPA_PLATFORM=offscreen \
+        dbus-run-session -- "$SCRIPT_PATH" --measure "$DAEMON" "$count"
+
+    rm -rf "$dir"
+}
+
+echo -e "${GREEN}=== Daemon RSS: per-credential objects vs virtual subtree ===${NC}"
+echo "Project root: ${PROJECT_ROOT}"
+echo "Daemon: ${DAEMON}"
+echo ""
+printf "%12s %16s %16s %12s\n" "credentials" "objects (kB)" "virtual (kB)" "saved (kB)"
+
+for count in "${COUNTS[@]}"; do
+    objects=$(run "$count" false)
+    virtual=$(run "$count" true)
+    printf "%12s %16s %16s %12s\n" "$count" "$objects" "$virtual" "$((objects - virtual))"
+done
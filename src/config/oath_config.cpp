@@ -88,6 +88,8 @@ OathConfig::OathConfig(QObject *parent, const QVariantList &)
             this, &OathConfig::markAsChanged);
     connect(m_ui->notificationExtraTimeSpinbox, QOverload<int>::of(&QSpinBox::valueChanged),
             this, &OathConfig::markAsChanged);
+    connect(m_ui->notificationFrameRateSpinbox, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &OathConfig::markAsChanged);
     connect(m_ui->enableCredentialsCacheCheckbox, &QCheckBox::toggled,
             this, &OathConfig::markAsChanged);
     connect(m_ui->deviceReconnectTimeoutSpinbox, QOverload<int>::of(&QSpinBox::valueChanged),
@@ -136,6 +138,7 @@ void OathConfig::load()
 
     m_ui->touchTimeoutSpinbox->setValue(m_config.readEntry("TouchTimeout", 10));
     m_ui->notificationExtraTimeSpinbox->setValue(m_config.readEntry("NotificationExtraTime", 15));
+    m_ui->notificationFrameRateSpinbox->setValue(m_config.readEntry("NotificationFrameRate", 1));
     m_ui->enableCredentialsCacheCheckbox->setChecked(m_config.readEntry("EnableCredentialsCache", false));
     m_ui->deviceReconnectTimeoutSpinbox->setValue(m_config.readEntry("DeviceReconnectTimeout", 30));
 
@@ -161,6 +164,7 @@ void OathConfig::save()
 
     m_config.writeEntry("TouchTimeout", m_ui->touchTimeoutSpinbox->value());
     m_config.writeEntry("NotificationExtraTime", m_ui->notificationExtraTimeSpinbox->value());
+    m_config.writeEntry("NotificationFrameRate", m_ui->notificationFrameRateSpinbox->value());
     m_config.writeEntry("EnableCredentialsCache", m_ui->enableCredentialsCacheCheckbox->isChecked());
     m_config.writeEntry("DeviceReconnectTimeout", m_ui->deviceReconnectTimeoutSpinbox->value());
 
@@ -178,6 +182,7 @@ void OathConfig::defaults()
     m_ui->primaryActionCombo->setCurrentIndex(0); // copy (first item)
     m_ui->touchTimeoutSpinbox->setValue(10);
     m_ui->notificationExtraTimeSpinbox->setValue(15);
+    m_ui->notificationFrameRateSpinbox->setValue(1);
     m_ui->enableCredentialsCacheCheckbox->setChecked(false);
     m_ui->deviceReconnectTimeoutSpinbox->setValue(30);
 
@@ -13,6 +13,7 @@
 
 #include <KLocalizedString>
 #include <QDebug>
+#include <QPointer>
 
 namespace YubiKeyOath {
 namespace Config {
@@ -192,31 +193,35 @@ bool OathDeviceListModel::testAndSavePassword(const QString &deviceId, const QSt
         return false;
     }
 
-    // Test and save password via session proxy
-    const bool success = sessionProxy->savePassword(password);
-
-    if (success) {
-        qCDebug(OathConfigLog) << "OathDeviceListModel: Password saved successfully";
-
-        // Update device info
-        DeviceInfo * const device = findDevice(deviceId);
-        if (device) {
-            device->hasValidPassword = true;
-            device->requiresPassword = true;
+    // Test and save password via session proxy (async - result arrives via callback)
+    sessionProxy->savePassword(password, [this, guard = QPointer<OathDeviceListModel>(this), deviceId](bool success) {
+        if (!guard) {
+            return; // Model destroyed while waiting for daemon
+        }
 
-            // Notify QML of change
-            const int row = findDeviceIndex(deviceId);
-            if (row >= 0) {
-                const QModelIndex idx = index(row);
-                Q_EMIT dataChanged(idx, idx);
+        if (success) {
+            qCDebug(OathConfigLog) << "OathDeviceListModel: Password saved successfully";
+
+            // Update device info
+            DeviceInfo * const device = findDevice(deviceId);
+            if (device) {
+                device->hasValidPassword = true;
+                device->requiresPassword = true;
+
+                // Notify QML of change
+                const int row = findDeviceIndex(deviceId);
+                if (row >= 0) {
+                    const QModelIndex idx = index(row);
+                    Q_EMIT dataChanged(idx, idx);
+                }
             }
+        } else {
+            qCWarning(OathConfigLog) << "OathDeviceListModel: Invalid password or save failed";
+            Q_EMIT passwordTestFailed(deviceId, i18n("Invalid password. Please try again."));
         }
-        return true;
-    } else {
-        qCWarning(OathConfigLog) << "OathDeviceListModel: Invalid password or save failed";
-        Q_EMIT passwordTestFailed(deviceId, i18n("Invalid password. Please try again."));
-        return false;
-    }
+    });
+
+    return true;
 }
 
 void OathDeviceListModel::showPasswordDialog(const QString &deviceId,
@@ -91,10 +91,10 @@ public:
      * @brief Tests and saves password for device
      * @param deviceId Device ID
      * @param password Password to test
-     * @return true if password valid and saved, false otherwise
+     * @return true if the password was submitted for verification, false on invalid input
      *
      * This method is called from PasswordDialog.qml.
-     * It tests the password via D-Bus and saves it if valid.
+     * It tests the password via D-Bus (asynchronously) and saves it if valid.
      * Emits passwordTestFailed signal if password invalid.
      */
     Q_INVOKABLE bool testAndSavePassword(const QString &deviceId, const QString &password);
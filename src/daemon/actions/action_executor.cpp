@@ -15,11 +15,19 @@
 #include <KLocalizedString>
 #include <QDebug>
 #include <QElapsedTimer>
+#include <utility>
 
 namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+namespace {
+// Grace period before asking the user to release modifiers
+constexpr int MODIFIER_GRACE_MS = 50;
+// How long the release notification waits before the action is cancelled
+constexpr int MODIFIER_RELEASE_WAIT_SECONDS = 15;
+} // namespace
+
 ActionExecutor::ActionExecutor(TextInputProvider *textInput,
                                ClipboardManager *clipboardManager,
                                const ConfigurationProvider *config,
@@ -30,7 +38,23 @@ ActionExecutor::ActionExecutor(TextInputProvider *textInput,
     , m_clipboardManager(clipboardManager)
     , m_config(config)
     , m_notificationOrchestrator(notificationOrchestrator)
+    , m_modifierWatcher(new ModifierReleaseWatcher(this))
 {
+    m_modifierNoticeTimer.setSingleShot(true);
+    connect(&m_modifierNoticeTimer, &QTimer::timeout, this, [this]() {
+        qCDebug(ActionExecutorLog) << "Modifiers still pressed after" << MODIFIER_GRACE_MS
+                                   << "ms - showing release notification";
+        if (m_notificationOrchestrator) {
+            m_notificationOrchestrator->showModifierReleaseNotification(m_pendingModifiers,
+                                                                        MODIFIER_RELEASE_WAIT_SECONDS);
+            m_modifierNotificationShown = true;
+        }
+    });
+
+    connect(m_modifierWatcher, &ModifierReleaseWatcher::released,
+            this, &ActionExecutor::onModifiersReleased);
+    connect(m_modifierWatcher, &ModifierReleaseWatcher::timedOut,
+            this, &ActionExecutor::onModifierWaitTimedOut);
 }
 
 ActionExecutor::ActionResult ActionExecutor::executeTypeAction(const QString &code, const QString &credentialName)
@@ -54,16 +78,17 @@ ActionExecutor::ActionResult ActionExecutor::executeTypeAction(const QString &co
         return ActionResult::Failed;
     }
 
-    // Check for pressed modifier keys and wait for release
-    QElapsedTimer modifierTimer;
-    modifierTimer.start();
-    const ActionResult modifierCheck = checkAndWaitForModifiers(credentialName);
-    qCDebug(ActionExecutorLog) << "[TIMING] Modifier check took" << modifierTimer.elapsed() << "ms";
-    if (modifierCheck != ActionResult::Success) {
-        qCWarning(ActionExecutorLog) << "Type action cancelled due to modifier keys for:" << credentialName;
-        return modifierCheck;
+    // Typing with Shift/Ctrl/Alt held would trigger shortcuts - wait for release
+    if (m_modifierWatcher->isActive() || ModifierKeyChecker::hasModifiersPressed()) {
+        deferUntilModifiersReleased(code, credentialName);
+        return ActionResult::Deferred;
     }
 
+    return typeCode(code, credentialName);
+}
+
+ActionExecutor::ActionResult ActionExecutor::typeCode(const QString &code, const QString &credentialName)
+{
     QElapsedTimer typeTimer;
     typeTimer.start();
     const bool success = m_textInput->typeText(code);
@@ -145,66 +170,66 @@ ActionExecutor::ActionResult ActionExecutor::executeCopyAction(const QString &co
     return ActionResult::Success;
 }
 
-ActionExecutor::ActionResult ActionExecutor::checkAndWaitForModifiers(const QString &credentialName)
+void ActionExecutor::deferUntilModifiersReleased(const QString &code, const QString &credentialName)
 {
-    qCDebug(ActionExecutorLog) << "Checking for pressed modifier keys before typing for:" << credentialName;
-
-    // Check if any modifiers are currently pressed
-    if (!ModifierKeyChecker::hasModifiersPressed()) {
-        qCDebug(ActionExecutorLog) << "No modifier keys pressed - proceeding with type action";
-        return ActionResult::Success;
-    }
-
-    // Get list of pressed modifiers for notifications
-    const QStringList pressedModifiers = ModifierKeyChecker::getPressedModifiers();
-    qCDebug(ActionExecutorLog) << "Modifier keys detected:" << pressedModifiers
-                               << "- waiting for release";
-
-    // Phase 1: Wait 50ms silently for user to release modifiers (optimized)
-    constexpr int INITIAL_WAIT_MS = 50;
-    constexpr int POLL_INTERVAL_MS = 30;  // Poll every 30ms for faster response
-
-    if (ModifierKeyChecker::waitForModifierRelease(INITIAL_WAIT_MS, POLL_INTERVAL_MS)) {
-        qCDebug(ActionExecutorLog) << "Modifiers released within initial" << INITIAL_WAIT_MS
-                                   << "ms - proceeding with type action";
-        return ActionResult::Success;
+    if (m_modifierWatcher->isActive()) {
+        qCDebug(ActionExecutorLog) << "Replacing deferred type action for:" << m_pendingCredentialName
+                                   << "with:" << credentialName;
+        const QString supersededName = std::exchange(m_pendingCredentialName, credentialName);
+        m_pendingCode = code;
+
+        // The replaced request never types - its waiter must still hear back
+        Q_EMIT typeActionFinished(supersededName, ActionResult::Failed);
+        return;
     }
 
-    // Phase 2: Still pressed after 500ms - show notification and wait up to 15s
-    qCDebug(ActionExecutorLog) << "Modifiers still pressed after" << INITIAL_WAIT_MS
-                               << "ms - showing release notification";
+    m_pendingCode = code;
+    m_pendingCredentialName = credentialName;
+    m_pendingModifiers = ModifierKeyChecker::getPressedModifiers();
+    m_modifierNotificationShown = false;
+    qCDebug(ActionExecutorLog) << "Modifier keys detected:" << m_pendingModifiers
+                               << "- deferring type action for:" << credentialName;
 
-    constexpr int RELEASE_WAIT_SECONDS = 15;
+    m_modifierNoticeTimer.start(MODIFIER_GRACE_MS);
+    m_modifierWatcher->start(MODIFIER_GRACE_MS + (MODIFIER_RELEASE_WAIT_SECONDS * 1000));
+}
 
-    // Show notification requesting release
-    if (m_notificationOrchestrator) {
-        m_notificationOrchestrator->showModifierReleaseNotification(pressedModifiers, RELEASE_WAIT_SECONDS);
-    }
+void ActionExecutor::onModifiersReleased()
+{
+    closeModifierNotification();
 
-    // Wait for release with notification countdown
-    constexpr int RELEASE_WAIT_MS = RELEASE_WAIT_SECONDS * 1000;
-    const bool released = ModifierKeyChecker::waitForModifierRelease(RELEASE_WAIT_MS, POLL_INTERVAL_MS);
+    const QString code = std::exchange(m_pendingCode, QString());
+    const QString credentialName = std::exchange(m_pendingCredentialName, QString());
+    qCDebug(ActionExecutorLog) << "Modifiers released - typing deferred code for:" << credentialName;
 
-    // Close notification
-    if (m_notificationOrchestrator) {
-        m_notificationOrchestrator->closeModifierNotification();
-    }
+    const ActionResult result = typeCode(code, credentialName);
+    Q_EMIT typeActionFinished(credentialName, result);
+}
 
-    if (released) {
-        qCDebug(ActionExecutorLog) << "Modifiers released during notification period - proceeding with type action";
-        return ActionResult::Success;
-    }
+void ActionExecutor::onModifierWaitTimedOut()
+{
+    closeModifierNotification();
 
-    // Phase 3: Timeout - modifiers still pressed after 15s
+    m_pendingCode.clear();
+    const QString credentialName = std::exchange(m_pendingCredentialName, QString());
     qCWarning(ActionExecutorLog) << "Modifier timeout - keys still pressed after"
-                                 << (INITIAL_WAIT_MS + RELEASE_WAIT_MS) << "ms - cancelling type action";
+                                 << MODIFIER_RELEASE_WAIT_SECONDS << "s - cancelling type action for:"
+                                 << credentialName;
 
-    // Show cancellation notification
     if (m_notificationOrchestrator) {
         m_notificationOrchestrator->showModifierCancelNotification();
     }
 
-    return ActionResult::Failed;
+    Q_EMIT typeActionFinished(credentialName, ActionResult::Failed);
+}
+
+void ActionExecutor::closeModifierNotification()
+{
+    m_modifierNoticeTimer.stop();
+    if (m_modifierNotificationShown && m_notificationOrchestrator) {
+        m_notificationOrchestrator->closeModifierNotification();
+    }
+    m_modifierNotificationShown = false;
 }
 
 } // namespace Daemon
@@ -7,6 +7,8 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 
 namespace YubiKeyOath {
 namespace Shared {
@@ -20,6 +22,7 @@ using Shared::ConfigurationProvider;
 class TextInputProvider;
 class ClipboardManager;
 class NotificationOrchestrator;
+class ModifierReleaseWatcher;
 
 /**
  * @brief Executes user actions (type/copy) with error handling
@@ -31,6 +34,12 @@ class NotificationOrchestrator;
  * - Type action: Attempts typing via input provider, falls back to clipboard on failure
  * - Copy action: Direct clipboard copy, no fallback
  *
+ * @par Modifier Keys
+ * Typing while Shift/Ctrl/Alt is held would produce shortcuts instead of digits.
+ * If modifiers are pressed, the type action is deferred: executeTypeAction()
+ * returns ActionResult::Deferred and typing starts as soon as the keys are
+ * released (event-driven, no polling), reported via typeActionFinished().
+ *
  * @par Input Methods
  * Supports multiple input methods via TextInputProvider:
  * - Portal (org.freedesktop.portal.RemoteDesktop) - works across X11/Wayland
@@ -52,6 +61,8 @@ class NotificationOrchestrator;
  * ActionExecutor::ActionResult result = executor->executeTypeAction("123456", "Google");
  * if (result == ActionExecutor::ActionResult::WaitingForPermission) {
  *     qDebug() << "Waiting for user to approve Portal permission...";
+ * } else if (result == ActionExecutor::ActionResult::Deferred) {
+ *     qDebug() << "Waiting for modifier release, see typeActionFinished()";
  * } else if (result == ActionExecutor::ActionResult::Success) {
  *     qDebug() << "Code typed successfully";
  * }
@@ -74,7 +85,8 @@ public:
     enum class ActionResult {
         Success,              ///< Action completed successfully
         Failed,               ///< Action failed completely (rare - usually has fallback)
-        WaitingForPermission  ///< Waiting for user to approve permission dialog (Portal only)
+        WaitingForPermission, ///< Waiting for user to approve permission dialog (Portal only)
+        Deferred              ///< Waiting for modifier key release, completes via typeActionFinished()
     };
 
     /**
@@ -104,9 +116,12 @@ public:
      *
      * @return ActionResult::Success - Code typed or copied (fallback) successfully
      *         ActionResult::WaitingForPermission - Portal permission dialog shown
+     *         ActionResult::Deferred - Modifier keys held; typing follows their release
      *         ActionResult::Failed - Both typing and clipboard failed (very rare)
      *
      * @note Emits notificationRequested() signal on fallback or failure.
+     * @note A new type action while one is deferred replaces the pending code;
+     *       the replaced one finishes with typeActionFinished(Failed).
      *
      * @par Thread Safety
      * Must be called from main/UI thread.
@@ -139,26 +154,46 @@ Q_SIGNALS:
      */
     void notificationRequested(const QString &title, const QString &message, int type);
 
+    /**
+     * @brief Emitted when a deferred type action completes
+     * @param credentialName Credential the code belongs to
+     * @param result Outcome of typing (Failed if modifiers were never released
+     *               or the request was superseded by a newer type action)
+     */
+    void typeActionFinished(const QString &credentialName, YubiKeyOath::Daemon::ActionExecutor::ActionResult result);
+
 private:
     /**
-     * @brief Checks for pressed modifier keys and waits for release
+     * @brief Types code via input provider, with clipboard fallback
+     */
+    ActionResult typeCode(const QString &code, const QString &credentialName);
+
+    /**
+     * @brief Defers typing until modifier keys are released
      *
      * Workflow:
-     * 1. Check if modifiers are pressed
-     * 2. Wait 500ms for release (silent polling)
-     * 3. If still pressed, show notification and wait up to 15s
-     * 4. If timeout, show cancel notification and fail
-     *
-     * @param credentialName Credential name for logging
-     * @return ActionResult::Success if modifiers released or not pressed
-     *         ActionResult::Failed if timeout waiting for release
+     * 1. Wait silently for a short grace period
+     * 2. If still pressed, show notification (up to 15s)
+     * 3. On release, close notification and type
+     * 4. On timeout, show cancel notification and fail
      */
-    ActionResult checkAndWaitForModifiers(const QString &credentialName);
+    void deferUntilModifiersReleased(const QString &code, const QString &credentialName);
+
+    void onModifiersReleased();
+    void onModifierWaitTimedOut();
+    void closeModifierNotification();
 
     TextInputProvider *m_textInput;
     ClipboardManager *m_clipboardManager;
     const ConfigurationProvider *m_config;
     NotificationOrchestrator *m_notificationOrchestrator;
+
+    ModifierReleaseWatcher *m_modifierWatcher;
+    QTimer m_modifierNoticeTimer;
+    QString m_pendingCode;
+    QString m_pendingCredentialName;
+    QStringList m_pendingModifiers;
+    bool m_modifierNotificationShown = false;
 };
 
 } // namespace Daemon
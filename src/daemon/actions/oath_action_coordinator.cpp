@@ -95,13 +95,24 @@ OathActionCoordinator::OathActionCoordinator(OathService *service,
         database,
         config))
 {
-    // Enable persistent portal session if configured (pre-creates session at startup)
-    if (m_textInput && config->persistPortalSession()) {
-        qCDebug(OathDaemonLog) << "OathActionCoordinator: Enabling persistent portal session mode";
-        m_textInput->setPersistSession(true);
-        m_textInput->preInitialize();
+    // Explicit setting wins (true also pre-creates the session at startup);
+    // without the key the provider decides from restore token availability
+    if (m_textInput && config->persistPortalSessionConfigured()) {
+        const bool persist = config->persistPortalSession();
+        qCDebug(OathDaemonLog) << "OathActionCoordinator: Persistent portal session mode:" << persist;
+        m_textInput->setPersistSession(persist);
+        if (persist) {
+            m_textInput->preInitialize();
+        }
+    }
+
+    if (m_textInput) {
+        m_textInput->setBurstTyping(config->burstTypeDigits());
     }
 
+    connect(m_actionExecutor.get(), &ActionExecutor::typeActionFinished,
+            this, &OathActionCoordinator::typeActionFinished);
+
     qCDebug(OathDaemonLog) << "OathActionCoordinator: Initialized with touch and reconnect workflow support";
 }
 
@@ -90,7 +90,7 @@ public:
      * @param credentialName Credential name for notifications
      * @param actionType "copy" or "type"
      * @param deviceModel Device model for brand-specific notification icon
-     * @return ActionResult (Success, Failed, WaitingForPermission)
+     * @return ActionResult (Success, Failed, WaitingForPermission, Deferred for type)
      *
      * Notification policy:
      * - Copy action: always shows notification on success with device-specific icon
@@ -199,16 +199,25 @@ public:
      * @brief Types pre-generated code without code generation
      * @param code TOTP/HOTP code to type
      * @param credentialName Credential name for notifications
-     * @return ActionResult (Success, Failed, WaitingForPermission)
+     * @return ActionResult (Success, Failed, WaitingForPermission, Deferred)
      *
      * Use this method when you already have a generated code and just need
      * to type it. Does NOT generate code - use generateCodeAsync() for that.
      * Useful for async workflows where code generation and typing are separate steps.
-     * Handles modifier key checking and Portal permission dialogs.
+     * Handles modifier key checking and Portal permission dialogs. Returns
+     * Deferred without blocking while modifier keys are held.
      */
     ActionExecutor::ActionResult executeTypeOnly(const QString &code,
                                                   const QString &credentialName);
 
+Q_SIGNALS:
+    /**
+     * @brief Emitted when a type action that returned Deferred completes
+     * @param credentialName Credential the code belongs to
+     * @param result Outcome of typing (see ActionExecutor::typeActionFinished())
+     */
+    void typeActionFinished(const QString &credentialName, YubiKeyOath::Daemon::ActionExecutor::ActionResult result);
+
 private:
 
     /**
@@ -82,6 +82,11 @@ int DaemonConfiguration::notificationExtraTime() const
     return readConfigEntry(ConfigKeys::NOTIFICATION_EXTRA_TIME, 15);
 }
 
+int DaemonConfiguration::notificationFrameRate() const
+{
+    return readConfigEntry(ConfigKeys::NOTIFICATION_FRAME_RATE, 1);
+}
+
 QString DaemonConfiguration::primaryAction() const
 {
     return readConfigEntry(ConfigKeys::PRIMARY_ACTION, QStringLiteral("copy"));
@@ -112,6 +117,21 @@ bool DaemonConfiguration::persistPortalSession() const
     return readConfigEntry(ConfigKeys::PERSIST_PORTAL_SESSION, true);
 }
 
+bool DaemonConfiguration::persistPortalSessionConfigured() const
+{
+    return m_configGroup.hasKey(ConfigKeys::PERSIST_PORTAL_SESSION);
+}
+
+bool DaemonConfiguration::burstTypeDigits() const
+{
+    return readConfigEntry(ConfigKeys::BURST_TYPE_DIGITS, false);
+}
+
+bool DaemonConfiguration::virtualCredentialObjects() const
+{
+    return readConfigEntry(ConfigKeys::VIRTUAL_CREDENTIAL_OBJECTS, false);
+}
+
 void DaemonConfiguration::onConfigFileChanged(const QString &path)
 {
     qDebug() << "DaemonConfiguration: Config file changed:" << path;
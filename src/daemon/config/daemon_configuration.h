@@ -42,6 +42,7 @@ public:
     bool showDeviceNameOnlyWhenMultiple() const override;
     int touchTimeout() const override;
     int notificationExtraTime() const override;
+    int notificationFrameRate() const override;
     QString primaryAction() const override;
 
     // Caching settings
@@ -54,6 +55,17 @@ public:
 
     // Portal session settings
     bool persistPortalSession() const override;
+    bool persistPortalSessionConfigured() const override;
+    bool burstTypeDigits() const override;
+
+    /**
+     * @brief Serve credential D-Bus objects from one virtual subtree per device
+     *
+     * When enabled, no QObject/adaptor is registered per credential until a
+     * client calls one of its methods. Read when a device object is created.
+     * scripts/measure-credential-objects-rss.sh compares daemon RSS in both modes.
+     */
+    bool virtualCredentialObjects() const;
 
 Q_SIGNALS:
     /**
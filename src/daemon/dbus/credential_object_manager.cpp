@@ -4,8 +4,10 @@
  */
 
 #include "credential_object_manager.h"
+#include "credential_subtree_object.h"
 #include "oath_credential_object.h"
 #include "services/oath_service.h"
+#include "config/daemon_configuration.h"
 #include "utils/credential_id_encoder.h"
 #include "logging_categories.h"
 
@@ -25,7 +27,19 @@ CredentialObjectManager::CredentialObjectManager(QString deviceId,
     , m_service(service)
     , m_connection(std::move(connection))
 {
-    qCDebug(OathDaemonLog) << "CredentialObjectManager: Created for device:" << m_deviceId;
+    const auto *config = m_service ? m_service->getConfiguration() : nullptr;
+    if (config && config->virtualCredentialObjects()) {
+        m_subtree = std::make_unique<CredentialSubtreeObject>(
+            m_deviceId, m_devicePath + QStringLiteral("/credentials"), m_service, m_connection);
+        if (!m_subtree->registerObject()) {
+            qCWarning(OathDaemonLog) << "CredentialObjectManager: Falling back to per-credential objects for"
+                                        << m_deviceId;
+            m_subtree.reset();
+        }
+    }
+
+    qCDebug(OathDaemonLog) << "CredentialObjectManager: Created for device:" << m_deviceId
+                              << "mode:" << (m_subtree ? "virtual subtree" : "per-credential objects");
 }
 
 CredentialObjectManager::~CredentialObjectManager()
@@ -38,13 +52,104 @@ OathCredentialObject* CredentialObjectManager::addCredential(const Shared::OathC
 {
     const QString credId = CredentialIdEncoder::encode(credential.originalName);
 
+    // Check if already exists
+    if (hasCredential(credId)) {
+        qCWarning(OathDaemonLog) << "CredentialObjectManager: Credential already exists:" << credId;
+        return getCredential(credId);
+    }
+
+    const QString path = registerCredential(credential);
+    if (path.isEmpty()) {
+        return nullptr;
+    }
+
+    // Emit signal for parent to forward to D-Bus
+    Q_EMIT credentialAdded(path);
+
+    qCInfo(OathDaemonLog) << "CredentialObjectManager: Credential added:" << credential.originalName
+                             << "at" << path;
+
+    return getCredential(credId);
+}
+
+void CredentialObjectManager::removeCredential(const QString &credentialId)
+{
+    const QString path = unregisterCredential(credentialId);
+    if (path.isEmpty()) {
+        qCWarning(OathDaemonLog) << "CredentialObjectManager: Credential not found:" << credentialId;
+        return;
+    }
+
+    // Emit signal for parent to forward to D-Bus
+    Q_EMIT credentialRemoved(path);
+
+    qCInfo(OathDaemonLog) << "CredentialObjectManager: Credential removed:" << credentialId;
+}
+
+QStringList CredentialObjectManager::addCredentials(const QList<Shared::OathCredential> &credentials)
+{
+    QStringList paths;
+    paths.reserve(credentials.size());
+
+    for (const auto &credential : credentials) {
+        if (hasCredential(CredentialIdEncoder::encode(credential.originalName))) {
+            continue;
+        }
+        const QString path = registerCredential(credential);
+        if (!path.isEmpty()) {
+            paths.append(path);
+        }
+    }
+
+    if (!paths.isEmpty()) {
+        m_objectsBatched += static_cast<quint64>(paths.size());
+        ++m_batchSignals;
+        Q_EMIT credentialsAdded(paths);
+
+        qCInfo(OathDaemonLog) << "CredentialObjectManager: Added" << paths.size()
+                                 << "credentials for device:" << m_deviceId
+                                 << "- batched" << m_objectsBatched << "objects into"
+                                 << m_batchSignals << "signals";
+    }
+
+    return paths;
+}
+
+void CredentialObjectManager::removeCredentials(const QStringList &credentialIds)
+{
+    QStringList paths;
+    paths.reserve(credentialIds.size());
+
+    for (const QString &credId : credentialIds) {
+        const QString path = unregisterCredential(credId);
+        if (!path.isEmpty()) {
+            paths.append(path);
+        }
+    }
+
+    if (!paths.isEmpty()) {
+        m_objectsBatched += static_cast<quint64>(paths.size());
+        ++m_batchSignals;
+        Q_EMIT credentialsRemoved(paths);
+
+        qCInfo(OathDaemonLog) << "CredentialObjectManager: Removed" << paths.size()
+                                 << "credentials for device:" << m_deviceId
+                                 << "- batched" << m_objectsBatched << "objects into"
+                                 << m_batchSignals << "signals";
+    }
+}
+
+QString CredentialObjectManager::registerCredential(const Shared::OathCredential &credential)
+{
+    const QString credId = CredentialIdEncoder::encode(credential.originalName);
+
     qCDebug(OathDaemonLog) << "CredentialObjectManager: Adding credential:" << credential.originalName
                               << "id:" << credId << "for device:" << m_deviceId;
 
-    // Check if already exists
-    if (m_credentials.contains(credId)) {
-        qCWarning(OathDaemonLog) << "CredentialObjectManager: Credential already exists:" << credId;
-        return m_credentials.value(credId);
+    // Virtual mode: data only, subtree answers for the path
+    if (m_subtree) {
+        m_subtree->insert(credId, credential);
+        return credentialPath(credId);
     }
 
     // Create credential object
@@ -59,55 +164,70 @@ OathCredentialObject* CredentialObjectManager::addCredential(const Shared::OathC
         qCCritical(OathDaemonLog) << "CredentialObjectManager: Failed to register credential object"
                                      << credId;
         delete credObj;
-        return nullptr;
+        return {};
     }
 
     m_credentials.insert(credId, credObj);
-
-    // Emit signal for parent to forward to D-Bus
-    Q_EMIT credentialAdded(path);
-
-    qCInfo(OathDaemonLog) << "CredentialObjectManager: Credential added:" << credential.originalName
-                             << "at" << path;
-
-    return credObj;
+    return path;
 }
 
-void CredentialObjectManager::removeCredential(const QString &credentialId)
+QString CredentialObjectManager::unregisterCredential(const QString &credentialId)
 {
     qCDebug(OathDaemonLog) << "CredentialObjectManager: Removing credential:" << credentialId
                               << "from device:" << m_deviceId;
 
-    if (!m_credentials.contains(credentialId)) {
-        qCWarning(OathDaemonLog) << "CredentialObjectManager: Credential not found:" << credentialId;
-        return;
+    if (m_subtree) {
+        return m_subtree->remove(credentialId) ? credentialPath(credentialId) : QString();
+    }
+
+    OathCredentialObject *const credObj = m_credentials.take(credentialId);
+    if (!credObj) {
+        return {};
     }
 
-    OathCredentialObject *const credObj = m_credentials.value(credentialId);
     const QString path = credObj->objectPath();
 
     // Unregister and delete
     credObj->unregisterObject();
     delete credObj;
 
-    m_credentials.remove(credentialId);
+    return path;
+}
 
-    // Emit signal for parent to forward to D-Bus
-    Q_EMIT credentialRemoved(path);
+bool CredentialObjectManager::hasCredential(const QString &credentialId) const
+{
+    return m_subtree ? m_subtree->contains(credentialId) : m_credentials.contains(credentialId);
+}
 
-    qCInfo(OathDaemonLog) << "CredentialObjectManager: Credential removed:" << credentialId;
+QStringList CredentialObjectManager::credentialIds() const
+{
+    return m_subtree ? m_subtree->credentialIds() : m_credentials.keys();
 }
 
 OathCredentialObject* CredentialObjectManager::getCredential(const QString &credentialId) const
 {
+    if (m_subtree) {
+        return m_subtree->liveObject(credentialId);
+    }
     return m_credentials.value(credentialId, nullptr);
 }
 
+QVariantMap CredentialObjectManager::getManagedObjectData(const QString &credentialId) const
+{
+    if (m_subtree) {
+        return m_subtree->managedObjectData(credentialId);
+    }
+    const auto *credObj = m_credentials.value(credentialId, nullptr);
+    return credObj ? credObj->getManagedObjectData() : QVariantMap();
+}
+
 QStringList CredentialObjectManager::credentialPaths() const
 {
     QStringList paths;
-    for (auto it = m_credentials.constBegin(); it != m_credentials.constEnd(); ++it) {
-        paths.append(it.value()->objectPath());
+    const QStringList ids = credentialIds();
+    paths.reserve(ids.size());
+    for (const QString &credId : ids) {
+        paths.append(credentialPath(credId));
     }
     return paths;
 }
@@ -127,26 +247,26 @@ void CredentialObjectManager::updateCredentials()
     }
 
     // Build set of existing credential IDs
-    const QSet<QString> existingCredIds = QSet<QString>(m_credentials.keyBegin(),
-                                                         m_credentials.keyEnd());
+    const QStringList existingIds = credentialIds();
+    const QSet<QString> existingCredIds(existingIds.cbegin(), existingIds.cend());
 
-    // Remove credentials that no longer exist
+    // Remove credentials that no longer exist (one bulk signal)
     const QSet<QString> toRemove = existingCredIds - currentCredIds;
-    for (const QString &credId : toRemove) {
-        removeCredential(credId);
-    }
+    removeCredentials(QStringList(toRemove.cbegin(), toRemove.cend()));
 
-    // Add new credentials
+    // Add new credentials (one bulk signal)
     const QSet<QString> toAdd = currentCredIds - existingCredIds;
+    QList<Shared::OathCredential> added;
+    added.reserve(toAdd.size());
     for (const auto &cred : currentCreds) {
-        const QString credId = CredentialIdEncoder::encode(cred.originalName);
-        if (toAdd.contains(credId)) {
-            addCredential(cred);
+        if (toAdd.contains(CredentialIdEncoder::encode(cred.originalName))) {
+            added.append(cred);
         }
     }
+    addCredentials(added);
 
     qCDebug(OathDaemonLog) << "CredentialObjectManager: Credentials updated for device:"
-                              << m_deviceId << "- total:" << m_credentials.size();
+                              << m_deviceId << "- total:" << credentialIds().size();
 }
 
 void CredentialObjectManager::removeAllCredentials()
@@ -154,20 +274,44 @@ void CredentialObjectManager::removeAllCredentials()
     qCDebug(OathDaemonLog) << "CredentialObjectManager: Removing all credentials for device:"
                               << m_deviceId;
 
-    const QStringList credIds = m_credentials.keys();
-    for (const QString &credId : credIds) {
-        removeCredential(credId);
-    }
+    removeCredentials(credentialIds());
 }
 
 QVariantMap CredentialObjectManager::getManagedObjects() const
 {
     QVariantMap result;
 
-    for (auto it = m_credentials.constBegin(); it != m_credentials.constEnd(); ++it) {
-        const QString path = it.value()->objectPath();
-        const QVariantMap credData = it.value()->getManagedObjectData();
-        result.insert(path, credData);
+    const QStringList ids = credentialIds();
+    for (const QString &credId : ids) {
+        result.insert(credentialPath(credId), getManagedObjectData(credId));
+    }
+
+    return result;
+}
+
+QList<Shared::PackedCredential> CredentialObjectManager::getPackedCredentials() const
+{
+    QList<Shared::PackedCredential> result;
+    const QStringList ids = credentialIds();
+    result.reserve(ids.size());
+
+    for (const QString &credId : ids) {
+        const Shared::OathCredential credential = m_subtree
+            ? m_subtree->credential(credId)
+            : m_credentials.value(credId)->credential();
+
+        Shared::PackedCredential packed;
+        packed.path = QDBusObjectPath(credentialPath(credId));
+        packed.fullName = credential.originalName;
+        packed.issuer = credential.issuer;
+        packed.username = credential.account;
+        packed.deviceId = m_deviceId;
+        packed.requiresTouch = credential.requiresTouch;
+        packed.type = static_cast<quint8>(credential.type);
+        packed.algorithm = static_cast<quint8>(credential.algorithm);
+        packed.digits = static_cast<quint8>(credential.digits);
+        packed.period = static_cast<quint16>(credential.period);
+        result.append(packed);
     }
 
     return result;
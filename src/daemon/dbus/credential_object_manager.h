@@ -8,8 +8,11 @@
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QStringList>
 #include <QDBusConnection>
+#include <memory>
 #include "types/oath_credential.h"
+#include "types/yubikey_value_types.h"
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -17,6 +20,7 @@ namespace Daemon {
 // Forward declarations
 class OathService;
 class OathCredentialObject;
+class CredentialSubtreeObject;
 
 /**
  * @brief Manages lifecycle of OathCredentialObject instances for a device
@@ -34,6 +38,12 @@ class OathCredentialObject;
  * @par Usage
  * Created by OathDeviceObject to manage its credential sub-objects.
  * OathDeviceObject forwards the signals for D-Bus hierarchy.
+ *
+ * @par Virtual mode
+ * With VirtualCredentialObjects enabled, no object is registered per
+ * credential. A single CredentialSubtreeObject serves devicePath/credentials/*
+ * and creates an OathCredentialObject only when a client calls a method.
+ * The D-Bus paths, properties and signals are identical in both modes.
  */
 class CredentialObjectManager : public QObject
 {
@@ -68,13 +78,42 @@ public:
      */
     void removeCredential(const QString &credentialId);
 
+    /**
+     * @brief Creates and registers several credential D-Bus objects at once
+     * @param credentials Credentials to publish
+     * @return D-Bus paths of the objects actually registered
+     *
+     * Emits a single credentialsAdded() for the whole batch instead of one
+     * credentialAdded() per credential. Already existing credentials are skipped.
+     */
+    QStringList addCredentials(const QList<Shared::OathCredential> &credentials);
+
+    /**
+     * @brief Removes and unregisters several credential D-Bus objects at once
+     * @param credentialIds Credential IDs (encoded names)
+     *
+     * Emits a single credentialsRemoved() for the whole batch.
+     */
+    void removeCredentials(const QStringList &credentialIds);
+
     /**
      * @brief Gets credential object by ID
      * @param credentialId Credential ID (encoded name)
      * @return Pointer to CredentialObject or nullptr if not found
+     *
+     * In virtual mode this materializes the credential's live object.
      */
     [[nodiscard]] OathCredentialObject* getCredential(const QString &credentialId) const;
 
+    /**
+     * @brief Gets ObjectManager data for one credential
+     * @param credentialId Credential ID (encoded name)
+     * @return Map of interface → properties, empty if not found
+     *
+     * Does not create a live object in virtual mode.
+     */
+    [[nodiscard]] QVariantMap getManagedObjectData(const QString &credentialId) const;
+
     /**
      * @brief Gets all credential object paths
      * @return List of D-Bus paths for all managed credentials
@@ -102,6 +141,14 @@ public:
      */
     [[nodiscard]] QVariantMap getManagedObjects() const;
 
+    /**
+     * @brief Gets all credentials in packed form
+     * @return One PackedCredential per published credential (no live objects created)
+     *
+     * Used by Manager's GetManagedObjectsPacked()
+     */
+    [[nodiscard]] QList<Shared::PackedCredential> getPackedCredentials() const;
+
 Q_SIGNALS:
     /**
      * @brief Emitted when a credential object is added
@@ -115,7 +162,34 @@ Q_SIGNALS:
      */
     void credentialRemoved(const QString &credentialPath);
 
+    /**
+     * @brief Emitted once per addCredentials() batch
+     * @param credentialPaths D-Bus object paths of added credentials (never empty)
+     */
+    void credentialsAdded(const QStringList &credentialPaths);
+
+    /**
+     * @brief Emitted once per removeCredentials() batch
+     * @param credentialPaths D-Bus object paths of removed credentials (never empty)
+     */
+    void credentialsRemoved(const QStringList &credentialPaths);
+
 private:
+    /**
+     * @brief Publishes a credential (object or subtree entry) without emitting signals
+     * @return D-Bus path, or empty string if registration failed
+     */
+    QString registerCredential(const Shared::OathCredential &credential);
+
+    /**
+     * @brief Unregisters and deletes a credential object without emitting signals
+     * @return D-Bus path of removed object, or empty string if not found
+     */
+    QString unregisterCredential(const QString &credentialId);
+
+    [[nodiscard]] bool hasCredential(const QString &credentialId) const;
+    [[nodiscard]] QStringList credentialIds() const;
+
     /**
      * @brief Builds credential D-Bus object path
      * @param credentialId Encoded credential ID
@@ -127,7 +201,12 @@ private:
     QString m_devicePath;
     OathService *m_service;
     QDBusConnection m_connection;
-    QMap<QString, OathCredentialObject*> m_credentials;  ///< Credential ID → CredentialObject
+    QMap<QString, OathCredentialObject*> m_credentials;  ///< Credential ID → CredentialObject (object mode)
+    std::unique_ptr<CredentialSubtreeObject> m_subtree;  ///< Virtual mode handler (null in object mode)
+
+    // Bulk signalling statistics
+    quint64 m_objectsBatched{0};   ///< Objects added/removed through batch calls
+    quint64 m_batchSignals{0};     ///< Bulk signals emitted for them
 };
 
 } // namespace Daemon
@@ -0,0 +1,316 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "credential_subtree_object.h"
+#include "oath_credential_object.h"
+#include "logging_categories.h"
+#include "credentialadaptor.h"  // Auto-generated D-Bus adaptor (introspection XML)
+
+#include <QDBusError>
+#include <QDBusMessage>
+#include <QDBusVariant>
+#include <QMetaClassInfo>
+#include <utility>
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+static constexpr const char *CREDENTIAL_INTERFACE = "pl.jkolo.yubikey.oath.Credential";
+static constexpr const char *PROPERTIES_INTERFACE = "org.freedesktop.DBus.Properties";
+
+CredentialSubtreeObject::CredentialSubtreeObject(QString deviceId,
+                                                 QString basePath,
+                                                 OathService *service,
+                                                 QDBusConnection connection,
+                                                 QObject *parent)
+    : QDBusVirtualObject(parent)
+    , m_deviceId(std::move(deviceId))
+    , m_basePath(std::move(basePath))
+    , m_service(service)
+    , m_connection(std::move(connection))
+{
+    qCDebug(OathDaemonLog) << "CredentialSubtreeObject: Created for device:" << m_deviceId
+                              << "at" << m_basePath;
+}
+
+CredentialSubtreeObject::~CredentialSubtreeObject()
+{
+    unregisterObject();
+    qDeleteAll(m_liveObjects);
+}
+
+bool CredentialSubtreeObject::registerObject()
+{
+    if (m_registered) {
+        return true;
+    }
+
+    if (!m_connection.registerVirtualObject(m_basePath, this, QDBusConnection::SubPath)) {
+        qCCritical(OathDaemonLog) << "CredentialSubtreeObject: Failed to register at"
+                                     << m_basePath << ":" << m_connection.lastError().message();
+        return false;
+    }
+
+    m_registered = true;
+    qCInfo(OathDaemonLog) << "CredentialSubtreeObject: Registered credential subtree at" << m_basePath;
+    return true;
+}
+
+void CredentialSubtreeObject::unregisterObject()
+{
+    if (!m_registered) {
+        return;
+    }
+
+    m_connection.unregisterObject(m_basePath);
+    m_registered = false;
+    qCDebug(OathDaemonLog) << "CredentialSubtreeObject: Unregistered:" << m_basePath;
+}
+
+bool CredentialSubtreeObject::insert(const QString &credentialId, const Shared::OathCredential &credential)
+{
+    if (m_credentials.contains(credentialId)) {
+        return false;
+    }
+    m_credentials.insert(credentialId, credential);
+    return true;
+}
+
+bool CredentialSubtreeObject::remove(const QString &credentialId)
+{
+    if (m_credentials.remove(credentialId) == 0) {
+        return false;
+    }
+    // Deferred: removal may be triggered from within the object's own signal handling
+    if (auto *object = m_liveObjects.take(credentialId)) {
+        object->deleteLater();
+    }
+    return true;
+}
+
+bool CredentialSubtreeObject::contains(const QString &credentialId) const
+{
+    return m_credentials.contains(credentialId);
+}
+
+QStringList CredentialSubtreeObject::credentialIds() const
+{
+    return m_credentials.keys();
+}
+
+QString CredentialSubtreeObject::credentialPath(const QString &credentialId) const
+{
+    return m_basePath + QLatin1Char('/') + credentialId;
+}
+
+Shared::OathCredential CredentialSubtreeObject::credential(const QString &credentialId) const
+{
+    return m_credentials.value(credentialId);
+}
+
+QVariantMap CredentialSubtreeObject::managedObjectData(const QString &credentialId) const
+{
+    const auto it = m_credentials.constFind(credentialId);
+    if (it == m_credentials.constEnd()) {
+        return {};
+    }
+
+    QVariantMap result;
+    result.insert(QLatin1String(CREDENTIAL_INTERFACE),
+                  OathCredentialObject::credentialProperties(it.value(), m_deviceId));
+    return result;
+}
+
+OathCredentialObject* CredentialSubtreeObject::liveObject(const QString &credentialId)
+{
+    if (auto *object = m_liveObjects.value(credentialId)) {
+        return object;
+    }
+
+    const auto it = m_credentials.constFind(credentialId);
+    if (it == m_credentials.constEnd()) {
+        return nullptr;
+    }
+
+    // Not registered on D-Bus - this subtree dispatches to it and relays its signals
+    const QString path = credentialPath(credentialId);
+    auto *object = new OathCredentialObject(it.value(), m_deviceId, m_service, m_connection);
+    object->setObjectPath(path);
+    relaySignals(object, path);
+    m_liveObjects.insert(credentialId, object);
+
+    qCDebug(OathDaemonLog) << "CredentialSubtreeObject: Materialized credential" << credentialId
+                              << "- live objects:" << m_liveObjects.size() << "of" << m_credentials.size();
+    return object;
+}
+
+QString CredentialSubtreeObject::introspect(const QString &path) const
+{
+    // Subtree root: list children so tools like qdbus/d-feet can walk the tree
+    if (path == m_basePath) {
+        QString nodes;
+        for (auto it = m_credentials.constBegin(); it != m_credentials.constEnd(); ++it) {
+            nodes += QStringLiteral("  <node name=\"%1\"/>\n").arg(it.key());
+        }
+        return nodes;
+    }
+
+    if (!contains(credentialIdForPath(path))) {
+        return {};
+    }
+
+    // Same interface description the adaptor exports for registered objects
+    static const QString interfaceXml = QString::fromUtf8(
+        CredentialAdaptor::staticMetaObject.classInfo(
+            CredentialAdaptor::staticMetaObject.indexOfClassInfo("D-Bus Introspection")).value());
+    return interfaceXml;
+}
+
+bool CredentialSubtreeObject::handleMessage(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    const QString credentialId = credentialIdForPath(message.path());
+    if (!contains(credentialId)) {
+        return false; // QtDBus replies with UnknownObject
+    }
+
+    const QString interface = message.interface();
+    if (interface == QLatin1String(PROPERTIES_INTERFACE)) {
+        return handlePropertiesCall(credentialId, message, connection);
+    }
+    if (interface.isEmpty() || interface == QLatin1String(CREDENTIAL_INTERFACE)) {
+        return handleCredentialCall(credentialId, message, connection);
+    }
+
+    return false; // Introspectable etc. handled by QtDBus via introspect()
+}
+
+QString CredentialSubtreeObject::credentialIdForPath(const QString &path) const
+{
+    if (!path.startsWith(m_basePath + QLatin1Char('/'))) {
+        return {};
+    }
+    const QString id = path.mid(m_basePath.size() + 1);
+    return id.contains(QLatin1Char('/')) ? QString() : id;
+}
+
+bool CredentialSubtreeObject::handlePropertiesCall(const QString &credentialId,
+                                                   const QDBusMessage &message,
+                                                   const QDBusConnection &connection) const
+{
+    const QList<QVariant> args = message.arguments();
+    const QString member = message.member();
+    const QString interface = args.isEmpty() ? QString() : args.at(0).toString();
+
+    if (interface != QLatin1String(CREDENTIAL_INTERFACE)) {
+        connection.send(message.createErrorReply(QDBusError::UnknownInterface,
+                                                 QStringLiteral("Unknown interface: %1").arg(interface)));
+        return true;
+    }
+
+    const QVariantMap properties = managedObjectData(credentialId)
+                                       .value(QLatin1String(CREDENTIAL_INTERFACE)).toMap();
+
+    if (member == QLatin1String("GetAll")) {
+        connection.send(message.createReply(QVariant::fromValue(properties)));
+        return true;
+    }
+
+    const QString propertyName = args.size() > 1 ? args.at(1).toString() : QString();
+    if (member == QLatin1String("Get")) {
+        if (!properties.contains(propertyName)) {
+            connection.send(message.createErrorReply(QDBusError::UnknownProperty,
+                                                     QStringLiteral("Unknown property: %1").arg(propertyName)));
+        } else {
+            connection.send(message.createReply(QVariant::fromValue(QDBusVariant(properties.value(propertyName)))));
+        }
+        return true;
+    }
+
+    if (member == QLatin1String("Set")) {
+        connection.send(message.createErrorReply(QDBusError::PropertyReadOnly,
+                                                 QStringLiteral("Property %1 is read-only").arg(propertyName)));
+        return true;
+    }
+
+    return false;
+}
+
+bool CredentialSubtreeObject::handleCredentialCall(const QString &credentialId,
+                                                   const QDBusMessage &message,
+                                                   const QDBusConnection &connection)
+{
+    const QString member = message.member();
+    const QList<QVariant> args = message.arguments();
+
+    OathCredentialObject *object = nullptr;
+    if (member == QLatin1String("GenerateCode")) {
+        object = liveObject(credentialId);
+        object->GenerateCode();
+    } else if (member == QLatin1String("CopyToClipboard")) {
+        object = liveObject(credentialId);
+        object->CopyToClipboard();
+    } else if (member == QLatin1String("TypeCode") && args.size() == 1) {
+        object = liveObject(credentialId);
+        object->TypeCode(args.at(0).toBool());
+    } else if (member == QLatin1String("Delete")) {
+        object = liveObject(credentialId);
+        object->Delete();
+    } else {
+        return false; // QtDBus replies with UnknownMethod
+    }
+
+    // All Credential methods are NoReply, but answer callers that still wait
+    if (message.isReplyRequired()) {
+        connection.send(message.createReply());
+    }
+    return true;
+}
+
+void CredentialSubtreeObject::relaySignals(OathCredentialObject *object, const QString &path)
+{
+    const auto relay = [this, path](const QString &name, const QList<QVariant> &arguments) {
+        QDBusMessage signal = QDBusMessage::createSignal(path, QLatin1String(CREDENTIAL_INTERFACE), name);
+        signal.setArguments(arguments);
+        if (!m_connection.send(signal)) {
+            qCWarning(OathDaemonLog) << "CredentialSubtreeObject: Failed to emit" << name << "on" << path;
+        }
+    };
+
+    connect(object, &OathCredentialObject::CodeGenerated, this,
+            [relay](const QString &code, qint64 validUntil, const QString &error) {
+                relay(QStringLiteral("CodeGenerated"), {code, validUntil, error});
+            });
+    connect(object, &OathCredentialObject::ClipboardCopied, this,
+            [relay](bool success, const QString &error) {
+                relay(QStringLiteral("ClipboardCopied"), {success, error});
+            });
+    connect(object, &OathCredentialObject::CodeTyped, this,
+            [relay](bool success, const QString &error) {
+                relay(QStringLiteral("CodeTyped"), {success, error});
+            });
+    connect(object, &OathCredentialObject::Deleted, this,
+            [relay](bool success, const QString &error) {
+                relay(QStringLiteral("Deleted"), {success, error});
+            });
+    connect(object, &OathCredentialObject::TouchRequired, this,
+            [relay](int timeoutSeconds, const QString &deviceModel) {
+                relay(QStringLiteral("TouchRequired"), {timeoutSeconds, deviceModel});
+            });
+    connect(object, &OathCredentialObject::TouchCompleted, this,
+            [relay](bool success) {
+                relay(QStringLiteral("TouchCompleted"), {success});
+            });
+    connect(object, &OathCredentialObject::ReconnectRequired, this,
+            [relay](const QString &deviceModel) {
+                relay(QStringLiteral("ReconnectRequired"), {deviceModel});
+            });
+    connect(object, &OathCredentialObject::ReconnectCompleted, this,
+            [relay](bool success) {
+                relay(QStringLiteral("ReconnectCompleted"), {success});
+            });
+}
+
+} // namespace Daemon
+} // namespace YubiKeyOath
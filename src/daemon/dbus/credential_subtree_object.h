@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QDBusVirtualObject>
+#include <QDBusConnection>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include "types/oath_credential.h"
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+// Forward declarations
+class OathService;
+class OathCredentialObject;
+
+/**
+ * @brief Serves all credential objects of a device from one virtual D-Bus object
+ *
+ * D-Bus path: /pl/jkolo/yubikey/oath/devices/<deviceId>/credentials (registered with SubPath)
+ * Children:   .../credentials/<credentialId>, Interfaces: pl.jkolo.yubikey.oath.Credential,
+ *             Properties, Introspectable
+ *
+ * Alternative to registering one OathCredentialObject (QObject + CredentialAdaptor +
+ * object tree node) per credential. Only the credential data is stored; property
+ * reads are answered from it directly. An OathCredentialObject is created lazily
+ * the first time a client invokes a method on a credential and then kept (without
+ * being registered itself) - its result signals are relayed from the child path.
+ *
+ * @par Usage
+ * Owned by CredentialObjectManager when VirtualCredentialObjects is enabled.
+ */
+class CredentialSubtreeObject : public QDBusVirtualObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs credential subtree
+     * @param deviceId Device ID (for credential association)
+     * @param basePath D-Bus path of subtree root (devicePath/credentials)
+     * @param service Pointer to OathService
+     * @param connection D-Bus connection
+     * @param parent Parent QObject (typically CredentialObjectManager)
+     */
+    explicit CredentialSubtreeObject(QString deviceId,
+                                     QString basePath,
+                                     OathService *service,
+                                     QDBusConnection connection,
+                                     QObject *parent = nullptr);
+    ~CredentialSubtreeObject() override;
+
+    /**
+     * @brief Registers subtree root on D-Bus
+     * @return true on success
+     */
+    bool registerObject();
+
+    /**
+     * @brief Unregisters subtree root from D-Bus
+     */
+    void unregisterObject();
+
+    /**
+     * @brief Publishes a credential under basePath/credentialId
+     * @return false if credentialId is already present
+     */
+    bool insert(const QString &credentialId, const Shared::OathCredential &credential);
+
+    /**
+     * @brief Withdraws a credential and destroys its live object, if any
+     * @return false if credentialId is unknown
+     */
+    bool remove(const QString &credentialId);
+
+    [[nodiscard]] bool contains(const QString &credentialId) const;
+    [[nodiscard]] QStringList credentialIds() const;
+    [[nodiscard]] QString credentialPath(const QString &credentialId) const;
+
+    /**
+     * @brief Gets stored credential data
+     * @return Credential or default-constructed value if credentialId is unknown
+     */
+    [[nodiscard]] Shared::OathCredential credential(const QString &credentialId) const;
+
+    /**
+     * @brief Gets ObjectManager data (interface → properties) for a credential
+     */
+    [[nodiscard]] QVariantMap managedObjectData(const QString &credentialId) const;
+
+    /**
+     * @brief Returns live object for credential, creating it on first use
+     * @return Object or nullptr if credentialId is unknown
+     */
+    OathCredentialObject* liveObject(const QString &credentialId);
+
+    /**
+     * @brief Number of credentials that currently have a live object
+     */
+    [[nodiscard]] int liveObjectCount() const { return static_cast<int>(m_liveObjects.size()); }
+
+    // QDBusVirtualObject interface
+    QString introspect(const QString &path) const override;
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override;
+
+private:
+    /**
+     * @brief Extracts credential ID from a child path
+     * @return ID or empty string if path is not a direct child of basePath
+     */
+    [[nodiscard]] QString credentialIdForPath(const QString &path) const;
+
+    bool handlePropertiesCall(const QString &credentialId, const QDBusMessage &message,
+                              const QDBusConnection &connection) const;
+    bool handleCredentialCall(const QString &credentialId, const QDBusMessage &message,
+                              const QDBusConnection &connection);
+
+    /**
+     * @brief Re-emits live object's Credential signals from its child path
+     */
+    void relaySignals(OathCredentialObject *object, const QString &path);
+
+    QString m_deviceId;
+    QString m_basePath;
+    OathService *m_service;
+    QDBusConnection m_connection;
+    bool m_registered{false};
+    QMap<QString, Shared::OathCredential> m_credentials;     ///< Credential ID → data
+    QHash<QString, OathCredentialObject*> m_liveObjects;     ///< Credential ID → live object (owned)
+};
+
+} // namespace Daemon
+} // namespace YubiKeyOath
@@ -292,29 +292,49 @@ void OathCredentialObject::TypeCode(bool fallbackToCopy)
         QElapsedTimer actionTimer;
         actionTimer.start();
 
-        auto result = m_service->getActionCoordinator()->executeTypeOnly(code, m_credential.originalName);
-        bool success = (result == ActionExecutor::ActionResult::Success);
+        auto *coordinator = m_service->getActionCoordinator();
+        const auto result = coordinator->executeTypeOnly(code, m_credential.originalName);
 
         qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: [TIMING] executeTypeOnly took"
-                                  << actionTimer.elapsed() << "ms";
-
-        if (!success && fallbackToCopy) {
-            qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: TypeCode failed, falling back to clipboard";
-            auto *device = m_service->getDevice(m_deviceId);
-            const Shared::DeviceModel deviceModel = device ? device->deviceModel() : Shared::DeviceModel{};
-            auto copyResult = m_service->getActionCoordinator()->executeActionWithNotification(
-                code, m_credential.originalName, QStringLiteral("copy"), deviceModel);
-            success = (copyResult == ActionExecutor::ActionResult::Success);
-        }
-
-        qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: [TIMING] TypeCode total:"
-                                  << typeCodeTimer->elapsed() << "ms";
+                                  << actionTimer.elapsed() << "ms, total:" << typeCodeTimer->elapsed() << "ms";
         delete typeCodeTimer;
 
-        Q_EMIT CodeTyped(success, success ? QString() : QStringLiteral("Failed to type code"));
+        if (result != ActionExecutor::ActionResult::Deferred) {
+            finishTypeCode(code, result, fallbackToCopy);
+            return;
+        }
+
+        // Typing starts once the user releases modifier keys - report CodeTyped then
+        qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: TypeCode deferred until modifiers are released";
+        disconnect(m_deferredTypeConnection);
+        m_deferredTypeConnection = connect(coordinator, &OathActionCoordinator::typeActionFinished,
+                this, [this, code, fallbackToCopy](const QString &credentialName, ActionExecutor::ActionResult finalResult) {
+            if (credentialName != m_credential.originalName) {
+                return;
+            }
+            disconnect(m_deferredTypeConnection);
+            m_deferredTypeConnection = {};
+            finishTypeCode(code, finalResult, fallbackToCopy);
+        });
     });
 }
 
+void OathCredentialObject::finishTypeCode(const QString &code, ActionExecutor::ActionResult result, bool fallbackToCopy)
+{
+    bool success = (result == ActionExecutor::ActionResult::Success);
+
+    if (!success && fallbackToCopy) {
+        qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: TypeCode failed, falling back to clipboard";
+        auto *device = m_service->getDevice(m_deviceId);
+        const Shared::DeviceModel deviceModel = device ? device->deviceModel() : Shared::DeviceModel{};
+        auto copyResult = m_service->getActionCoordinator()->executeActionWithNotification(
+            code, m_credential.originalName, QStringLiteral("copy"), deviceModel);
+        success = (copyResult == ActionExecutor::ActionResult::Success);
+    }
+
+    Q_EMIT CodeTyped(success, success ? QString() : QStringLiteral("Failed to type code"));
+}
+
 void OathCredentialObject::Delete()
 {
     qCDebug(OathDaemonLog) << "YubiKeyCredentialObject: Delete (async) credential:"
@@ -342,21 +362,28 @@ QVariantMap OathCredentialObject::getManagedObjectData() const
     QVariantMap result;
 
     // pl.jkolo.yubikey.oath.Credential interface properties
-    QVariantMap credProps;
-    credProps.insert(QLatin1String("FullName"), m_credential.originalName);
-    credProps.insert(QLatin1String("Issuer"), m_credential.issuer);
-    credProps.insert(QLatin1String("Username"), m_credential.account);
-    credProps.insert(QLatin1String("RequiresTouch"), m_credential.requiresTouch);
-    credProps.insert(QLatin1String("Type"), type());
-    credProps.insert(QLatin1String("Algorithm"), algorithm());
-    credProps.insert(QLatin1String("Digits"), m_credential.digits);
-    credProps.insert(QLatin1String("Period"), m_credential.period);
-    credProps.insert(QLatin1String("DeviceId"), m_deviceId);
-
-    result.insert(QLatin1String(CREDENTIAL_INTERFACE), credProps);
+    result.insert(QLatin1String(CREDENTIAL_INTERFACE), credentialProperties(m_credential, m_deviceId));
 
     return result;
 }
 
+QVariantMap OathCredentialObject::credentialProperties(const Shared::OathCredential &credential,
+                                                       const QString &deviceId)
+{
+    QVariantMap credProps;
+    credProps.insert(QLatin1String("FullName"), credential.originalName);
+    credProps.insert(QLatin1String("Issuer"), credential.issuer);
+    credProps.insert(QLatin1String("Username"), credential.account);
+    credProps.insert(QLatin1String("RequiresTouch"), credential.requiresTouch);
+    credProps.insert(QLatin1String("Type"), credential.type == OathType::TOTP
+                                            ? QString::fromLatin1("TOTP")
+                                            : QString::fromLatin1("HOTP"));
+    credProps.insert(QLatin1String("Algorithm"), algorithmToString(credential.algorithm));
+    credProps.insert(QLatin1String("Digits"), credential.digits);
+    credProps.insert(QLatin1String("Period"), credential.period);
+    credProps.insert(QLatin1String("DeviceId"), deviceId);
+    return credProps;
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
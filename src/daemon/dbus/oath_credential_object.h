@@ -12,6 +12,7 @@
 #include <functional>
 #include "types/oath_credential.h"
 #include "types/yubikey_value_types.h"
+#include "actions/action_executor.h"  // For ActionExecutor::ActionResult
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -100,6 +101,11 @@ public:
     int period() const;
     QString deviceId() const;
 
+    /**
+     * @brief Gets credential data this object was created from
+     */
+    const Shared::OathCredential &credential() const { return m_credential; }
+
 public Q_SLOTS:
     // === ASYNC API (all methods fire-and-forget with signal results) ===
 
@@ -202,6 +208,17 @@ public:
      */
     QVariantMap getManagedObjectData() const;
 
+    /**
+     * @brief Builds pl.jkolo.yubikey.oath.Credential property map
+     * @param credential Credential data
+     * @param deviceId Parent device ID
+     * @return Property name → value (same values the Q_PROPERTYs return)
+     *
+     * Shared with CredentialSubtreeObject, which serves properties without an object.
+     */
+    static QVariantMap credentialProperties(const Shared::OathCredential &credential,
+                                            const QString &deviceId);
+
 private:
     using CodeResultCallback = std::function<void(const QString &code, qint64 validUntil, const QString &error)>;
 
@@ -224,6 +241,16 @@ private:
      */
     void disconnectPending();
 
+    /**
+     * @brief Completes TypeCode once the type action has a final result
+     * @param code Generated code (for clipboard fallback)
+     * @param result Outcome of typing
+     * @param fallbackToCopy Copy to clipboard if typing failed
+     *
+     * Emits CodeTyped.
+     */
+    void finishTypeCode(const QString &code, ActionExecutor::ActionResult result, bool fallbackToCopy);
+
     Shared::OathCredential m_credential;     ///< Credential data
     QString m_deviceId;                      ///< Parent device ID
     OathService *m_service;               ///< Business logic service (not owned)
@@ -232,6 +259,7 @@ private:
     bool m_registered;                       ///< Registration state
     QMetaObject::Connection m_pendingConnection;       ///< Current one-shot signal connection
     QMetaObject::Connection m_touchSignalConnection;   ///< Connection to OathDevice::touchRequired()
+    QMetaObject::Connection m_deferredTypeConnection;  ///< Waits for a Deferred TypeCode to finish
 };
 
 } // namespace Daemon
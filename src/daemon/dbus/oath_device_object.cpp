@@ -70,6 +70,9 @@ OathDeviceObject::OathDeviceObject(QString deviceId,
         }
     }
 
+    // Cache LastSeen once - refreshed on state transitions only
+    refreshLastSeen();
+
     // Create credential object manager
     m_credentialManager = std::make_unique<CredentialObjectManager>(
         m_deviceId, m_objectPath, m_service, m_connection, this);
@@ -79,18 +82,60 @@ OathDeviceObject::OathDeviceObject(QString deviceId,
             this, [this](const QString &path) {
                 Q_EMIT CredentialAdded(QDBusObjectPath(path));
                 Q_EMIT credentialAdded();
+                Q_EMIT managedObjectDataChanged({path});
             });
     connect(m_credentialManager.get(), &CredentialObjectManager::credentialRemoved,
             this, [this](const QString &path) {
                 Q_EMIT CredentialRemoved(QDBusObjectPath(path));
                 Q_EMIT credentialRemoved();
+                Q_EMIT managedObjectDataChanged({path});
+            });
+
+    // Batches: the bulk signal carries every credential's properties, so clients that
+    // handle it need no per-credential GetAll. It goes out first; the singular signals
+    // still follow for each path so clients that only know those keep working.
+    connect(m_credentialManager.get(), &CredentialObjectManager::credentialsAdded,
+            this, [this](const QStringList &paths) {
+                if (paths.size() > 1) {
+                    Shared::CredentialPropertiesMap credentials;
+                    for (const QString &path : paths) {
+                        const QVariantMap data = m_credentialManager->getManagedObjectData(
+                            path.section(QLatin1Char('/'), -1));
+                        if (!data.isEmpty()) {
+                            credentials.insert(QDBusObjectPath(path),
+                                               data.value(QStringLiteral("pl.jkolo.yubikey.oath.Credential")).toMap());
+                        }
+                    }
+                    Q_EMIT CredentialsAdded(credentials);
+                }
+                for (const QString &path : paths) {
+                    Q_EMIT CredentialAdded(QDBusObjectPath(path));
+                }
+                Q_EMIT credentialAdded();
+                Q_EMIT managedObjectDataChanged(paths);
+            });
+    connect(m_credentialManager.get(), &CredentialObjectManager::credentialsRemoved,
+            this, [this](const QStringList &paths) {
+                if (paths.size() > 1) {
+                    QList<QDBusObjectPath> objectPaths;
+                    objectPaths.reserve(paths.size());
+                    for (const QString &path : paths) {
+                        objectPaths.append(QDBusObjectPath(path));
+                    }
+                    Q_EMIT CredentialsRemoved(objectPaths);
+                }
+                for (const QString &path : paths) {
+                    Q_EMIT CredentialRemoved(QDBusObjectPath(path));
+                }
+                Q_EMIT credentialRemoved();
+                Q_EMIT managedObjectDataChanged(paths);
             });
 
     // Connect to service signals for credential updates
     connect(m_service, &OathService::credentialsUpdated,
             this, [this](const QString &deviceId) {
                 if (deviceId == m_deviceId) {
-                    m_credentialManager->updateCredentials();
+                    syncCredentials();
                 }
             });
 
@@ -190,6 +235,11 @@ bool OathDeviceObject::hasValidPassword() const
     return m_hasValidPassword;
 }
 
+bool OathDeviceObject::credentialsStale() const
+{
+    return m_credentialsStale;
+}
+
 QString OathDeviceObject::firmwareVersionString() const
 {
     return m_firmwareVersion.toString();
@@ -237,12 +287,23 @@ quint8 OathDeviceObject::formFactor() const
 }
 
 qint64 OathDeviceObject::lastSeen() const
+{
+    return m_lastSeen;
+}
+
+void OathDeviceObject::refreshLastSeen()
 {
     const QDateTime lastSeenDateTime = m_service->getDeviceLastSeen(m_deviceId);
-    if (lastSeenDateTime.isValid()) {
-        return lastSeenDateTime.toMSecsSinceEpoch();
+    // 0 if device not in database or invalid timestamp
+    const qint64 lastSeen = lastSeenDateTime.isValid() ? lastSeenDateTime.toMSecsSinceEpoch() : 0;
+
+    if (m_lastSeen == lastSeen) {
+        return;
     }
-    return 0; // Return 0 if device not in database or invalid timestamp
+
+    m_lastSeen = lastSeen;
+    Q_EMIT lastSeenChanged(m_lastSeen);
+    emitSessionPropertyChanged(QStringLiteral("LastSeen"), m_lastSeen);
 }
 
 void OathDeviceObject::setName(const QString &name)
@@ -292,6 +353,9 @@ void OathDeviceObject::setState(quint8 state, const QString &message)
         emitSessionPropertyChanged(QStringLiteral("State"), state);
         qCDebug(OathDaemonLog) << "YubiKeyDeviceObject: State changed for device:" << m_deviceId
                                   << "to:" << static_cast<int>(state);
+
+        // Database LastSeen is updated on connect/disconnect
+        refreshLastSeen();
     }
 
     if (messageChanged) {
@@ -389,14 +453,50 @@ Shared::AddCredentialResult OathDeviceObject::AddCredential(const QString &name,
 
     // If success, result.message contains credential name - build path
     if (result.status == QLatin1String("Success")) {
-        const QString credId = CredentialIdEncoder::encode(result.message);
-        const QString path = QString::fromLatin1("%1/credentials/%2").arg(m_objectPath, credId);
-        return {QLatin1String("Success"), path};
+        return {QLatin1String("Success"), credentialPath(result.message)};
     }
 
     return result;
 }
 
+QList<Shared::AddCredentialResult> OathDeviceObject::AddCredentials(const QList<QVariantMap> &credentials)
+{
+    qCDebug(OathDaemonLog) << "YubiKeyDeviceObject: AddCredentials for device:" << m_deviceId
+                              << "count:" << credentials.size();
+
+    auto results = m_service->addCredentials(m_deviceId, credentials);
+
+    // On success, message contains the stored credential name - build path
+    for (auto &result : results) {
+        if (result.status == QLatin1String("Success")) {
+            result.message = credentialPath(result.message);
+        }
+    }
+
+    return results;
+}
+
+QList<Shared::AddCredentialResult> OathDeviceObject::DeleteCredentials(const QStringList &credentialNames)
+{
+    qCDebug(OathDaemonLog) << "YubiKeyDeviceObject: DeleteCredentials for device:" << m_deviceId
+                              << "count:" << credentialNames.size();
+
+    auto results = m_service->deleteCredentials(m_deviceId, credentialNames);
+
+    for (auto &result : results) {
+        if (result.status == QLatin1String("Success")) {
+            result.message = credentialPath(result.message);
+        }
+    }
+
+    return results;
+}
+
+QString OathDeviceObject::credentialPath(const QString &credentialName) const
+{
+    return QString::fromLatin1("%1/credentials/%2").arg(m_objectPath, CredentialIdEncoder::encode(credentialName));
+}
+
 OathCredentialObject* OathDeviceObject::addCredential(const Shared::OathCredential &credential)
 {
     return m_credentialManager->addCredential(credential);
@@ -418,8 +518,23 @@ QStringList OathDeviceObject::credentialPaths() const
 }
 
 void OathDeviceObject::updateCredentials()
+{
+    syncCredentials();
+}
+
+void OathDeviceObject::syncCredentials()
 {
     m_credentialManager->updateCredentials();
+
+    const bool stale = !m_credentialManager->credentialPaths().isEmpty()
+                       && !m_service->hasLiveCredentials(m_deviceId);
+    if (m_credentialsStale != stale) {
+        m_credentialsStale = stale;
+        qCDebug(OathDaemonLog) << "YubiKeyDeviceObject: Credentials of" << m_deviceId
+                                  << (stale ? "served from cache (stale)" : "live");
+        Q_EMIT credentialsStaleChanged(m_credentialsStale);
+        emitSessionPropertyChanged(QStringLiteral("CredentialsStale"), m_credentialsStale);
+    }
 }
 
 void OathDeviceObject::connectToDevice()
@@ -477,6 +592,7 @@ QVariantMap OathDeviceObject::getManagedObjectData() const
     sessionProps.insert(QLatin1String("StateMessage"), m_stateMessage);
     sessionProps.insert(QLatin1String("HasValidPassword"), m_hasValidPassword);
     sessionProps.insert(QLatin1String("LastSeen"), lastSeen());
+    sessionProps.insert(QLatin1String("CredentialsStale"), m_credentialsStale);
 
     result.insert(QLatin1String(DEVICE_SESSION_INTERFACE), sessionProps);
 
@@ -488,42 +604,72 @@ QVariantMap OathDeviceObject::getManagedCredentialObjects() const
     return m_credentialManager->getManagedObjects();
 }
 
+QList<Shared::PackedCredential> OathDeviceObject::getPackedCredentials() const
+{
+    return m_credentialManager->getPackedCredentials();
+}
+
 void OathDeviceObject::emitPropertyChanged(const QString &interfaceName,
                                           const QString &propertyName,
                                           const QVariant &value)
 {
+    // Every exported property flows through here - keep Manager snapshot in sync
+    Q_EMIT managedObjectDataChanged({m_objectPath});
+
     if (!m_registered) {
         return;
     }
 
-    // Create PropertiesChanged signal
-    // Signature: PropertiesChanged(interface_name, changed_properties, invalidated_properties)
-    QDBusMessage signal = QDBusMessage::createSignal(
-        m_objectPath,
-        QStringLiteral("org.freedesktop.DBus.Properties"),
-        QStringLiteral("PropertiesChanged")
-    );
+    m_pendingPropertyChanges[interfaceName].insert(propertyName, value);
+    ++m_propertyChangesQueued;
+
+    if (!m_propertyFlushScheduled) {
+        m_propertyFlushScheduled = true;
+        QMetaObject::invokeMethod(this, &OathDeviceObject::flushPropertyChanges, Qt::QueuedConnection);
+    }
+}
+
+void OathDeviceObject::flushPropertyChanges()
+{
+    m_propertyFlushScheduled = false;
 
-    // Prepare arguments
-    QVariantMap changedProperties;
-    changedProperties.insert(propertyName, value);
+    QMap<QString, QVariantMap> pending;
+    pending.swap(m_pendingPropertyChanges);
+
+    if (!m_registered) {
+        return;
+    }
 
     const QStringList invalidatedProperties; // Empty - we provide values directly
 
-    signal << interfaceName
-           << changedProperties
-           << invalidatedProperties;
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        // Signature: PropertiesChanged(interface_name, changed_properties, invalidated_properties)
+        QDBusMessage signal = QDBusMessage::createSignal(
+            m_objectPath,
+            QStringLiteral("org.freedesktop.DBus.Properties"),
+            QStringLiteral("PropertiesChanged")
+        );
+        signal << it.key()
+               << it.value()
+               << invalidatedProperties;
+
+        if (!m_connection.send(signal)) {
+            qCWarning(OathDaemonLog) << "Failed to emit PropertiesChanged for"
+                                         << it.value().keys() << "on interface" << it.key()
+                                         << "on" << m_objectPath;
+            continue;
+        }
 
-    // Send signal
-    if (!m_connection.send(signal)) {
-        qCWarning(OathDaemonLog) << "Failed to emit PropertiesChanged for"
-                                     << propertyName << "on interface" << interfaceName
-                                     << "on" << m_objectPath;
-    } else {
-        qCDebug(OathDaemonLog) << "Emitted PropertiesChanged:" << propertyName
-                                   << "=" << value << "on interface" << interfaceName
+        ++m_propertyMessagesSent;
+        qCDebug(OathDaemonLog) << "Emitted PropertiesChanged:" << it.value()
+                                   << "on interface" << it.key()
                                    << "on" << m_objectPath;
     }
+
+    qCDebug(OathDaemonLog) << "YubiKeyDeviceObject: PropertiesChanged coalescing for" << m_deviceId
+                              << "- queued:" << m_propertyChangesQueued
+                              << "sent:" << m_propertyMessagesSent
+                              << "saved:" << (m_propertyChangesQueued - m_propertyMessagesSent);
 }
 
 void OathDeviceObject::emitDevicePropertyChanged(const QString &propertyName, const QVariant &value)
@@ -10,6 +10,7 @@
 #include <QDBusObjectPath>
 #include <QDBusConnection>
 #include <QVariant>
+#include <QMap>
 #include <memory>
 #include "types/oath_credential.h"
 #include "types/yubikey_value_types.h"
@@ -38,11 +39,11 @@ class CredentialObjectManager;
  *
  * 1. **pl.jkolo.yubikey.oath.Device** (DeviceAdaptor.xml)
  *    - Hardware and OATH application properties (Name, FirmwareVersion, SerialNumber, DeviceModel, RequiresPassword)
- *    - OATH operations (ChangePassword, Forget, AddCredential)
+ *    - OATH operations (ChangePassword, Forget, AddCredential, AddCredentials, DeleteCredentials)
  *    - Properties are STABLE across device connections
  *
  * 2. **pl.jkolo.yubikey.oath.DeviceSession** (DeviceSessionAdaptor.xml)
- *    - Runtime session state (State, StateMessage, HasValidPassword, LastSeen)
+ *    - Runtime session state (State, StateMessage, HasValidPassword, LastSeen, CredentialsStale)
  *    - Session operations (SavePassword)
  *    - Properties are VOLATILE and change during device lifecycle
  *
@@ -75,6 +76,7 @@ class OathDeviceObject : public QObject
     Q_PROPERTY(QString FormFactor READ formFactorString CONSTANT)
     Q_PROPERTY(QStringList Capabilities READ capabilitiesList CONSTANT)
     Q_PROPERTY(qint64 LastSeen READ lastSeen NOTIFY lastSeenChanged)
+    Q_PROPERTY(bool CredentialsStale READ credentialsStale NOTIFY credentialsStaleChanged)
     // Note: CredentialCount and Credentials properties removed - use Manager's GetManagedObjects() instead
 
 public:
@@ -124,6 +126,7 @@ public:
     QString formFactorString() const;
     QStringList capabilitiesList() const;
     qint64 lastSeen() const;
+    bool credentialsStale() const;
 
     // Internal getters for raw values (used internally, not exposed via D-Bus)
     QString deviceId() const;
@@ -180,6 +183,24 @@ public Q_SLOTS:
                                               int counter,
                                               bool requireTouch);
 
+    /**
+     * @brief Adds several credentials in one card transaction
+     * @param credentials One map per credential (keys as AddCredential arguments)
+     * @return One (status, pathOrMessage) per input
+     *
+     * Status: "Success" (credential object path) | "Error" (message)
+     */
+    QList<Shared::AddCredentialResult> AddCredentials(const QList<QVariantMap> &credentials);
+
+    /**
+     * @brief Deletes several credentials in one card transaction
+     * @param credentialNames Full credential names as stored on the device
+     * @return One (status, pathOrMessage) per input
+     *
+     * Status: "Success" (removed object path) | "Error" (message)
+     */
+    QList<Shared::AddCredentialResult> DeleteCredentials(const QStringList &credentialNames);
+
 Q_SIGNALS:
     // Property change signals
     void nameChanged(const QString &name);
@@ -188,15 +209,30 @@ Q_SIGNALS:
     void requiresPasswordChanged(bool required);
     void hasValidPasswordChanged(bool hasValid);
     void lastSeenChanged(qint64 timestamp);
+    void credentialsStaleChanged(bool stale);
 
     // Device-specific signals
     void CredentialAdded(const QDBusObjectPath &credentialPath);
     void CredentialRemoved(const QDBusObjectPath &credentialPath);
+    void CredentialsAdded(const YubiKeyOath::Shared::CredentialPropertiesMap &credentials);
+    void CredentialsRemoved(const QList<QDBusObjectPath> &credentialPaths);
 
     // Internal signals for Manager
     void credentialAdded();
     void credentialRemoved();
 
+    /**
+     * @brief Emitted when any data returned by getManagedObjectData() or
+     *        getManagedCredentialObjects() changes
+     *
+     * @param objectPaths Device and/or credential paths whose data was added,
+     *                    modified or removed
+     *
+     * Lets the Manager invalidate its cached GetManagedObjects() snapshot and
+     * record the paths in its change journal.
+     */
+    void managedObjectDataChanged(const QStringList &objectPaths);
+
 public:
     /**
      * @brief Creates and registers a Credential object
@@ -257,12 +293,41 @@ public:
      */
     QVariantMap getManagedCredentialObjects() const;
 
+    /**
+     * @brief Gets all credentials in packed form
+     *
+     * Used by Manager's GetManagedObjectsPacked()
+     */
+    QList<Shared::PackedCredential> getPackedCredentials() const;
+
 private:
     /**
-     * @brief Emits D-Bus PropertiesChanged signal
+     * @brief Builds the object path of a credential on this device
+     * @param credentialName Credential name as stored on the device
+     */
+    QString credentialPath(const QString &credentialName) const;
+
+    /**
+     * @brief Synchronizes credential objects and the CredentialsStale property
+     *
+     * Credentials served from the database cache (daemon start, card not yet
+     * read, device offline) are published at once with CredentialsStale=true.
+     * When the live list arrives, the diff in CredentialObjectManager keeps
+     * unchanged objects in place and only CredentialsStale flips to false.
+     */
+    void syncCredentials();
+
+    /**
+     * @brief Queues a D-Bus PropertiesChanged entry
      * @param interfaceName D-Bus interface name (e.g., "pl.jkolo.yubikey.oath.Device")
      * @param propertyName Name of changed property
      * @param value New value
+     *
+     * Changes are coalesced per interface and sent by flushPropertyChanges()
+     * on the next event loop iteration, so a burst such as State +
+     * StateMessage + HasValidPassword during initialization crosses the bus
+     * as one message per interface. Repeated changes of one property within
+     * the same tick only send the latest value.
      */
     void emitPropertyChanged(const QString &interfaceName,
                             const QString &propertyName,
@@ -282,6 +347,19 @@ private:
      */
     void emitSessionPropertyChanged(const QString &propertyName, const QVariant &value);
 
+    /**
+     * @brief Sends one PropertiesChanged signal per interface with queued changes
+     */
+    void flushPropertyChanges();
+
+    /**
+     * @brief Re-reads LastSeen from the database and emits change if different
+     *
+     * Called on state transitions (the database timestamp only moves on
+     * connect/disconnect), so property reads never hit SQLite.
+     */
+    void refreshLastSeen();
+
     QString m_deviceId;                                 ///< Device ID
     OathService *m_service;                          ///< Business logic service (not owned)
     QDBusConnection m_connection;                       ///< D-Bus connection
@@ -291,12 +369,20 @@ private:
 
     std::unique_ptr<CredentialObjectManager> m_credentialManager;  ///< Manages credential D-Bus objects
 
+    // PropertiesChanged coalescing
+    QMap<QString, QVariantMap> m_pendingPropertyChanges;  ///< Interface → changed properties
+    bool m_propertyFlushScheduled{false};
+    quint64 m_propertyChangesQueued{0};                   ///< Property changes requested
+    quint64 m_propertyMessagesSent{0};                    ///< PropertiesChanged messages sent
+
     // Cached properties
     QString m_name;
     quint8 m_state{0x00};  // DeviceState::Disconnected
     QString m_stateMessage;
     bool m_requiresPassword;
     bool m_hasValidPassword;
+    qint64 m_lastSeen{0};          ///< Cached LastSeen (ms since epoch, 0 if unknown)
+    bool m_credentialsStale{false}; ///< Published credentials come from database cache
     Shared::Version m_firmwareVersion;
     quint32 m_serialNumber{0};
     QString m_deviceModel;        ///< Human-readable model string
@@ -13,6 +13,7 @@
 #include <QDBusConnection>
 #include <QDBusMessage>
 #include <QDBusMetaType>
+#include <QSet>
 #include <utility>
 
 namespace YubiKeyOath {
@@ -103,9 +104,33 @@ namespace Daemon {
             return QString::fromLatin1(DAEMON_VERSION);
         }
 
+        void OathManagerObject::setFirstRequestObserver(std::function<void()> observer)
+        {
+            m_firstRequestObserver = std::move(observer);
+        }
+
+        void OathManagerObject::noteRequest()
+        {
+            if (m_firstRequestObserver)
+            {
+                const auto observer = std::exchange(m_firstRequestObserver, nullptr);
+                observer();
+            }
+        }
+
         ManagedObjectMap OathManagerObject::GetManagedObjects()
         {
-            qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetManagedObjects() called";
+            noteRequest();
+
+            if (m_snapshotValid)
+            {
+                ++m_snapshotHits;
+                qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetManagedObjects() served from snapshot"
+                                  << "generation:" << m_generation
+                                  << "objects:" << m_snapshot.size()
+                                  << "hits/rebuilds:" << m_snapshotHits << "/" << m_snapshotRebuilds;
+                return m_snapshot; // Implicitly shared - no deep copy
+            }
 
             ManagedObjectMap result;
 
@@ -114,55 +139,156 @@ namespace Daemon {
             {
                 const OathDeviceObject* const deviceObj = deviceIt.value();
 
-                // Get device object path and properties
-                const QString devicePath = deviceObj->objectPath();
-                const QVariantMap deviceInterfacesVariant = deviceObj->getManagedObjectData();
-
-                // Convert QVariantMap to InterfacePropertiesMap (QMap<QString, QVariantMap>)
-                InterfacePropertiesMap deviceInterfaces;
-                for (auto devIfaceIt = deviceInterfacesVariant.constBegin(); devIfaceIt != deviceInterfacesVariant.constEnd(); ++devIfaceIt)
-                {
-                    deviceInterfaces.insert(devIfaceIt.key(), devIfaceIt.value().toMap());
-                }
-
-                qCDebug(OathDaemonLog) << "YubiKeyManagerObject: Adding device path:" << devicePath
-                                  << "interfaces:" << deviceInterfaces.keys();
-
                 // Add device to result - convert QString to QDBusObjectPath
-                result.insert(QDBusObjectPath(devicePath), deviceInterfaces);
+                result.insert(QDBusObjectPath(deviceObj->objectPath()),
+                              toInterfacePropertiesMap(deviceObj->getManagedObjectData()));
 
                 // Get all credential objects for this device
                 const QVariantMap credentialObjects = deviceObj->getManagedCredentialObjects();
-                qCDebug(OathDaemonLog) << "YubiKeyManagerObject: Device has" << credentialObjects.size() << "credentials";
-
                 for (auto credIt = credentialObjects.constBegin();
                      credIt != credentialObjects.constEnd(); ++credIt)
                 {
-                    const QVariantMap credInterfacesVariant = credIt.value().toMap();
+                    result.insert(QDBusObjectPath(credIt.key()),
+                                  toInterfacePropertiesMap(credIt.value().toMap()));
+                }
+            }
 
-                    // Convert QVariantMap to InterfacePropertiesMap
-                    InterfacePropertiesMap credInterfaces;
-                    for (auto credIfaceIt = credInterfacesVariant.constBegin(); credIfaceIt != credInterfacesVariant.constEnd(); ++credIfaceIt)
-                    {
-                        credInterfaces.insert(credIfaceIt.key(), credIfaceIt.value().toMap());
-                    }
+            m_snapshot = result;
+            m_snapshotValid = true;
+            ++m_snapshotRebuilds;
+
+            qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetManagedObjects() rebuilt snapshot"
+                              << "generation:" << m_generation
+                              << "objects:" << result.size()
+                              << "hits/rebuilds:" << m_snapshotHits << "/" << m_snapshotRebuilds;
+
+            return result;
+        }
+
+        Shared::PackedManagedObjects OathManagerObject::GetManagedObjectsPacked()
+        {
+            noteRequest();
+
+            if (m_packedSnapshotValid)
+            {
+                return m_packedSnapshot; // Implicitly shared containers - no deep copy
+            }
+
+            Shared::PackedManagedObjects result;
+            result.generation = m_generation;
+
+            for (auto deviceIt = m_devices.constBegin(); deviceIt != m_devices.constEnd(); ++deviceIt)
+            {
+                const OathDeviceObject* const deviceObj = deviceIt.value();
+                result.devices.insert(QDBusObjectPath(deviceObj->objectPath()),
+                                      toInterfacePropertiesMap(deviceObj->getManagedObjectData()));
+                result.credentials.append(deviceObj->getPackedCredentials());
+            }
+
+            m_packedSnapshot = result;
+            m_packedSnapshotValid = true;
+
+            qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetManagedObjectsPacked() rebuilt snapshot"
+                              << "generation:" << m_generation
+                              << "devices:" << result.devices.size()
+                              << "credentials:" << result.credentials.size();
+
+            return result;
+        }
 
-                    qCDebug(OathDaemonLog) << "YubiKeyManagerObject: Adding credential path:" << credIt.key()
-                                      << "interfaces:" << credInterfaces.keys();
-                    // Convert QString to QDBusObjectPath
-                    result.insert(QDBusObjectPath(credIt.key()), credInterfaces);
+        Shared::ManagedObjectChanges OathManagerObject::GetChangesSince(qulonglong generation)
+        {
+            noteRequest();
+
+            Shared::ManagedObjectChanges result;
+            result.generation = m_generation;
+
+            // Trimmed from journal, or counter from a previous daemon run
+            if (generation < m_journalFloor || generation > m_generation)
+            {
+                result.fullResyncRequired = true;
+                ++m_resyncReplies;
+                qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetChangesSince(" << generation
+                                  << ") requires full resync, journal covers" << m_journalFloor
+                                  << "-" << m_generation
+                                  << "deltas/resyncs:" << m_deltaReplies << "/" << m_resyncReplies;
+                return result;
+            }
+
+            // Newest entries are at the back - stop at the first one the client has seen
+            QSet<QString> paths;
+            for (auto it = m_journal.crbegin(); it != m_journal.crend() && it->generation > generation; ++it)
+            {
+                paths.insert(it->path);
+            }
+
+            // Current state decides whether a journaled path was changed or removed
+            const ManagedObjectMap current = GetManagedObjects();
+            for (const QString& path : std::as_const(paths))
+            {
+                const QDBusObjectPath objectPath(path);
+                const auto objectIt = current.constFind(objectPath);
+                if (objectIt != current.constEnd())
+                {
+                    result.changed.insert(objectPath, objectIt.value());
+                }
+                else
+                {
+                    result.removed.append(objectPath);
                 }
             }
 
-            qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetManagedObjects() returning"
-                              << result.size() << "objects";
+            ++m_deltaReplies;
+            qCDebug(OathDaemonLog) << "YubiKeyManagerObject: GetChangesSince(" << generation << ")"
+                              << "generation:" << m_generation
+                              << "changed:" << result.changed.size()
+                              << "removed:" << result.removed.size()
+                              << "deltas/resyncs:" << m_deltaReplies << "/" << m_resyncReplies;
+
+            return result;
+        }
 
-            // Debug: print all object paths
-            for (auto it = result.constBegin(); it != result.constEnd(); ++it)
+        void OathManagerObject::invalidateSnapshot(const QStringList& objectPaths)
+        {
+            if (m_snapshotValid)
+            {
+                m_snapshot.clear();
+                m_snapshotValid = false;
+            }
+            if (m_packedSnapshotValid)
             {
-                qCDebug(OathDaemonLog) << "  Object:" << it.key().path();
+                m_packedSnapshot = {};
+                m_packedSnapshotValid = false;
             }
+            ++m_generation;
 
+            for (const QString& path : objectPaths)
+            {
+                m_journal.append({m_generation, path});
+            }
+            if (m_journal.size() > MAX_JOURNAL_ENTRIES)
+            {
+                // Clients older than the last dropped entry can no longer get a delta
+                const qsizetype excess = m_journal.size() - MAX_JOURNAL_ENTRIES;
+                m_journalFloor = m_journal.at(excess - 1).generation;
+                m_journal.remove(0, excess);
+            }
+        }
+
+        void OathManagerObject::trackDevice(OathDeviceObject* deviceObj)
+        {
+            connect(deviceObj, &OathDeviceObject::managedObjectDataChanged,
+                    this, &OathManagerObject::invalidateSnapshot);
+        }
+
+        InterfacePropertiesMap OathManagerObject::toInterfacePropertiesMap(const QVariantMap& interfaces)
+        {
+            // Convert QVariantMap to InterfacePropertiesMap (QMap<QString, QVariantMap>)
+            InterfacePropertiesMap result;
+            for (auto it = interfaces.constBegin(); it != interfaces.constEnd(); ++it)
+            {
+                result.insert(it.key(), it.value().toMap());
+            }
             return result;
         }
 
@@ -198,33 +324,16 @@ namespace Daemon {
                     {
                         qCDebug(OathDaemonLog) << "YubiKeyManagerObject: Device reconnected, emitting InterfacesAdded:" << deviceId;
 
-                        const QString path = deviceObj->objectPath();
-                        const QDBusObjectPath dbusPath(path);
-                        const QVariantMap interfacesData = deviceObj->getManagedObjectData();
-
-                        // Convert QVariantMap to InterfacePropertiesMap for D-Bus signal
-                        InterfacePropertiesMap interfacesAndProperties;
-                        for (auto it = interfacesData.constBegin(); it != interfacesData.constEnd(); ++it)
-                        {
-                            interfacesAndProperties.insert(it.key(), it.value().toMap());
-                        }
-                        Q_EMIT InterfacesAdded(dbusPath, interfacesAndProperties);
+                        Q_EMIT InterfacesAdded(QDBusObjectPath(deviceObj->objectPath()),
+                                               toInterfacePropertiesMap(deviceObj->getManagedObjectData()));
 
                         // Also emit InterfacesAdded for all credential objects
                         const QVariantMap credentialObjects = deviceObj->getManagedCredentialObjects();
                         for (auto credIt = credentialObjects.constBegin();
                              credIt != credentialObjects.constEnd(); ++credIt)
                         {
-                            const QDBusObjectPath credDbusPath(credIt.key());
-                            const QVariantMap credData = credIt.value().toMap();
-
-                            // Convert QVariantMap to InterfacePropertiesMap for D-Bus signal
-                            InterfacePropertiesMap credInterfacesAndProperties;
-                            for (auto it = credData.constBegin(); it != credData.constEnd(); ++it)
-                            {
-                                credInterfacesAndProperties.insert(it.key(), it.value().toMap());
-                            }
-                            Q_EMIT InterfacesAdded(credDbusPath, credInterfacesAndProperties);
+                            Q_EMIT InterfacesAdded(QDBusObjectPath(credIt.key()),
+                                                   toInterfacePropertiesMap(credIt.value().toMap()));
                         }
 
                         qCDebug(OathDaemonLog) << "YubiKeyManagerObject: Emitted InterfacesAdded for device and"
@@ -260,6 +369,8 @@ namespace Daemon {
             }
 
             m_devices.insert(deviceId, deviceObj);
+            trackDevice(deviceObj);
+            invalidateSnapshot(QStringList{path} + deviceObj->credentialPaths());
 
             // If device is connected, connect to it and update state
             if (isConnected)
@@ -268,32 +379,16 @@ namespace Daemon {
             }
 
             // Emit ObjectManager signal: InterfacesAdded
-            const QDBusObjectPath dbusPath(path);
-            const QVariantMap interfacesData = deviceObj->getManagedObjectData();
-
-            // Convert QVariantMap to InterfacePropertiesMap for D-Bus signal
-            InterfacePropertiesMap interfacesAndProperties;
-            for (auto it = interfacesData.constBegin(); it != interfacesData.constEnd(); ++it)
-            {
-                interfacesAndProperties.insert(it.key(), it.value().toMap());
-            }
-            Q_EMIT InterfacesAdded(dbusPath, interfacesAndProperties);
+            Q_EMIT InterfacesAdded(QDBusObjectPath(path),
+                                   toInterfacePropertiesMap(deviceObj->getManagedObjectData()));
 
             // Also emit InterfacesAdded for all credential objects
             const QVariantMap credentialObjects = deviceObj->getManagedCredentialObjects();
             for (auto credIt = credentialObjects.constBegin();
                  credIt != credentialObjects.constEnd(); ++credIt)
             {
-                const QDBusObjectPath credDbusPath(credIt.key());
-                const QVariantMap credData = credIt.value().toMap();
-
-                // Convert QVariantMap to InterfacePropertiesMap for D-Bus signal
-                InterfacePropertiesMap credInterfacesAndProperties;
-                for (auto it = credData.constBegin(); it != credData.constEnd(); ++it)
-                {
-                    credInterfacesAndProperties.insert(it.key(), it.value().toMap());
-                }
-                Q_EMIT InterfacesAdded(credDbusPath, credInterfacesAndProperties);
+                Q_EMIT InterfacesAdded(QDBusObjectPath(credIt.key()),
+                                       toInterfacePropertiesMap(credIt.value().toMap()));
             }
 
             qCInfo(OathDaemonLog) << "YubiKeyManagerObject: Device added successfully:" << deviceId
@@ -358,10 +453,12 @@ namespace Daemon {
             }
 
             // Unregister and delete device object (also unregisters all credentials)
+            disconnect(deviceObj, nullptr, this, nullptr);
             deviceObj->unregisterObject();
             delete deviceObj;
 
             m_devices.remove(deviceId);
+            invalidateSnapshot(QStringList{path} + credentialPaths);
 
             // Emit ObjectManager signal: InterfacesRemoved for device
             const QDBusObjectPath dbusPath(path);
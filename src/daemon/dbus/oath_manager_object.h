@@ -10,9 +10,13 @@
 #include <QString>
 #include <QDBusObjectPath>
 #include <QDBusConnection>
+#include <QList>
 #include <QMap>
+#include <QStringList>
 #include <QVariant>
+#include <functional>
 #include <memory>
+#include "types/yubikey_value_types.h"
 
 // Type for GetManagedObjects (must be outside namespace for Q_DECLARE_METATYPE)
 // Signature: a{oa{sa{sv}}} = QMap<ObjectPath, QMap<InterfaceName, Properties>>
@@ -101,6 +105,9 @@ public Q_SLOTS:
      *
      * D-Bus signature: a{oa{sa{sv}}}
      * Returns the entire object hierarchy: devices + credentials
+     *
+     * Served from a cached snapshot (implicitly shared, no per-call tree walk).
+     * The snapshot is rebuilt lazily after the generation changed.
      */
     ManagedObjectMap GetManagedObjects();
 
@@ -161,7 +168,76 @@ public:
      */
     OathDeviceObject* getDevice(const QString &deviceId) const;
 
+    /**
+     * @brief Gets object tree generation
+     * @return Counter incremented on every structural or property change
+     *
+     * Two GetManagedObjects() replies with the same generation are identical.
+     */
+    quint64 generation() const { return m_generation; }
+
+    /**
+     * @brief Manager: Get all managed objects in compact form
+     * @return Device objects plus packed credential array and generation
+     *
+     * D-Bus signature: (uta{oa{sa{sv}}}a(ossssbyyyq))
+     * Same content as GetManagedObjects(), but credentials are fixed-order structs
+     * instead of string-keyed variant maps - far less to marshal for large sets.
+     * Cached like GetManagedObjects() and invalidated together with it.
+     *
+     * Q_INVOKABLE (not a slot) so it is exported only on the Manager interface via
+     * ManagerAdaptor, not on ObjectManager by ExportAllSlots.
+     */
+    Q_INVOKABLE Shared::PackedManagedObjects GetManagedObjectsPacked();
+
+    /**
+     * @brief Manager: Get objects changed after a known generation
+     * @param generation Generation from a previous GetManagedObjectsPacked() or
+     *                   GetChangesSince() reply (0 = none)
+     * @return Current generation plus changed and removed objects
+     *
+     * D-Bus signature: t → (tba{oa{sa{sv}}}ao)
+     * Answered from a bounded journal of changed object paths; changed objects
+     * carry their current data from the GetManagedObjects() snapshot. If the
+     * generation is older than the journal (or from another daemon instance),
+     * fullResyncRequired is set and the client must fetch everything again.
+     *
+     * Q_INVOKABLE for the same reason as GetManagedObjectsPacked().
+     */
+    Q_INVOKABLE Shared::ManagedObjectChanges GetChangesSince(qulonglong generation);
+
+    /**
+     * @brief Sets callback invoked once, when the first client request arrives
+     *
+     * Covers GetManagedObjects(), GetManagedObjectsPacked() and GetChangesSince() -
+     * every client starts with one of them. Runs before the reply is sent.
+     * A callback instead of a signal: ExportAllSignals would put a signal on D-Bus.
+     */
+    void setFirstRequestObserver(std::function<void()> observer);
+
 private:
+    /**
+     * @brief Invokes and clears the first-request observer, if any
+     */
+    void noteRequest();
+
+    /**
+     * @brief Marks the GetManagedObjects() snapshot stale, bumps generation and
+     *        records the affected paths in the change journal
+     * @param objectPaths Paths added, modified or removed by this change
+     */
+    void invalidateSnapshot(const QStringList &objectPaths);
+
+    /**
+     * @brief Connects device object change signals to invalidateSnapshot()
+     */
+    void trackDevice(OathDeviceObject *deviceObj);
+
+    /**
+     * @brief Converts getManagedObjectData() result to D-Bus marshallable map
+     */
+    static InterfacePropertiesMap toInterfacePropertiesMap(const QVariantMap &interfaces);
+
     /**
      * @brief Builds D-Bus object path for device
      * @param deviceId Device ID (used as fallback if serialNumber == 0)
@@ -177,6 +253,29 @@ private:
     bool m_registered{false};                           ///< Registration state
 
     QMap<QString, OathDeviceObject*> m_devices;     ///< Device ID → DeviceObject (owned)
+    std::function<void()> m_firstRequestObserver;       ///< Cleared after first call
+
+    // GetManagedObjects() snapshot
+    ManagedObjectMap m_snapshot;                        ///< Cached reply (valid if m_snapshotValid)
+    bool m_snapshotValid{false};                        ///< False after any change
+    quint64 m_generation{1};                            ///< Bumped on every invalidation
+    quint64 m_snapshotHits{0};                          ///< Calls served without rebuild
+    quint64 m_snapshotRebuilds{0};                      ///< Calls that rebuilt the snapshot
+
+    // GetManagedObjectsPacked() snapshot
+    Shared::PackedManagedObjects m_packedSnapshot;      ///< Cached reply (valid if m_packedSnapshotValid)
+    bool m_packedSnapshotValid{false};                  ///< False after any change
+
+    // GetChangesSince() journal
+    struct JournalEntry {
+        quint64 generation;                             ///< Generation the change produced
+        QString path;                                   ///< Affected object path
+    };
+    static constexpr int MAX_JOURNAL_ENTRIES = 1024;    ///< Oldest entries dropped beyond this
+    QList<JournalEntry> m_journal;                      ///< Ascending by generation
+    quint64 m_journalFloor{1};                          ///< Oldest generation deltas can start from
+    quint64 m_deltaReplies{0};                          ///< GetChangesSince() answered with a delta
+    quint64 m_resyncReplies{0};                         ///< GetChangesSince() answered with full resync
 };
 
 } // namespace Daemon
@@ -88,7 +88,7 @@ void DeviceReconnectCoordinator::onTimeout()
         return;
     }
 
-    // Try to reconnect (device has exponential backoff built-in)
+    // Try to reconnect (device waits for reader state changes itself)
     qCDebug(OathDeviceManagerLog) << "Calling reconnect function for device" << m_deviceId;
     const auto result = m_reconnectFunc(m_readerName);
 
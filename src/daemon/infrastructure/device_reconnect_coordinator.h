@@ -17,14 +17,14 @@ namespace Daemon {
 using namespace YubiKeyOath::Shared;  // For Result<T>
 
 /**
- * @brief Coordinates device reconnection with exponential backoff
+ * @brief Coordinates background device reconnection
  *
  * Extracted from OathDeviceManager to handle the complexity of device
  * reconnection after card reset (SCARD_W_RESET_CARD).
  *
  * Reconnection strategy:
  * - Initial delay: 10ms (let external app release card)
- * - Calls reconnect function once (device has built-in exponential backoff)
+ * - Calls reconnect function once (device waits for the card via reader events)
  * - Emits success/failure signals
  *
  * Usage:
@@ -0,0 +1,363 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "keymap_table.h"
+#include "../logging_categories.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <KConfigGroup>
+#include <KSharedConfig>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include <linux/input-event-codes.h>
+#include <xkbcommon/xkbcommon.h>
+
+// X11 headers last - they define macros (None, Bool, Status) that clash with Qt
+#include <X11/Xatom.h>
+#include <X11/XKBlib.h>
+#include <X11/Xlib.h>
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+namespace {
+
+constexpr int DBUS_TIMEOUT_MS = 200;
+
+const QString KEYBOARD_SERVICE = QStringLiteral("org.kde.keyboard");
+const QString KEYBOARD_PATH = QStringLiteral("/Layouts");
+const QString KEYBOARD_INTERFACE = QStringLiteral("org.kde.KeyboardLayouts");
+
+/**
+ * @brief Preference rank of a key stroke (lower is better)
+ *
+ * Main-block keys come first, then the ISO key next to left Shift, then the
+ * keypad and multimedia keys (e.g. KEY_KPASTERISK, KEY_DOLLAR) that many
+ * applications do not treat as text. Within a tier, fewer modifiers win.
+ */
+int strokeRank(const KeyStroke &stroke)
+{
+    int tier = 2;
+    if (stroke.keycode <= KEY_RIGHTSHIFT || stroke.keycode == KEY_SPACE) {
+        tier = 0;
+    } else if (stroke.keycode == KEY_102ND) {
+        tier = 1;
+    }
+    return tier * 4 + (stroke.shift ? 1 : 0) + (stroke.altGr ? 1 : 0);
+}
+
+xkb_mod_mask_t modMask(xkb_keymap *keymap, const char *name)
+{
+    const xkb_mod_index_t index = xkb_keymap_mod_get_index(keymap, name);
+    return index == XKB_MOD_INVALID ? 0 : (xkb_mod_mask_t{1} << index);
+}
+
+/**
+ * @brief Reads rule names and active group from the X server
+ * @return true if _XKB_RULES_NAMES was available
+ */
+bool readX11Names(KeymapNames &names)
+{
+    Display *display = XOpenDisplay(nullptr);  // NOLINT(misc-const-correctness) - needs XCloseDisplay()
+    if (!display) {
+        return false;
+    }
+
+    bool found = false;
+    const Atom atom = XInternAtom(display, "_XKB_RULES_NAMES", True);
+    if (atom != None) {
+        Atom actualType = None;
+        int actualFormat = 0;
+        unsigned long itemCount = 0;
+        unsigned long bytesAfter = 0;
+        unsigned char *data = nullptr;
+
+        if (XGetWindowProperty(display, DefaultRootWindow(display), atom, 0, 1024, False, XA_STRING,
+                               &actualType, &actualFormat, &itemCount, &bytesAfter, &data) == Success
+            && data && actualFormat == 8) {
+            // rules\0model\0layout\0variant\0options\0
+            const QList<QByteArray> fields = QByteArray(reinterpret_cast<const char *>(data),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast) - X11 API
+                                                        static_cast<qsizetype>(itemCount)).split('\0');
+            const auto field = [&fields](qsizetype i) {
+                return i < fields.size() ? QString::fromLatin1(fields.at(i)) : QString();
+            };
+            names.rules = field(0);
+            names.model = field(1);
+            names.layout = field(2);
+            names.variant = field(3);
+            names.options = field(4);
+            found = true;
+        }
+        if (data) {
+            XFree(data);
+        }
+    }
+
+    XkbStateRec state{};
+    if (XkbGetState(display, XkbUseCoreKbd, &state) == Success) {
+        names.activeGroup = state.group;
+    }
+
+    XCloseDisplay(display);
+    return found;
+}
+
+/**
+ * @brief Gets the index of the active layout from Plasma's keyboard daemon
+ */
+uint activePlasmaLayout()
+{
+    const QDBusMessage call = QDBusMessage::createMethodCall(
+        KEYBOARD_SERVICE, KEYBOARD_PATH, KEYBOARD_INTERFACE, QStringLiteral("getLayout"));
+    const QDBusMessage reply = QDBusConnection::sessionBus().call(call, QDBus::Block, DBUS_TIMEOUT_MS);
+
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        return 0;
+    }
+    return reply.arguments().constFirst().toUInt();
+}
+
+} // namespace
+
+KeymapTable &KeymapTable::instance()
+{
+    static KeymapTable instance;
+    return instance;
+}
+
+KeymapTable::KeymapTable(QObject *parent)
+    : QObject(parent)
+{
+    // Plasma announces layout switches and layout list edits on D-Bus
+    QDBusConnection::sessionBus().connect(KEYBOARD_SERVICE, KEYBOARD_PATH, KEYBOARD_INTERFACE,
+                                          QStringLiteral("layoutChanged"),
+                                          this, SLOT(onLayoutChanged()));
+    QDBusConnection::sessionBus().connect(KEYBOARD_SERVICE, KEYBOARD_PATH, KEYBOARD_INTERFACE,
+                                          QStringLiteral("layoutListChanged"),
+                                          this, SLOT(onLayoutChanged()));
+}
+
+void KeymapTable::prepare()
+{
+    // X11 has no change notification here - compare names (one round trip)
+    if (m_valid && QGuiApplication::platformName() == QStringLiteral("xcb")) {
+        KeymapNames current;
+        if (readX11Names(current) && !(current == m_names)) {
+            qCDebug(TextInputLog) << "KeymapTable: X11 layout changed";
+            m_valid = false;
+        }
+    }
+
+    if (m_valid) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_names = detectNames();
+    m_table = build(m_names);
+    if (m_table.isEmpty()) {
+        qCWarning(TextInputLog) << "KeymapTable: Could not compile keymap for layout" << m_names.layout
+                                 << "- falling back to US layout";
+        m_table = usFallback();
+    }
+    m_valid = true;
+
+    qCDebug(TextInputLog) << "KeymapTable: [TIMING] Built" << m_table.size() << "entries for layout"
+                           << m_names.layout << "variant" << m_names.variant << "group" << m_names.activeGroup
+                           << "in" << timer.elapsed() << "ms";
+}
+
+std::optional<KeyStroke> KeymapTable::lookup(QChar ch)
+{
+    if (!m_valid) {
+        prepare();
+    }
+
+    const auto it = m_table.constFind(ch.unicode());
+    if (it == m_table.constEnd()) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+void KeymapTable::invalidate()
+{
+    m_valid = false;
+    m_table.clear();
+}
+
+void KeymapTable::onLayoutChanged()
+{
+    qCDebug(TextInputLog) << "KeymapTable: Keyboard layout changed, invalidating table";
+    invalidate();
+}
+
+KeymapNames KeymapTable::detectNames()
+{
+    KeymapNames names;
+
+    if (QGuiApplication::platformName() == QStringLiteral("xcb") && readX11Names(names)) {
+        return names;
+    }
+
+    // Plasma keeps the configured layouts in kxkbrc (KWin compiles its keymap from it)
+    const KSharedConfig::Ptr config = KSharedConfig::openConfig(QStringLiteral("kxkbrc"), KConfig::NoGlobals);
+    config->reparseConfiguration();
+    const KConfigGroup layoutGroup = config->group(QStringLiteral("Layout"));
+    if (layoutGroup.readEntry("Use", false)) {
+        names.model = layoutGroup.readEntry("Model", QString());
+        names.layout = layoutGroup.readEntry("LayoutList", QString());
+        names.variant = layoutGroup.readEntry("VariantList", QString());
+        names.options = layoutGroup.readEntry("Options", QString());
+        names.activeGroup = activePlasmaLayout();
+    }
+
+    // Anything left empty resolves to libxkbcommon defaults (XKB_DEFAULT_* or "us")
+    return names;
+}
+
+QHash<char16_t, KeyStroke> KeymapTable::build(const KeymapNames &names)
+{
+    QHash<char16_t, KeyStroke> table;
+
+    xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);  // NOLINT(misc-const-correctness) - needs unref
+    if (!context) {
+        qCWarning(TextInputLog) << "KeymapTable: Failed to create xkb context";
+        return table;
+    }
+
+    const QByteArray rules = names.rules.toUtf8();
+    const QByteArray model = names.model.toUtf8();
+    const QByteArray layout = names.layout.toUtf8();
+    const QByteArray variant = names.variant.toUtf8();
+    const QByteArray options = names.options.toUtf8();
+    const auto orNull = [](const QByteArray &value) { return value.isEmpty() ? nullptr : value.constData(); };
+
+    const xkb_rule_names ruleNames{orNull(rules), orNull(model), orNull(layout), orNull(variant), orNull(options)};
+    xkb_keymap *keymap = xkb_keymap_new_from_names(context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);  // NOLINT(misc-const-correctness) - needs unref
+    if (!keymap) {
+        qCWarning(TextInputLog) << "KeymapTable: Failed to compile keymap for" << names.layout;
+        xkb_context_unref(context);
+        return table;
+    }
+
+    // Only modifiers we can press ourselves; LevelThree is bound to Mod5 by xkeyboard-config
+    const xkb_mod_mask_t shiftMask = modMask(keymap, XKB_MOD_NAME_SHIFT);
+    const xkb_mod_mask_t altGrMask = modMask(keymap, "Mod5");
+    const xkb_mod_mask_t usableMask = shiftMask | altGrMask;
+
+    const xkb_keycode_t minKey = xkb_keymap_min_keycode(keymap);
+    const xkb_keycode_t maxKey = xkb_keymap_max_keycode(keymap);
+
+    for (xkb_keycode_t key = std::max<xkb_keycode_t>(minKey, XKB_KEYCODE_OFFSET); key <= maxKey; ++key) {
+        const xkb_layout_index_t layoutCount = xkb_keymap_num_layouts_for_key(keymap, key);
+        if (layoutCount == 0) {
+            continue;
+        }
+        // Groups wrap around for keys with fewer layouts (XKB default)
+        const xkb_layout_index_t group = names.activeGroup % layoutCount;
+
+        const xkb_level_index_t levelCount = xkb_keymap_num_levels_for_key(keymap, key, group);
+        for (xkb_level_index_t level = 0; level < levelCount; ++level) {
+            const xkb_keysym_t *syms = nullptr;
+            if (xkb_keymap_key_get_syms_by_level(keymap, key, group, level, &syms) != 1) {
+                continue;
+            }
+
+            const uint32_t codepoint = xkb_keysym_to_utf32(syms[0]);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic) - C API
+            if (codepoint == 0 || codepoint > 0xFFFF) {
+                continue;  // Dead keys, function keys, characters outside the BMP
+            }
+
+            std::array<xkb_mod_mask_t, 8> masks{};
+            const size_t maskCount = xkb_keymap_key_get_mods_for_level(keymap, key, group, level,
+                                                                       masks.data(), masks.size());
+            std::optional<xkb_mod_mask_t> mask;
+            for (size_t i = 0; i < maskCount; ++i) {
+                const xkb_mod_mask_t candidate = masks.at(i);
+                if ((candidate & ~usableMask) == 0
+                    && (!mask || std::popcount(candidate) < std::popcount(*mask))) {
+                    mask = candidate;
+                }
+            }
+            if (!mask) {
+                continue;  // Needs Caps Lock, NumLock, Ctrl, ...
+            }
+
+            const KeyStroke stroke{key - XKB_KEYCODE_OFFSET, (*mask & shiftMask) != 0, (*mask & altGrMask) != 0};
+            // Return produces '\r'; callers type '\n'
+            const char16_t ch = codepoint == u'\r' ? u'\n' : static_cast<char16_t>(codepoint);
+
+            const auto existing = table.constFind(ch);
+            if (existing == table.constEnd() || strokeRank(stroke) < strokeRank(*existing)) {
+                table.insert(ch, stroke);
+            }
+        }
+    }
+
+    xkb_keymap_unref(keymap);
+    xkb_context_unref(context);
+    return table;
+}
+
+QHash<char16_t, KeyStroke> KeymapTable::usFallback()
+{
+    QHash<char16_t, KeyStroke> table;
+
+    // Letter keycodes follow the QWERTY rows, not the alphabet
+    static constexpr std::array<uint32_t, 26> LETTER_KEYS = {
+        KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I, KEY_J, KEY_K, KEY_L, KEY_M,
+        KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R, KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z,
+    };
+    for (size_t i = 0; i < LETTER_KEYS.size(); ++i) {
+        const auto offset = static_cast<char16_t>(i);
+        table.insert(static_cast<char16_t>(u'a' + offset), {LETTER_KEYS.at(i), false, false});
+        table.insert(static_cast<char16_t>(u'A' + offset), {LETTER_KEYS.at(i), true, false});
+    }
+
+    static constexpr std::array<uint32_t, 10> DIGIT_KEYS = {
+        KEY_0, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9,
+    };
+    for (size_t i = 0; i < DIGIT_KEYS.size(); ++i) {
+        table.insert(static_cast<char16_t>(u'0' + i), {DIGIT_KEYS.at(i), false, false});
+    }
+
+    struct Symbol {
+        char16_t ch;
+        uint32_t keycode;
+        bool shift;
+    };
+    static constexpr std::array<Symbol, 35> SYMBOLS = {{
+        {u' ', KEY_SPACE, false},      {u'\n', KEY_ENTER, false},     {u'\t', KEY_TAB, false},
+        {u'-', KEY_MINUS, false},      {u'=', KEY_EQUAL, false},      {u'[', KEY_LEFTBRACE, false},
+        {u']', KEY_RIGHTBRACE, false}, {u';', KEY_SEMICOLON, false},  {u'\'', KEY_APOSTROPHE, false},
+        {u'`', KEY_GRAVE, false},      {u'\\', KEY_BACKSLASH, false}, {u',', KEY_COMMA, false},
+        {u'.', KEY_DOT, false},        {u'/', KEY_SLASH, false},
+        {u'!', KEY_1, true},           {u'@', KEY_2, true},           {u'#', KEY_3, true},
+        {u'$', KEY_4, true},           {u'%', KEY_5, true},           {u'^', KEY_6, true},
+        {u'&', KEY_7, true},           {u'*', KEY_8, true},           {u'(', KEY_9, true},
+        {u')', KEY_0, true},           {u'_', KEY_MINUS, true},       {u'+', KEY_EQUAL, true},
+        {u'{', KEY_LEFTBRACE, true},   {u'}', KEY_RIGHTBRACE, true},  {u':', KEY_SEMICOLON, true},
+        {u'"', KEY_APOSTROPHE, true},  {u'~', KEY_GRAVE, true},       {u'|', KEY_BACKSLASH, true},
+        {u'<', KEY_COMMA, true},       {u'>', KEY_DOT, true},         {u'?', KEY_SLASH, true},
+    }};
+    for (const Symbol &symbol : SYMBOLS) {
+        table.insert(symbol.ch, {symbol.keycode, symbol.shift, false});
+    }
+
+    return table;
+}
+
+} // namespace Daemon
+} // namespace YubiKeyOath
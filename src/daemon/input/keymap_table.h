@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <cstdint>
+#include <optional>
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+/**
+ * @brief Physical key and modifiers needed to produce one character
+ */
+struct KeyStroke {
+    uint32_t keycode = 0;  ///< evdev keycode (linux/input-event-codes.h)
+    bool shift = false;
+    bool altGr = false;    ///< ISO Level3 Shift (right Alt)
+};
+
+/**
+ * @brief XKB rule names describing a keyboard layout (as in setxkbmap)
+ *
+ * Layout and variant may be comma-separated lists (one entry per group).
+ * Empty fields fall back to libxkbcommon defaults (XKB_DEFAULT_* environment).
+ */
+struct KeymapNames {
+    QString rules;
+    QString model;
+    QString layout;
+    QString variant;
+    QString options;
+    uint activeGroup = 0;
+
+    bool operator==(const KeymapNames &other) const = default;
+};
+
+/**
+ * @brief Character → (keycode, modifiers) lookup table for the active XKB layout
+ *
+ * Single Responsibility: Map text to key strokes for keyboard emulation
+ *
+ * Shared by PortalTextInput and X11TextInput. The table is compiled from the
+ * active keymap with libxkbcommon the first time it is needed, so typing is a
+ * hash lookup per character and follows the user's layout (AZERTY, QWERTZ, ...)
+ * instead of assuming US.
+ *
+ * @par Layout detection
+ * - X11: _XKB_RULES_NAMES root window property and XKB state (active group)
+ * - Plasma Wayland: kxkbrc and org.kde.keyboard /Layouts (active layout)
+ * - Otherwise: libxkbcommon defaults
+ *
+ * @par Invalidation
+ * The table is dropped on org.kde.KeyboardLayouts layoutChanged/layoutListChanged.
+ * On X11, prepare() also compares the rule names and active group, so layout
+ * switches outside Plasma are picked up at the next typing session.
+ *
+ * If no keymap can be compiled, a built-in US table is used.
+ *
+ * @par Thread Safety
+ * Must be used from the main thread.
+ */
+class KeymapTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// XKB (and X11) keycodes are evdev keycodes shifted by 8
+    static constexpr uint32_t XKB_KEYCODE_OFFSET = 8;
+
+    /**
+     * @brief Gets the process-wide table shared by all text input providers
+     */
+    static KeymapTable &instance();
+
+    /**
+     * @brief Makes sure the table matches the active layout
+     *
+     * Call at the start of a typing session. Cheap when nothing changed.
+     */
+    void prepare();
+
+    /**
+     * @brief Looks up the key stroke for a character
+     * @param ch Character to type ('\\n' maps to Return)
+     * @return Key stroke, or std::nullopt if the layout cannot produce it
+     *
+     * Builds the table if needed but does not re-check the layout; call
+     * prepare() once per typing session for that.
+     */
+    std::optional<KeyStroke> lookup(QChar ch);
+
+    /**
+     * @brief Drops the table; it is rebuilt on next use
+     */
+    void invalidate();
+
+    /**
+     * @brief Compiles a lookup table for the given layout
+     * @param names XKB rule names and active group
+     * @return Table, empty if the keymap could not be compiled
+     *
+     * Among several ways to produce a character, main-block keys are preferred
+     * over the keypad, then the fewest modifiers, then the lowest keycode.
+     */
+    static QHash<char16_t, KeyStroke> build(const KeymapNames &names);
+
+    /**
+     * @brief Built-in US layout table (used when no keymap can be compiled)
+     */
+    static QHash<char16_t, KeyStroke> usFallback();
+
+private Q_SLOTS:
+    void onLayoutChanged();
+
+private:
+    explicit KeymapTable(QObject *parent = nullptr);
+
+    static KeymapNames detectNames();
+
+    QHash<char16_t, KeyStroke> m_table;
+    KeymapNames m_names;
+    bool m_valid = false;
+};
+
+} // namespace Daemon
+} // namespace YubiKeyOath
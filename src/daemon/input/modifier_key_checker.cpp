@@ -8,12 +8,13 @@
 
 #include <QApplication>
 #include <QElapsedTimer>
-#include <QCoreApplication>
-#include <QThread>
+#include <QEventLoop>
+#include <QSocketNotifier>
 #include <KLocalizedString>
 
-// X11 includes for XQueryKeymap
+// X11 includes for XQueryKeymap and XKB state events
 #include <X11/Xlib.h>
+#include <X11/XKBlib.h>
 #include <X11/keysym.h>
 #include <cstdlib>
 
@@ -348,6 +349,31 @@ namespace {
                               << "(evdev: no keyboards found or permission denied, X11: not available)";
         return Qt::NoModifier;
     }
+
+    /**
+     * @brief Discards queued input events so the device stays readable only on new activity
+     * @param fd Non-blocking evdev file descriptor
+     */
+    void drainEvdevEvents(int fd)
+    {
+        input_event event{};
+        while (read(fd, &event, sizeof(event)) == static_cast<ssize_t>(sizeof(event))) {
+            // Only the current key state (EVIOCGKEY) matters, not the event contents
+        }
+    }
+
+    /**
+     * @brief Checks the XKB modifier state on an open display
+     * @return true if Shift, Control, Alt or AltGr (Mod5) is active
+     */
+    bool hasModifiersPressedXkb(Display *display)
+    {
+        XkbStateRec state{};
+        if (XkbGetState(display, XkbUseCoreKbd, &state) != Success) {
+            return false;
+        }
+        return (state.mods & (ShiftMask | ControlMask | Mod1Mask | Mod5Mask)) != 0;
+    }
 }  // namespace
 
 bool ModifierKeyChecker::hasModifiersPressed()
@@ -365,8 +391,9 @@ bool ModifierKeyChecker::hasModifiersPressed()
 
 bool ModifierKeyChecker::waitForModifierRelease(int timeoutMs, int pollIntervalMs)
 {
+    Q_UNUSED(pollIntervalMs)
     qCDebug(TextInputLog) << "ModifierKeyChecker: Waiting for modifier release"
-                          << "timeout:" << timeoutMs << "ms, poll interval:" << pollIntervalMs << "ms";
+                          << "timeout:" << timeoutMs << "ms";
 
     QElapsedTimer timer;
     timer.start();
@@ -377,25 +404,25 @@ bool ModifierKeyChecker::waitForModifierRelease(int timeoutMs, int pollIntervalM
         return true;
     }
 
-    // Poll until timeout or release
-    while (timer.elapsed() < timeoutMs) {
-        // Process events to keep UI responsive and update keyboard state
-        QCoreApplication::processEvents(QEventLoop::AllEvents, pollIntervalMs);
-
-        // Wait for poll interval
-        QThread::msleep(pollIntervalMs);
-
-        // Check if modifiers are released
-        if (!hasModifiersPressed()) {
-            qCDebug(TextInputLog) << "ModifierKeyChecker: Modifiers released after"
-                                  << timer.elapsed() << "ms";
-            return true;
-        }
+    ModifierReleaseWatcher watcher;
+    QEventLoop loop;
+    bool released = false;
+    QObject::connect(&watcher, &ModifierReleaseWatcher::released, &loop, [&released, &loop]() {
+        released = true;
+        loop.quit();
+    });
+    QObject::connect(&watcher, &ModifierReleaseWatcher::timedOut, &loop, &QEventLoop::quit);
+    watcher.start(timeoutMs);
+    loop.exec();
+
+    if (released) {
+        qCDebug(TextInputLog) << "ModifierKeyChecker: Modifiers released after"
+                              << timer.elapsed() << "ms";
+    } else {
+        qCDebug(TextInputLog) << "ModifierKeyChecker: Timeout after" << timeoutMs
+                              << "ms - modifiers still pressed";
     }
-
-    qCDebug(TextInputLog) << "ModifierKeyChecker: Timeout after" << timeoutMs
-                          << "ms - modifiers still pressed";
-    return false;
+    return released;
 }
 
 QStringList ModifierKeyChecker::getPressedModifiers()
@@ -419,5 +446,147 @@ QStringList ModifierKeyChecker::getPressedModifiers()
     return names;
 }
 
+// ========== ModifierReleaseWatcher ==========
+
+ModifierReleaseWatcher::ModifierReleaseWatcher(QObject *parent)
+    : QObject(parent)
+{
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, [this]() {
+        finish(false);
+    });
+}
+
+ModifierReleaseWatcher::~ModifierReleaseWatcher()
+{
+    detach();
+}
+
+void ModifierReleaseWatcher::start(int timeoutMs)
+{
+    cancel();
+    m_active = true;
+
+    if (!attachEvdev() && !attachX11()) {
+        qCDebug(TextInputLog) << "ModifierReleaseWatcher: No event source available, treating as released";
+    }
+
+    m_timeoutTimer.start(timeoutMs);
+
+    // Keys may have been released before the sources were attached
+    QTimer::singleShot(0, this, [this]() {
+        if (m_active) {
+            onKeyboardActivity();
+        }
+    });
+}
+
+void ModifierReleaseWatcher::cancel()
+{
+    m_active = false;
+    m_timeoutTimer.stop();
+    detach();
+}
+
+void ModifierReleaseWatcher::onKeyboardActivity()
+{
+    bool pressed = false;
+
+    if (!m_notifiers.isEmpty() && m_display) {
+        while (XPending(m_display) > 0) {
+            XEvent event;
+            XNextEvent(m_display, &event);
+        }
+        pressed = hasModifiersPressedXkb(m_display);
+    } else if (!m_notifiers.isEmpty()) {
+        for (const auto *notifier : std::as_const(m_notifiers)) {
+            drainEvdevEvents(static_cast<int>(notifier->socket()));
+        }
+        pressed = getCurrentModifiersEvdev() != Qt::NoModifier;
+    }
+
+    if (!pressed) {
+        finish(true);
+    }
+}
+
+void ModifierReleaseWatcher::finish(bool wasReleased)
+{
+    if (!m_active) {
+        return;
+    }
+    cancel();
+
+    if (wasReleased) {
+        qCDebug(TextInputLog) << "ModifierReleaseWatcher: Modifiers released";
+        Q_EMIT released();
+    } else {
+        qCDebug(TextInputLog) << "ModifierReleaseWatcher: Timeout - modifiers still pressed";
+        Q_EMIT timedOut();
+    }
+}
+
+bool ModifierReleaseWatcher::attachEvdev()
+{
+    if (!initializeEvdevDevices()) {
+        return false;
+    }
+
+    for (const auto &kbd : g_keyboards) {
+        if (kbd.fd < 0) {
+            continue;
+        }
+        // Only events arriving from now on should wake us up
+        drainEvdevEvents(kbd.fd);
+
+        auto *notifier = new QSocketNotifier(kbd.fd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, &ModifierReleaseWatcher::onKeyboardActivity);
+        m_notifiers.append(notifier);
+    }
+
+    qCDebug(TextInputLog) << "ModifierReleaseWatcher: Watching" << m_notifiers.size() << "evdev device(s)";
+    return !m_notifiers.isEmpty();
+}
+
+bool ModifierReleaseWatcher::attachX11()
+{
+    const char * const display_env = std::getenv("DISPLAY");
+    if (display_env == nullptr || display_env[0] == '\0') {
+        return false;
+    }
+
+    int major = XkbMajorVersion;
+    int minor = XkbMinorVersion;
+    int reason = 0;
+    m_display = XkbOpenDisplay(nullptr, nullptr, nullptr, &major, &minor, &reason);
+    if (!m_display) {
+        qCDebug(TextInputLog) << "ModifierReleaseWatcher: Cannot open display with XKB, reason:" << reason;
+        return false;
+    }
+
+    // Wake up on every modifier state change of the core keyboard
+    XkbSelectEventDetails(m_display, XkbUseCoreKbd, XkbStateNotify,
+                          XkbModifierStateMask, XkbModifierStateMask);
+    XFlush(m_display);
+
+    auto *notifier = new QSocketNotifier(ConnectionNumber(m_display), QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, &ModifierReleaseWatcher::onKeyboardActivity);
+    m_notifiers.append(notifier);
+
+    qCDebug(TextInputLog) << "ModifierReleaseWatcher: Watching XKB state events";
+    return true;
+}
+
+void ModifierReleaseWatcher::detach()
+{
+    qDeleteAll(m_notifiers);
+    m_notifiers.clear();
+
+    if (m_display) {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
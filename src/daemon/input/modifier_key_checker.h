@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <QList>
+#include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
+
+class QSocketNotifier;
+struct _XDisplay;
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -23,8 +29,9 @@ namespace Daemon {
  * - AltGr (GroupSwitchModifier)
  *
  * @par Design Pattern
- * Static utility class using X11 XQueryKeymap for modifier detection.
- * Works on X11 and XWayland (requires $DISPLAY environment variable).
+ * Static utility class reading key state from evdev (EVIOCGKEY), with
+ * X11 XQueryKeymap as fallback (X11 and XWayland, requires $DISPLAY).
+ * Use ModifierReleaseWatcher to wait for release without blocking.
  *
  * @par Thread Safety
  * All methods must be called from the main/UI thread.
@@ -63,17 +70,18 @@ public:
     /**
      * @brief Waits for all modifier keys to be released
      *
-     * Polls keyboard state at regular intervals until either:
+     * Runs a ModifierReleaseWatcher in a local event loop until either:
      * - All modifiers are released (returns true)
      * - Timeout expires (returns false)
      *
      * @param timeoutMs Maximum time to wait in milliseconds (default: 500ms)
-     * @param pollIntervalMs How often to check keyboard state in milliseconds (default: 50ms)
+     * @param pollIntervalMs Unused; release is detected from key events.
+     *        Kept for source compatibility.
      *
      * @return true if modifiers were released within timeout, false if timeout expired
      *
-     * @note This is a blocking call that processes events while waiting.
-     *       The UI remains responsive during the wait.
+     * @note This is a blocking call that runs a nested event loop. Daemon
+     *       code should use ModifierReleaseWatcher directly instead.
      *
      * @par Thread Safety
      * Must be called from main/UI thread.
@@ -101,5 +109,81 @@ private:
     ModifierKeyChecker& operator=(const ModifierKeyChecker&) = delete;
 };
 
+/**
+ * @brief Signals as soon as all monitored modifier keys are released
+ *
+ * Single Responsibility: Event-driven wait for modifier release
+ *
+ * Re-checks the modifier state only when the keyboard reports activity,
+ * so release is seen within one event instead of one poll interval and
+ * nothing runs while the keys are held.
+ *
+ * @par Event Sources
+ * - evdev: QSocketNotifier on the keyboard devices (Wayland and X11)
+ * - X11: XKB StateNotify events for modifier changes (evdev unavailable)
+ * - Neither: released() right away, as hasModifiersPressed() reports none
+ *
+ * @par Thread Safety
+ * Must be used from main/UI thread.
+ *
+ * @par Usage Example
+ * @code
+ * auto *watcher = new ModifierReleaseWatcher(this);
+ * connect(watcher, &ModifierReleaseWatcher::released, this, &Foo::typeNow);
+ * connect(watcher, &ModifierReleaseWatcher::timedOut, this, &Foo::cancel);
+ * watcher->start(15000);
+ * @endcode
+ */
+class ModifierReleaseWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModifierReleaseWatcher(QObject *parent = nullptr);
+    ~ModifierReleaseWatcher() override;
+
+    /**
+     * @brief Starts watching (restarts if already active)
+     * @param timeoutMs Time after which timedOut() is emitted
+     *
+     * Exactly one of released() or timedOut() is emitted per start(),
+     * always from the event loop, never from within start().
+     */
+    void start(int timeoutMs);
+
+    /**
+     * @brief Stops watching without emitting a signal
+     */
+    void cancel();
+
+    /**
+     * @brief Whether a wait is in progress
+     */
+    bool isActive() const { return m_active; }
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when no monitored modifier is pressed any more
+     */
+    void released();
+
+    /**
+     * @brief Emitted when modifiers are still pressed after the timeout
+     */
+    void timedOut();
+
+private:
+    void onKeyboardActivity();
+    void finish(bool wasReleased);
+    bool attachEvdev();
+    bool attachX11();
+    void detach();
+
+    QList<QSocketNotifier *> m_notifiers;
+    QTimer m_timeoutTimer;
+    _XDisplay *m_display = nullptr;
+    bool m_active = false;
+};
+
 } // namespace Daemon
 } // namespace YubiKeyOath
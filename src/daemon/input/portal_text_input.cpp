@@ -4,16 +4,18 @@
  */
 
 #include "portal_text_input.h"
+#include "keymap_table.h"
 #include "../storage/secret_storage.h"
 #include "../logging_categories.h"
 
 #include <QDebug>
-#include <QDateTime>
 #include <QElapsedTimer>
 #include <QGuiApplication>
-#include <QThread>
 #include <QEventLoop>
 #include <QTimer>
+#include <QVarLengthArray>
+
+#include <algorithm>
 
 #include <libportal/portal.h>
 #include <linux/input-event-codes.h>
@@ -30,6 +32,10 @@ PortalTextInput::PortalTextInput(SecretStorage *secretStorage, QObject *parent)
     , m_secretStorage(secretStorage)
 {
     qCDebug(TextInputLog) << "PortalTextInput: Constructor";
+
+    m_keyTimer.setSingleShot(true);
+    m_keyTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_keyTimer, &QTimer::timeout, this, &PortalTextInput::sendKeyEvents);
 }
 
 PortalTextInput::~PortalTextInput()
@@ -48,7 +54,7 @@ bool PortalTextInput::typeText(const QString &text)
     totalTimer.start();
 
     qCDebug(TextInputLog) << "PortalTextInput: typeText() called with" << text.length()
-                           << "characters, persistSession:" << m_persistSession;
+                           << "characters, persistSession:" << shouldPersistSession();
 
     if (text.isEmpty()) {
         qCWarning(TextInputLog) << "PortalTextInput: Empty text provided";
@@ -59,6 +65,20 @@ bool PortalTextInput::typeText(const QString &text)
     m_waitingForPermission = false;
     m_permissionRejected = false;
 
+    // Convert up front: unsupported text fails before a session is even opened
+    QQueue<KeyEvent> events;
+    if (!buildKeyEvents(text, events)) {
+        return false;
+    }
+
+    // Previous text is still being typed - append to it on the same session
+    if (!m_keyQueue.isEmpty()) {
+        qCDebug(TextInputLog) << "PortalTextInput: [QUEUE] Appending" << events.size()
+                               << "key events to" << m_keyQueue.size() << "pending";
+        m_keyQueue.append(events);
+        return waitForTypingFinished();
+    }
+
     // Initialize portal if needed (portal handle is reused across operations)
     if (!m_portal) {
         QElapsedTimer portalTimer;
@@ -76,7 +96,7 @@ bool PortalTextInput::typeText(const QString &text)
     // Session management depends on persist mode
     bool sessionCreatedHere = false;
 
-    if (m_persistSession && m_sessionReady && isSessionValid()) {
+    if (shouldPersistSession() && m_sessionReady && isSessionValid()) {
         // Reuse existing persistent session
         qCDebug(TextInputLog) << "PortalTextInput: [SESSION-REUSE] Reusing persistent session";
     } else {
@@ -87,7 +107,7 @@ bool PortalTextInput::typeText(const QString &text)
         // Close invalid/stale session first
         if (m_sessionReady || m_session) {
             qCDebug(TextInputLog) << "PortalTextInput: Closing"
-                                   << (m_persistSession ? "invalid persistent" : "stale") << "session";
+                                   << (shouldPersistSession() ? "invalid persistent" : "stale") << "session";
             closeSession();
         }
 
@@ -103,32 +123,23 @@ bool PortalTextInput::typeText(const QString &text)
         sessionCreatedHere = true;
     }
 
-    // Send key events
-    QElapsedTimer typingTimer;
-    typingTimer.start();
-
-    const bool success = sendKeyEvents(text);
-
-    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Key events sending took"
-                           << typingTimer.elapsed() << "ms";
+    // Send the first run of key events now; spaced remainder is drained by m_keyTimer.
+    // The session is closed (non-persist mode) once the queue is empty.
+    m_keyQueue = std::move(events);
+    m_typedEvents = 0;
+    m_typingTimer.start();
 
-    // Close session after operation only in non-persist mode
-    if (!m_persistSession) {
-        QElapsedTimer closeTimer;
-        closeTimer.start();
-
-        closeSession();
-
-        qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Session close took"
-                               << closeTimer.elapsed() << "ms";
-    } else {
-        qCDebug(TextInputLog) << "PortalTextInput: [SESSION-PERSIST] Keeping session alive for reuse";
+    bool success = sendKeyEvents();
+    if (success && !m_keyQueue.isEmpty()) {
+        // Report the outcome of the whole text, not just the first run
+        success = waitForTypingFinished();
     }
 
     const qint64 totalTime = totalTimer.elapsed();
-    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Total operation time:"
+    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] typeText() returned after"
                            << totalTime << "ms (success:" << success
-                           << ", sessionReused:" << !sessionCreatedHere << ")";
+                           << ", sessionReused:" << !sessionCreatedHere
+                           << ", pending events:" << m_keyQueue.size() << ")";
 
     return success;
 }
@@ -258,6 +269,7 @@ bool PortalTextInput::createSession()
     QString restoreToken;
     if (m_secretStorage) {
         restoreToken = m_secretStorage->loadRestoreToken();
+        m_hasRestoreToken = !restoreToken.isEmpty();
         qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Restore token load took"
                                << tokenTimer.elapsed() << "ms, empty:" << restoreToken.isEmpty()
                                << "length:" << restoreToken.length();
@@ -392,6 +404,7 @@ bool PortalTextInput::createSession()
         g_free(token);  // Free GLib-allocated string
 
         qCDebug(TextInputLog) << "PortalTextInput: [DIAGNOSTIC] Got new restore token, length:" << newToken.length();
+        m_hasRestoreToken = true;
 
         // Save to KWallet for persistence across daemon restarts
         if (m_secretStorage) {
@@ -437,144 +450,124 @@ bool PortalTextInput::sendKeycode(uint32_t keycode, bool pressed)
     return true;
 }
 
-bool PortalTextInput::sendKeyEvents(const QString &text)
+bool PortalTextInput::buildKeyEvents(const QString &text, QQueue<KeyEvent> &events)
 {
-    qCDebug(TextInputLog) << "PortalTextInput: Sending" << text.length() << "characters via libportal";
-    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Started at" << QDateTime::currentMSecsSinceEpoch();
-
-    bool success = true;
-
-    for (const QChar &ch : text) {
-        uint32_t keycode = 0;
-        bool needShift = false;
-
-        if (!convertCharToKeycode(ch, keycode, needShift)) {
-            qCWarning(TextInputLog) << "PortalTextInput: Failed to convert character:" << ch;
-            success = false;
-            continue;
+    // Follow the active layout (table is shared with X11TextInput)
+    KeymapTable &keymap = KeymapTable::instance();
+    keymap.prepare();
+
+    // Unmodified digits can go out as a single burst if enabled
+    const bool burst = m_burstTyping
+        && std::all_of(text.cbegin(), text.cend(), [](QChar ch) {
+               return ch.unicode() >= u'0' && ch.unicode() <= u'9';
+           });
+
+    QQueue<KeyEvent> built;
+
+    for (const QChar ch : text) {
+        const auto stroke = keymap.lookup(ch);
+        if (!stroke) {
+            qCWarning(TextInputLog) << "PortalTextInput: Character not available in keyboard layout:" << ch;
+            return false;
         }
 
-        // Press shift if needed
-        if (needShift) {
-            if (!sendKeycode(KEY_LEFTSHIFT, true)) {
-                success = false;
-                continue;
-            }
-            QThread::msleep(KEY_DELAY_MS);
+        QVarLengthArray<uint32_t, 2> modifiers;
+        if (stroke->shift) {
+            modifiers.append(KEY_LEFTSHIFT);
         }
-
-        // Press key
-        if (!sendKeycode(keycode, true)) {
-            success = false;
-            if (needShift) {
-                sendKeycode(KEY_LEFTSHIFT, false);  // Release shift even on error
-            }
-            continue;
+        if (stroke->altGr) {
+            modifiers.append(KEY_RIGHTALT);
         }
-        QThread::msleep(KEY_DELAY_MS);
+        // Every event is spaced, except unmodified digits in burst mode
+        const int delay = burst && modifiers.isEmpty() ? 0 : KEY_DELAY_MS;
 
-        // Release key
-        if (!sendKeycode(keycode, false)) {
-            success = false;
-            if (needShift) {
-                sendKeycode(KEY_LEFTSHIFT, false);
-            }
-            continue;
+        // Modifier state must reach the compositor before the key and outlive it
+        for (const uint32_t modifier : modifiers) {
+            built.enqueue({modifier, true, delay});
         }
-        QThread::msleep(KEY_DELAY_MS);
-
-        // Release shift if needed
-        if (needShift) {
-            if (!sendKeycode(KEY_LEFTSHIFT, false)) {
-                success = false;
-            }
-            QThread::msleep(KEY_DELAY_MS);
+        built.enqueue({stroke->keycode, true, delay});
+        built.enqueue({stroke->keycode, false, delay});
+        for (auto it = modifiers.crbegin(); it != modifiers.crend(); ++it) {
+            built.enqueue({*it, false, delay});
         }
     }
 
-    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Finished at" << QDateTime::currentMSecsSinceEpoch();
-    qCDebug(TextInputLog) << "PortalTextInput: Sent" << text.length() << "characters, success:" << success;
+    qCDebug(TextInputLog) << "PortalTextInput: Built" << built.size() << "key events for"
+                           << text.length() << "characters, burst:" << burst;
 
-    return success;
+    events = std::move(built);
+    return true;
 }
 
-// =============================================================================
-// Character to Keycode Conversion (US Keyboard Layout)
-// =============================================================================
-
-bool PortalTextInput::convertCharToKeycode(QChar ch, uint32_t &keycode, bool &needShift)
+bool PortalTextInput::sendKeyEvents()
 {
-    needShift = false;
-    char16_t const unicode = ch.unicode();
-
-    // Numbers (0-9)
-    if (unicode >= '0' && unicode <= '9') {
-        keycode = KEY_1 + (unicode - '1');
-        if (unicode == '0') {
-            keycode = KEY_0;
+    while (!m_keyQueue.isEmpty()) {
+        const KeyEvent event = m_keyQueue.dequeue();
+
+        if (!sendKeycode(event.keycode, event.pressed)) {
+            // Session is gone - held keys cannot be released through it either
+            qCWarning(TextInputLog) << "PortalTextInput: Dropping" << m_keyQueue.size()
+                                     << "pending key events";
+            m_keyQueue.clear();
+            finishTyping(false);
+            return false;
         }
-        return true;
-    }
+        ++m_typedEvents;
 
-    // Lowercase letters (a-z)
-    if (unicode >= 'a' && unicode <= 'z') {
-        keycode = KEY_A + (unicode - 'a');
-        return true;
+        if (event.delayAfterMs > 0 && !m_keyQueue.isEmpty()) {
+            m_keyTimer.start(event.delayAfterMs);
+            return true;
+        }
     }
 
-    // Uppercase letters (A-Z)
-    if (unicode >= 'A' && unicode <= 'Z') {
-        keycode = KEY_A + (unicode - 'A');
-        needShift = true;
-        return true;
-    }
+    finishTyping(true);
+    return true;
+}
 
-    // Special characters (unshifted)
-    switch (ch.unicode()) {
-    case ' ':  keycode = KEY_SPACE; break;
-    case '-':  keycode = KEY_MINUS; break;
-    case '=':  keycode = KEY_EQUAL; break;
-    case '[':  keycode = KEY_LEFTBRACE; break;
-    case ']':  keycode = KEY_RIGHTBRACE; break;
-    case ';':  keycode = KEY_SEMICOLON; break;
-    case '\'': keycode = KEY_APOSTROPHE; break;
-    case '`':  keycode = KEY_GRAVE; break;
-    case '\\': keycode = KEY_BACKSLASH; break;
-    case ',':  keycode = KEY_COMMA; break;
-    case '.':  keycode = KEY_DOT; break;
-    case '/':  keycode = KEY_SLASH; break;
-    case '\n': keycode = KEY_ENTER; break;
-    case '\t': keycode = KEY_TAB; break;
-
-    // Shifted special characters
-    case '!':  keycode = KEY_1; needShift = true; break;
-    case '@':  keycode = KEY_2; needShift = true; break;
-    case '#':  keycode = KEY_3; needShift = true; break;
-    case '$':  keycode = KEY_4; needShift = true; break;
-    case '%':  keycode = KEY_5; needShift = true; break;
-    case '^':  keycode = KEY_6; needShift = true; break;
-    case '&':  keycode = KEY_7; needShift = true; break;
-    case '*':  keycode = KEY_8; needShift = true; break;
-    case '(':  keycode = KEY_9; needShift = true; break;
-    case ')':  keycode = KEY_0; needShift = true; break;
-    case '_':  keycode = KEY_MINUS; needShift = true; break;
-    case '+':  keycode = KEY_EQUAL; needShift = true; break;
-    case '{':  keycode = KEY_LEFTBRACE; needShift = true; break;
-    case '}':  keycode = KEY_RIGHTBRACE; needShift = true; break;
-    case ':':  keycode = KEY_SEMICOLON; needShift = true; break;
-    case '"':  keycode = KEY_APOSTROPHE; needShift = true; break;
-    case '~':  keycode = KEY_GRAVE; needShift = true; break;
-    case '|':  keycode = KEY_BACKSLASH; needShift = true; break;
-    case '<':  keycode = KEY_COMMA; needShift = true; break;
-    case '>':  keycode = KEY_DOT; needShift = true; break;
-    case '?':  keycode = KEY_SLASH; needShift = true; break;
-
-    default:
-        qCWarning(TextInputLog) << "PortalTextInput: Unsupported character:" << ch;
+bool PortalTextInput::waitForTypingFinished()
+{
+    // Events are sent from m_keyTimer, so keep the event loop running instead of sleeping
+    bool success = false;
+    bool finished = false;
+    QEventLoop loop;
+    const QMetaObject::Connection connection = connect(this, &PortalTextInput::typingFinished, &loop,
+                                                       [&](bool typed) {
+        success = typed;
+        finished = true;
+        loop.quit();
+    });
+    QTimer::singleShot(TYPING_TIMEOUT_MS, &loop, &QEventLoop::quit);
+    loop.exec();
+    disconnect(connection);
+
+    if (!finished) {
+        qCWarning(TextInputLog) << "PortalTextInput: Key queue did not drain within" << TYPING_TIMEOUT_MS << "ms";
+        closeSession();
         return false;
     }
+    return success;
+}
 
-    return true;
+void PortalTextInput::finishTyping(bool success)
+{
+    qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Sent" << m_typedEvents
+                           << "key events in" << m_typingTimer.elapsed() << "ms end-to-end (success:"
+                           << success << ")";
+
+    // Close session after operation only in non-persist mode
+    if (!shouldPersistSession()) {
+        QElapsedTimer closeTimer;
+        closeTimer.start();
+
+        closeSession();
+
+        qCDebug(TextInputLog) << "PortalTextInput: [TIMING] Session close took"
+                               << closeTimer.elapsed() << "ms";
+    } else {
+        qCDebug(TextInputLog) << "PortalTextInput: [SESSION-PERSIST] Keeping session alive for reuse";
+    }
+
+    Q_EMIT typingFinished(success);
 }
 
 // =============================================================================
@@ -585,6 +578,13 @@ void PortalTextInput::closeSession()
 {
     qCDebug(TextInputLog) << "PortalTextInput: Closing session (keeping portal handle for reuse)";
 
+    m_keyTimer.stop();
+    const bool discarded = !m_keyQueue.isEmpty();
+    if (discarded) {
+        qCWarning(TextInputLog) << "PortalTextInput: Discarding" << m_keyQueue.size() << "unsent key events";
+        m_keyQueue.clear();
+    }
+
     m_sessionReady = false;
 
     if (m_session) {
@@ -595,6 +595,10 @@ void PortalTextInput::closeSession()
     }
 
     // Keep m_portal alive for fast session recreation
+
+    if (discarded) {
+        Q_EMIT typingFinished(false);  // Text was cut short
+    }
 }
 
 void PortalTextInput::cleanup()
@@ -635,5 +639,16 @@ void PortalTextInput::setPersistSession(bool persist)
     m_persistSession = persist;
 }
 
+bool PortalTextInput::shouldPersistSession() const
+{
+    return m_persistSession.value_or(m_hasRestoreToken);
+}
+
+void PortalTextInput::setBurstTyping(bool enabled)
+{
+    qCDebug(TextInputLog) << "PortalTextInput: setBurstTyping:" << enabled;
+    m_burstTyping = enabled;
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
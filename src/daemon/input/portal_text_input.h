@@ -6,10 +6,14 @@
 #pragma once
 
 #include "text_input_provider.h"
+#include <QElapsedTimer>
 #include <QObject>
+#include <QQueue>
 #include <QString>
+#include <QTimer>
 #include <QVariant>
 #include <memory>
+#include <optional>
 
 #include <libportal/portal.h>
 
@@ -33,6 +37,12 @@ class SecretStorage;
  * 2. libportal xdp_session_keyboard_key() API for keyboard events
  * 3. No external dependencies beyond Qt and libportal
  *
+ * Key injection: typeText() converts the whole text into a queue of key
+ * events up front. Events are spaced by KEY_DELAY_MS (except unmodified
+ * digits in burst mode); the queue is drained from a timer while typeText()
+ * runs a local event loop, so the thread never sleeps and the returned
+ * result covers the whole text.
+ *
  * Replaces previous libei + liboeffis implementation with cleaner, simpler API.
  */
 class PortalTextInput : public QObject, public TextInputProvider
@@ -48,6 +58,7 @@ public:
     QString providerName() const override;
     void preInitialize() override;
     void setPersistSession(bool persist) override;
+    void setBurstTyping(bool enabled) override;
 
     /**
      * @brief Check if last typeText() failure was due to waiting for permission
@@ -61,16 +72,69 @@ public:
      */
     bool wasPermissionRejected() const override { return m_permissionRejected; }
 
+Q_SIGNALS:
+    /**
+     * @brief Emitted when the key queue has drained or was dropped
+     * @param success false if the session rejected an event or closed early
+     */
+    void typingFinished(bool success);
+
 private:
+    /**
+     * @brief Single key press or release in the injection queue
+     */
+    struct KeyEvent {
+        uint32_t keycode = 0;
+        bool pressed = false;
+        int delayAfterMs = 0;  ///< Gap before the next event is sent
+    };
+
     bool initializePortal();
     bool createSession();
     void closeSession();  // Close session but keep portal handle (for session-per-operation)
     void cleanup();       // Full cleanup: close session AND portal
     bool isSessionValid() const;
 
-    bool sendKeyEvents(const QString &text);
+    /**
+     * @brief Converts text into key events with the minimal spacing
+     * @param text Text to type (mapped through the shared KeymapTable)
+     * @param events Output queue (untouched on failure)
+     * @return false if any character cannot be typed
+     *
+     * Fails before anything is typed, so a code is never half-entered.
+     */
+    bool buildKeyEvents(const QString &text, QQueue<KeyEvent> &events);
+
+    /**
+     * @brief Sends queued events until a spaced event or the end of the queue
+     * @return false if the session rejected an event (queue is dropped)
+     */
+    bool sendKeyEvents();
+
+    /**
+     * @brief Called when the queue has drained: logs latency, closes session
+     * @param success false if events were dropped
+     *
+     * Emits typingFinished().
+     */
+    void finishTyping(bool success);
+
+    /**
+     * @brief Runs a local event loop until typingFinished() (or TYPING_TIMEOUT_MS)
+     * @return Result reported by typingFinished(), false on timeout
+     */
+    bool waitForTypingFinished();
+
+    /**
+     * @brief Effective session persistence
+     *
+     * An explicit setPersistSession() wins. Otherwise the session is kept
+     * once the portal has issued a restore token, since recreating it then
+     * costs a round trip but never a permission dialog.
+     */
+    bool shouldPersistSession() const;
+
     bool sendKeycode(uint32_t keycode, bool pressed);
-    bool convertCharToKeycode(QChar ch, uint32_t &keycode, bool &needShift);
 
     // libportal session management
     XdpPortal *m_portal = nullptr;
@@ -78,15 +142,26 @@ private:
     bool m_sessionReady = false;
     SecretStorage *m_secretStorage = nullptr;  // For loading/saving restore token
 
-    // Session persistence mode
-    bool m_persistSession = false;
+    // Session persistence mode (unset = decided by restore token availability)
+    std::optional<bool> m_persistSession;
+    bool m_hasRestoreToken = false;
+
+    // Key injection queue, drained by m_keyTimer
+    QQueue<KeyEvent> m_keyQueue;
+    QTimer m_keyTimer;
+    QElapsedTimer m_typingTimer;  // End-to-end latency of the current text
+    qsizetype m_typedEvents = 0;
+    bool m_burstTyping = false;
 
     // Permission state tracking
     bool m_waitingForPermission = false;
     bool m_permissionRejected = false;
 
-    // Keystroke timing (ms delay between key press/release) - optimized for speed
+    // Spacing between key events (outside burst mode)
     static constexpr int KEY_DELAY_MS = 2;
+
+    // Upper bound for draining one queue; hit only if the timer stalls
+    static constexpr int TYPING_TIMEOUT_MS = 5000;
 };
 
 } // namespace Daemon
@@ -75,6 +75,16 @@ public:
      * Default implementation: no-op (providers that don't support persistence)
      */
     virtual void setPersistSession(bool /*persist*/) {}
+
+    /**
+     * @brief Enable or disable zero-delay typing of digit-only text
+     *
+     * When enabled, numeric codes are sent as one burst without any spacing
+     * between key events.
+     *
+     * Default implementation: no-op (providers without key spacing)
+     */
+    virtual void setBurstTyping(bool /*enabled*/) {}
 };
 
 } // namespace Daemon
@@ -7,9 +7,16 @@
 #include "../logging_categories.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QDebug>
 
+#include <linux/input-event-codes.h>
+
+// X11 headers last - they define macros that clash with Qt
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+
 namespace YubiKeyOath {
 namespace Daemon {
 
@@ -24,6 +31,76 @@ bool X11TextInput::typeText(const QString &text)
 {
     qCDebug(TextInputLog) << "X11TextInput: Typing text, length:" << text.length();
 
+    QElapsedTimer timer;
+    timer.start();
+
+    KeymapTable &keymap = KeymapTable::instance();
+    keymap.prepare();
+
+    QList<KeyStroke> strokes;
+    strokes.reserve(text.length());
+    for (const QChar ch : text) {
+        const auto stroke = keymap.lookup(ch);
+        if (!stroke) {
+            qCDebug(TextInputLog) << "X11TextInput: Character not in keyboard layout, using xdotool";
+            return typeWithXdotool(text);
+        }
+        strokes.append(*stroke);
+    }
+
+    const bool success = sendKeyStrokes(strokes);
+    qCDebug(TextInputLog) << "X11TextInput: [TIMING] Typed" << strokes.size() << "characters in"
+                           << timer.elapsed() << "ms, success:" << success;
+    return success;
+}
+
+bool X11TextInput::sendKeyStrokes(const QList<KeyStroke> &strokes)
+{
+    Display *display = XOpenDisplay(nullptr);  // NOLINT(misc-const-correctness) - needs XCloseDisplay()
+    if (!display) {
+        qCWarning(TextInputLog) << "X11TextInput: Cannot open X display";
+        return false;
+    }
+
+    int eventBase = 0;
+    int errorBase = 0;
+    int majorVersion = 0;
+    int minorVersion = 0;
+    if (!XTestQueryExtension(display, &eventBase, &errorBase, &majorVersion, &minorVersion)) {
+        qCWarning(TextInputLog) << "X11TextInput: XTest extension not available";
+        XCloseDisplay(display);
+        return false;
+    }
+
+    // The server processes requests in order, so no spacing is needed
+    const auto sendKey = [display](uint32_t keycode, bool pressed) {
+        XTestFakeKeyEvent(display, keycode + KeymapTable::XKB_KEYCODE_OFFSET, pressed ? True : False, CurrentTime);
+    };
+
+    for (const KeyStroke &stroke : strokes) {
+        if (stroke.shift) {
+            sendKey(KEY_LEFTSHIFT, true);
+        }
+        if (stroke.altGr) {
+            sendKey(KEY_RIGHTALT, true);
+        }
+        sendKey(stroke.keycode, true);
+        sendKey(stroke.keycode, false);
+        if (stroke.altGr) {
+            sendKey(KEY_RIGHTALT, false);
+        }
+        if (stroke.shift) {
+            sendKey(KEY_LEFTSHIFT, false);
+        }
+    }
+
+    XSync(display, False);
+    XCloseDisplay(display);
+    return true;
+}
+
+bool X11TextInput::typeWithXdotool(const QString &text)
+{
     QProcess process;
     QStringList args;
     args << QStringLiteral("type") << text;
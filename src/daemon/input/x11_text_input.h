@@ -6,6 +6,8 @@
 #pragma once
 
 #include "text_input_provider.h"
+#include "keymap_table.h"
+#include <QList>
 #include <QObject>
 
 namespace YubiKeyOath {
@@ -16,6 +18,10 @@ class SecretStorage;
 
 /**
  * @brief X11-specific text input implementation
+ *
+ * Maps text through the shared KeymapTable and injects the key strokes with
+ * the XTest extension. Text the active layout cannot produce falls back to
+ * xdotool, which remaps a spare keycode per character.
  */
 class X11TextInput : public QObject, public TextInputProvider
 {
@@ -28,6 +34,10 @@ public:
     bool typeText(const QString &text) override;
     bool isCompatible() const override;
     QString providerName() const override;
+
+private:
+    static bool sendKeyStrokes(const QList<KeyStroke> &strokes);
+    static bool typeWithXdotool(const QString &text);
 };
 
 } // namespace Daemon
@@ -6,15 +6,21 @@
 #include "oath_dbus_service.h"
 #include "types/yubikey_value_types.h"
 #include "types/device_state.h"
+#include "logging_categories.h"
 
 #include <QApplication>
 #include <QDBusConnection>
 #include <QDBusError>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <KLocalizedString>
 
 int main(int argc, char *argv[])
 {
+    // Startup metrics (name claimed, first reply, live devices) are relative to this
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     // NOLINTNEXTLINE(misc-const-correctness) - QApplication is modified internally by Qt
     QApplication app(argc, argv);
     app.setApplicationName(QStringLiteral("yubikey-oath-daemon"));
@@ -40,10 +46,10 @@ int main(int argc, char *argv[])
     qRegisterMetaType<QList<YubiKeyOath::Shared::CredentialInfo>>("QList<YubiKeyOath::Shared::CredentialInfo>");
     qRegisterMetaType<YubiKeyOath::Shared::DeviceState>("YubiKeyOath::Shared::DeviceState");
 
-    // Create service
-    const YubiKeyOath::Daemon::OathDBusService service;
+    // Create service (phase 1: database + D-Bus objects only, PC/SC is deferred)
+    const YubiKeyOath::Daemon::OathDBusService service(startupTimer);
 
-    // Register on session bus
+    // Register on session bus - pending activation requests are delivered from here on
     QDBusConnection connection = QDBusConnection::sessionBus();
 
     if (!connection.registerService(QStringLiteral("pl.jkolo.yubikey.oath.daemon"))) {
@@ -51,6 +57,8 @@ int main(int argc, char *argv[])
                     << connection.lastError().message();
         return 1;
     }
+    qCInfo(YubiKeyOath::Daemon::OathDaemonLog) << "[STARTUP] D-Bus service name claimed after"
+                                               << startupTimer.elapsed() << "ms";
 
     return app.exec();
 }
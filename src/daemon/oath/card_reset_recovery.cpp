@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "card_reset_recovery.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+BatchResend::BatchResend(QStringList names, SendFunction send)
+    : m_names(std::move(names))
+    , m_send(std::move(send))
+{
+}
+
+QList<Result<void>> BatchResend::operator()()
+{
+    if (m_results.isEmpty()) {
+        m_lastSent = m_names;
+        m_results = m_send(m_names);
+        return m_results;
+    }
+
+    QStringList remaining;
+    QList<qsizetype> positions;
+    for (qsizetype i = 0; i < std::min(m_names.size(), m_results.size()); ++i) {
+        if (m_results.at(i).isError()) {
+            remaining.append(m_names.at(i));
+            positions.append(i);
+        }
+    }
+
+    m_lastSent = remaining;
+    if (remaining.isEmpty()) {
+        return m_results;
+    }
+
+    const auto retried = m_send(remaining);
+    for (qsizetype i = 0; i < std::min(positions.size(), retried.size()); ++i) {
+        m_results[positions.at(i)] = retried.at(i);
+    }
+    return m_results;
+}
+
+} // namespace Daemon
+} // namespace YubiKeyOath
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QList>
+#include <QStringList>
+#include <functional>
+#include "common/result.h"
+
+namespace YubiKeyOath {
+namespace Daemon {
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Runs a card operation, re-running it once after a recovered card reset
+ * @param operation Single attempt of the operation (locks the card mutex itself)
+ * @param resetPending Returns true if the attempt was cut short by a card reset
+ * @param recover Reconnects the card; returns true if it is usable again
+ * @return Result of the last attempt
+ *
+ * Extracted from OathDevice so the re-run policy can be tested without PC/SC.
+ * The operation is re-run at most once and only if recover() succeeded.
+ */
+template<typename Operation, typename ResetPending, typename Recover>
+auto runWithCardResetRecovery(Operation &&operation, ResetPending &&resetPending, Recover &&recover)
+    -> decltype(operation())
+{
+    auto result = operation();
+    if (!resetPending() || !recover()) {
+        return result;
+    }
+    return operation();
+}
+
+/**
+ * @brief Batch operation whose re-runs only re-send the items that failed
+ *
+ * For commands that are not idempotent (DELETE): the first call sends every
+ * name, each later call (a re-run after a card reset) sends only the names
+ * whose result is still an error and merges the new results in place.
+ *
+ * Usage:
+ * @code
+ * BatchResend batch(names, [this](const QStringList &subset) { return deleteCredentialsOnce(subset); });
+ * return withCardResetRecovery(batch);
+ * @endcode
+ */
+class BatchResend
+{
+public:
+    using SendFunction = std::function<QList<Result<void>>(const QStringList &names)>;
+
+    /**
+     * @param names All names in the batch
+     * @param send Sends a subset, returning one result per name in order
+     */
+    BatchResend(QStringList names, SendFunction send);
+
+    /**
+     * @brief Sends the batch, or its failed remainder on later calls
+     * @return One result per name passed to the constructor
+     */
+    QList<Result<void>> operator()();
+
+    /**
+     * @brief Names sent by the last call
+     */
+    [[nodiscard]] QStringList lastSent() const { return m_lastSent; }
+
+private:
+    QStringList m_names;
+    SendFunction m_send;
+    QList<Result<void>> m_results;  ///< Empty until the first call
+    QStringList m_lastSent;
+};
+
+} // namespace Daemon
+} // namespace YubiKeyOath
@@ -49,6 +49,15 @@ public:
      */
     using ApduSender = std::function<QByteArray(const QByteArray &command)>;
 
+    /**
+     * @brief APDUs sent by a successful Strategy 1 probe
+     *
+     * SELECT Management, GET DEVICE INFO, re-SELECT OATH. This is the
+     * shortest sequence that yields a serial number, used as the probe cost
+     * of device info whose actual count was not recorded.
+     */
+    static constexpr int MANAGEMENT_PROBE_APDU_COUNT = 3;
+
     /**
      * @brief Function type for parsing SELECT response
      * @param response SELECT response data
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "known_device_info_cache.h"
+#include "extended_device_info_fetcher.h"
+#include "../logging_categories.h"
+
+#include <QMutexLocker>
+
+namespace YubiKeyOath {
+namespace Daemon {
+
+void KnownDeviceInfoCache::remember(const QString &deviceId,
+                                    const Version &selectFirmware,
+                                    const ExtendedDeviceInfo &info)
+{
+    if (deviceId.isEmpty() || info.serialNumber == 0) {
+        return;
+    }
+
+    Entry entry{selectFirmware, info};
+    if (entry.info.probeApduCount <= 0) {
+        entry.info.probeApduCount = ExtendedDeviceInfoFetcher::MANAGEMENT_PROBE_APDU_COUNT;
+    }
+
+    const QMutexLocker locker(&m_mutex);
+    m_entries.insert(deviceId, entry);
+}
+
+std::optional<ExtendedDeviceInfo> KnownDeviceInfoCache::lookup(const QString &deviceId,
+                                                               const Version &selectFirmware) const
+{
+    const QMutexLocker locker(&m_mutex);
+
+    const auto it = m_entries.constFind(deviceId);
+    if (it == m_entries.constEnd()) {
+        return std::nullopt;
+    }
+
+    if (it->selectFirmware != selectFirmware) {
+        qCDebug(OathDeviceManagerLog) << "Fingerprint changed for" << deviceId
+                                      << "(remembered firmware" << it->selectFirmware.toString()
+                                      << ", SELECT reports" << selectFirmware.toString() << ") - re-probing";
+        return std::nullopt;
+    }
+
+    return it->info;
+}
+
+void KnownDeviceInfoCache::forget(const QString &deviceId)
+{
+    const QMutexLocker locker(&m_mutex);
+    m_entries.remove(deviceId);
+}
+
+qint64 KnownDeviceInfoCache::recordReuse(const ExtendedDeviceInfo &info)
+{
+    const QMutexLocker locker(&m_mutex);
+    m_probeApdusSaved += info.probeApduCount;
+    return m_probeApdusSaved;
+}
+
+qint64 KnownDeviceInfoCache::probeApdusSaved() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return m_probeApdusSaved;
+}
+
+} // namespace Daemon
+} // namespace YubiKeyOath
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <optional>
+#include "yk_oath_session.h"  // For ExtendedDeviceInfo definition
+
+namespace YubiKeyOath {
+namespace Daemon {
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Remembers extended device info so reconnects can skip probing
+ *
+ * Extracted from OathDeviceManager. Entries are keyed by device ID and
+ * fingerprinted by the firmware version OATH SELECT reports: a lookup with
+ * a different SELECT firmware misses, so the caller re-probes.
+ *
+ * Thread-safe: device connects run in the PC/SC worker pool.
+ *
+ * Usage:
+ * @code
+ * KnownDeviceInfoCache cache;
+ * if (auto info = cache.lookup(deviceId, selectFirmware)) {
+ *     cache.recordReuse(*info);    // skip Management/OTP/PIV probing
+ * } else {
+ *     cache.remember(deviceId, selectFirmware, probedInfo);
+ * }
+ * @endcode
+ */
+class KnownDeviceInfoCache
+{
+public:
+    /**
+     * @brief Stores extended info for a device
+     * @param deviceId Device ID (from OATH SELECT)
+     * @param selectFirmware Firmware version reported by OATH SELECT (fingerprint)
+     * @param info Extended info (model, serial, form factor) to reuse
+     *
+     * Entries without a serial number are ignored. Entries without a recorded
+     * probe cost (seeded from the database) are charged
+     * ExtendedDeviceInfoFetcher::MANAGEMENT_PROBE_APDU_COUNT, the shortest
+     * probe sequence that yields a serial number.
+     */
+    void remember(const QString &deviceId, const Version &selectFirmware, const ExtendedDeviceInfo &info);
+
+    /**
+     * @brief Looks up remembered info for a connecting device
+     * @param deviceId Device ID from SELECT
+     * @param selectFirmware Firmware version from SELECT
+     * @return Remembered info if the fingerprint matches, std::nullopt otherwise
+     */
+    [[nodiscard]] std::optional<ExtendedDeviceInfo> lookup(const QString &deviceId,
+                                                           const Version &selectFirmware) const;
+
+    /**
+     * @brief Drops the entry for a device (e.g. when it is forgotten)
+     * @param deviceId Device ID
+     */
+    void forget(const QString &deviceId);
+
+    /**
+     * @brief Accounts for a probe chain skipped by reusing @p info
+     * @param info Info returned by lookup()
+     * @return Total probe APDUs saved so far
+     */
+    qint64 recordReuse(const ExtendedDeviceInfo &info);
+
+    /**
+     * @brief Total probe APDUs saved by reuse
+     */
+    [[nodiscard]] qint64 probeApdusSaved() const;
+
+private:
+    /// Extended info remembered per device, valid while the SELECT fingerprint matches
+    struct Entry {
+        Version selectFirmware;
+        ExtendedDeviceInfo info;
+    };
+
+    mutable QMutex m_mutex;  ///< Protects m_entries and m_probeApdusSaved
+    QHash<QString, Entry> m_entries;  ///< deviceId → remembered extended info
+    qint64 m_probeApdusSaved = 0;  ///< Total probe APDUs skipped by reusing remembered info
+};
+
+} // namespace Daemon
+} // namespace YubiKeyOath
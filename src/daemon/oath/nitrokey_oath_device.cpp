@@ -33,6 +33,7 @@ NitrokeyOathDevice::NitrokeyOathDevice(const QString &deviceId,
                                      const QByteArray &challenge,
                                      bool requiresPassword,
                                      SCARDCONTEXT context,
+                                     const std::optional<ExtendedDeviceInfo> &knownInfo,
                                      QObject *parent)
     : OathDevice(parent)
 {
@@ -56,8 +57,6 @@ NitrokeyOathDevice::NitrokeyOathDevice(const QString &deviceId,
             this, &NitrokeyOathDevice::touchRequired);
     connect(m_session.get(), &NitrokeyOathSession::errorOccurred,
             this, &NitrokeyOathDevice::errorOccurred);
-    connect(m_session.get(), &NitrokeyOathSession::cardResetDetected,
-            this, &NitrokeyOathDevice::onCardResetDetected);
 
     // Initialize OATH session immediately (following Yubico yubikey-manager pattern)
     // This ensures the session is active and ready for CALCULATE ALL without
@@ -73,7 +72,7 @@ NitrokeyOathDevice::NitrokeyOathDevice(const QString &deviceId,
 
     // Get extended device information (model, serial number, form factor)
     // Nitrokey uses SELECT command (0x79 tag) for firmware and serial
-    auto extResult = m_session->getExtendedDeviceInfo(m_readerName);
+    auto extResult = resolveExtendedDeviceInfo(knownInfo);
     if (extResult.isError()) {
         qCWarning(YubiKeyOathDeviceLog) << "Failed to get extended device info:" << extResult.error();
         // Fallback to Nitrokey-specific model detection from reader name + firmware
@@ -142,6 +141,9 @@ NitrokeyOathDevice::~NitrokeyOathDevice()
         }
     }
 
+    // A card reset recovery queued on the PC/SC worker pool uses the card handle too
+    cancelCardResetRecovery();
+
     // Disconnect from card
     if (m_cardHandle != 0) {
         qCDebug(YubiKeyOathDeviceLog) << "Disconnecting card handle for device" << m_deviceId;
@@ -152,8 +154,7 @@ NitrokeyOathDevice::~NitrokeyOathDevice()
 
 // NOTE: OATH Operations (generateCode, authenticateWithPassword, addCredential,
 // deleteCredential, changePassword, setPassword, updateCredentialCacheAsync,
-// cancelPendingOperation, onReconnectResult, onCardResetDetected,
-// fetchCredentialsSync, reconnectCardHandle) are now implemented in
+// cancelPendingOperation, fetchCredentialsSync, reconnectCardHandle) are now implemented in
 // OathDevice base class using polymorphic m_session and factory pattern
 
 
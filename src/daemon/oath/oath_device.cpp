@@ -6,10 +6,14 @@
 #include "oath_device.h"
 #include "oath_error_codes.h"
 #include "yk_oath_session.h"
+#include "card_reset_recovery.h"
 #include "../logging_categories.h"
 #include "../pcsc/card_transaction.h"
+#include "../infrastructure/pcsc_worker_pool.h"
 #include "shared/types/device_state.h"
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QMutexLocker>
 #include <QThread>
 #include <QtConcurrent>
@@ -17,6 +21,9 @@
 // C++ standard library for timeout support
 #include <future>
 #include <chrono>
+#include <algorithm>
+#include <utility>
+#include <cstring>
 
 // PC/SC includes
 #ifdef __APPLE__
@@ -31,6 +38,18 @@ namespace Daemon {
 
 namespace {
 
+/// Upper bound for reconnecting after a card reset
+constexpr qint64 RECONNECT_TIMEOUT_MS = 5000;
+
+/// Longest wait for a reader state change before a usable card is retried
+constexpr qint64 RECONNECT_STATE_WAIT_MS = 250;
+
+bool isMainThread()
+{
+    const auto *app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
 /**
  * @brief SCardConnect with timeout support
  * @param context PC/SC context
@@ -77,10 +96,102 @@ LONG SCardConnectWithTimeout(SCARDCONTEXT context,
 // Constructor and destructor must be in .cpp for Qt MOC to generate vtable
 OathDevice::OathDevice(QObject *parent)
     : QObject(parent)
+    , m_recoveryToken(std::make_shared<RecoveryToken>(this))
+{
+}
+
+OathDevice::~OathDevice()
+{
+    // Derived destructors already cancelled before releasing the card handle
+    cancelCardResetRecovery();
+}
+
+// ============================================================================
+// Card Reset Recovery
+// ============================================================================
+
+template<typename Operation>
+auto OathDevice::withCardResetRecovery(Operation &&operation) -> decltype(operation())
+{
+    // Session refuses APDUs after a reset, so the operation failed fast and
+    // released m_cardMutex - reconnect, then run it again from the start
+    return runWithCardResetRecovery(
+        std::forward<Operation>(operation),
+        [this]() { return m_session->isCardResetPending(); },
+        [this]() {
+            if (!recoverFromCardReset()) {
+                return false;
+            }
+            qCInfo(YubiKeyOathDeviceLog) << "Re-running operation on device" << m_deviceId << "after card reset";
+            return true;
+        });
+}
+
+bool OathDevice::recoverFromCardReset()
+{
+    // Reconnecting may block for up to RECONNECT_TIMEOUT_MS - never on the main thread
+    if (isMainThread()) {
+        scheduleCardResetRecovery();
+        return false;
+    }
+    return reconnectAfterCardReset();
+}
+
+void OathDevice::scheduleCardResetRecovery()
+{
+    if (m_recoveryScheduled.exchange(true)) {
+        return;  // Already queued for this reset
+    }
+
+    qCInfo(YubiKeyOathDeviceLog) << "Card reset on main thread - recovering device" << m_deviceId
+                                 << "on the PC/SC worker pool";
+    // The job holds only the token - it may run after this device is gone
+    PcscWorkerPool::instance().submit(m_deviceId, [token = m_recoveryToken]() {
+        QMutexLocker locker(&token->mutex);  // NOLINT(misc-const-correctness)
+        if (!token->device) {
+            return;  // Device destroyed while the job was queued
+        }
+        token->device->reconnectAfterCardReset();
+        token->device->m_recoveryScheduled = false;
+    }, PcscOperationPriority::UserInteraction);
+}
+
+void OathDevice::cancelCardResetRecovery()
 {
+    // Blocks only while a recovery is running - reconnect gives up after RECONNECT_TIMEOUT_MS
+    QMutexLocker locker(&m_recoveryToken->mutex);  // NOLINT(misc-const-correctness)
+    m_recoveryToken->device = nullptr;
 }
 
-OathDevice::~OathDevice() = default;
+bool OathDevice::reconnectAfterCardReset()
+{
+    QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
+
+    // Another operation may have reconnected while we waited for the mutex
+    if (!m_session->isCardResetPending()) {
+        return true;
+    }
+
+    qCInfo(YubiKeyOathDeviceLog) << "Recovering device" << m_deviceId << "from card reset";
+    const auto result = reconnectCardHandleLocked(m_readerName);
+    if (result.isSuccess()) {
+        return true;
+    }
+
+    // Let the device manager keep trying in the background
+    locker.unlock();
+    Q_EMIT needsReconnect(m_deviceId, m_readerName, QByteArray());
+    return false;
+}
+
+CardTransaction OathDevice::beginTransaction(bool skipOathSelect)
+{
+    CardTransaction transaction(m_cardHandle, m_session.get(), skipOathSelect);
+    if (transaction.cardWasReset()) {
+        m_session->markCardReset();
+    }
+    return transaction;
+}
 
 // ============================================================================
 // State Management Implementation
@@ -152,6 +263,11 @@ void OathDevice::setPassword(const QString& password)
 // =============================================================================
 
 Result<QString> OathDevice::generateCode(const QString& name)
+{
+    return withCardResetRecovery([&]() { return generateCodeOnce(name); });
+}
+
+Result<QString> OathDevice::generateCodeOnce(const QString& name)
 {
     qCDebug(YubiKeyOathDeviceLog) << "generateCode() for" << name << "on device" << m_deviceId
                                   << "- credentials cache size:" << m_credentials.size();
@@ -185,7 +301,7 @@ Result<QString> OathDevice::generateCode(const QString& name)
     // Skip SELECT OATH when password is set - authenticate() does its own SELECT to get
     // a fresh challenge, so CardTransaction's SELECT would be redundant (saves ~100-500ms)
     const bool skipSelect = !m_password.isEmpty();
-    const CardTransaction transaction(m_cardHandle, m_session.get(), skipSelect);
+    const CardTransaction transaction = beginTransaction(skipSelect);
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return Result<QString>::error(transaction.errorMessage());
@@ -215,6 +331,11 @@ Result<QString> OathDevice::generateCode(const QString& name)
 }
 
 Result<void> OathDevice::authenticateWithPassword(const QString& password)
+{
+    return withCardResetRecovery([&]() { return authenticateWithPasswordOnce(password); });
+}
+
+Result<void> OathDevice::authenticateWithPasswordOnce(const QString& password)
 {
     qCDebug(YubiKeyOathDeviceLog) << "authenticateWithPassword() for device" << m_deviceId;
 
@@ -222,7 +343,7 @@ Result<void> OathDevice::authenticateWithPassword(const QString& password)
     QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
 
     // Begin PC/SC transaction with automatic SELECT OATH
-    const CardTransaction transaction(m_cardHandle, m_session.get());
+    const CardTransaction transaction = beginTransaction();
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return Result<void>::error(transaction.errorMessage());
@@ -238,6 +359,11 @@ Result<void> OathDevice::authenticateWithPassword(const QString& password)
 }
 
 Result<void> OathDevice::addCredential(const OathCredentialData &data)
+{
+    return withCardResetRecovery([&]() { return addCredentialOnce(data); });
+}
+
+Result<void> OathDevice::addCredentialOnce(const OathCredentialData &data)
 {
     qCDebug(YubiKeyOathDeviceLog) << "addCredential() for device" << m_deviceId
                                    << "credential:" << data.name;
@@ -246,7 +372,7 @@ Result<void> OathDevice::addCredential(const OathCredentialData &data)
     QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
 
     // Begin PC/SC transaction with automatic SELECT OATH
-    const CardTransaction transaction(m_cardHandle, m_session.get());
+    const CardTransaction transaction = beginTransaction();
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return Result<void>::error(transaction.errorMessage());
@@ -274,7 +400,181 @@ Result<void> OathDevice::addCredential(const OathCredentialData &data)
     return result;
 }
 
+QList<Result<void>> OathDevice::addCredentials(const QList<OathCredentialData> &credentials)
+{
+    return withCardResetRecovery([&]() { return addCredentialsOnce(credentials); });
+}
+
+QList<Result<void>> OathDevice::addCredentialsOnce(const QList<OathCredentialData> &credentials)
+{
+    qCDebug(YubiKeyOathDeviceLog) << "addCredentials() for device" << m_deviceId
+                                   << "count:" << credentials.size();
+
+    if (credentials.isEmpty()) {
+        return {};
+    }
+
+    // Serialize card access to prevent race conditions between threads
+    QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
+
+    const auto failAll = [&credentials](const Result<void> &error) {
+        return QList<Result<void>>(credentials.size(), error);
+    };
+
+    // Begin PC/SC transaction with automatic SELECT OATH - one for the whole batch
+    const CardTransaction transaction = beginTransaction();
+    if (!transaction.isValid()) {
+        qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
+        return failAll(Result<void>::error(transaction.errorMessage()));
+    }
+
+    // Authenticate once if password required
+    if (!m_password.isEmpty()) {
+        qCDebug(YubiKeyOathDeviceLog) << "Authenticating within transaction before adding credentials";
+        auto authResult = m_session->authenticate(m_password, m_deviceId);
+        if (authResult.isError()) {
+            qCWarning(YubiKeyOathDeviceLog) << "Authentication failed:" << authResult.error();
+            return failAll(authResult);
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    auto results = m_session->putCredentials(credentials);
+
+    const auto added = std::count_if(results.cbegin(), results.cend(),
+                                     [](const Result<void> &result) { return result.isSuccess(); });
+    qCDebug(YubiKeyOathDeviceLog) << "Added" << added << "of" << credentials.size()
+                                   << "credentials in" << timer.elapsed() << "ms";
+
+    if (added > 0) {
+        QList<OathCredentialData> written;
+        for (qsizetype i = 0; i < credentials.size(); ++i) {
+            if (results.at(i).isSuccess()) {
+                written.append(credentials.at(i));
+            }
+        }
+        applyCredentialDiff(written, {});
+    }
+
+    return results;
+}
+
+QList<Result<void>> OathDevice::deleteCredentials(const QStringList &names)
+{
+    // Unlike PUT, DELETE is not idempotent: a re-run only sends what failed before the reset
+    BatchResend batch(names, [this](const QStringList &subset) { return deleteCredentialsOnce(subset); });
+    return withCardResetRecovery(batch);
+}
+
+QList<Result<void>> OathDevice::deleteCredentialsOnce(const QStringList &names)
+{
+    qCDebug(YubiKeyOathDeviceLog) << "deleteCredentials() for device" << m_deviceId
+                                   << "count:" << names.size();
+
+    if (names.isEmpty()) {
+        return {};
+    }
+
+    // Serialize card access to prevent race conditions between threads
+    QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
+
+    const auto failAll = [&names](const Result<void> &error) {
+        return QList<Result<void>>(names.size(), error);
+    };
+
+    // Begin PC/SC transaction with automatic SELECT OATH - one for the whole batch
+    const CardTransaction transaction = beginTransaction();
+    if (!transaction.isValid()) {
+        qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
+        return failAll(Result<void>::error(transaction.errorMessage()));
+    }
+
+    // Authenticate once if password required
+    if (!m_password.isEmpty()) {
+        qCDebug(YubiKeyOathDeviceLog) << "Authenticating within transaction before deleting credentials";
+        auto authResult = m_session->authenticate(m_password, m_deviceId);
+        if (authResult.isError()) {
+            qCWarning(YubiKeyOathDeviceLog) << "Authentication failed:" << authResult.error();
+            return failAll(authResult);
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    auto results = m_session->deleteCredentials(names);
+
+    QStringList removed;
+    for (qsizetype i = 0; i < names.size(); ++i) {
+        if (results.at(i).isSuccess()) {
+            removed.append(names.at(i));
+        }
+    }
+    qCDebug(YubiKeyOathDeviceLog) << "Deleted" << removed.size() << "of" << names.size()
+                                   << "credentials in" << timer.elapsed() << "ms";
+
+    if (!removed.isEmpty()) {
+        applyCredentialDiff({}, removed);
+    }
+
+    return results;
+}
+
+void OathDevice::applyCredentialDiff(const QList<OathCredentialData> &added, const QStringList &removed)
+{
+    {
+        QMutexLocker locker(&m_credentialCacheMutex);  // NOLINT(misc-const-correctness)
+
+        // A running full fetch may have read the card before this batch - apply on top of its result
+        if (m_updateInProgress) {
+            qCDebug(YubiKeyOathDeviceLog) << "Full credential fetch in progress, queueing local diff";
+            m_pendingCredentialDiffs.append(CredentialDiff{added, removed});
+            return;
+        }
+
+        m_credentials = mergeCredentialDiff(m_credentials, added, removed);
+        qCDebug(YubiKeyOathDeviceLog) << "Applied local credential diff: +" << added.size()
+                                       << "-" << removed.size() << "=" << m_credentials.size() << "credentials";
+    }
+
+    Q_EMIT credentialsChanged();
+}
+
+QList<OathCredential> OathDevice::mergeCredentialDiff(QList<OathCredential> credentials,
+                                                      const QList<OathCredentialData> &added,
+                                                      const QStringList &removed) const
+{
+    credentials.removeIf([&removed](const OathCredential &cred) {
+        return removed.contains(cred.originalName);
+    });
+
+    // Same fields a CALCULATE ALL / LIST would report; codes are generated on demand
+    for (const auto &data : added) {
+        OathCredential cred;
+        cred.originalName = data.name;
+        cred.deviceId = m_deviceId;
+        cred.isTotp = (data.type == OathType::TOTP);
+        cred.type = data.type;
+        cred.algorithm = data.algorithm;
+        cred.digits = data.digits;
+        cred.requiresTouch = data.requireTouch;
+        OathProtocol::parseCredentialId(data.name, cred.isTotp, cred.period, cred.issuer, cred.account);
+
+        credentials.removeIf([&cred](const OathCredential &existing) {
+            return existing.originalName == cred.originalName;
+        });
+        credentials.append(cred);
+    }
+
+    return credentials;
+}
+
 Result<void> OathDevice::deleteCredential(const QString &name)
+{
+    return withCardResetRecovery([&]() { return deleteCredentialOnce(name); });
+}
+
+Result<void> OathDevice::deleteCredentialOnce(const QString &name)
 {
     qCDebug(YubiKeyOathDeviceLog) << "deleteCredential() for device" << m_deviceId
                                    << "credential:" << name;
@@ -283,7 +583,7 @@ Result<void> OathDevice::deleteCredential(const QString &name)
     QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
 
     // Begin PC/SC transaction with automatic SELECT OATH
-    const CardTransaction transaction(m_cardHandle, m_session.get());
+    const CardTransaction transaction = beginTransaction();
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return Result<void>::error(transaction.errorMessage());
@@ -312,6 +612,11 @@ Result<void> OathDevice::deleteCredential(const QString &name)
 }
 
 Result<void> OathDevice::changePassword(const QString &oldPassword, const QString &newPassword)
+{
+    return withCardResetRecovery([&]() { return changePasswordOnce(oldPassword, newPassword); });
+}
+
+Result<void> OathDevice::changePasswordOnce(const QString &oldPassword, const QString &newPassword)
 {
     qCDebug(YubiKeyOathDeviceLog) << "changePassword() for device" << m_deviceId;
 
@@ -319,7 +624,7 @@ Result<void> OathDevice::changePassword(const QString &oldPassword, const QStrin
     QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
 
     // Begin PC/SC transaction with automatic SELECT OATH
-    const CardTransaction transaction(m_cardHandle, m_session.get());
+    const CardTransaction transaction = beginTransaction();
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return Result<void>::error(transaction.errorMessage());
@@ -345,13 +650,15 @@ void OathDevice::updateCredentialCacheAsync(const QString& password)
 {
     qCDebug(YubiKeyOathDeviceLog) << "updateCredentialCacheAsync() for device" << m_deviceId;
 
-    if (m_updateInProgress) {
-        qCDebug(YubiKeyOathDeviceLog) << "Update already in progress";
-        return;
+    {
+        QMutexLocker locker(&m_credentialCacheMutex);  // NOLINT(misc-const-correctness)
+        if (m_updateInProgress) {
+            qCDebug(YubiKeyOathDeviceLog) << "Update already in progress";
+            return;
+        }
+        m_updateInProgress = true;
     }
 
-    m_updateInProgress = true;
-
     // Set state to FetchingCredentials if not already in error state
     if (state() != Shared::DeviceState::Error) {
         setState(Shared::DeviceState::FetchingCredentials);
@@ -382,16 +689,30 @@ void OathDevice::updateCredentialCacheAsync(const QString& password)
 
         // Update credentials cache BEFORE emitting signal
         // This ensures cache is populated when signal handlers execute and when getCredentials() is called
-        m_credentials = credentials;
-        qCDebug(YubiKeyOathDeviceLog) << "Updated credentials cache with" << credentials.size() << "credentials";
+        QList<OathCredential> merged = credentials;
+        {
+            QMutexLocker locker(&m_credentialCacheMutex);  // NOLINT(misc-const-correctness)
+
+            // Batch writes that finished during the fetch
+            const QList<CredentialDiff> pending = std::exchange(m_pendingCredentialDiffs, {});
+            for (const auto &diff : pending) {
+                merged = mergeCredentialDiff(merged, diff.added, diff.removed);
+            }
+            if (!pending.isEmpty()) {
+                qCDebug(YubiKeyOathDeviceLog) << "Applied" << pending.size() << "queued credential diffs to fetch result";
+            }
 
-        // Clear the update-in-progress flag
-        m_updateInProgress = false;
-        qCDebug(YubiKeyOathDeviceLog) << "Cleared updateInProgress flag";
+            m_credentials = merged;
+            qCDebug(YubiKeyOathDeviceLog) << "Updated credentials cache with" << merged.size() << "credentials";
+
+            // Clear the update-in-progress flag
+            m_updateInProgress = false;
+            qCDebug(YubiKeyOathDeviceLog) << "Cleared updateInProgress flag";
+        }
 
         // Emit signal AFTER cache is updated
         // Signal handlers in derived classes are now redundant but kept for backwards compatibility
-        Q_EMIT credentialCacheFetched(credentials);
+        Q_EMIT credentialCacheFetched(merged);
     });
 }
 
@@ -405,28 +726,12 @@ void OathDevice::cancelPendingOperation()
     m_session->cancelOperation();
 }
 
-void OathDevice::onReconnectResult(bool success)
+QList<OathCredential> OathDevice::fetchCredentialsSync(const QString& password)
 {
-    qCDebug(YubiKeyOathDeviceLog) << "onReconnectResult() for device" << m_deviceId
-             << "success:" << success;
-
-    // Forward result to session to unblock waiting sendApdu()
-    if (success) {
-        qCInfo(YubiKeyOathDeviceLog) << "Reconnect successful, emitting reconnectReady to session";
-        Q_EMIT m_session->reconnectReady();
-    } else {
-        qCWarning(YubiKeyOathDeviceLog) << "Reconnect failed, emitting reconnectFailed to session";
-        Q_EMIT m_session->reconnectFailed();
-    }
+    return withCardResetRecovery([&]() { return fetchCredentialsSyncOnce(password); });
 }
 
-void OathDevice::onCardResetDetected(const QByteArray &command)
-{
-    qCDebug(YubiKeyOathDeviceLog) << "Card reset detected, emitting needsReconnect for device" << m_deviceId;
-    Q_EMIT needsReconnect(m_deviceId, m_readerName, command);
-}
-
-QList<OathCredential> OathDevice::fetchCredentialsSync(const QString& password)
+QList<OathCredential> OathDevice::fetchCredentialsSyncOnce(const QString& password)
 {
     qCDebug(YubiKeyOathDeviceLog) << "fetchCredentialsSync() for device" << m_deviceId;
     if (password.isEmpty()) {
@@ -444,7 +749,7 @@ QList<OathCredential> OathDevice::fetchCredentialsSync(const QString& password)
     QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
 
     // Begin PC/SC transaction with automatic SELECT OATH
-    const CardTransaction transaction(m_cardHandle, m_session.get());
+    const CardTransaction transaction = beginTransaction();
     if (!transaction.isValid()) {
         qCWarning(YubiKeyOathDeviceLog) << "Transaction failed:" << transaction.errorMessage();
         return {};
@@ -496,74 +801,126 @@ QList<OathCredential> OathDevice::fetchCredentialsSync(const QString& password)
 }
 
 Result<void> OathDevice::reconnectCardHandle(const QString &readerName)
+{
+    // Nothing holds m_cardMutex while waiting for a reconnect, so this is safe from any thread
+    QMutexLocker locker(&m_cardMutex);  // NOLINT(misc-const-correctness) - QMutexLocker destructor unlocks
+    return reconnectCardHandleLocked(readerName);
+}
+
+Result<void> OathDevice::reconnectCardHandleLocked(const QString &readerName)
 {
     qCDebug(YubiKeyOathDeviceLog) << "reconnectCardHandle() for device" << m_deviceId
              << "reader:" << readerName;
 
-    // NOTE: No mutex lock here - safe because:
-    // 1. Only called from main thread (onReconnectTimer)
-    // 2. Background thread waits in loop.exec() for reconnectReady signal, doesn't use m_cardHandle
-    // 3. Using mutex here would cause DEADLOCK (background thread holds mutex while waiting)
+    QElapsedTimer timer;
+    timer.start();
 
-    // 1. Disconnect old card handle to free PC/SC resource
+    // 1. SCardReconnect on the existing handle - acknowledges the reset without
+    //    a new connection (typical case: another application reset the card)
     if (m_cardHandle != 0) {
-        qCDebug(YubiKeyOathDeviceLog) << "Disconnecting old card handle";
+        DWORD activeProtocol = 0;
+        const LONG result = SCardReconnect(m_cardHandle, SCARD_SHARE_SHARED,
+                                           SCARD_PROTOCOL_T0 | SCARD_PROTOCOL_T1,
+                                           SCARD_LEAVE_CARD, &activeProtocol);
+        if (result == SCARD_S_SUCCESS && adoptCardHandle(m_cardHandle, activeProtocol)) {
+            qCInfo(YubiKeyOathDeviceLog) << "Card handle reconnected (SCardReconnect) in"
+                                         << timer.elapsed() << "ms";
+            return Result<void>::success();
+        }
+
+        qCDebug(YubiKeyOathDeviceLog) << "SCardReconnect failed:" << QString::number(result, 16)
+                                      << "- falling back to full connect";
         SCardDisconnect(m_cardHandle, SCARD_LEAVE_CARD);
         m_cardHandle = 0;
     }
 
-    // 2. Exponential backoff reconnect attempts
-    static constexpr int delays[] = {100, 200, 400, 800, 1600, 3000};  // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
-    const int maxAttempts = 6;
+    // 2. Full connect, driven by reader state changes instead of fixed delays.
+    //    Own context: a blocking SCardGetStatusChange() locks its context, and
+    //    m_context is shared with the other devices.
+    SCARDCONTEXT waitContext = 0;
+    if (SCardEstablishContext(SCARD_SCOPE_SYSTEM, nullptr, nullptr, &waitContext) != SCARD_S_SUCCESS) {
+        qCWarning(YubiKeyOathDeviceLog) << "Cannot establish PC/SC context for reconnect";
+        return Result<void>::error(i18n("Failed to reconnect after multiple attempts"));
+    }
 
-    for (int attempt = 0; attempt < maxAttempts; attempt++) {
-        if (attempt > 0) {
-            qCDebug(YubiKeyOathDeviceLog) << "Reconnect attempt" << attempt
-                     << "after" << delays[attempt - 1] << "ms delay";
-            QThread::msleep(delays[attempt - 1]);
+    const QByteArray readerNameBytes = readerName.toUtf8();
+    SCARD_READERSTATE readerState;
+    memset(&readerState, 0, sizeof(readerState));
+    readerState.szReader = readerNameBytes.constData();
+    readerState.dwCurrentState = SCARD_STATE_UNAWARE;  // First call returns the current state at once
+
+    bool cardUsable = false;
+    int attempts = 0;
+    while (timer.elapsed() < RECONNECT_TIMEOUT_MS) {
+        const auto waitMs = static_cast<DWORD>(std::min<qint64>(RECONNECT_STATE_WAIT_MS,
+                                                                RECONNECT_TIMEOUT_MS - timer.elapsed()));
+        const LONG waitResult = SCardGetStatusChange(waitContext, waitMs, &readerState, 1);
+        if (waitResult == SCARD_S_SUCCESS) {
+            readerState.dwCurrentState = readerState.dwEventState & ~SCARD_STATE_CHANGED;
+            const DWORD state = readerState.dwEventState;
+            cardUsable = (state & SCARD_STATE_PRESENT) && !(state & (SCARD_STATE_MUTE | SCARD_STATE_EXCLUSIVE));
+            qCDebug(YubiKeyOathDeviceLog) << "Reader state:" << QString::number(state, 16)
+                                          << "usable:" << cardUsable;
+        } else if (waitResult != SCARD_E_TIMEOUT) {
+            qCWarning(YubiKeyOathDeviceLog) << "SCardGetStatusChange failed:" << QString::number(waitResult, 16);
+            break;
         }
 
+        // No card, or held exclusively by another application: wait for the next change.
+        // A usable card whose connect failed is retried once per wait slice.
+        if (!cardUsable) {
+            continue;
+        }
+
+        ++attempts;
         SCARDHANDLE newHandle = 0;
         DWORD activeProtocol = 0;
         const LONG result = SCardConnectWithTimeout(m_context,
-                                              readerName.toUtf8().constData(),
+                                              readerNameBytes.constData(),
                                               SCARD_SHARE_SHARED,
                                               SCARD_PROTOCOL_T0 | SCARD_PROTOCOL_T1,
                                               &newHandle, &activeProtocol,
                                               2000);  // 2 second timeout
 
-        if (result == SCARD_S_SUCCESS) {
-            qCDebug(YubiKeyOathDeviceLog) << "SCardConnect successful, handle:" << newHandle;
-
-            // 3. SELECT OATH applet to verify functionality
-            // Use factory method to create brand-specific session
-            auto tempSession = createTempSession(newHandle, activeProtocol);
-            QByteArray challenge;
-            Version firmwareVersion;  // Not used in reconnect verification
-            auto selectResult = tempSession->selectOathApplication(challenge, firmwareVersion);
-
-            if (selectResult.isSuccess()) {
-                qCInfo(YubiKeyOathDeviceLog) << "OATH SELECT successful, updating card handle";
-
-                // 4. Update handle in existing session without destroying it
-                m_cardHandle = newHandle;
-                m_session->updateCardHandle(newHandle, activeProtocol);
-
-                qCInfo(YubiKeyOathDeviceLog) << "Card handle reconnected successfully";
-                return Result<void>::success();
-            } else {
-                qCWarning(YubiKeyOathDeviceLog) << "OATH SELECT failed:" << selectResult.error();
-                SCardDisconnect(newHandle, SCARD_LEAVE_CARD);
-            }
-        } else {
+        if (result != SCARD_S_SUCCESS) {
             qCDebug(YubiKeyOathDeviceLog) << "SCardConnect failed:" << QString::number(result, 16);
+            continue;
+        }
+
+        if (adoptCardHandle(newHandle, activeProtocol)) {
+            SCardReleaseContext(waitContext);
+            qCInfo(YubiKeyOathDeviceLog) << "Card handle reconnected (SCardConnect) in"
+                                         << timer.elapsed() << "ms," << attempts << "attempt(s)";
+            return Result<void>::success();
         }
+        SCardDisconnect(newHandle, SCARD_LEAVE_CARD);
     }
 
-    qCWarning(YubiKeyOathDeviceLog) << "Failed to reconnect after" << maxAttempts << "attempts";
+    SCardReleaseContext(waitContext);
+    qCWarning(YubiKeyOathDeviceLog) << "Failed to reconnect within" << timer.elapsed() << "ms,"
+                                    << attempts << "connect attempt(s)";
     return Result<void>::error(i18n("Failed to reconnect after multiple attempts"));
 }
 
+bool OathDevice::adoptCardHandle(SCARDHANDLE handle, DWORD protocol)
+{
+    // SELECT OATH applet to verify functionality (brand-specific session via factory method)
+    auto tempSession = createTempSession(handle, protocol);
+    QByteArray challenge;
+    Version firmwareVersion;  // Not used in reconnect verification
+    const auto selectResult = tempSession->selectOathApplication(challenge, firmwareVersion);
+    if (selectResult.isError()) {
+        qCWarning(YubiKeyOathDeviceLog) << "OATH SELECT failed:" << selectResult.error();
+        return false;
+    }
+
+    // Update handle in existing session without destroying it (clears the reset state)
+    m_cardHandle = handle;
+    m_protocol = protocol;
+    m_session->updateCardHandle(handle, protocol);
+    return true;
+}
+
 void OathDevice::setSessionRateLimitMs(qint64 intervalMs)
 {
     if (m_session) {
@@ -572,5 +929,20 @@ void OathDevice::setSessionRateLimitMs(qint64 intervalMs)
     }
 }
 
+Result<ExtendedDeviceInfo> OathDevice::resolveExtendedDeviceInfo(const std::optional<ExtendedDeviceInfo> &knownInfo)
+{
+    if (knownInfo.has_value()) {
+        qCInfo(YubiKeyOathDeviceLog) << "Reusing extended device info for" << m_deviceId
+                                     << "- probe chain skipped, saved" << knownInfo->probeApduCount << "APDUs";
+        return Result<ExtendedDeviceInfo>::success(*knownInfo);
+    }
+
+    auto result = m_session->getExtendedDeviceInfo(m_readerName);
+    if (result.isSuccess()) {
+        m_probedDeviceInfo = result.value();
+    }
+    return result;
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
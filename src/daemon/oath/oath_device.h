@@ -9,7 +9,9 @@
 #include <QString>
 #include <QList>
 #include <QMutex>
+#include <atomic>
 #include <memory>
+#include <optional>
 #include "types/oath_credential.h"
 #include "types/oath_credential_data.h"
 #include "types/device_state.h"
@@ -17,6 +19,7 @@
 #include "shared/types/device_model.h"
 #include "shared/utils/version.h"
 #include "../utils/secure_memory.h"
+#include "yk_oath_session.h"
 
 // PC/SC forward declarations
 #ifdef __APPLE__
@@ -30,8 +33,7 @@ namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
-// Forward declarations
-class YkOathSession;
+class CardTransaction;
 
 /**
  * @brief Abstract base class for OATH device implementations
@@ -93,16 +95,45 @@ public:
     void setErrorState(const QString &error);
 
     // OATH operations (implemented in base class using polymorphic m_session)
+    // If another application resets the card meanwhile, the operation is
+    // re-run once after the card handle was reconnected (see withCardResetRecovery()).
     virtual Result<QString> generateCode(const QString &name);
     virtual Result<void> authenticateWithPassword(const QString &password);
     virtual Result<void> addCredential(const OathCredentialData &data);
+
+    /**
+     * @brief Adds several credentials in one card transaction
+     * @param credentials Credentials to store
+     * @return One result per input credential, in input order
+     *
+     * One SELECT, one authentication and back-to-back PUTs (bulk import).
+     * Written credentials are added to the cache locally (no CALCULATE ALL).
+     */
+    virtual QList<Result<void>> addCredentials(const QList<OathCredentialData> &credentials);
     virtual Result<void> deleteCredential(const QString &name);
+
+    /**
+     * @brief Deletes several credentials in one card transaction
+     * @param names Credential names as stored on the device
+     * @return One result per input name, in input order
+     *
+     * One SELECT, one authentication and back-to-back DELETEs. Deleted
+     * credentials are dropped from the cache locally (no CALCULATE ALL).
+     */
+    virtual QList<Result<void>> deleteCredentials(const QStringList &names);
     virtual Result<void> changePassword(const QString &oldPassword, const QString &newPassword);
     virtual void setPassword(const QString &password);
     [[nodiscard]] virtual bool hasPassword() const { return !m_password.isEmpty(); }
     virtual void updateCredentialCacheAsync(const QString &password = QString());
     virtual void cancelPendingOperation();
-    virtual void onReconnectResult(bool success);
+
+    /**
+     * @brief Replaces the card handle after a card reset
+     * @param readerName PC/SC reader name
+     * @return Success once a new handle answered SELECT
+     *
+     * Takes the card mutex; may be called from any thread.
+     */
     virtual Result<void> reconnectCardHandle(const QString &readerName);
     virtual QList<OathCredential> fetchCredentialsSync(const QString &password = QString());
 
@@ -114,11 +145,30 @@ public:
      */
     void setSessionRateLimitMs(qint64 intervalMs);
 
+    /**
+     * @brief Extended device info probed during construction
+     * @return Probe result, or std::nullopt if the probe failed or known info was reused
+     *
+     * OathDeviceManager keeps this so the next connect of the same device
+     * can skip the Management/OTP/PIV probe chain.
+     */
+    [[nodiscard]] const std::optional<ExtendedDeviceInfo> &probedDeviceInfo() const { return m_probedDeviceInfo; }
+
 Q_SIGNALS:
     void touchRequired();
     void errorOccurred(const QString &error);
     void credentialsChanged();
     void credentialCacheFetched(const QList<OathCredential> &credentials);
+
+    /**
+     * @brief Emitted when the device could not reconnect after a card reset
+     * @param deviceId Device ID
+     * @param readerName PC/SC reader name
+     * @param command APDU that hit the reset (may be empty)
+     *
+     * The failed operation already returned its error; OathDeviceManager
+     * keeps trying in the background so later operations find the card usable.
+     */
     void needsReconnect(const QString &deviceId, const QString &readerName, const QByteArray &command);
 
     /**
@@ -131,15 +181,6 @@ Q_SIGNALS:
      */
     void stateChanged(Shared::DeviceState newState);
 
-protected Q_SLOTS:
-    /**
-     * @brief Handles cardResetDetected signal from session
-     * @param command APDU command that failed due to card reset
-     *
-     * Forwards the signal as needsReconnect with device information.
-     */
-    void onCardResetDetected(const QByteArray &command);
-
 protected:
     // Common member variables shared by all OATH device implementations
     // Moved from YubiKeyOathDevice and NitrokeyOathDevice to eliminate duplication
@@ -159,6 +200,7 @@ protected:
     DeviceModel m_deviceModel;
     quint32 m_serialNumber{0};
     quint8 m_formFactor{0};
+    std::optional<ExtendedDeviceInfo> m_probedDeviceInfo;  ///< Set only when the probe chain actually ran
 
     // Authentication state
     bool m_requiresPassword{false};
@@ -168,6 +210,14 @@ protected:
     QList<OathCredential> m_credentials;
     bool m_updateInProgress{false};
 
+    /// Local edits made while a full fetch runs, applied on top of its result
+    struct CredentialDiff {
+        QList<OathCredentialData> added;
+        QStringList removed;
+    };
+    QList<CredentialDiff> m_pendingCredentialDiffs;
+    QMutex m_credentialCacheMutex;  // Protects m_credentials writes, m_updateInProgress and m_pendingCredentialDiffs
+
     // Device state machine
     Shared::DeviceState m_state{Shared::DeviceState::Disconnected};
     QString m_lastError;
@@ -175,11 +225,63 @@ protected:
 
     // Thread safety
     QMutex m_cardMutex;
+    std::atomic<bool> m_recoveryScheduled{false};  ///< Card reset recovery queued on the PC/SC worker pool
+
+    /**
+     * @brief Shared between the device and its queued card reset recovery
+     *
+     * The recovery job holds the mutex while it runs and does nothing once
+     * device is cleared, so it never touches a destroyed device.
+     */
+    struct RecoveryToken {
+        explicit RecoveryToken(OathDevice *owner) : device(owner) {}
+        QMutex mutex;
+        OathDevice *device;
+    };
+    std::shared_ptr<RecoveryToken> m_recoveryToken;
+
+    /**
+     * @brief Detaches a queued card reset recovery from this device
+     *
+     * A job that has not started yet becomes a no-op; a running one is waited
+     * for. Derived destructors call this before releasing the card handle.
+     */
+    void cancelCardResetRecovery();
 
     // OATH session (polymorphic base type)
     // Each derived class provides brand-specific session implementation
     std::unique_ptr<YkOathSession> m_session;
 
+    /**
+     * @brief Returns extended device info, probing the device only if needed
+     * @param knownInfo Info persisted from an earlier probe of this device (fingerprint already matched)
+     * @return knownInfo if set, otherwise the result of YkOathSession::getExtendedDeviceInfo()
+     *
+     * Successful probes are stored in m_probedDeviceInfo. Must be called after
+     * the session was created and the OATH application selected.
+     */
+    Result<ExtendedDeviceInfo> resolveExtendedDeviceInfo(const std::optional<ExtendedDeviceInfo> &knownInfo);
+
+    /**
+     * @brief Updates the credential cache after batch writes without re-fetching
+     * @param added Credentials written to the device (names as stored)
+     * @param removed Names deleted from the device
+     *
+     * Emits credentialsChanged(). While a full fetch is in progress the diff
+     * is queued and applied to the fetch result when it completes, whether
+     * the fetch read the card before or after this batch.
+     */
+    void applyCredentialDiff(const QList<OathCredentialData> &added, const QStringList &removed);
+
+    /**
+     * @brief Returns @p credentials with a diff applied (removals first, then additions)
+     *
+     * Idempotent: additions replace entries of the same name.
+     */
+    QList<OathCredential> mergeCredentialDiff(QList<OathCredential> credentials,
+                                              const QList<OathCredentialData> &added,
+                                              const QStringList &removed) const;
+
     /**
      * @brief Factory method for creating temporary session during reconnect
      *
@@ -193,6 +295,75 @@ protected:
     virtual std::unique_ptr<YkOathSession> createTempSession(
         SCARDHANDLE handle,
         DWORD protocol) = 0;
+
+private:
+    /**
+     * @brief Runs a card operation, re-running it once after a card reset
+     * @param operation Operation body (locks m_cardMutex itself)
+     * @return Result of the last run
+     *
+     * A reset makes the session refuse APDUs, so the operation fails fast and
+     * releases the mutex. The handle is then reconnected and the operation
+     * runs again from the start (new transaction, SELECT and authentication).
+     * Nothing waits on an event loop, and other devices are never involved.
+     * See runWithCardResetRecovery().
+     */
+    template<typename Operation>
+    auto withCardResetRecovery(Operation &&operation) -> decltype(operation());
+
+    /**
+     * @brief Recovers from a card reset seen by the session
+     * @return true if the card is usable again and the operation may re-run
+     *
+     * Off the main thread the handle is reconnected inline. On the main thread
+     * the reconnect is queued on the PC/SC worker pool instead and false is
+     * returned, so the operation fails fast rather than blocking the UI.
+     */
+    bool recoverFromCardReset();
+
+    /**
+     * @brief Queues reconnectAfterCardReset() on the PC/SC worker pool (once per reset)
+     */
+    void scheduleCardResetRecovery();
+
+    /**
+     * @brief Reconnects the card handle if the session saw a reset
+     * @return true if the card is usable again
+     *
+     * Emits needsReconnect() on failure.
+     */
+    bool reconnectAfterCardReset();
+
+    /**
+     * @brief Begins a transaction, recording a card reset reported by PC/SC
+     * @param skipOathSelect See CardTransaction
+     */
+    CardTransaction beginTransaction(bool skipOathSelect = false);
+
+    /**
+     * @brief reconnectCardHandle() body; caller holds m_cardMutex
+     *
+     * Tries SCardReconnect() on the current handle first. Otherwise waits for
+     * a usable card with SCardGetStatusChange() and connects again, for at
+     * most 5 seconds.
+     */
+    Result<void> reconnectCardHandleLocked(const QString &readerName);
+
+    /**
+     * @brief Verifies a handle with SELECT OATH and installs it in the session
+     * @return false if SELECT failed (handle left untouched)
+     */
+    bool adoptCardHandle(SCARDHANDLE handle, DWORD protocol);
+
+    // Single attempt of each public operation (see withCardResetRecovery())
+    Result<QString> generateCodeOnce(const QString &name);
+    Result<void> authenticateWithPasswordOnce(const QString &password);
+    Result<void> addCredentialOnce(const OathCredentialData &data);
+    QList<Result<void>> addCredentialsOnce(const QList<OathCredentialData> &credentials);
+    Result<void> deleteCredentialOnce(const QString &name);
+    QList<Result<void>> deleteCredentialsOnce(const QStringList &names);
+    Result<void> changePasswordOnce(const QString &oldPassword, const QString &newPassword);
+    QList<OathCredential> fetchCredentialsSyncOnce(const QString &password);
 };
 
 } // namespace Daemon
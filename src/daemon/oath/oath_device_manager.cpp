@@ -45,7 +45,6 @@ using namespace YubiKeyOath::Shared;
 OathDeviceManager::OathDeviceManager(QObject* parent)
     : QObject(parent)
     , m_readerMonitor(new CardReaderMonitor(this))
-    , m_reconnectCoordinator(std::make_unique<DeviceReconnectCoordinator>(this))
 {
     qCDebug(OathDeviceManagerLog) << "Constructor called";
 
@@ -66,12 +65,6 @@ OathDeviceManager::OathDeviceManager(QObject* parent)
     // Connect async credential cache fetching
     connect(this, &OathDeviceManager::credentialCacheFetchedForDevice,
             this, &OathDeviceManager::onCredentialCacheFetchedForDevice);
-
-    // Forward reconnect coordinator signals
-    connect(m_reconnectCoordinator.get(), &DeviceReconnectCoordinator::reconnectStarted,
-            this, &OathDeviceManager::reconnectStarted);
-    connect(m_reconnectCoordinator.get(), &DeviceReconnectCoordinator::reconnectCompleted,
-            this, &OathDeviceManager::reconnectCompleted);
 }
 
 OathDeviceManager::~OathDeviceManager() {
@@ -259,8 +252,19 @@ QString OathDeviceManager::connectToDevice(const QString &readerName) {
                                      << ", firmware:" << firmwareVersion.toString()
                                      << ", hasSelectSerial:" << hasSelectSerial << ")";
 
+    // Reuse extended info from an earlier probe if the SELECT fingerprint still matches
+    const std::optional<ExtendedDeviceInfo> knownInfo = m_knownDeviceInfo.lookup(deviceId, firmwareVersion);
+
     // Create brand-specific device instance using factory
-    auto devicePtr = createDevice(finalBrand, deviceId, readerName, cardHandle, protocol, challenge, requiresPassword);
+    auto devicePtr = createDevice(finalBrand, deviceId, readerName, cardHandle, protocol, challenge, requiresPassword, knownInfo);
+
+    if (devicePtr->probedDeviceInfo().has_value()) {
+        m_knownDeviceInfo.remember(deviceId, firmwareVersion, *devicePtr->probedDeviceInfo());
+    } else if (knownInfo.has_value()) {
+        const qint64 totalSaved = m_knownDeviceInfo.recordReuse(*knownInfo);
+        qCInfo(OathDeviceManagerLog) << "Skipped extended info probe for" << deviceId
+                                     << "- total probe APDUs saved:" << totalSaved;
+    }
 
     // Get raw pointer for signal connections (before moving ownership to map)
     OathDevice* const device = devicePtr.get();
@@ -284,16 +288,9 @@ QString OathDeviceManager::connectToDevice(const QString &readerName) {
     qWarning() << "OathDeviceManager: credentialCacheFetched connection" << (connected ? "SUCCEEDED" : "FAILED")
                << "for device:" << deviceId << "device ptr:" << device;
 
-    // Connect reconnect signals for card reset handling
+    // Background reconnect when the device could not recover from a card reset itself
     connect(device, &OathDevice::needsReconnect,
             this, &OathDeviceManager::reconnectDeviceAsync);
-    connect(this, &OathDeviceManager::reconnectCompleted,
-            device, [device, deviceId](const QString &reconnectedDeviceId, bool success) {
-        // Only forward to this device if the reconnect was for this device
-        if (reconnectedDeviceId == deviceId) {
-            device->onReconnectResult(success);
-        }
-    });
 
     // Critical section: add to device map
     {
@@ -344,6 +341,12 @@ void OathDeviceManager::disconnectDevice(const QString &deviceId) {
     }
     // Lock released here, device already deleted by unique_ptr
 
+    // Pending reconnect of the removed device is pointless now. Coordinators
+    // live on the main thread, and connectToDevice() may get here from a worker.
+    QMetaObject::invokeMethod(this, [this, deviceId]() {
+        delete m_reconnectCoordinators.take(deviceId);  // Destructor cancels
+    }, Qt::QueuedConnection);
+
     // Emit device disconnected signal
     Q_EMIT deviceDisconnected(deviceId);
     qCDebug(OathDeviceManagerLog) << "Emitted deviceDisconnected signal for" << deviceId;
@@ -561,6 +564,8 @@ void OathDeviceManager::removeDeviceFromMemory(const QString &deviceId)
 {
     qCDebug(OathDeviceManagerLog) << "removeDeviceFromMemory() called for device:" << deviceId;
 
+    m_knownDeviceInfo.forget(deviceId);
+
     bool wasInCache = false;
     int remainingDevices = 0;
 
@@ -613,19 +618,29 @@ void OathDeviceManager::reconnectDeviceAsync(const QString &deviceId, const QStr
     qCDebug(OathDeviceManagerLog) << "reconnectDeviceAsync() called for device" << deviceId
              << "reader:" << readerName << "command length:" << command.length();
 
-    // Set up reconnect function that will be called by coordinator
-    m_reconnectCoordinator->setReconnectFunction(
-        [this, deviceId](const QString &reader) -> Result<void> {
-            auto *const device = getDevice(deviceId);
-            if (!device) {
-                qCWarning(OathDeviceManagerLog) << "Device" << deviceId << "no longer exists";
-                return Result<void>::error(QStringLiteral("Device no longer exists"));
-            }
-            return device->reconnectCardHandle(reader);
-        });
+    // One coordinator per device: a reset of one key never cancels or delays
+    // the reconnect of another
+    DeviceReconnectCoordinator *coordinator = m_reconnectCoordinators.value(deviceId);
+    if (!coordinator) {
+        coordinator = new DeviceReconnectCoordinator(this);
+        coordinator->setReconnectFunction(
+            [this, deviceId](const QString &reader) -> Result<void> {
+                auto *const device = getDevice(deviceId);
+                if (!device) {
+                    qCWarning(OathDeviceManagerLog) << "Device" << deviceId << "no longer exists";
+                    return Result<void>::error(QStringLiteral("Device no longer exists"));
+                }
+                return device->reconnectCardHandle(reader);
+            });
+        connect(coordinator, &DeviceReconnectCoordinator::reconnectStarted,
+                this, &OathDeviceManager::reconnectStarted);
+        connect(coordinator, &DeviceReconnectCoordinator::reconnectCompleted,
+                this, &OathDeviceManager::reconnectCompleted);
+        m_reconnectCoordinators.insert(deviceId, coordinator);
+    }
 
     // Start reconnection (coordinator handles timing and signals)
-    m_reconnectCoordinator->startReconnect(deviceId, readerName, command);
+    coordinator->startReconnect(deviceId, readerName, command);
 }
 
 // Factory Methods (private)
@@ -656,7 +671,8 @@ std::unique_ptr<OathDevice> OathDeviceManager::createDevice(
     SCARDHANDLE cardHandle,
     DWORD protocol,
     const QByteArray &challenge,
-    bool requiresPassword)
+    bool requiresPassword,
+    const std::optional<ExtendedDeviceInfo> &knownInfo)
 {
     using namespace YubiKeyOath::Shared;
 
@@ -665,7 +681,7 @@ std::unique_ptr<OathDevice> OathDeviceManager::createDevice(
     case DeviceBrand::Nitrokey:
         device = std::make_unique<NitrokeyOathDevice>(
             deviceId, readerName, cardHandle, protocol,
-            challenge, requiresPassword, m_context, this);
+            challenge, requiresPassword, m_context, knownInfo, this);
         break;
 
     case DeviceBrand::YubiKey:
@@ -673,7 +689,7 @@ std::unique_ptr<OathDevice> OathDeviceManager::createDevice(
     default:
         device = std::make_unique<YubiKeyOathDevice>(
             deviceId, readerName, cardHandle, protocol,
-            challenge, requiresPassword, m_context, this);
+            challenge, requiresPassword, m_context, knownInfo, this);
         break;
     }
 
@@ -689,6 +705,13 @@ std::unique_ptr<OathDevice> OathDeviceManager::createDevice(
     return device;
 }
 
+void OathDeviceManager::rememberDeviceInfo(const QString &deviceId,
+                                            const Version &selectFirmware,
+                                            const ExtendedDeviceInfo &info)
+{
+    m_knownDeviceInfo.remember(deviceId, selectFirmware, info);
+}
+
 void OathDeviceManager::enumerateAndConnectDevicesAsync()
 {
     qCDebug(OathDeviceManagerLog) << "=== enumerateAndConnectDevicesAsync() START ===";
@@ -7,6 +7,7 @@
 
 // Qt includes
 #include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QObject>
@@ -15,12 +16,14 @@
 
 // STL includes
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 // Local includes
 #include "types/oath_credential.h"
 #include "types/device_state.h"
 #include "oath_device.h"
+#include "known_device_info_cache.h"
 #include "../pcsc/card_reader_monitor.h"
 #include "common/result.h"
 
@@ -91,6 +94,22 @@ public:
      */
     void setConfiguration(Shared::ConfigurationProvider *config);
 
+    /**
+     * @brief Remembers extended device info so reconnects can skip probing
+     * @param deviceId Device ID (from OATH SELECT)
+     * @param selectFirmware Firmware version reported by OATH SELECT (fingerprint)
+     * @param info Extended info (model, serial, form factor) to reuse
+     *
+     * While a connecting device reports the same ID and SELECT firmware, the
+     * Management/OTP/PIV probe chain is skipped and @p info is reused.
+     * Used to seed the cache from the database at startup; successful probes
+     * are remembered automatically. Entries without a serial number are ignored.
+     * @see KnownDeviceInfoCache::remember()
+     */
+    void rememberDeviceInfo(const QString &deviceId,
+                            const Version &selectFirmware,
+                            const ExtendedDeviceInfo &info);
+
     // Device lifecycle management
     /**
      * @brief Initializes PC/SC context (without starting monitoring)
@@ -181,16 +200,14 @@ public:
      * @brief Asynchronously reconnects to YubiKey after card reset
      * @param deviceId Device ID to reconnect
      * @param readerName PC/SC reader name to reconnect to
-     * @param command APDU command to retry after successful reconnect
+     * @param command APDU command that hit the reset (for logging)
      *
-     * This method handles card reset (SCARD_W_RESET_CARD) by performing:
-     * 1. Full disconnect of device (frees card handle)
-     * 2. Exponential backoff retry: 100ms, 200ms, 400ms, 800ms, 1600ms, 3000ms
-     * 3. Reconnect attempt on each timer tick
-     * 4. Emits reconnectCompleted(deviceId, success) when done
+     * Fallback for OathDevice::needsReconnect, i.e. when the operation that
+     * saw the reset (SCARD_W_RESET_CARD) could not reconnect the card itself.
+     * Each device has its own DeviceReconnectCoordinator, so a reset of one
+     * key never cancels or delays the reconnect of another.
      *
-     * The exponential backoff allows external apps (like ykman) to release
-     * the card before we retry connection.
+     * Emits reconnectStarted(deviceId), then reconnectCompleted(deviceId, success).
      */
     void reconnectDeviceAsync(const QString &deviceId, const QString &readerName, const QByteArray &command);
 
@@ -251,8 +268,7 @@ Q_SIGNALS:
      * @param success true if reconnect succeeded, false otherwise
      *
      * This signal is emitted after reconnectDeviceAsync() completes.
-     * Used to notify YubiKeyOathDevice::onReconnectResult() which forwards
-     * to OathSession to unblock waiting sendApdu().
+     * Used by OathService to update the reconnect notification.
      */
     void reconnectCompleted(const QString &deviceId, bool success);
 
@@ -380,6 +396,7 @@ private:
      * @param protocol PC/SC protocol
      * @param challenge Challenge from SELECT response
      * @param requiresPassword Password requirement flag
+     * @param knownInfo Remembered extended info (skips probing when set)
      * @return Brand-specific device instance (YubiKeyOathDevice or NitrokeyOathDevice)
      */
     std::unique_ptr<OathDevice> createDevice(Shared::DeviceBrand brand,
@@ -388,7 +405,8 @@ private:
                                             SCARDHANDLE cardHandle,
                                             DWORD protocol,
                                             const QByteArray &challenge,
-                                            bool requiresPassword);
+                                            bool requiresPassword,
+                                            const std::optional<ExtendedDeviceInfo> &knownInfo = std::nullopt);
 
     // Member variables
     CardReaderMonitor *m_readerMonitor;
@@ -407,8 +425,10 @@ private:
     SCARDCONTEXT m_context = 0;  ///< PC/SC context (shared by all devices)
     bool m_initialized = false;  ///< Tracks initialization state
 
-    // Reconnect coordinator (extracted from inline state management)
-    std::unique_ptr<DeviceReconnectCoordinator> m_reconnectCoordinator;
+    KnownDeviceInfoCache m_knownDeviceInfo;  ///< Remembered extended info (thread-safe, connects run in worker pool)
+
+    // Reconnect coordinators, one per device (owned via QObject parent, main thread only)
+    QHash<QString, DeviceReconnectCoordinator *> m_reconnectCoordinators;
 };
 } // namespace Daemon
 } // namespace YubiKeyOath
@@ -14,10 +14,9 @@
 #include <QMessageAuthenticationCode>
 #include <QRandomGenerator>
 #include <QDebug>
-#include <QEventLoop>
-#include <QTimer>
 #include <QDateTime>
 #include <QThread>
+#include <optional>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -51,17 +50,22 @@ YkOathSession::~YkOathSession()
 // PC/SC Communication
 // =============================================================================
 
-QByteArray YkOathSession::sendApdu(const QByteArray &command, int retryCount)
+QByteArray YkOathSession::sendApdu(const QByteArray &command)
 {
     qCDebug(YubiKeyOathDeviceLog) << "sendApdu() for device:" << m_deviceId
-             << "command:" << SecureLogging::safeApduInfo(command)
-             << "retryCount:" << retryCount;
+             << "command:" << SecureLogging::safeApduInfo(command);
 
     if (m_cardHandle == 0) {
         qCDebug(YubiKeyOathDeviceLog) << "Device" << m_deviceId << "not connected (invalid handle)";
         return {};
     }
 
+    // The handle is dead until the owner reconnects it - don't touch the card
+    if (m_cardResetPending) {
+        qCDebug(YubiKeyOathDeviceLog) << "Card reset pending for device" << m_deviceId << "- APDU not sent";
+        return {};
+    }
+
     // PC/SC rate limiting: configurable interval between operations
     // Default is 0 (no delay) for maximum performance.
     // Users experiencing communication errors with specific readers can increase this value.
@@ -100,60 +104,17 @@ QByteArray YkOathSession::sendApdu(const QByteArray &command, int retryCount)
     if (result != SCARD_S_SUCCESS) {
         qCDebug(YubiKeyOathDeviceLog) << "Failed to send APDU, error code:" << QString::number(result, 16);
 
-        // Handle card reset - emit signal and wait for reconnect result
-        if (result == SCARD_W_RESET_CARD && retryCount == 0) {
-            qCWarning(YubiKeyOathDeviceLog) << "Card reset detected (SCARD_W_RESET_CARD), emitting signal and waiting for reconnect";
-
-            // Emit signal to trigger reconnect workflow in upper layers
-            Q_EMIT cardResetDetected(command);
-
-            // Wait for reconnect result using QEventLoop
-            QEventLoop loop;
-            bool reconnectSuccess = false;
-
-            // Connect to signals from upper layer (YubiKeyOathDevice)
-            const QMetaObject::Connection connReady = connect(this, &YkOathSession::reconnectReady, &loop, [&]() {
-                qCInfo(YubiKeyOathDeviceLog) << "Received reconnectReady signal";
-                reconnectSuccess = true;
-                loop.quit();
-            });
-
-            const QMetaObject::Connection connFailed = connect(this, &YkOathSession::reconnectFailed, &loop, [&]() {
-                qCWarning(YubiKeyOathDeviceLog) << "Received reconnectFailed signal";
-                reconnectSuccess = false;
-                loop.quit();
-            });
-
-            // Set timeout (10 seconds) to prevent infinite waiting
-            QTimer::singleShot(10000, &loop, [&]() {
-                qCWarning(YubiKeyOathDeviceLog) << "Reconnect timeout after 10 seconds";
-                reconnectSuccess = false;
-                loop.quit();
-            });
-
-            qCDebug(YubiKeyOathDeviceLog) << "Waiting for reconnect result...";
-            loop.exec(); // Block here until signal or timeout
-
-            // Disconnect temporary connections
-            disconnect(connReady);
-            disconnect(connFailed);
-
-            if (reconnectSuccess) {
-                qCInfo(YubiKeyOathDeviceLog) << "Reconnect successful, retrying APDU";
-                // Retry the command with incremented retry count to prevent infinite recursion
-                return sendApdu(command, retryCount + 1);
-            } else {
-                qCWarning(YubiKeyOathDeviceLog) << "Reconnect failed or timeout, cannot retry APDU";
-                Q_EMIT errorOccurred(tr("Card reset and reconnect failed"));
-                return {};
-            }
+        // Card reset by another application: fail fast and let the owner reconnect.
+        // The operation is re-run by OathDevice once the handle is replaced.
+        if (result == SCARD_W_RESET_CARD) {
+            markCardReset(command);
+            return {};
         }
 
         // Check if card was removed/disconnected (non-recoverable errors)
         if (result == SCARD_W_REMOVED_CARD ||
-            result == SCARD_E_NO_SMARTCARD ||
-            result == SCARD_W_RESET_CARD) {
-            qCDebug(YubiKeyOathDeviceLog) << "Device" << m_deviceId << "was removed, disconnected, or reset (after retry)";
+            result == SCARD_E_NO_SMARTCARD) {
+            qCDebug(YubiKeyOathDeviceLog) << "Device" << m_deviceId << "was removed or disconnected";
         }
 
         Q_EMIT errorOccurred(tr("Failed to send APDU: 0x%1").arg(result, 0, 16));
@@ -489,8 +450,63 @@ Result<void> YkOathSession::putCredential(const OathCredentialData &data)
     qCDebug(YubiKeyOathDeviceLog) << "Sending PUT command, length:" << command.length();
 
     // Send command
-    const QByteArray response = sendApdu(command);
+    return putResponseToResult(sendApdu(command));
+}
+
+QList<Result<void>> YkOathSession::putCredentials(const QList<OathCredentialData> &credentials)
+{
+    qCDebug(YubiKeyOathDeviceLog) << "putCredentials() for device" << m_deviceId
+                                   << "count:" << credentials.size();
+
+    // Validate and encode everything up front - no card I/O between PUTs
+    QList<Result<void>> results;
+    QList<QByteArray> commands;
+    results.reserve(credentials.size());
+    commands.reserve(credentials.size());
+    for (const auto &data : credentials) {
+        const QString validationError = data.validate();
+        QByteArray command;
+        if (validationError.isEmpty()) {
+            command = OathProtocol::createPutCommand(data);
+        }
+
+        if (!validationError.isEmpty()) {
+            qCWarning(YubiKeyOathDeviceLog) << "Invalid credential data for" << data.name << ":" << validationError;
+            results.append(Result<void>::error(validationError));
+        } else if (command.isEmpty()) {
+            qCWarning(YubiKeyOathDeviceLog) << "Failed to create PUT command for" << data.name;
+            results.append(Result<void>::error(tr("Failed to encode credential data")));
+        } else {
+            results.append(Result<void>::success());
+        }
+        commands.append(command);
+    }
+
+    // Send back-to-back; stop at the first fatal condition (card full or gone)
+    std::optional<Result<void>> fatalError;
+    for (qsizetype i = 0; i < commands.size(); ++i) {
+        if (results.at(i).isError()) {
+            continue;
+        }
+        if (fatalError) {
+            results[i] = *fatalError;
+            continue;
+        }
+
+        const QByteArray response = sendApdu(commands.at(i));
+        results[i] = putResponseToResult(response);
+
+        if (response.isEmpty()
+            || OathProtocol::getStatusWord(response) == OathProtocol::SW_INSUFFICIENT_SPACE) {
+            fatalError = results.at(i);
+        }
+    }
+
+    return results;
+}
 
+Result<void> YkOathSession::putResponseToResult(const QByteArray &response) const
+{
     if (response.isEmpty()) {
         qCWarning(YubiKeyOathDeviceLog) << "Empty response from PUT command";
         return Result<void>::error(tr("No response from YubiKey"));
@@ -547,8 +563,45 @@ Result<void> YkOathSession::deleteCredential(const QString &name)
     qCDebug(YubiKeyOathDeviceLog) << "Sending DELETE command, length:" << command.length();
 
     // Send command
-    const QByteArray response = sendApdu(command);
+    return deleteResponseToResult(sendApdu(command));
+}
+
+QList<Result<void>> YkOathSession::deleteCredentials(const QStringList &names)
+{
+    qCDebug(YubiKeyOathDeviceLog) << "deleteCredentials() for device" << m_deviceId
+                                   << "count:" << names.size();
+
+    QList<Result<void>> results;
+    results.reserve(names.size());
+
+    // Send back-to-back; once the card stops responding the rest fail unsent
+    std::optional<Result<void>> fatalError;
+    for (const QString &name : names) {
+        if (fatalError) {
+            results.append(*fatalError);
+            continue;
+        }
+
+        const QByteArray command = name.isEmpty() ? QByteArray() : OathProtocol::createDeleteCommand(name);
+        if (command.isEmpty()) {
+            qCWarning(YubiKeyOathDeviceLog) << "Failed to create DELETE command for" << name;
+            results.append(Result<void>::error(name.isEmpty() ? tr("Credential name cannot be empty")
+                                                              : tr("Failed to encode credential name")));
+            continue;
+        }
+
+        const QByteArray response = sendApdu(command);
+        results.append(deleteResponseToResult(response));
+        if (response.isEmpty()) {
+            fatalError = results.constLast();
+        }
+    }
+
+    return results;
+}
 
+Result<void> YkOathSession::deleteResponseToResult(const QByteArray &response) const
+{
     if (response.isEmpty()) {
         qCWarning(YubiKeyOathDeviceLog) << "Empty response from DELETE command";
         return Result<void>::error(tr("No response from YubiKey"));
@@ -770,16 +823,28 @@ Result<ExtendedDeviceInfo> YkOathSession::getExtendedDeviceInfo(const QString &r
                                                     firmware, requiresPassword, serialNumber);
     };
 
-    // Create fetcher with dependencies
+    // Create fetcher with dependencies (sender counts APDUs so reuse can report savings)
+    int apduCount = 0;
     ExtendedDeviceInfoFetcher fetcher(
-        [this](const QByteArray &command) { return sendApdu(command); },
+        [this, &apduCount](const QByteArray &command) {
+            ++apduCount;
+            return sendApdu(command);
+        },
         parseSelectResponse,
         m_deviceId,
         m_selectSerialNumber,
         m_firmwareVersion
     );
 
-    return fetcher.fetch(readerName);
+    auto result = fetcher.fetch(readerName);
+    qCDebug(YubiKeyOathDeviceLog) << "Extended device info probe used" << apduCount << "APDUs";
+    if (result.isError()) {
+        return result;
+    }
+
+    ExtendedDeviceInfo info = result.value();
+    info.probeApduCount = apduCount;
+    return Result<ExtendedDeviceInfo>::success(info);
 }
 
 void YkOathSession::cancelOperation()
@@ -800,10 +865,21 @@ void YkOathSession::updateCardHandle(SCARDHANDLE newHandle, DWORD newProtocol)
 
     m_cardHandle = newHandle;
     m_protocol = newProtocol;
+    m_cardResetPending = false;
 
     qCDebug(YubiKeyOathDeviceLog) << "Card handle updated, session marked as inactive";
 }
 
+void YkOathSession::markCardReset(const QByteArray &command)
+{
+    if (m_cardResetPending.exchange(true)) {
+        return;  // Already reported for this handle
+    }
+
+    qCWarning(YubiKeyOathDeviceLog) << "Card reset detected (SCARD_W_RESET_CARD) for device" << m_deviceId
+                                    << "command length:" << command.length();
+}
+
 void YkOathSession::setRateLimitMs(qint64 intervalMs)
 {
     m_rateLimitMs = intervalMs;
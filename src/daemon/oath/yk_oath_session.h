@@ -5,11 +5,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <QByteArray>
 #include <QString>
 #include <QList>
 #include <QObject>
+#include <QStringList>
 #include "types/oath_credential.h"
 #include "types/oath_credential_data.h"
 #include "oath_protocol.h"
@@ -41,6 +43,7 @@ struct ExtendedDeviceInfo {
     YubiKeyModel deviceModel{0}; ///< Alias for model (for compatibility)
     quint32 serialNumber{0};    ///< Device serial number
     quint8 formFactor{0};       ///< Form factor code
+    int probeApduCount{0};      ///< APDUs spent by the probe chain (0 if reused from cache)
 };
 
 /**
@@ -69,9 +72,11 @@ struct ExtendedDeviceInfo {
  * Signals:
  * - touchRequired() - emitted when YubiKey requires physical touch (SW=0x6985)
  * - errorOccurred() - emitted when PC/SC communication fails
- * - cardResetDetected() - emitted when SCARD_W_RESET_CARD detected
- * - reconnectReady() - emitted by upper layer after successful reconnect
- * - reconnectFailed() - emitted by upper layer when reconnect fails
+ *
+ * Card reset:
+ * - After SCARD_W_RESET_CARD the session refuses further APDUs (they fail
+ *   immediately) until the owner installs a new handle with updateCardHandle()
+ * - The owner re-runs the interrupted operation; the session never waits
  */
 class YkOathSession : public QObject, public IOathSelector
 {
@@ -105,7 +110,32 @@ public:
     virtual Result<QList<OathCredential>> listCredentials();
     virtual Result<void> authenticate(const QString &password, const QString &deviceId);
     virtual Result<void> putCredential(const OathCredentialData &data);
+
+    /**
+     * @brief Writes several credentials back-to-back
+     * @param credentials Credentials to store
+     * @return One result per input credential, in input order
+     *
+     * All PUT commands are validated and encoded before the first one is sent,
+     * so the card is only touched for well-formed entries and the APDUs go out
+     * without per-item setup. Caller must hold the transaction and have
+     * authenticated (same contract as putCredential()). Once the card reports
+     * insufficient space or stops responding, the remaining entries fail
+     * without being sent.
+     */
+    virtual QList<Result<void>> putCredentials(const QList<OathCredentialData> &credentials);
     virtual Result<void> deleteCredential(const QString &name);
+
+    /**
+     * @brief Deletes several credentials back-to-back
+     * @param names Credential names as stored on the device
+     * @return One result per input name, in input order
+     *
+     * Same contract as deleteCredential() (caller holds the transaction and
+     * has authenticated). Once the card stops responding, the remaining
+     * names fail without being sent.
+     */
+    virtual QList<Result<void>> deleteCredentials(const QStringList &names);
     virtual Result<void> setPassword(const QString &newPassword, const QString &deviceId);
     virtual Result<void> removePassword();
     virtual Result<void> changePassword(const QString &oldPassword,
@@ -113,7 +143,32 @@ public:
                                 const QString &deviceId);
     virtual Result<ExtendedDeviceInfo> getExtendedDeviceInfo(const QString &readerName = QString());
     virtual void cancelOperation();
+
+    /**
+     * @brief Installs a new card handle, e.g. after a card reset
+     * @param newHandle PC/SC card handle (non-owning)
+     * @param newProtocol PC/SC protocol
+     *
+     * Clears the card-reset state.
+     */
     virtual void updateCardHandle(SCARDHANDLE newHandle, DWORD newProtocol);
+
+    /**
+     * @brief Checks whether the card was reset since the handle was installed
+     * @return true if APDUs are refused until updateCardHandle()
+     *
+     * Safe to call without holding the caller's card mutex.
+     */
+    [[nodiscard]] bool isCardResetPending() const { return m_cardResetPending; }
+
+    /**
+     * @brief Records a card reset seen outside sendApdu() (e.g. SCardBeginTransaction)
+     * @param command APDU that failed, if any (logged)
+     *
+     * Logs only the first report per handle; the owner polls isCardResetPending().
+     */
+    void markCardReset(const QByteArray &command = QByteArray());
+
     [[nodiscard]] virtual QString deviceId() const { return m_deviceId; }
     [[nodiscard]] virtual bool requiresPassword() const { return m_requiresPassword; }
     [[nodiscard]] virtual quint32 selectSerialNumber() const { return m_selectSerialNumber; }
@@ -148,38 +203,10 @@ Q_SIGNALS:
      */
     void errorOccurred(const QString &error);
 
-    /**
-     * @brief Emitted when card reset is detected (SCARD_W_RESET_CARD)
-     * @param command The APDU command that failed due to reset
-     *
-     * Triggered when external application (like ykman) resets the card.
-     * This signal initiates reconnect workflow through upper layers.
-     */
-    void cardResetDetected(const QByteArray &command);
-
-    /**
-     * @brief Emitted when reconnect completed successfully
-     *
-     * This signal is emitted by upper layer (YubiKeyOathDevice) after
-     * successful reconnect. YkOathSession waits for this in sendApdu()
-     * to retry the failed command.
-     */
-    void reconnectReady();
-
-    /**
-     * @brief Emitted when reconnect failed
-     *
-     * This signal is emitted by upper layer (YubiKeyOathDevice) when
-     * reconnect attempts fail. YkOathSession waits for this in sendApdu()
-     * to abort the operation.
-     */
-    void reconnectFailed();
-
 protected:
     /**
      * @brief Sends APDU command to device with chained response handling
      * @param command APDU command bytes
-     * @param retryCount Internal parameter for retry recursion guard (default 0)
      * @return Response data including status word, or empty on error
      *
      * Handles chained responses:
@@ -188,11 +215,11 @@ protected:
      * - Returns full data with final status word
      *
      * Handles card reset (SCARD_W_RESET_CARD):
-     * - Emits cardResetDetected() signal to trigger reconnect workflow
-     * - Retries command once after successful reconnect
-     * - Prevents infinite recursion with retryCount guard
+     * - Marks the session as reset (see markCardReset()) and returns empty
+     * - Later calls return empty without touching the card until
+     *   updateCardHandle(); nothing blocks or waits for the reconnect
      */
-    QByteArray sendApdu(const QByteArray &command, int retryCount = 0);
+    QByteArray sendApdu(const QByteArray &command);
 
     // Note: PBKDF2 derivation moved to PasswordDerivation::deriveKeyPbkdf2 utility.
     // See src/daemon/utils/password_derivation.h
@@ -207,6 +234,20 @@ protected:
      */
     bool reconnectCard();
 
+    /**
+     * @brief Maps a PUT response to a result
+     * @param response Raw response including status word (may be empty)
+     * @return Success, or user-visible error for the status word
+     */
+    Result<void> putResponseToResult(const QByteArray &response) const;
+
+    /**
+     * @brief Maps a DELETE response to a result
+     * @param response Raw response including status word (may be empty)
+     * @return Success, or user-visible error for the status word
+     */
+    Result<void> deleteResponseToResult(const QByteArray &response) const;
+
     // Protected member variables (accessible to derived classes)
     SCARDHANDLE m_cardHandle;  ///< PC/SC card handle (non-owning)
     DWORD m_protocol;          ///< PC/SC protocol (T=0 or T=1)
@@ -217,6 +258,7 @@ protected:
     std::unique_ptr<OathProtocol> m_oathProtocol;  ///< Brand-specific OATH protocol implementation
     qint64 m_lastPcscOperationTime = 0;  ///< Timestamp (ms since epoch) of last PC/SC operation for rate limiting
     qint64 m_rateLimitMs = 0;  ///< Configurable rate limit in ms (0 = no delay, default for max performance)
+    std::atomic<bool> m_cardResetPending{false};  ///< Card reset seen, APDUs refused until updateCardHandle()
 };
 
 } // namespace Daemon
@@ -33,6 +33,7 @@ YubiKeyOathDevice::YubiKeyOathDevice(const QString &deviceId,
                                      const QByteArray &challenge,
                                      bool requiresPassword,
                                      SCARDCONTEXT context,
+                                     const std::optional<ExtendedDeviceInfo> &knownInfo,
                                      QObject *parent)
     : OathDevice(parent)
 {
@@ -56,8 +57,6 @@ YubiKeyOathDevice::YubiKeyOathDevice(const QString &deviceId,
             this, &YubiKeyOathDevice::touchRequired);
     connect(m_session.get(), &YkOathSession::errorOccurred,
             this, &YubiKeyOathDevice::errorOccurred);
-    connect(m_session.get(), &YkOathSession::cardResetDetected,
-            this, &YubiKeyOathDevice::onCardResetDetected);
 
     // Initialize OATH session immediately (following Yubico yubikey-manager pattern)
     // This ensures the session is active and ready for CALCULATE ALL without
@@ -73,7 +72,7 @@ YubiKeyOathDevice::YubiKeyOathDevice(const QString &deviceId,
 
     // Get extended device information (model, serial number, form factor)
     // This uses Management interface for YubiKey 4/5 or OTP GET_SERIAL + reader name for NEO
-    auto extResult = m_session->getExtendedDeviceInfo(m_readerName);
+    auto extResult = resolveExtendedDeviceInfo(knownInfo);
     if (extResult.isError()) {
         qCWarning(YubiKeyOathDeviceLog) << "Failed to get extended device info:" << extResult.error();
         // Fallback to firmware-based model detection
@@ -138,6 +137,9 @@ YubiKeyOathDevice::~YubiKeyOathDevice()
         }
     }
 
+    // A card reset recovery queued on the PC/SC worker pool uses the card handle too
+    cancelCardResetRecovery();
+
     // Disconnect from card
     if (m_cardHandle != 0) {
         qCDebug(YubiKeyOathDeviceLog) << "Disconnecting card handle for device" << m_deviceId;
@@ -148,8 +150,7 @@ YubiKeyOathDevice::~YubiKeyOathDevice()
 
 // NOTE: OATH Operations (generateCode, authenticateWithPassword, addCredential,
 // deleteCredential, changePassword, setPassword, updateCredentialCacheAsync,
-// cancelPendingOperation, onReconnectResult, onCardResetDetected,
-// fetchCredentialsSync, reconnectCardHandle) are now implemented in
+// cancelPendingOperation, fetchCredentialsSync, reconnectCardHandle) are now implemented in
 // OathDevice base class using polymorphic m_session and factory pattern
 
 
@@ -18,6 +18,7 @@
 #include <QObject>
 #include <QString>
 #include <memory>
+#include <optional>
 
 // Forward declarations for PC/SC types
 #ifdef __APPLE__
@@ -60,6 +61,7 @@ public:
      * @param challenge Challenge from YubiKey SELECT
      * @param requiresPassword Whether device requires password (from TAG_CHALLENGE presence in SELECT)
      * @param context PC/SC context (not owned, must outlive this object)
+     * @param knownInfo Extended info from an earlier probe; skips the probe chain when set
      * @param parent Parent QObject
      */
     explicit YubiKeyOathDevice(const QString &deviceId,
@@ -69,6 +71,7 @@ public:
                                const QByteArray &challenge,
                                bool requiresPassword,
                                SCARDCONTEXT context,
+                               const std::optional<ExtendedDeviceInfo> &knownInfo = std::nullopt,
                                QObject *parent = nullptr);
 
     /**
@@ -133,7 +136,7 @@ public:
 
     // NOTE: All OATH operations (generateCode, authenticateWithPassword, addCredential,
     // deleteCredential, changePassword, setPassword, hasPassword,
-    // updateCredentialCacheAsync, cancelPendingOperation, onReconnectResult,
+    // updateCredentialCacheAsync, cancelPendingOperation,
     // fetchCredentialsSync, reconnectCardHandle) are now implemented in
     // OathDevice base class using polymorphic m_session and factory pattern
 
@@ -144,7 +147,7 @@ public:
     // - External connections to &OathDevice::credentialCacheFetched receive nothing
     // See: src/daemon/oath/oath_device.h for signal declarations
 
-    // NOTE: onCardResetDetected slot is now implemented in OathDevice base class
+    // NOTE: Card reset recovery is implemented in OathDevice base class
 
 protected:
     /**
@@ -18,6 +18,9 @@ namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+// Upper bound for deferring PC/SC setup when no client request arrives (plain autostart)
+static constexpr int LIVE_ATTACH_DELAY_MS = 250;
+
 void OathDBusService::registerDBusTypes()
 {
     // Register D-Bus types only once (static flag pattern)
@@ -32,22 +35,32 @@ void OathDBusService::registerDBusTypes()
     qDBusRegisterMetaType<CredentialInfo>();
     qDBusRegisterMetaType<GenerateCodeResult>();
     qDBusRegisterMetaType<AddCredentialResult>();
+    qDBusRegisterMetaType<QList<AddCredentialResult>>();
+    qDBusRegisterMetaType<QList<QVariantMap>>();
     qDBusRegisterMetaType<QList<DeviceInfo>>();
     qDBusRegisterMetaType<QList<CredentialInfo>>();
+    qDBusRegisterMetaType<CredentialPropertiesMap>();
     qDBusRegisterMetaType<DeviceState>();
 
     // Register ObjectManager types (used by GetManagedObjects)
     qDBusRegisterMetaType<InterfacePropertiesMap>();
     qDBusRegisterMetaType<ManagedObjectMap>();
 
+    // Register packed credential types (used by GetManagedObjectsPacked, after the map types they nest)
+    qDBusRegisterMetaType<PackedCredential>();
+    qDBusRegisterMetaType<QList<PackedCredential>>();
+    qDBusRegisterMetaType<PackedManagedObjects>();
+    qDBusRegisterMetaType<ManagedObjectChanges>();
+
     registered = true;
     qCDebug(OathDaemonLog) << "OathDBusService: D-Bus metatypes registered";
 }
 
-OathDBusService::OathDBusService(QObject *parent)
+OathDBusService::OathDBusService(const QElapsedTimer &startupTimer, QObject *parent)
     : QObject(parent)
     , m_service(std::make_unique<OathService>(this))
     , m_manager(nullptr)
+    , m_startupTimer(startupTimer)
 {
     // Register D-Bus types before any D-Bus operations
     registerDBusTypes();
@@ -76,15 +89,41 @@ OathDBusService::OathDBusService(QObject *parent)
 
     qCInfo(OathDaemonLog) << "OathDBusService: D-Bus interface initialized (devices will be added via signals)";
 
-    // Start PC/SC monitoring after D-Bus infrastructure is ready
-    // Device D-Bus objects will be created asynchronously via deviceConnected signals
-    QTimer::singleShot(0, this, [this]() {
-        qCInfo(OathDaemonLog) << "OathDBusService: Starting PC/SC monitoring";
-        m_service->getDeviceManager()->startMonitoring();
-        qCDebug(OathDaemonLog) << "OathDBusService: PC/SC monitoring started successfully";
+    // Phase 2 waits until the first request (usually the one that D-Bus-activated us)
+    // has been answered from the database - queued, so it runs after the reply is sent
+    m_manager->setFirstRequestObserver([this]() {
+        const qint64 receivedMs = m_startupTimer.elapsed();
+        QMetaObject::invokeMethod(this, [this, receivedMs]() {
+            qCInfo(OathDaemonLog) << "OathDBusService: [STARTUP] Time to first reply:"
+                                  << m_startupTimer.elapsed() << "ms (request received at"
+                                  << receivedMs << "ms)";
+            attachLiveDevices();
+        }, Qt::QueuedConnection);
     });
+    QTimer::singleShot(LIVE_ATTACH_DELAY_MS, this, &OathDBusService::attachLiveDevices);
+
+    qCDebug(OathDaemonLog) << "OathDBusService: Initialization complete after"
+                           << m_startupTimer.elapsed() << "ms (live devices deferred)";
+}
+
+void OathDBusService::attachLiveDevices()
+{
+    if (m_liveDevicesAttached) {
+        return;
+    }
+    m_liveDevicesAttached = true;
 
-    qCDebug(OathDaemonLog) << "OathDBusService: Initialization complete";
+    // Device D-Bus objects will be created asynchronously via deviceConnected signals
+    qCInfo(OathDaemonLog) << "OathDBusService: Starting PC/SC monitoring";
+    auto *deviceManager = m_service->getDeviceManager();
+    auto initResult = deviceManager->initialize();
+    if (initResult.isError()) {
+        qCWarning(OathDaemonLog) << "OathDBusService: Failed to initialize OATH:" << initResult.error();
+        return;
+    }
+    deviceManager->startMonitoring();
+    qCInfo(OathDaemonLog) << "OathDBusService: [STARTUP] Live devices attached after"
+                          << m_startupTimer.elapsed() << "ms";
 }
 
 OathDBusService::~OathDBusService()
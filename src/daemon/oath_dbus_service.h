@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <memory>
 #include "types/yubikey_value_types.h"
@@ -50,10 +51,27 @@ class OathDBusService : public QObject
     Q_OBJECT
 
 public:
-    explicit OathDBusService(QObject *parent = nullptr);
+    /**
+     * @brief Constructs service and registers D-Bus objects (phase 1)
+     * @param startupTimer Timer started at process start (for startup metrics)
+     * @param parent Parent QObject
+     *
+     * Only the database and D-Bus objects are set up here, so the caller can
+     * claim the bus name right away. PC/SC initialization and live device
+     * attachment (phase 2) run from the event loop after the first client
+     * request was answered, or after a short delay if no request arrives.
+     */
+    explicit OathDBusService(const QElapsedTimer &startupTimer, QObject *parent = nullptr);
     ~OathDBusService() override;
 
 private:
+    /**
+     * @brief Phase 2: establishes PC/SC context and starts reader monitoring
+     *
+     * Runs once. Devices then appear via deviceConnected signals.
+     */
+    void attachLiveDevices();
+
     /**
      * @brief Register D-Bus metatypes for OATH operations
      *
@@ -66,6 +84,8 @@ private:
 
     std::unique_ptr<OathService> m_service;
     OathManagerObject *m_manager;  // Owned by QObject hierarchy (parent = this)
+    QElapsedTimer m_startupTimer;  // Started at process start
+    bool m_liveDevicesAttached{false};
 };
 
 } // namespace Daemon
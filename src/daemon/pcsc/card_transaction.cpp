@@ -11,6 +11,11 @@
 namespace YubiKeyOath {
 namespace Daemon {
 
+// PC/SC error codes not always defined in headers
+#ifndef SCARD_W_RESET_CARD
+#define SCARD_W_RESET_CARD ((LONG)0x80100068)
+#endif
+
 CardTransaction::CardTransaction(SCARDHANDLE cardHandle,
                                IOathSelector *session,
                                bool skipOathSelect)
@@ -30,6 +35,7 @@ CardTransaction::CardTransaction(SCARDHANDLE cardHandle,
     const LONG result = SCardBeginTransaction(m_cardHandle);
 
     if (result != SCARD_S_SUCCESS) {
+        m_cardWasReset = (result == SCARD_W_RESET_CARD);
         m_error = QStringLiteral("SCardBeginTransaction failed: 0x%1").arg(result, 0, 16);
         qCWarning(YubiKeyPcscLog) << m_error;
         return;
@@ -88,6 +94,7 @@ CardTransaction::~CardTransaction()
 CardTransaction::CardTransaction(CardTransaction &&other) noexcept
     : m_cardHandle(other.m_cardHandle)
     , m_transactionStarted(other.m_transactionStarted)
+    , m_cardWasReset(other.m_cardWasReset)
     , m_error(std::move(other.m_error))
 {
     // Invalidate the source object (prevent double-EndTransaction)
@@ -111,6 +118,7 @@ CardTransaction &CardTransaction::operator=(CardTransaction &&other) noexcept
         // Transfer ownership from other
         m_cardHandle = other.m_cardHandle;
         m_transactionStarted = other.m_transactionStarted;
+        m_cardWasReset = other.m_cardWasReset;
         m_error = std::move(other.m_error);
 
         // Invalidate source
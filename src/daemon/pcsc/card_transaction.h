@@ -124,9 +124,18 @@ public:
      */
     QString errorMessage() const { return m_error; }
 
+    /**
+     * @brief Check if BEGIN_TRANSACTION failed because the card was reset
+     * @return true if SCardBeginTransaction returned SCARD_W_RESET_CARD
+     *
+     * The handle must be reconnected before it can be used again.
+     */
+    bool cardWasReset() const { return m_cardWasReset; }
+
 private:
     SCARDHANDLE m_cardHandle;
     bool m_transactionStarted;
+    bool m_cardWasReset = false;
     QString m_error;
 };
 
@@ -14,6 +14,7 @@
 #include "utils/device_name_formatter.h"
 
 #include <QTimer>
+#include <QPointer>
 #include <QFutureWatcher>
 #include <QMetaObject>
 #include <QtConcurrent/QtConcurrent>
@@ -23,6 +24,55 @@ namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+namespace {
+
+// Encodes a non-default TOTP period in the credential name (ykman-compatible format).
+// Idempotent: names already carrying the period prefix are left alone.
+OathCredentialData withEncodedPeriod(const OathCredentialData &data)
+{
+    OathCredentialData encoded = data;
+    if (encoded.type == OathType::TOTP && encoded.period != 30) {
+        const QString prefix = QString::number(encoded.period) + QStringLiteral("/");
+        if (!encoded.name.startsWith(prefix)) {
+            encoded.name = prefix + encoded.name;
+            qCDebug(OathDaemonLog) << "CredentialService: Encoded period in name:" << encoded.name;
+        }
+    }
+    return encoded;
+}
+
+// Batch entries that reach the card: period-encoded, not yet on the device, first occurrence only
+struct CredentialWritePlan {
+    QList<OathCredentialData> toWrite;  ///< Encoded credentials, in batch order
+    QList<qsizetype> writeIndexes;      ///< Batch index of each toWrite entry
+    QList<qsizetype> skippedIndexes;    ///< Batch indexes whose name is already taken
+};
+
+// Names already on the device (or repeated in the batch) are skipped, not overwritten
+CredentialWritePlan planCredentialWrites(const QList<OathCredential> &existing,
+                                         const QList<OathCredentialData> &batch)
+{
+    QSet<QString> takenNames;
+    for (const auto &cred : existing) {
+        takenNames.insert(cred.originalName);
+    }
+
+    CredentialWritePlan plan;
+    for (qsizetype i = 0; i < batch.size(); ++i) {
+        const OathCredentialData encoded = withEncodedPeriod(batch.at(i));
+        if (takenNames.contains(batch.at(i).name) || takenNames.contains(encoded.name)) {
+            plan.skippedIndexes.append(i);
+            continue;
+        }
+        takenNames.insert(encoded.name);
+        plan.toWrite.append(encoded);
+        plan.writeIndexes.append(i);
+    }
+    return plan;
+}
+
+} // namespace
+
 CredentialService::CredentialService(OathDeviceManager *deviceManager,
                                    OathDatabase *database,
                                    Shared::ConfigurationProvider *config,
@@ -178,6 +228,12 @@ QList<OathCredential> CredentialService::getCredentials(const QString &deviceId)
     return credentials;
 }
 
+bool CredentialService::hasLiveCredentials(const QString &deviceId) const
+{
+    auto *device = m_deviceManager->getDevice(deviceId);
+    return device && !device->credentials().isEmpty();
+}
+
 QList<OathCredential> CredentialService::getCredentials()
 {
     // Delegate to existing method with empty deviceId (= all devices)
@@ -285,6 +341,34 @@ AddCredentialResult CredentialService::addCredential(const QString &deviceId,
         return {QStringLiteral("Error"), i18n("Device not found")};
     }
 
+    // Build and validate credential data
+    const auto built = buildCredentialData(name, secret, type, algorithm, digits, period, counter, requireTouch);
+    if (built.isError()) {
+        return {QStringLiteral("Error"), built.error()};
+    }
+    const OathCredentialData data = built.value();
+
+    // Add credential to device
+    auto result = device->addCredential(data);
+
+    if (result.isError()) {
+        qCWarning(OathDaemonLog) << "CredentialService: Failed to add credential:" << result.error();
+        return {QStringLiteral("Error"), result.error()};
+    }
+
+    qCDebug(OathDaemonLog) << "CredentialService: Credential added successfully";
+    return {QStringLiteral("Success"), i18n("Credential added successfully")};
+}
+
+Result<OathCredentialData> CredentialService::buildCredentialData(const QString &name,
+                                                                 const QString &secret,
+                                                                 const QString &type,
+                                                                 const QString &algorithm,
+                                                                 int digits,
+                                                                 int period,
+                                                                 int counter,
+                                                                 bool requireTouch)
+{
     // Build credential data from parameters (with defaults for empty values)
     OathCredentialData data;
     data.name = name;
@@ -298,7 +382,7 @@ AddCredentialResult CredentialService::addCredential(const QString &deviceId,
         data.type = OathType::TOTP; // Default to TOTP
     } else {
         qCWarning(OathDaemonLog) << "CredentialService: Invalid type:" << type;
-        return {QStringLiteral("Error"), i18n("Invalid credential type (must be TOTP or HOTP)")};
+        return Result<OathCredentialData>::error(i18n("Invalid credential type (must be TOTP or HOTP)"));
     }
 
     // Parse algorithm (default: SHA1)
@@ -333,19 +417,10 @@ AddCredentialResult CredentialService::addCredential(const QString &deviceId,
     const QString validationError = data.validate();
     if (!validationError.isEmpty()) {
         qCWarning(OathDaemonLog) << "CredentialService: Validation failed:" << validationError;
-        return {QStringLiteral("Error"), validationError};
-    }
-
-    // Add credential to device
-    auto result = device->addCredential(data);
-
-    if (result.isError()) {
-        qCWarning(OathDaemonLog) << "CredentialService: Failed to add credential:" << result.error();
-        return {QStringLiteral("Error"), result.error()};
+        return Result<OathCredentialData>::error(validationError);
     }
 
-    qCDebug(OathDaemonLog) << "CredentialService: Credential added successfully";
-    return {QStringLiteral("Success"), i18n("Credential added successfully")};
+    return Result<OathCredentialData>::success(data);
 }
 
 bool CredentialService::deleteCredential(const QString &deviceId, const QString &credentialName)
@@ -382,6 +457,125 @@ bool CredentialService::deleteCredential(const QString &deviceId, const QString
 
 // === ASYNC API IMPLEMENTATIONS ===
 
+QList<AddCredentialResult> CredentialService::addCredentials(const QString &deviceId,
+                                                             const QList<QVariantMap> &credentials)
+{
+    qCDebug(OathDaemonLog) << "CredentialService: addCredentials" << credentials.size() << "device:" << deviceId;
+
+    QList<AddCredentialResult> results(credentials.size());
+
+    auto *device = m_deviceManager->getDevice(deviceId);
+    if (!device) {
+        qCWarning(OathDaemonLog) << "CredentialService: Device" << deviceId << "not found";
+        results.fill({QStringLiteral("Error"), i18n("Device not found")});
+        return results;
+    }
+
+    // Validate everything first; only well-formed, new names reach the card
+    QList<OathCredentialData> valid;
+    QList<qsizetype> validIndexes;
+    for (qsizetype i = 0; i < credentials.size(); ++i) {
+        const QVariantMap &map = credentials.at(i);
+        const QString name = map.value(QStringLiteral("name")).toString();
+        const QString secret = map.value(QStringLiteral("secret")).toString();
+        if (name.isEmpty() || secret.isEmpty()) {
+            results[i] = {QStringLiteral("Error"), i18n("Name and secret are required")};
+            continue;
+        }
+
+        const auto built = buildCredentialData(name, secret,
+                                               map.value(QStringLiteral("type")).toString(),
+                                               map.value(QStringLiteral("algorithm")).toString(),
+                                               map.value(QStringLiteral("digits")).toInt(),
+                                               map.value(QStringLiteral("period")).toInt(),
+                                               map.value(QStringLiteral("counter")).toInt(),
+                                               map.value(QStringLiteral("requireTouch")).toBool());
+        if (built.isError()) {
+            results[i] = {QStringLiteral("Error"), built.error()};
+            continue;
+        }
+
+        valid.append(built.value());
+        validIndexes.append(i);
+    }
+
+    const CredentialWritePlan plan = planCredentialWrites(device->credentials(), valid);
+    for (const qsizetype k : plan.skippedIndexes) {
+        results[validIndexes.at(k)] = {QStringLiteral("Error"), i18n("Credential with this name already exists on the YubiKey")};
+    }
+
+    const auto writeResults = device->addCredentials(plan.toWrite);
+
+    int added = 0;
+    for (qsizetype j = 0; j < plan.writeIndexes.size(); ++j) {
+        const qsizetype index = validIndexes.at(plan.writeIndexes.at(j));
+        const auto &result = writeResults.at(j);
+        if (result.isSuccess()) {
+            results[index] = {QStringLiteral("Success"), plan.toWrite.at(j).name};
+            ++added;
+        } else {
+            results[index] = {QStringLiteral("Error"), result.error()};
+        }
+    }
+
+    qCDebug(OathDaemonLog) << "CredentialService: Added" << added << "of" << credentials.size() << "credentials";
+
+    if (added > 0) {
+        persistCredentialCache(device);
+        Q_EMIT credentialsUpdated(deviceId);
+    }
+
+    return results;
+}
+
+QList<AddCredentialResult> CredentialService::deleteCredentials(const QString &deviceId,
+                                                                const QStringList &credentialNames)
+{
+    qCDebug(OathDaemonLog) << "CredentialService: deleteCredentials" << credentialNames.size() << "device:" << deviceId;
+
+    QList<AddCredentialResult> results(credentialNames.size());
+
+    auto *device = m_deviceManager->getDevice(deviceId);
+    if (!device) {
+        qCWarning(OathDaemonLog) << "CredentialService: Device" << deviceId << "not found";
+        results.fill({QStringLiteral("Error"), i18n("Device not found")});
+        return results;
+    }
+
+    const auto deleteResults = device->deleteCredentials(credentialNames);
+
+    int deleted = 0;
+    for (qsizetype i = 0; i < credentialNames.size(); ++i) {
+        const auto &result = deleteResults.at(i);
+        if (result.isSuccess()) {
+            results[i] = {QStringLiteral("Success"), credentialNames.at(i)};
+            ++deleted;
+        } else {
+            results[i] = {QStringLiteral("Error"), result.error()};
+        }
+    }
+
+    qCDebug(OathDaemonLog) << "CredentialService: Deleted" << deleted << "of" << credentialNames.size() << "credentials";
+
+    if (deleted > 0) {
+        persistCredentialCache(device);
+        Q_EMIT credentialsUpdated(deviceId);
+    }
+
+    return results;
+}
+
+void CredentialService::persistCredentialCache(OathDevice *device)
+{
+    if (!m_config->enableCredentialsCache()) {
+        return;
+    }
+
+    if (!m_database->saveCredentials(device->deviceId(), device->credentials())) {
+        qCWarning(OathDaemonLog) << "CredentialService: Failed to save credentials to cache";
+    }
+}
+
 void CredentialService::generateCodeAsync(const QString &deviceId, const QString &credentialName)
 {
     qCDebug(OathDaemonLog) << "CredentialService: generateCodeAsync for credential:"
@@ -570,56 +764,41 @@ void CredentialService::showAddCredentialDialogAsync(const QString &deviceId,
                                   << "secret length:" << data.secret.length()
                                   << "device:" << selectedDeviceId;
 
-        // === SINGLE CODE PATH: Check device connection ===
-        auto *device = m_deviceManager->getDevice(selectedDeviceId);
-
-        if (!device) {
-            // Device NOT connected - wait for connection
-            qCDebug(OathDaemonLog) << "CredentialService: Device not connected, waiting for connection:" << selectedDeviceId;
-
-            // Update dialog overlay
-            dialog->updateOverlayStatus(i18n("Waiting for device connection..."));
-
-            // Connect to deviceConnected signal and wait
-            auto *connection = new QMetaObject::Connection();
-            *connection = connect(m_deviceManager, &OathDeviceManager::deviceConnected,
-                    this, [this, dialog, data, selectedDeviceId, connection](const QString &deviceId) {
-                if (deviceId == selectedDeviceId) {
-                    qCDebug(OathDaemonLog) << "CredentialService: Device connected:" << deviceId;
-
-                    // Update overlay
-                    dialog->updateOverlayStatus(i18n("Device connected - saving credential..."));
-
-                    // Disconnect signal to avoid multiple triggers
-                    disconnect(*connection);
-                    delete connection;
-
-                    // Now validate and save
-                    QString errorMessage;
-                    auto *device = validateCredentialBeforeSave(data, selectedDeviceId, errorMessage);
-                    if (!device) {
-                        dialog->showSaveResult(false, errorMessage);
-                        return;
-                    }
+        // === SINGLE CODE PATH: wait for device connection if needed, then validate and save ===
+        runWhenDeviceConnected(selectedDeviceId, dialog, [this, dialog, data, selectedDeviceId]() {
+            QString errorMessage;
+            auto *device = validateCredentialBeforeSave(data, selectedDeviceId, errorMessage);
+            if (!device) {
+                dialog->showSaveResult(false, errorMessage);
+                return;
+            }
 
-                    // Save credential asynchronously (extracted helper method)
-                    saveCredentialToDeviceAsync(device, data, dialog);
-                }
-            });
+            // Save credential asynchronously (extracted helper method)
+            saveCredentialToDeviceAsync(device, data, dialog);
+        });
+    });
 
-            return;  // Exit early - wait for device
-        }
+    // Bulk import (several QR codes or an otpauth-migration:// export)
+    connect(dialog, &AddCredentialDialog::credentialsReadyToSave,
+            this, [this, dialog](const QList<OathCredentialData> &credentials, const QString &selectedDeviceId) {
+        qCDebug(OathDaemonLog) << "CredentialService: Credential batch ready to save -"
+                                  << "count:" << credentials.size()
+                                  << "device:" << selectedDeviceId;
 
-        // === Device connected - validate and save ===
-        QString errorMessage;
-        device = validateCredentialBeforeSave(data, selectedDeviceId, errorMessage);
-        if (!device) {
-            dialog->showSaveResult(false, errorMessage);
+        if (selectedDeviceId.isEmpty()) {
+            dialog->showSaveResult(false, i18n("No device selected"));
             return;
         }
 
-        // Save credential asynchronously (extracted helper method)
-        saveCredentialToDeviceAsync(device, data, dialog);
+        runWhenDeviceConnected(selectedDeviceId, dialog, [this, dialog, credentials, selectedDeviceId]() {
+            auto *device = m_deviceManager->getDevice(selectedDeviceId);
+            if (!device) {
+                dialog->showSaveResult(false, i18n("Device not found"));
+                return;
+            }
+
+            saveCredentialsToDeviceAsync(device, credentials, dialog);
+        });
     });
 
     // Ensure dialog is visible and on top (important for daemon processes without main window)
@@ -629,6 +808,48 @@ void CredentialService::showAddCredentialDialogAsync(const QString &deviceId,
     dialog->raise();
 }
 
+void CredentialService::runWhenDeviceConnected(const QString &deviceId,
+                                               AddCredentialDialog *dialog,
+                                               const std::function<void()> &action)
+{
+    if (m_deviceManager->getDevice(deviceId)) {
+        action();
+        return;
+    }
+
+    // Device NOT connected - wait for connection
+    qCDebug(OathDaemonLog) << "CredentialService: Device not connected, waiting for connection:" << deviceId;
+
+    // Update dialog overlay
+    dialog->updateOverlayStatus(i18n("Waiting for device connection..."));
+
+    // Connect to deviceConnected signal and wait
+    auto *connection = new QMetaObject::Connection();
+    *connection = connect(m_deviceManager, &OathDeviceManager::deviceConnected,
+            this, [dialog = QPointer<AddCredentialDialog>(dialog), deviceId, action, connection](const QString &connectedId) {
+        if (!dialog) {
+            // Dialog closed while waiting - drop the save
+            qCDebug(OathDaemonLog) << "CredentialService: Dialog closed while waiting for device:" << deviceId;
+            QObject::disconnect(*connection);
+            delete connection;
+            return;
+        }
+
+        if (connectedId == deviceId) {
+            qCDebug(OathDaemonLog) << "CredentialService: Device connected:" << connectedId;
+
+            // Update overlay
+            dialog->updateOverlayStatus(i18n("Device connected - saving credential..."));
+
+            // Disconnect signal to avoid multiple triggers
+            QObject::disconnect(*connection);
+            delete connection;
+
+            action();
+        }
+    });
+}
+
 QList<DeviceInfo> CredentialService::getAvailableDevices()
 {
     // Get all devices from database (includes firmware/model info)
@@ -707,23 +928,15 @@ void CredentialService::saveCredentialToDeviceAsync(OathDevice *device,
     QFuture<Result<void>> const future = QtConcurrent::run([device, data]() -> Result<void> {
         qCDebug(OathDaemonLog) << "CredentialService: Background thread - starting addCredential";
 
-        // Make copy for modification
-        OathCredentialData dialogData = data;
-
-        // Encode period in credential name for TOTP (ykman-compatible format)
-        if (dialogData.type == OathType::TOTP && dialogData.period != 30) {
-            dialogData.name = QString::number(dialogData.period) + QStringLiteral("/") + dialogData.name;
-            qCDebug(OathDaemonLog) << "CredentialService: Encoded period in name:" << dialogData.name;
-        }
-
         // PC/SC operation in background thread
-        return device->addCredential(dialogData);
+        return device->addCredential(withEncodedPeriod(data));
     });
 
     // Watch future and handle result in UI thread
+    // Dialog may be closed while the card is busy
     auto *watcher = new QFutureWatcher<Result<void>>(this);
     connect(watcher, &QFutureWatcher<Result<void>>::finished,
-            this, [this, watcher, dialog, device, data]() {
+            this, [this, watcher, dialog = QPointer<AddCredentialDialog>(dialog), device, data]() {
         qCDebug(OathDaemonLog) << "CredentialService: Background thread finished";
 
         auto result = watcher->result();
@@ -768,5 +981,88 @@ void CredentialService::saveCredentialToDeviceAsync(OathDevice *device,
     watcher->setFuture(future);
 }
 
+void CredentialService::saveCredentialsToDeviceAsync(OathDevice *device,
+                                                      const QList<OathCredentialData> &credentials,
+                                                      AddCredentialDialog *dialog)
+{
+    Q_ASSERT(device);
+
+    const CredentialWritePlan plan = planCredentialWrites(device->credentials(), credentials);
+    const QList<OathCredentialData> toWrite = plan.toWrite;
+    QStringList skipped;
+    for (const qsizetype k : plan.skippedIndexes) {
+        skipped.append(credentials.at(k).name);
+    }
+
+    qCDebug(OathDaemonLog) << "CredentialService: Writing" << toWrite.size() << "credentials,"
+                              << "skipping" << skipped.size() << "existing";
+
+    // One card transaction for the whole batch, in background thread
+    QFuture<QList<Result<void>>> const future = QtConcurrent::run([device, toWrite]() {
+        return device->addCredentials(toWrite);
+    });
+
+    // Dialog may be closed while the card is busy
+    auto *watcher = new QFutureWatcher<QList<Result<void>>>(this);
+    connect(watcher, &QFutureWatcher<QList<Result<void>>>::finished,
+            this, [this, watcher, dialog = QPointer<AddCredentialDialog>(dialog), device, toWrite, skipped]() {
+        const auto results = watcher->result();
+
+        int added = 0;
+        QStringList failures;
+        for (qsizetype i = 0; i < toWrite.size(); ++i) {
+            const auto result = i < results.size() ? results.at(i)
+                                                   : Result<void>::error(i18n("No response from device"));
+            if (result.isSuccess()) {
+                ++added;
+            } else {
+                failures.append(QStringLiteral("%1: %2").arg(toWrite.at(i).name, result.error()));
+            }
+        }
+
+        qCDebug(OathDaemonLog) << "CredentialService: Batch finished -" << added << "added,"
+                                  << failures.size() << "failed," << skipped.size() << "skipped";
+
+        if (added > 0) {
+            // Device cache was updated from the results (see OathDevice::addCredentials)
+            persistCredentialCache(device);
+
+            if (m_config->showNotifications()) {
+                m_notificationManager->showNotification(
+                    i18n("YubiKey OATH"),
+                    0,
+                    QStringLiteral("yubikey"),
+                    i18n("Credentials Added"),
+                    i18np("1 credential has been added successfully",
+                          "%1 credentials have been added successfully", added),
+                    QStringList(),
+                    QVariantMap(),
+                    5000
+                );
+            }
+
+            Q_EMIT credentialsUpdated(device->deviceId());
+        }
+
+        if (dialog) {
+            if (failures.isEmpty() && skipped.isEmpty()) {
+                dialog->showSaveResult(true, i18n("Credentials added successfully"));
+            } else {
+                QStringList lines;
+                lines.append(i18n("Added %1 of %2 credentials.", added, toWrite.size() + skipped.size()));
+                if (!skipped.isEmpty()) {
+                    lines.append(i18n("Already on the device: %1", skipped.join(QStringLiteral(", "))));
+                }
+                lines.append(failures);
+                dialog->showSaveResult(false, lines.join(QLatin1Char('\n')));
+            }
+        }
+
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(future);
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
@@ -10,9 +10,13 @@
 #include <QList>
 #include <QHash>
 #include <QSet>
+#include <QStringList>
+#include <QVariantMap>
+#include <functional>
 #include "types/oath_credential.h"
 #include "types/oath_credential_data.h"
 #include "types/yubikey_value_types.h"
+#include "common/result.h"
 #include "../../shared/config/configuration_provider.h"
 
 namespace YubiKeyOath {
@@ -61,6 +65,14 @@ public:
      */
     QList<Shared::OathCredential> getCredentials(const QString &deviceId);
 
+    /**
+     * @brief Checks whether getCredentials(deviceId) is served from the card
+     * @param deviceId Device ID
+     * @return true if the device is connected and its credentials are in memory,
+     *         false if they come from the database cache (or there are none)
+     */
+    bool hasLiveCredentials(const QString &deviceId) const;
+
     /**
      * @brief Gets all credentials from all connected devices
      * @return List of credentials from all devices
@@ -115,6 +127,30 @@ public:
      */
     bool deleteCredential(const QString &deviceId, const QString &credentialName);
 
+    /**
+     * @brief Adds several credentials in one card transaction
+     * @param deviceId Device ID
+     * @param credentials One map per credential with the addCredential() parameters as keys
+     *                    ("name", "secret", "type", "algorithm", "digits", "period",
+     *                    "counter", "requireTouch"); missing keys take the same defaults
+     * @return One (status, message) per input: "Success" with the stored name, or "Error"
+     *
+     * Never interactive - entries without name or secret fail. Names already on
+     * the device fail without being sent. The credential cache is updated from
+     * the results instead of re-fetched.
+     */
+    QList<Shared::AddCredentialResult> addCredentials(const QString &deviceId,
+                                                      const QList<QVariantMap> &credentials);
+
+    /**
+     * @brief Deletes several credentials in one card transaction
+     * @param deviceId Device ID
+     * @param credentialNames Full credential names as stored on the device
+     * @return One (status, message) per input: "Success" with the name, or "Error"
+     */
+    QList<Shared::AddCredentialResult> deleteCredentials(const QString &deviceId,
+                                                         const QStringList &credentialNames);
+
     // === ASYNC API (for new D-Bus interface in Phase 4) ===
 
     /**
@@ -270,6 +306,49 @@ private:
                                      const Shared::OathCredentialData &data,
                                      class AddCredentialDialog *dialog);
 
+    /**
+     * @brief Saves a batch of credentials to device asynchronously
+     * @param device Device to save credentials to
+     * @param credentials Credentials to save (bulk import from QR codes)
+     * @param dialog Dialog to show result in (may be nullptr)
+     *
+     * Skips names already present on the device, then writes the rest with
+     * OathDevice::addCredentials() (one card transaction). The dialog closes
+     * only if every credential was written; otherwise it lists what failed.
+     */
+    void saveCredentialsToDeviceAsync(OathDevice *device,
+                                      const QList<Shared::OathCredentialData> &credentials,
+                                      class AddCredentialDialog *dialog);
+
+    /**
+     * @brief Builds credential data from D-Bus parameters (automatic mode)
+     * @return Validated data with period encoded in the name, or error message
+     */
+    static Shared::Result<Shared::OathCredentialData> buildCredentialData(const QString &name,
+                                                                          const QString &secret,
+                                                                          const QString &type,
+                                                                          const QString &algorithm,
+                                                                          int digits,
+                                                                          int period,
+                                                                          int counter,
+                                                                          bool requireTouch);
+
+    /**
+     * @brief Stores the device's credential list in the database cache (if enabled)
+     * @param device Device whose cache was updated locally after a batch
+     */
+    void persistCredentialCache(OathDevice *device);
+
+    /**
+     * @brief Runs action now, or once the device connects
+     * @param deviceId Device the dialog wants to save to
+     * @param dialog Dialog whose overlay shows the waiting state
+     * @param action Save step to run on the UI thread
+     */
+    void runWhenDeviceConnected(const QString &deviceId,
+                                class AddCredentialDialog *dialog,
+                                const std::function<void()> &action);
+
     // === Code cache helpers ===
 
     /**
@@ -14,7 +14,6 @@
 
 #include <QSet>
 #include <QMetaObject>
-#include <QtConcurrent>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -313,39 +312,31 @@ void DeviceLifecycleService::onDeviceConnected(const QString &deviceId)
         // Set device state to Authenticating (password loading phase)
         device->setState(Shared::DeviceState::Authenticating);
 
-        // Load password asynchronously to avoid blocking daemon startup
-        [[maybe_unused]] auto future = QtConcurrent::run([this, deviceId, device]() {
-            qCDebug(OathDaemonLog) << "[Worker] Loading password from KWallet for device:" << deviceId;
-
-            const QString password = m_secretStorage->loadPasswordSync(deviceId);
-
-            // Process result on main thread
-            QMetaObject::invokeMethod(this, [this, deviceId, device, password]() {
-                if (!password.isEmpty()) {
-                    qCDebug(OathDaemonLog) << "DeviceLifecycleService: Password loaded successfully from KWallet";
-
-                    // Save password in device for future use
-                    if (device) {
-                        qCDebug(OathDaemonLog) << "DeviceLifecycleService: Calling setPassword() for device:" << deviceId;
-                        device->setPassword(password);
-                    } else {
-                        qCWarning(OathDaemonLog) << "DeviceLifecycleService: ERROR - device pointer is null for:" << deviceId;
-                        return;
-                    }
-
-                    // Trigger credential cache update with password
-                    if (device) {
-                        qCDebug(OathDaemonLog) << "DeviceLifecycleService: Starting async credential fetch with password for device:" << deviceId;
-                        device->updateCredentialCacheAsync(password);
-                    }
-                } else {
-                    qCDebug(OathDaemonLog) << "DeviceLifecycleService: No password in KWallet for device:" << deviceId;
-                    // Try without password
-                    if (device) {
-                        device->updateCredentialCacheAsync(QString());
-                    }
-                }
-            }, Qt::QueuedConnection);
+        // Load password asynchronously to avoid blocking daemon startup.
+        // SecretStorage batches concurrent requests into a single wallet open.
+        m_secretStorage->loadPasswordAsync(deviceId, this, [this, deviceId](const QString &password) {
+            // Re-resolve device: it may have been removed while the wallet was opening
+            OathDevice *device = m_deviceManager->getDevice(deviceId);
+            if (!device) {
+                qCWarning(OathDaemonLog) << "DeviceLifecycleService: Device gone before password arrived:" << deviceId;
+                return;
+            }
+
+            if (!password.isEmpty()) {
+                qCDebug(OathDaemonLog) << "DeviceLifecycleService: Password loaded successfully from KWallet";
+
+                // Save password in device for future use
+                qCDebug(OathDaemonLog) << "DeviceLifecycleService: Calling setPassword() for device:" << deviceId;
+                device->setPassword(password);
+
+                // Trigger credential cache update with password
+                qCDebug(OathDaemonLog) << "DeviceLifecycleService: Starting async credential fetch with password for device:" << deviceId;
+                device->updateCredentialCacheAsync(password);
+            } else {
+                qCDebug(OathDaemonLog) << "DeviceLifecycleService: No password in KWallet for device:" << deviceId;
+                // Try without password
+                device->updateCredentialCacheAsync(QString());
+            }
         });
     } else {
         qCDebug(OathDaemonLog) << "DeviceLifecycleService: Device doesn't require password, fetching credentials";
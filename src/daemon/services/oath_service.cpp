@@ -51,13 +51,26 @@ OathService::OathService(QObject *parent)
     // Initialize database
     if (!m_database->initialize()) {
         qCWarning(OathDaemonLog) << "OathService: Failed to initialize database";
+    } else {
+        // Seed extended device info so known devices skip Management/OTP/PIV probing.
+        // The stored firmware serves as SELECT fingerprint; where the OATH applet
+        // reports a different version (NEO, YubiKey 4), the first connect re-probes.
+        // Records carry no probe APDU count; the cache charges the Management sequence.
+        const QList<OathDatabase::DeviceRecord> records = m_database->getAllDevices();
+        for (const auto &record : records) {
+            ExtendedDeviceInfo info;
+            info.firmwareVersion = record.firmwareVersion;
+            info.model = record.deviceModel;
+            info.deviceModel = record.deviceModel;
+            info.serialNumber = record.serialNumber;
+            info.formFactor = record.formFactor;
+            m_deviceManager->rememberDeviceInfo(record.deviceId, record.firmwareVersion, info);
+        }
     }
 
-    // Initialize OATH
-    auto initResult = m_deviceManager->initialize();
-    if (initResult.isError()) {
-        qCWarning(OathDaemonLog) << "OathService: Failed to initialize OATH:" << initResult.error();
-    }
+    // NOTE: PC/SC context (OathDeviceManager::initialize()) is NOT set up here.
+    // OathDBusService does it after the bus name is claimed, so D-Bus activation
+    // is answered from the database before any PC/SC work happens.
 
     // Connect device lifecycle signals (delegate to DeviceLifecycleService)
     connect(m_deviceManager.get(), &OathDeviceManager::deviceConnected,
@@ -110,6 +123,12 @@ OathService::OathService(QObject *parent)
     qCDebug(OathDaemonLog) << "OathService: Initialization complete (async device enumeration in progress)";
 }
 
+OathService::OathService(NoComponents, QObject *parent)
+    : QObject(parent)
+{
+    qCDebug(OathDaemonLog) << "OathService: Created without components";
+}
+
 OathService::~OathService()
 {
     qCDebug(OathDaemonLog) << "OathService: Destructor";
@@ -149,6 +168,11 @@ CredentialService* OathService::getCredentialService() const
     return m_credentialService.get();
 }
 
+bool OathService::hasLiveCredentials(const QString &deviceId) const
+{
+    return m_credentialService->hasLiveCredentials(deviceId);
+}
+
 QList<QString> OathService::getConnectedDeviceIds() const
 {
     return m_deviceLifecycleService->getConnectedDeviceIds();
@@ -211,6 +235,21 @@ bool OathService::deleteCredential(const QString &deviceId, const QString &crede
     qCDebug(OathDaemonLog) << "OathService: Delegating deleteCredential to CredentialService";
     return m_credentialService->deleteCredential(deviceId, credentialName);
 }
+
+QList<AddCredentialResult> OathService::addCredentials(const QString &deviceId,
+                                                      const QList<QVariantMap> &credentials)
+{
+    qCDebug(OathDaemonLog) << "OathService: Delegating addCredentials to CredentialService";
+    return m_credentialService->addCredentials(deviceId, credentials);
+}
+
+QList<AddCredentialResult> OathService::deleteCredentials(const QString &deviceId,
+                                                         const QStringList &credentialNames)
+{
+    qCDebug(OathDaemonLog) << "OathService: Delegating deleteCredentials to CredentialService";
+    return m_credentialService->deleteCredentials(deviceId, credentialNames);
+}
+
 bool OathService::copyCodeToClipboard(const QString &deviceId, const QString &credentialName)
 {
     qCDebug(OathDaemonLog) << "OathService: copyCodeToClipboard" << credentialName << "device:" << deviceId;
@@ -11,6 +11,8 @@
 #include <QHash>
 #include <QMutex>
 #include <QDateTime>
+#include <QStringList>
+#include <QVariantMap>
 #include <memory>
 #include "types/yubikey_value_types.h"
 #include "types/oath_credential.h"
@@ -75,27 +77,27 @@ public:
      * Merges connected devices with database records, generating
      * default names for new devices.
      */
-    QList<DeviceInfo> listDevices();
+    virtual QList<DeviceInfo> listDevices();
 
     /**
      * @brief Gets credentials from specific device or all devices
      * @param deviceId Device ID (empty = all devices)
      * @return List of credentials
      */
-    QList<OathCredential> getCredentials(const QString &deviceId);
+    virtual QList<OathCredential> getCredentials(const QString &deviceId);
 
     /**
      * @brief Gets all credentials from all connected devices
      * @return List of credentials from all devices
      */
-    QList<OathCredential> getCredentials();
+    virtual QList<OathCredential> getCredentials();
 
     /**
      * @brief Gets device instance by ID
      * @param deviceId Device ID to retrieve
      * @return Pointer to device or nullptr if not found
      */
-    OathDevice* getDevice(const QString &deviceId);
+    virtual OathDevice* getDevice(const QString &deviceId);
 
     /**
      * @brief Gets device manager instance
@@ -111,6 +113,15 @@ public:
      */
     CredentialService* getCredentialService() const;
 
+    /**
+     * @brief Checks whether getCredentials(deviceId) is served from the card
+     * @param deviceId Device ID
+     * @return false if the credentials come from the database cache (or there are none)
+     *
+     * @see CredentialService::hasLiveCredentials()
+     */
+    virtual bool hasLiveCredentials(const QString &deviceId) const;
+
     /**
      * @brief Gets action coordinator for direct action execution
      * @return Pointer to OathActionCoordinator (not owned)
@@ -120,6 +131,12 @@ public:
      */
     OathActionCoordinator* getActionCoordinator() const { return m_actionCoordinator.get(); }
 
+    /**
+     * @brief Gets daemon configuration
+     * @return Pointer to DaemonConfiguration (not owned)
+     */
+    DaemonConfiguration* getConfiguration() const { return m_config.get(); }
+
     /**
      * @brief Gets IDs of all currently connected devices
      * @return List of connected device IDs
@@ -131,7 +148,7 @@ public:
      * @param deviceId Device ID
      * @return QDateTime timestamp (unix epoch in ms) or invalid QDateTime if device not in database
      */
-    QDateTime getDeviceLastSeen(const QString &deviceId) const;
+    virtual QDateTime getDeviceLastSeen(const QString &deviceId) const;
 
     /**
      * @brief Generates TOTP/HOTP code for credential
@@ -223,6 +240,28 @@ public:
      */
     bool deleteCredential(const QString &deviceId, const QString &credentialName);
 
+    /**
+     * @brief Adds several credentials in one card transaction
+     * @param deviceId Device ID
+     * @param credentials One map per credential (keys as addCredential() parameters)
+     * @return One (status, message) per input
+     *
+     * @see CredentialService::addCredentials()
+     */
+    QList<AddCredentialResult> addCredentials(const QString &deviceId,
+                                              const QList<QVariantMap> &credentials);
+
+    /**
+     * @brief Deletes several credentials in one card transaction
+     * @param deviceId Device ID
+     * @param credentialNames Full credential names as stored on the device
+     * @return One (status, message) per input
+     *
+     * @see CredentialService::deleteCredentials()
+     */
+    QList<AddCredentialResult> deleteCredentials(const QString &deviceId,
+                                                 const QStringList &credentialNames);
+
     /**
      * @brief Copies TOTP code to clipboard
      * @param deviceId Device ID (empty = use first available device)
@@ -300,6 +339,20 @@ Q_SIGNALS:
      */
     void deviceForgotten(const QString &deviceId);
 
+protected:
+    /// Tag selecting the constructor for test doubles
+    struct NoComponents {};
+
+    /**
+     * @brief Constructs service without any components (for test doubles)
+     * @param parent Parent QObject
+     *
+     * Creates no device manager, database, secret storage or configuration,
+     * so nothing touches PC/SC, KWallet or the user's database. Subclasses
+     * override the virtual methods used by the D-Bus object layer.
+     */
+    OathService(NoComponents, QObject *parent);
+
 private Q_SLOTS:
     void onCredentialCacheFetched(const QString &deviceId,
                                  const QList<OathCredential> &credentials);
@@ -9,6 +9,15 @@
 #include <kwallet.h>
 #include <QDebug>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <utility>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -22,10 +31,7 @@ SecretStorage::SecretStorage(QObject *parent)
 
 SecretStorage::~SecretStorage()
 {
-    if (m_wallet) {
-        delete m_wallet;
-        m_wallet = nullptr;
-    }
+    releaseWallet();
 }
 
 SecureMemory::SecureString SecretStorage::loadPasswordSync(const QString &deviceId)
@@ -37,24 +43,232 @@ SecureMemory::SecureString SecretStorage::loadPasswordSync(const QString &device
         return {};
     }
 
-    // Ensure wallet is open and folder is set
     if (!ensureWalletOpen()) {
         qCWarning(SecretStorageLog) << "Could not open KWallet";
         return {};
     }
 
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+
+    const QString key = passwordKey(deviceId);
+    if (readPasswordList()) {
+        return m_passwordCache.value(key);
+    }
+
+    // Batch read unavailable - fall back to reading the single entry
+    // Wrap in SecureString for automatic memory wiping
+    return SecureMemory::SecureString(readPasswordEntry(deviceId));
+}
+
+QString SecretStorage::readPasswordEntry(const QString &deviceId)
+{
+    if (!m_wallet || !m_wallet->isOpen()) {
+        return {};
+    }
+
     // Read password for this device
-    QString password;
     const QString key = passwordKey(deviceId);
+    QString password;
     if (m_wallet->readPassword(key, password) == 0) {
         qCDebug(SecretStorageLog) << "Password loaded from KWallet for key:" << key << ", empty:" << password.isEmpty();
     } else {
         qCDebug(SecretStorageLog) << "No password found in KWallet for key:" << key;
         password = QString();
     }
+    return password;
+}
 
-    // Wrap in SecureString for automatic memory wiping
-    return SecureMemory::SecureString(std::move(password));
+void SecretStorage::loadPasswordAsync(const QString &deviceId, QObject *context, PasswordCallback callback)
+{
+    m_pendingRequests.append(PendingRequest{deviceId, context, std::move(callback)});
+
+    if (m_passwordsLoaded) {
+        // Cache ready - answer from locked memory on next event loop iteration
+        QMetaObject::invokeMethod(this, &SecretStorage::deliverPendingPasswords, Qt::QueuedConnection);
+        return;
+    }
+
+    if (m_batchInFlight) {
+        qCDebug(SecretStorageLog) << "Password request for" << deviceId << "joins in-flight batch load";
+        return;
+    }
+
+    m_batchInFlight = true;
+    qCDebug(SecretStorageLog) << "Starting batch password load (requested by" << deviceId << ")";
+
+    if (m_wallet && m_wallet->isOpen()) {
+        startBatchLoad();
+        return;
+    }
+
+    // Open without blocking; onWalletOpened() continues the batch load
+    if (!m_walletOpening) {
+        releaseWallet();
+        m_walletOpening = true;
+        using namespace KWallet;
+        m_wallet = Wallet::openWallet(Wallet::LocalWallet(), 0, Wallet::Asynchronous);
+        if (!m_wallet) {
+            m_walletOpening = false;
+            qCWarning(SecretStorageLog) << "Could not open wallet";
+            QMetaObject::invokeMethod(this, &SecretStorage::deliverPendingPasswords, Qt::QueuedConnection);
+            return;
+        }
+        connect(m_wallet, &Wallet::walletOpened, this, &SecretStorage::onWalletOpened);
+        connect(m_wallet, &Wallet::walletClosed, this, &SecretStorage::onWalletClosed, Qt::QueuedConnection);
+    }
+}
+
+void SecretStorage::onWalletOpened(bool opened)
+{
+    m_walletOpening = false;
+
+    if (!opened || !selectWalletFolder()) {
+        qCWarning(SecretStorageLog) << "Could not open wallet";
+        deliverPendingPasswords();
+        return;
+    }
+
+    startBatchLoad();
+}
+
+void SecretStorage::startBatchLoad()
+{
+    // Wallet stays owned by the main thread - the worker only reads from it
+    [[maybe_unused]] auto future = QtConcurrent::run([this]() {
+        {
+            QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+            readPasswordList();
+        }
+        QMetaObject::invokeMethod(this, &SecretStorage::deliverPendingPasswords, Qt::QueuedConnection);
+    });
+}
+
+void SecretStorage::deliverPendingPasswords()
+{
+    m_batchInFlight = false;
+
+    QList<PendingRequest> requests = std::exchange(m_pendingRequests, {});
+    if (requests.isEmpty()) {
+        return;
+    }
+
+    if (!m_passwordsLoaded && (!m_wallet || !m_wallet->isOpen())) {
+        // Wallet unavailable (open refused or closed meanwhile) - nothing to read
+        for (const auto &request : std::as_const(requests)) {
+            if (request.context) {
+                request.callback(QString());
+            }
+        }
+        return;
+    }
+
+    if (!m_passwordsLoaded) {
+        // Batch load did not complete (passwordList() failed or the locked cache
+        // is too small) - read the requested entries one by one, off the main thread
+        qCWarning(SecretStorageLog) << "Batch password load failed, reading" << requests.size()
+                                    << "requested entries individually";
+
+        [[maybe_unused]] auto future = QtConcurrent::run([this, requests = std::move(requests)]() {
+            QStringList passwords;
+            passwords.reserve(requests.size());
+            {
+                QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+                for (const auto &request : requests) {
+                    passwords.append(readPasswordEntry(request.deviceId));
+                }
+            }
+            QMetaObject::invokeMethod(this, [requests, passwords = std::move(passwords)]() mutable {
+                for (qsizetype i = 0; i < requests.size(); ++i) {
+                    if (requests.at(i).context) {
+                        requests.at(i).callback(passwords.at(i));
+                    }
+                    SecureMemory::wipeString(passwords[i]);
+                }
+            }, Qt::QueuedConnection);
+        });
+        return;
+    }
+
+    for (const auto &request : std::as_const(requests)) {
+        if (!request.context) {
+            continue;
+        }
+        const SecureMemory::SecureString password = cachedPassword(request.deviceId);
+        request.callback(password);
+    }
+}
+
+SecureMemory::SecureString SecretStorage::cachedPassword(const QString &deviceId)
+{
+    if (!m_passwordsLoaded && !ensureWalletOpen()) {
+        return {};
+    }
+
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+
+    if (!m_passwordsLoaded) {
+        // Cache dropped since the batch load (save/remove/wallet closed)
+        return SecureMemory::SecureString(readPasswordEntry(deviceId));
+    }
+
+    return m_passwordCache.value(passwordKey(deviceId));
+}
+
+void SecretStorage::clearPasswordCache()
+{
+    m_passwordCache.clear();
+    m_passwordsLoaded = false;
+}
+
+void SecretStorage::onWalletClosed()
+{
+    qCDebug(SecretStorageLog) << "Wallet closed - dropping cached passwords";
+
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+    clearPasswordCache();
+}
+
+bool SecretStorage::readPasswordList()
+{
+    if (m_passwordsLoaded) {
+        return true;
+    }
+
+    if (!m_wallet || !m_wallet->isOpen()) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool ok = false;
+    QMap<QString, QString> entries = m_wallet->passwordList(&ok);
+    if (!ok) {
+        qCWarning(SecretStorageLog) << "Failed to read password list from KWallet";
+        return false;
+    }
+
+    bool allStored = true;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        allStored = m_passwordCache.insert(it.key(), it.value()) && allStored;
+        SecureMemory::wipeString(it.value());
+    }
+
+    if (!allStored) {
+        qCWarning(SecretStorageLog) << "Locked password cache is too small for" << entries.size()
+                                    << "entries - falling back to per-entry reads";
+        m_passwordCache.clear();
+        return false;
+    }
+
+    if (!m_passwordCache.isLocked()) {
+        qCWarning(SecretStorageLog) << "Could not lock password cache in RAM (RLIMIT_MEMLOCK?)";
+    }
+
+    m_passwordsLoaded = true;
+    qCInfo(SecretStorageLog) << "Loaded" << entries.size() << "secrets from KWallet in one batch after"
+                             << timer.elapsed() << "ms";
+    return true;
 }
 
 bool SecretStorage::savePassword(const QString &password, const QString &deviceId)
@@ -72,10 +286,13 @@ bool SecretStorage::savePassword(const QString &password, const QString &deviceI
         return false;
     }
 
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+
     // Write password with device-specific key
     const QString key = passwordKey(deviceId);
     if (m_wallet->writePassword(key, password) == 0) {
         qCDebug(SecretStorageLog) << "Password saved to KWallet with key:" << key;
+        clearPasswordCache();  // Next load re-reads the wallet
         return true;
     }
 
@@ -86,20 +303,39 @@ bool SecretStorage::savePassword(const QString &password, const QString &deviceI
 
 bool SecretStorage::ensureWalletOpen()
 {
+    Q_ASSERT(QThread::currentThread() == thread());
+
     if (m_wallet && m_wallet->isOpen()) {
         return true;
     }
 
-    if (!m_wallet) {
-        using namespace KWallet;
-        m_wallet = Wallet::openWallet(Wallet::LocalWallet(), 0, Wallet::Synchronous);
+    // Closed by KWallet (e.g. user locked it) or still opening asynchronously -
+    // a synchronous open replaces the handle
+    const bool batchWaiting = m_walletOpening;
+    m_walletOpening = false;
+    releaseWallet();
+
+    using namespace KWallet;
+    m_wallet = Wallet::openWallet(Wallet::LocalWallet(), 0, Wallet::Synchronous);
+    if (m_wallet) {
+        connect(m_wallet, &Wallet::walletClosed, this, &SecretStorage::onWalletClosed, Qt::QueuedConnection);
     }
 
-    if (!m_wallet || !m_wallet->isOpen()) {
+    const bool opened = m_wallet && m_wallet->isOpen() && selectWalletFolder();
+    if (!opened) {
         qCWarning(SecretStorageLog) << "Could not open wallet";
-        return false;
     }
 
+    if (batchWaiting) {
+        // The replaced handle would have continued the batch load
+        QMetaObject::invokeMethod(this, [this, opened]() { onWalletOpened(opened); }, Qt::QueuedConnection);
+    }
+
+    return opened;
+}
+
+bool SecretStorage::selectWalletFolder()
+{
     // Create folder if it doesn't exist
     if (!m_wallet->hasFolder(walletFolder())) {
         m_wallet->createFolder(walletFolder());
@@ -114,6 +350,20 @@ bool SecretStorage::ensureWalletOpen()
     return true;
 }
 
+void SecretStorage::releaseWallet()
+{
+    if (!m_wallet) {
+        return;
+    }
+
+    disconnect(m_wallet, nullptr, this, nullptr);
+
+    // Waits for a background read still using the handle
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+    delete m_wallet;
+    m_wallet = nullptr;
+}
+
 bool SecretStorage::removePassword(const QString &deviceId)
 {
     qCDebug(SecretStorageLog) << "Removing password for device:" << deviceId;
@@ -122,11 +372,14 @@ bool SecretStorage::removePassword(const QString &deviceId)
         return false;
     }
 
+    QMutexLocker locker(&m_walletMutex);  // NOLINT(misc-const-correctness)
+
     QString const key = passwordKey(deviceId);
     int const result = m_wallet->removeEntry(key);
 
     if (result == 0) {
         qCDebug(SecretStorageLog) << "Password removed successfully for:" << deviceId;
+        clearPasswordCache();  // Next load re-reads the wallet
         return true;
     } else {
         qCWarning(SecretStorageLog) << "Failed to remove password for:" << deviceId;
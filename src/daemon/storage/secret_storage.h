@@ -7,8 +7,13 @@
 
 #include "../utils/secure_memory.h"
 
+#include <QList>
+#include <QMutex>
 #include <QObject>
+#include <QPointer>
 #include <QString>
+#include <atomic>
+#include <functional>
 
 // Forward declarations for KDE classes (must be outside namespace)
 namespace KWallet
@@ -23,6 +28,16 @@ namespace Daemon {
  * @brief Manages secure secret storage using KWallet
  *
  * Single Responsibility: Handle secret persistence in KWallet (passwords, tokens)
+ *
+ * The wallet is opened once and all entries of our folder are read in a
+ * single batch into a SecureMemory::LockedSecretMap. Later loads are served
+ * from that locked region, so multi-device startup pays the wallet latency
+ * only once. Saves, removals and the wallet closing drop the cache, so the
+ * next load re-reads the wallet. If the batch read does not complete, each
+ * entry is read individually instead.
+ *
+ * The KWallet handle is created, opened and deleted on the main thread only.
+ * Background jobs only read from an already open wallet, under m_walletMutex.
  */
 class SecretStorage : public QObject
 {
@@ -43,6 +58,23 @@ public:
      */
     virtual SecureMemory::SecureString loadPasswordSync(const QString &deviceId);
 
+    /// Receives the loaded password (empty if not found); wiped after the call returns
+    using PasswordCallback = std::function<void(const QString &password)>;
+
+    /**
+     * @brief Loads password without blocking the calling (main) thread
+     * @param deviceId Unique device identifier
+     * @param context Callback is dropped if this object is destroyed first
+     * @param callback Invoked on the main thread with the password
+     *
+     * The first request starts one background batch load of all passwords;
+     * requests arriving meanwhile wait for that same batch. Once loaded,
+     * requests are answered from the locked cache on the next event loop
+     * iteration. Must be called from the main thread.
+     * Virtual to allow mocking in tests.
+     */
+    virtual void loadPasswordAsync(const QString &deviceId, QObject *context, PasswordCallback callback);
+
     /**
      * @brief Saves password to KWallet
      * @param password Password to save
@@ -80,7 +112,75 @@ public:
     bool removeRestoreToken();
 
 private:
-    KWallet::Wallet *m_wallet;
+    /**
+     * @brief Reads all folder entries into m_passwordCache (once)
+     * @return true if the cache is loaded
+     *
+     * Caller must hold m_walletMutex. Does not open the wallet; blocks for the
+     * passwordList() round trip, so the async path runs it on a worker thread.
+     */
+    bool readPasswordList();
+
+    /**
+     * @brief Reads a single entry from the wallet, bypassing the cache
+     * @return Password, empty if not found or the wallet is not open
+     *
+     * Caller must hold m_walletMutex. Does not open the wallet.
+     */
+    QString readPasswordEntry(const QString &deviceId);
+
+    /**
+     * @brief Runs readPasswordList() in the background, then delivers pending requests
+     *
+     * Main thread only; the wallet must be open.
+     */
+    void startBatchLoad();
+
+    /**
+     * @brief Continues the batch load once the asynchronous wallet open finished
+     */
+    void onWalletOpened(bool opened);
+
+    /**
+     * @brief Returns password from cache, or reads the entry if the cache is not loaded
+     */
+    SecureMemory::SecureString cachedPassword(const QString &deviceId);
+
+    /**
+     * @brief Answers all queued async requests (main thread, after batch load)
+     *
+     * If the batch load did not complete, the requested entries are read
+     * individually in the background and answered afterwards.
+     */
+    void deliverPendingPasswords();
+
+    /**
+     * @brief Drops all cached passwords; the next load re-reads the wallet
+     *
+     * Caller must hold m_walletMutex.
+     */
+    void clearPasswordCache();
+
+    /**
+     * @brief Drops the cache when KWallet closes the wallet
+     */
+    void onWalletClosed();
+
+    struct PendingRequest {
+        QString deviceId;
+        QPointer<QObject> context;
+        PasswordCallback callback;
+    };
+
+    KWallet::Wallet *m_wallet;  ///< Created and deleted on the main thread only
+    bool m_walletOpening{false};  ///< Asynchronous open in progress (main thread only)
+
+    QMutex m_walletMutex;  ///< Serializes wallet access and protects m_passwordCache
+    SecureMemory::LockedSecretMap m_passwordCache;  ///< Wallet key → password, locked in RAM
+    std::atomic<bool> m_passwordsLoaded{false};
+
+    QList<PendingRequest> m_pendingRequests;  ///< Main thread only
+    bool m_batchInFlight{false};              ///< Main thread only
 
     // Helper methods for constants (to avoid QStringLiteral macro issues)
     static QString walletFolder() { return QStringLiteral("YubiKey OATH Application"); }
@@ -91,7 +191,25 @@ private:
     // Portal restore token key (used by portal_text_input for session persistence)
     static constexpr const char* PORTAL_TOKEN_KEY = "portal_restore_token";
 
+    /**
+     * @brief Opens the wallet synchronously if it is not open yet
+     * @return true if the wallet is open and our folder is selected
+     *
+     * Main thread only. Must be called without holding m_walletMutex.
+     */
     bool ensureWalletOpen();
+
+    /**
+     * @brief Creates (if needed) and selects our wallet folder
+     */
+    bool selectWalletFolder();
+
+    /**
+     * @brief Deletes the wallet handle, waiting for a background read using it
+     *
+     * Main thread only. Must be called without holding m_walletMutex.
+     */
+    void releaseWallet();
 };
 
 } // namespace Daemon
@@ -25,6 +25,7 @@
 #include <QTimer>
 #include <QIcon>
 #include <KLocalizedString>
+#include <algorithm>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -291,6 +292,20 @@ void AddCredentialDialog::onRevealSecretClicked()
 
 void AddCredentialDialog::onOkClicked()
 {
+    if (!m_batchCredentials.isEmpty()) {
+        // Bulk import - entries were validated by the parser, only touch is user-editable
+        QList<OathCredentialData> credentials = m_batchCredentials;
+        for (auto &data : credentials) {
+            data.requireTouch = m_touchCheckBox->isChecked();
+        }
+
+        showProcessingOverlay(i18np("Saving 1 credential...", "Saving %1 credentials...", credentials.size()));
+        qCDebug(OathDaemonLog) << "AddCredentialDialog: Emitting credentialsReadyToSave signal, count:"
+                                  << credentials.size();
+        Q_EMIT credentialsReadyToSave(credentials, getSelectedDeviceId());
+        return;
+    }
+
     if (validateAndBuildData()) {
         // Always emit signal - service layer handles connection waiting
         showProcessingOverlay(i18n("Saving credential..."));
@@ -388,14 +403,21 @@ void AddCredentialDialog::onScanQrClicked()
     connect(m_screenshotCapturer, &ScreenshotCapturer::cancelled,
             this, &AddCredentialDialog::onCancelled);
 
-    // Start screenshot capture (async, will emit captured or cancelled)
-    m_screenshotCapturer->captureFullscreen(30000);
+    // Start screenshot capture (async, will emit captured or cancelled).
+    // Luminance is streamed from the pipe - the RGBA screenshot is never materialized.
+    m_screenshotCapturer->captureLuminance(30000);
 }
 
 void AddCredentialDialog::fillFieldsFromQrData(const OathCredentialData &data)
 {
     qCDebug(OathDaemonLog) << "AddCredentialDialog: Filling fields from QR data";
 
+    // A rescan replaces a previously scanned batch
+    if (!m_batchCredentials.isEmpty()) {
+        m_batchCredentials.clear();
+        setPerCredentialFieldsEnabled(true);
+    }
+
     // Fill text fields
     m_issuerField->setText(data.issuer);
     m_accountField->setText(data.account);
@@ -417,6 +439,39 @@ void AddCredentialDialog::fillFieldsFromQrData(const OathCredentialData &data)
     updateFieldsForType();
 }
 
+void AddCredentialDialog::enterBatchMode(const QList<OathCredentialData> &credentials)
+{
+    qCDebug(OathDaemonLog) << "AddCredentialDialog: Entering batch mode with" << credentials.size() << "credentials";
+
+    m_batchCredentials = credentials;
+
+    // Per-credential fields do not apply to a batch; touch is applied to every entry
+    setPerCredentialFieldsEnabled(false);
+    m_issuerField->clear();
+    m_accountField->clear();
+    m_secretField->clear();
+    m_errorLabel->hide();
+
+    QStringList names;
+    for (const auto &data : credentials) {
+        names.append(data.name);
+    }
+    showMessage(i18np("Found 1 account: %2. Press OK to import it.",
+                      "Found %1 accounts: %2. Press OK to import all of them.",
+                      credentials.size(), names.join(QStringLiteral(", "))),
+                KMessageWidget::Positive);
+}
+
+void AddCredentialDialog::setPerCredentialFieldsEnabled(bool enabled)
+{
+    const QList<QWidget *> fields{m_issuerField, m_accountField, m_secretField,
+                                  m_revealSecretButton, m_typeCombo, m_algorithmCombo,
+                                  m_digitsSpinBox, m_periodSpinBox, m_counterSpinBox};
+    for (auto *field : fields) {
+        field->setEnabled(enabled);
+    }
+}
+
 void AddCredentialDialog::showProcessingOverlay(const QString &message)
 {
     qCDebug(OathDaemonLog) << "AddCredentialDialog: Showing processing overlay:" << message;
@@ -431,36 +486,58 @@ void AddCredentialDialog::onCaptured(const QImage &image)
     // Update overlay status to QR parsing
     updateOverlayStatus(i18n("Processing QR code"));
 
-    // Run QR parsing + URI parsing in background thread (CPU-heavy)
-    QFuture<Result<OathCredentialData>> const future = QtConcurrent::run([image]() -> Result<OathCredentialData> {
+    // Run QR parsing + URI parsing in background thread (CPU-heavy).
+    // QImage is implicitly shared: the lambda holds a reference, not a pixel copy,
+    // and the Grayscale8 image is decoded without further conversion.
+    using ParseResult = Result<QList<OathCredentialData>>;
+    QFuture<ParseResult> const future = QtConcurrent::run([image]() -> ParseResult {
         qCDebug(OathDaemonLog) << "AddCredentialDialog: Background QR parsing started";
 
-        // Parse QR code from in-memory image (static method - thread-safe)
-        auto qrResult = QrCodeParser::parse(image);
+        // Decode every QR code in the image (static method - thread-safe)
+        auto qrResult = QrCodeParser::parseAll(image);
 
         if (qrResult.isError()) {
             qCWarning(OathDaemonLog) << "AddCredentialDialog: QR parsing failed:" << qrResult.error();
-            return Result<OathCredentialData>::error(i18n("No QR code found in the screenshot. Please try again."));
+            return ParseResult::error(i18n("No QR code found in the screenshot. Please try again."));
         }
 
-        QString const otpauthUri = qrResult.value();
-        qCDebug(OathDaemonLog) << "AddCredentialDialog: QR code parsed, URI length:" << otpauthUri.length();
-
-        // Parse otpauth URI (static method - thread-safe)
-        auto parseResult = OtpauthUriParser::parse(otpauthUri);
+        qCDebug(OathDaemonLog) << "AddCredentialDialog: Decoded" << qrResult.value().size() << "QR codes";
+
+        // Parse each otpauth:// or otpauth-migration:// URI (static method - thread-safe).
+        // Unrelated QR codes on screen are ignored as long as one of them yields credentials.
+        QList<OathCredentialData> credentials;
+        QString firstError;
+        for (const QString &uri : qrResult.value()) {
+            auto parseResult = OtpauthUriParser::parseAll(uri);
+            if (parseResult.isError()) {
+                qCWarning(OathDaemonLog) << "AddCredentialDialog: URI parsing failed:" << parseResult.error();
+                if (firstError.isEmpty()) {
+                    firstError = parseResult.error();
+                }
+                continue;
+            }
+            for (const auto &data : parseResult.value()) {
+                const bool duplicate = std::any_of(credentials.cbegin(), credentials.cend(),
+                                                   [&data](const OathCredentialData &existing) {
+                                                       return existing.name == data.name;
+                                                   });
+                if (!duplicate) {
+                    credentials.append(data);
+                }
+            }
+        }
 
-        if (parseResult.isError()) {
-            qCWarning(OathDaemonLog) << "AddCredentialDialog: URI parsing failed:" << parseResult.error();
-            return Result<OathCredentialData>::error(parseResult.error());
+        if (credentials.isEmpty()) {
+            return ParseResult::error(firstError);
         }
 
-        qCDebug(OathDaemonLog) << "AddCredentialDialog: Credential data parsed successfully";
-        return parseResult;
+        qCDebug(OathDaemonLog) << "AddCredentialDialog: Parsed" << credentials.size() << "credentials";
+        return ParseResult::success(credentials);
     });
 
     // Use QFutureWatcher to get notified when QR parsing is done (in UI thread)
-    auto *watcher = new QFutureWatcher<Result<OathCredentialData>>(this);
-    connect(watcher, &QFutureWatcher<Result<OathCredentialData>>::finished,
+    auto *watcher = new QFutureWatcher<ParseResult>(this);
+    connect(watcher, &QFutureWatcher<ParseResult>::finished,
             this, [this, watcher]() {
         qCDebug(OathDaemonLog) << "AddCredentialDialog: Background QR parsing finished";
 
@@ -478,9 +555,12 @@ void AddCredentialDialog::onCaptured(const QImage &image)
         if (result.isError()) {
             qCWarning(OathDaemonLog) << "AddCredentialDialog: QR processing failed:" << result.error();
             showMessage(result.error(), KMessageWidget::Error);
+        } else if (result.value().size() > 1) {
+            // Bulk import (UI thread)
+            enterBatchMode(result.value());
         } else {
             // Fill form fields with parsed data (UI thread)
-            fillFieldsFromQrData(result.value());
+            fillFieldsFromQrData(result.value().constFirst());
             showMessage(i18n("QR code scanned successfully. Please review the information below."),
                        KMessageWidget::Positive);
         }
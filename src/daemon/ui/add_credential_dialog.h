@@ -39,6 +39,10 @@ class ProcessingOverlay;
  * - Counter (HOTP only, initial value)
  * - Require Touch (checkbox)
  * - Device selection (if multiple YubiKeys)
+ *
+ * If a scan yields several credentials (multiple QR codes or an
+ * otpauth-migration:// export), the form switches to bulk mode and OK
+ * imports all of them via credentialsReadyToSave().
  */
 class AddCredentialDialog : public QDialog
 {
@@ -99,6 +103,13 @@ Q_SIGNALS:
      */
     void credentialReadyToSave(const Shared::OathCredentialData &data, const QString &deviceId);
 
+    /**
+     * @brief Emitted when a scanned batch is ready to be saved (bulk import)
+     * @param credentials Parsed credentials (touch setting applied)
+     * @param deviceId Target device ID
+     */
+    void credentialsReadyToSave(const QList<Shared::OathCredentialData> &credentials, const QString &deviceId);
+
 private Q_SLOTS:
     void onTypeChanged(int index);
     void onDeviceChanged(int index);
@@ -113,6 +124,8 @@ private:
     void updateFieldsForType();
     bool validateAndBuildData();
     void fillFieldsFromQrData(const OathCredentialData &data);
+    void enterBatchMode(const QList<OathCredentialData> &credentials);
+    void setPerCredentialFieldsEnabled(bool enabled);
     void showMessage(const QString &text, int messageType);
     void showProcessingOverlay(const QString &message);
     void hideProcessingOverlay();
@@ -143,6 +156,9 @@ private:
 
     bool m_secretRevealed = false;
 
+    // Bulk import: credentials from the last scan (empty = single credential form)
+    QList<OathCredentialData> m_batchCredentials;
+
     // Device list for firmware validation
     QList<Shared::DeviceInfo> m_availableDevices;
 };
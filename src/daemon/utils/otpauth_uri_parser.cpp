@@ -4,15 +4,246 @@
  */
 
 #include "otpauth_uri_parser.h"
+#include "../logging_categories.h"
+#include <QByteArray>
 #include <QUrl>
 #include <QUrlQuery>
 #include <QDebug>
 #include <KLocalizedString>
+#include <optional>
 
 namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+namespace {
+
+// MigrationPayload / OtpParameters field numbers (Google Authenticator export)
+constexpr quint32 PAYLOAD_OTP_PARAMETERS = 1;
+constexpr quint32 OTP_SECRET = 1;
+constexpr quint32 OTP_NAME = 2;
+constexpr quint32 OTP_ISSUER = 3;
+constexpr quint32 OTP_ALGORITHM = 4;
+constexpr quint32 OTP_DIGITS = 5;
+constexpr quint32 OTP_TYPE = 6;
+constexpr quint32 OTP_COUNTER = 7;
+
+// Protobuf wire types
+constexpr quint32 WIRE_VARINT = 0;
+constexpr quint32 WIRE_FIXED64 = 1;
+constexpr quint32 WIRE_LENGTH_DELIMITED = 2;
+constexpr quint32 WIRE_FIXED32 = 5;
+
+/**
+ * @brief Minimal protobuf wire-format reader (just enough for MigrationPayload)
+ */
+class ProtobufReader
+{
+public:
+    explicit ProtobufReader(const QByteArray &data)
+        : m_data(data)
+    {
+    }
+
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+    std::optional<quint64> readVarint()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (atEnd()) {
+                return std::nullopt;
+            }
+            const auto byte = static_cast<quint8>(m_data.at(m_pos++));
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<QByteArray> readBytes()
+    {
+        const auto length = readVarint();
+        if (!length || *length > static_cast<quint64>(m_data.size() - m_pos)) {
+            return std::nullopt;
+        }
+        QByteArray bytes = m_data.mid(m_pos, static_cast<qsizetype>(*length));
+        m_pos += static_cast<qsizetype>(*length);
+        return bytes;
+    }
+
+    bool skip(quint32 wireType)
+    {
+        switch (wireType) {
+        case WIRE_VARINT:
+            return readVarint().has_value();
+        case WIRE_LENGTH_DELIMITED:
+            return readBytes().has_value();
+        case WIRE_FIXED64:
+            return advance(8);
+        case WIRE_FIXED32:
+            return advance(4);
+        default:
+            return false;
+        }
+    }
+
+private:
+    bool advance(qsizetype count)
+    {
+        if (m_data.size() - m_pos < count) {
+            return false;
+        }
+        m_pos += count;
+        return true;
+    }
+
+    QByteArray m_data;
+    qsizetype m_pos{0};
+};
+
+// RFC 4648 Base32 without padding (the applet and otpauth:// accept both)
+QString encodeBase32(const QByteArray &data)
+{
+    static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+    QString result;
+    result.reserve(static_cast<qsizetype>((data.size() * 8 + 4) / 5));
+
+    quint32 buffer = 0;
+    int bits = 0;
+    for (const char byte : data) {
+        buffer = (buffer << 8) | static_cast<quint8>(byte);
+        bits += 8;
+        while (bits >= 5) {
+            result.append(QLatin1Char(alphabet[(buffer >> (bits - 5)) & 0x1F]));
+            bits -= 5;
+        }
+    }
+    if (bits > 0) {
+        result.append(QLatin1Char(alphabet[(buffer << (5 - bits)) & 0x1F]));
+    }
+    return result;
+}
+
+/**
+ * @brief Decodes one OtpParameters message
+ * @return Credential, or an error for malformed or unsupported entries
+ */
+Result<OathCredentialData> parseOtpParameters(const QByteArray &message)
+{
+    ProtobufReader reader(message);
+
+    QByteArray secret;
+    QString name;
+    QString issuer;
+    quint64 algorithm = 0;
+    quint64 digits = 0;
+    quint64 type = 0;
+    quint64 counter = 0;
+
+    while (!reader.atEnd()) {
+        const auto key = reader.readVarint();
+        if (!key) {
+            return Result<OathCredentialData>::error(i18n("Malformed migration payload"));
+        }
+        const auto field = static_cast<quint32>(*key >> 3);
+        const auto wireType = static_cast<quint32>(*key & 0x7);
+
+        if (wireType == WIRE_LENGTH_DELIMITED
+            && (field == OTP_SECRET || field == OTP_NAME || field == OTP_ISSUER)) {
+            const auto bytes = reader.readBytes();
+            if (!bytes) {
+                return Result<OathCredentialData>::error(i18n("Malformed migration payload"));
+            }
+            if (field == OTP_SECRET) {
+                secret = *bytes;
+            } else if (field == OTP_NAME) {
+                name = QString::fromUtf8(*bytes);
+            } else {
+                issuer = QString::fromUtf8(*bytes);
+            }
+        } else if (wireType == WIRE_VARINT
+                   && (field == OTP_ALGORITHM || field == OTP_DIGITS
+                       || field == OTP_TYPE || field == OTP_COUNTER)) {
+            const auto value = reader.readVarint();
+            if (!value) {
+                return Result<OathCredentialData>::error(i18n("Malformed migration payload"));
+            }
+            if (field == OTP_ALGORITHM) {
+                algorithm = *value;
+            } else if (field == OTP_DIGITS) {
+                digits = *value;
+            } else if (field == OTP_TYPE) {
+                type = *value;
+            } else {
+                counter = *value;
+            }
+        } else if (!reader.skip(wireType)) {
+            return Result<OathCredentialData>::error(i18n("Malformed migration payload"));
+        }
+    }
+
+    OathCredentialData data;
+    data.secret = encodeBase32(secret);
+
+    // Name is "issuer:account" or just the account; explicit issuer wins
+    const qsizetype colonPos = name.indexOf(QLatin1Char(':'));
+    if (colonPos >= 0) {
+        data.issuer = name.left(colonPos);
+        data.account = name.mid(colonPos + 1);
+    } else {
+        data.account = name;
+    }
+    if (!issuer.isEmpty()) {
+        data.issuer = issuer;
+    }
+    if (data.issuer.isEmpty()) {
+        data.issuer = data.account;
+    }
+    data.name = data.issuer + QStringLiteral(":") + data.account;
+
+    // Enum values: 0 = unspecified (exporter default), see MigrationPayload
+    switch (algorithm) {
+    case 0:
+    case 1:
+        data.algorithm = OathAlgorithm::SHA1;
+        break;
+    case 2:
+        data.algorithm = OathAlgorithm::SHA256;
+        break;
+    case 3:
+        data.algorithm = OathAlgorithm::SHA512;
+        break;
+    default:
+        return Result<OathCredentialData>::error(
+            i18n("Unsupported algorithm for %1 (must be SHA1, SHA256, or SHA512)", data.name));
+    }
+
+    data.digits = (digits == 2) ? 8 : 6;
+
+    if (type == 1) {
+        data.type = OathType::HOTP;
+        data.counter = static_cast<quint32>(counter);
+    } else if (type == 0 || type == 2) {
+        data.type = OathType::TOTP;
+        data.period = 30; // Not part of the export format
+    } else {
+        return Result<OathCredentialData>::error(i18n("Unsupported OTP type for %1", data.name));
+    }
+
+    const QString validationError = data.validate();
+    if (!validationError.isEmpty()) {
+        return Result<OathCredentialData>::error(validationError);
+    }
+
+    return Result<OathCredentialData>::success(data);
+}
+
+} // namespace
+
 Result<OathCredentialData> OtpauthUriParser::parse(const QString &uri)
 {
     // Parse URI
@@ -152,5 +383,78 @@ Result<OathCredentialData> OtpauthUriParser::parse(const QString &uri)
     return Result<OathCredentialData>::success(data);
 }
 
+Result<QList<OathCredentialData>> OtpauthUriParser::parseMigration(const QString &uri)
+{
+    const QUrl url(uri);
+
+    if (!url.isValid()) {
+        return Result<QList<OathCredentialData>>::error(i18n("Invalid URI format"));
+    }
+
+    if (url.scheme().toLower() != QStringLiteral("otpauth-migration")) {
+        return Result<QList<OathCredentialData>>::error(i18n("URI must start with otpauth-migration://"));
+    }
+
+    // Standard Base64 - '+' and '/' are percent-encoded, so take the fully decoded value
+    const QUrlQuery query(url);
+    const QString data = query.queryItemValue(QStringLiteral("data"), QUrl::FullyDecoded);
+    const auto decoded = QByteArray::fromBase64Encoding(
+        data.toLatin1(), QByteArray::Base64Encoding | QByteArray::AbortOnBase64DecodingErrors);
+    if (data.isEmpty() || !decoded) {
+        return Result<QList<OathCredentialData>>::error(i18n("Data parameter is missing or invalid"));
+    }
+
+    QList<OathCredentialData> credentials;
+    ProtobufReader reader(*decoded);
+    while (!reader.atEnd()) {
+        const auto key = reader.readVarint();
+        if (!key) {
+            return Result<QList<OathCredentialData>>::error(i18n("Malformed migration payload"));
+        }
+        const auto field = static_cast<quint32>(*key >> 3);
+        const auto wireType = static_cast<quint32>(*key & 0x7);
+
+        // version, batch_size, batch_index and batch_id are not needed:
+        // every QR code of a multi-part export is a complete payload
+        if (field != PAYLOAD_OTP_PARAMETERS || wireType != WIRE_LENGTH_DELIMITED) {
+            if (!reader.skip(wireType)) {
+                return Result<QList<OathCredentialData>>::error(i18n("Malformed migration payload"));
+            }
+            continue;
+        }
+
+        const auto message = reader.readBytes();
+        if (!message) {
+            return Result<QList<OathCredentialData>>::error(i18n("Malformed migration payload"));
+        }
+
+        auto entry = parseOtpParameters(*message);
+        if (entry.isError()) {
+            qCWarning(OathDaemonLog) << "OtpauthUriParser: Skipping migration entry:" << entry.error();
+            continue;
+        }
+        credentials.append(entry.value());
+    }
+
+    if (credentials.isEmpty()) {
+        return Result<QList<OathCredentialData>>::error(i18n("Migration payload contains no supported accounts"));
+    }
+
+    return Result<QList<OathCredentialData>>::success(credentials);
+}
+
+Result<QList<OathCredentialData>> OtpauthUriParser::parseAll(const QString &uri)
+{
+    if (uri.startsWith(QStringLiteral("otpauth-migration:"), Qt::CaseInsensitive)) {
+        return parseMigration(uri);
+    }
+
+    auto result = parse(uri);
+    if (result.isError()) {
+        return Result<QList<OathCredentialData>>::error(result.error());
+    }
+    return Result<QList<OathCredentialData>>::success({result.value()});
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <QList>
 #include <QString>
 #include "types/oath_credential_data.h"
 #include "common/result.h"
@@ -31,6 +32,12 @@ using Shared::OathCredentialData;
  * - counter: Initial counter for HOTP (required for HOTP)
  *
  * Spec: https://github.com/google/google-authenticator/wiki/Key-Uri-Format
+ *
+ * Also decodes Google Authenticator batch exports:
+ *   otpauth-migration://offline?data=BASE64
+ *
+ * where data is a protobuf MigrationPayload holding one OtpParameters entry
+ * per account (raw secret bytes, name, issuer, algorithm, digits, type, counter).
  */
 class OtpauthUriParser
 {
@@ -46,6 +53,24 @@ public:
      */
     static Result<OathCredentialData> parse(const QString &uri);
 
+    /**
+     * @brief Parses otpauth-migration:// batch export into credentials
+     * @param uri otpauth-migration:// URI string
+     * @return Result with all credentials of the payload on success, error message on failure
+     *
+     * Entries the OATH applet cannot store (MD5, unknown type) are skipped with a
+     * warning. Fails if the payload is malformed or holds no usable entry.
+     * Large exports are split across several QR codes - each one is a separate URI.
+     */
+    static Result<QList<OathCredentialData>> parseMigration(const QString &uri);
+
+    /**
+     * @brief Parses either URI format into a list of credentials
+     * @param uri otpauth:// or otpauth-migration:// URI string
+     * @return Result with one credential (otpauth://) or a batch (otpauth-migration://)
+     */
+    static Result<QList<OathCredentialData>> parseAll(const QString &uri);
+
 private:
     OtpauthUriParser() = delete; // Utility class - no instances
 };
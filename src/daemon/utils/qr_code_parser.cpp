@@ -8,13 +8,126 @@
 #include <QFile>
 #include <QImage>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QRect>
+#include <QtConcurrent>
 #include <KLocalizedString>
 #include <ZXing/ReadBarcode.h>
 
+#include <algorithm>
+
 namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+namespace {
+
+// Images up to this size (larger side) get a single exhaustive pass
+constexpr int COARSE_MAX_DIMENSION = 1920;
+
+// Full-resolution fallback grid (QRs larger than the overlap are found by the coarse pass)
+constexpr int TILE_SIZE = 1024;
+constexpr int TILE_OVERLAP = 256;
+
+ZXing::ImageView luminanceView(const QImage &luminance)
+{
+    return ZXing::ImageView{
+        luminance.constBits(),
+        luminance.width(),
+        luminance.height(),
+        ZXing::ImageFormat::Lum,
+        static_cast<int>(luminance.bytesPerLine())
+    };
+}
+
+ZXing::ReaderOptions exhaustiveOptions()
+{
+    ZXing::ReaderOptions options;
+    options.setFormats(ZXing::BarcodeFormat::QRCode);
+    options.setTryHarder(true);
+    options.setTryRotate(true);
+    options.setTryInvert(true);
+    return options;
+}
+
+// Bounding box of a detected symbol, scaled back to full resolution and padded
+// for quiet zone and downscaling error
+QRect candidateRegion(const ZXing::Position &position, double scale, const QRect &bounds)
+{
+    int minX = position[0].x;
+    int maxX = position[0].x;
+    int minY = position[0].y;
+    int maxY = position[0].y;
+    for (const auto &point : position) {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    const QRect region(QPoint(static_cast<int>(minX / scale), static_cast<int>(minY / scale)),
+                       QPoint(static_cast<int>(maxX / scale), static_cast<int>(maxY / scale)));
+    const int padding = std::max(region.width(), region.height()) / 2 + 16;
+    return region.adjusted(-padding, -padding, padding, padding).intersected(bounds);
+}
+
+QList<QRect> tileGrid(const QSize &size)
+{
+    QList<QRect> tiles;
+    const int step = TILE_SIZE - TILE_OVERLAP;
+    for (int y = 0; y < size.height(); y += step) {
+        for (int x = 0; x < size.width(); x += step) {
+            tiles.append(QRect(x, y, TILE_SIZE, TILE_SIZE).intersected(QRect(QPoint(0, 0), size)));
+            if (x + TILE_SIZE >= size.width()) {
+                break;
+            }
+        }
+        if (y + TILE_SIZE >= size.height()) {
+            break;
+        }
+    }
+    return tiles;
+}
+
+void appendUnique(QStringList &texts, const QString &text)
+{
+    if (!text.isEmpty() && !texts.contains(text)) {
+        texts.append(text);
+    }
+}
+
+// All symbols in the region - a region may hold several QR codes (bulk export pages)
+QStringList decodeRegion(const QImage &luminance, const QRect &region)
+{
+    const ZXing::ImageView view = luminanceView(luminance).cropped(
+        region.x(), region.y(), region.width(), region.height());
+
+    QStringList texts;
+    for (const auto &result : ZXing::ReadBarcodes(view, exhaustiveOptions())) {
+        if (result.isValid()) {
+            appendUnique(texts, QString::fromStdString(result.text()));
+        }
+    }
+    return texts;
+}
+
+QStringList decodeRegionsInParallel(const QImage &luminance, const QList<QRect> &regions)
+{
+    const QList<QStringList> decoded = QtConcurrent::blockingMapped(regions, [&luminance](const QRect &region) {
+        return decodeRegion(luminance, region);
+    });
+
+    QStringList texts;
+    for (const QStringList &regionTexts : decoded) {
+        for (const QString &text : regionTexts) {
+            appendUnique(texts, text);
+        }
+    }
+    return texts;
+}
+
+} // namespace
+
 Result<QString> QrCodeParser::parse(const QString &imagePath)
 {
     // Check if file exists
@@ -46,51 +159,93 @@ Result<QString> QrCodeParser::parse(const QImage &image)
              << "size:" << image.width() << "x" << image.height()
              << "format:" << image.format();
 
-    // Try with RGB first (better quality)
-    const QImage rgbImage = image.convertToFormat(QImage::Format_RGB888);
+    const QStringList texts = detect(image);
+    if (texts.isEmpty()) {
+        return Result<QString>::error(i18n("No QR code found in image or failed to decode"));
+    }
 
-    // Decode QR code using ZXing-C++
-    const ZXing::ImageView zxingImage{
-        rgbImage.bits(),
-        rgbImage.width(),
-        rgbImage.height(),
-        ZXing::ImageFormat::RGB,
-        static_cast<int>(rgbImage.bytesPerLine())
-    };
+    const QString &decodedText = texts.constFirst();
 
-    ZXing::ReaderOptions options;
-    options.setFormats(ZXing::BarcodeFormat::QRCode);
-    options.setTryHarder(true);
-    options.setTryRotate(true);
-    options.setTryInvert(true);
+    qCDebug(QrCodeParserLog) << "Successfully decoded QR code, length:" << decodedText.length();
 
-    auto result = ZXing::ReadBarcode(zxingImage, options);
+    return Result<QString>::success(decodedText);
+}
 
-    if (!result.isValid()) {
-        qCDebug(QrCodeParserLog) << "Failed with RGB, trying grayscale...";
+Result<QStringList> QrCodeParser::parseAll(const QImage &image)
+{
+    if (image.isNull()) {
+        return Result<QStringList>::error(i18n("Image is null or invalid"));
+    }
 
-        // Try again with grayscale
-        const QImage grayImage = image.convertToFormat(QImage::Format_Grayscale8);
-        const ZXing::ImageView grayZxingImage{
-            grayImage.bits(),
-            grayImage.width(),
-            grayImage.height(),
-            ZXing::ImageFormat::Lum,
-            static_cast<int>(grayImage.bytesPerLine())
-        };
+    const QStringList texts = detect(image);
+    if (texts.isEmpty()) {
+        return Result<QStringList>::error(i18n("No QR code found in image or failed to decode"));
+    }
+
+    qCDebug(QrCodeParserLog) << "Successfully decoded" << texts.size() << "QR codes";
 
-        result = ZXing::ReadBarcode(grayZxingImage, options);
+    return Result<QStringList>::success(texts);
+}
 
-        if (!result.isValid()) {
-            return Result<QString>::error(i18n("No QR code found in image or failed to decode"));
+QStringList QrCodeParser::detect(const QImage &image)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // Single luminance conversion - all passes below read from this buffer
+    const QImage luminance = image.convertToFormat(QImage::Format_Grayscale8);
+    const QRect bounds = luminance.rect();
+
+    // Small images: one exhaustive pass is cheaper than the pipeline
+    const int largerSide = std::max(luminance.width(), luminance.height());
+    if (largerSide <= COARSE_MAX_DIMENSION) {
+        const QStringList texts = decodeRegion(luminance, bounds);
+        qCDebug(QrCodeParserLog) << "Single-pass decode found" << texts.size()
+                                 << "QR codes in" << timer.elapsed() << "ms";
+        return texts;
+    }
+
+    // Coarse pass: downscaled copy, also reports symbols it could locate but not decode
+    const double scale = static_cast<double>(COARSE_MAX_DIMENSION) / largerSide;
+    const QImage coarse = luminance.scaled(qRound(luminance.width() * scale),
+                                           qRound(luminance.height() * scale),
+                                           Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                              .convertToFormat(QImage::Format_Grayscale8);
+
+    ZXing::ReaderOptions coarseOptions;
+    coarseOptions.setFormats(ZXing::BarcodeFormat::QRCode);
+    coarseOptions.setTryHarder(true);
+    coarseOptions.setTryInvert(true);
+    coarseOptions.setReturnErrors(true);
+
+    QStringList texts;
+    QList<QRect> candidates;
+    for (const auto &result : ZXing::ReadBarcodes(luminanceView(coarse), coarseOptions)) {
+        const QRect region = candidateRegion(result.position(), scale, bounds);
+        if (result.isValid()) {
+            appendUnique(texts, QString::fromStdString(result.text()));
+        } else if (!region.isEmpty()) {
+            candidates.append(region);
         }
     }
 
-    const QString decodedText = QString::fromStdString(result.text());
+    qCDebug(QrCodeParserLog) << "Coarse pass at scale" << scale << "decoded" << texts.size()
+                             << "and located" << candidates.size() << "candidates in" << timer.elapsed() << "ms";
 
-    qCDebug(QrCodeParserLog) << "Successfully decoded QR code, length:" << decodedText.length();
+    // Full resolution: candidate regions only, or the tile grid if nothing was located
+    if (texts.isEmpty() && candidates.isEmpty()) {
+        candidates = tileGrid(luminance.size());
+        qCDebug(QrCodeParserLog) << "No candidates, scanning" << candidates.size() << "tiles";
+    }
 
-    return Result<QString>::success(decodedText);
+    if (!candidates.isEmpty()) {
+        for (const QString &text : decodeRegionsInParallel(luminance, candidates)) {
+            appendUnique(texts, text);
+        }
+    }
+
+    qCDebug(QrCodeParserLog) << "Detection pipeline found" << texts.size() << "QR codes in" << timer.elapsed() << "ms";
+    return texts;
 }
 
 } // namespace Daemon
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
 #include <QImage>
 #include "common/result.h"
 
@@ -18,6 +19,13 @@ using Shared::Result;
  *
  * Uses ZXing library to decode QR codes from images (in-memory or from files).
  * Supports common image formats: PNG, JPG, BMP, etc.
+ *
+ * Large images (4K / multi-monitor screenshots) go through a detection
+ * pipeline instead of exhaustive full-resolution scans:
+ * 1. Single luminance (Grayscale8) conversion
+ * 2. Coarse pass on a downscaled copy to locate QR candidates
+ * 3. Full-resolution decoding of only the candidate regions, in parallel
+ * 4. If no candidates were found: parallel decoding of an overlapping tile grid
  */
 class QrCodeParser
 {
@@ -54,7 +62,25 @@ public:
      */
     static Result<QString> parse(const QImage &image);
 
+    /**
+     * @brief Decodes every QR code in an in-memory image
+     * @param image QImage to decode
+     * @return Result with decoded strings (unique, in detection order) on success,
+     *         error message if the image is null or holds no decodable QR code
+     *
+     * Used for bulk import, e.g. a page showing several otpauth:// codes or a
+     * multi-part otpauth-migration:// export.
+     */
+    static Result<QStringList> parseAll(const QImage &image);
+
 private:
+    /**
+     * @brief Runs the detection pipeline
+     * @param image Non-null image
+     * @return Decoded texts (unique, in detection order), empty if none found
+     */
+    static QStringList detect(const QImage &image);
+
     QrCodeParser() = delete; // Utility class - no instances
 };
 
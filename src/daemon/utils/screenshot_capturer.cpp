@@ -23,6 +23,8 @@
 #include <fcntl.h>
 #include <cstring>
 #include <utility>  // std::exchange
+#include <algorithm>
+#include <vector>
 #include <array>
 
 namespace YubiKeyOath {
@@ -81,10 +83,10 @@ ScreenshotCapturer::ScreenshotCapturer(QObject *parent)
 
 ScreenshotCapturer::~ScreenshotCapturer() = default;
 
-ScreenshotCapturer::PipeReadResult ScreenshotCapturer::readPipeData(int fd, int timeout) noexcept
+bool ScreenshotCapturer::streamPipe(int fd, int timeout, const ChunkSink &sink) noexcept
 {
-    QByteArray imageData;
-    std::array<char, PIPE_BUFFER_SIZE> buffer{};
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+    qint64 totalBytes = 0;
 
     QElapsedTimer timer;
     timer.start();
@@ -102,19 +104,19 @@ ScreenshotCapturer::PipeReadResult ScreenshotCapturer::readPipeData(int fd, int
 
         if (selectResult < 0) {
             qCWarning(ScreenshotCaptureLog) << "select() failed:" << strerror(errno);
-            return {.success = false, .data = QByteArray()};
+            return false;
         }
 
         if (selectResult == 0) {
             // Timeout - check if we got some data
-            if (!imageData.isEmpty()) {
+            if (totalBytes > 0) {
                 // Got data but nothing more coming - probably EOF
                 break;
             }
             continue;
         }
 
-        const ssize_t bytesRead = read(fd, buffer.data(), PIPE_BUFFER_SIZE);
+        const ssize_t bytesRead = read(fd, buffer.data(), buffer.size());
 
         if (bytesRead < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
@@ -122,27 +124,125 @@ ScreenshotCapturer::PipeReadResult ScreenshotCapturer::readPipeData(int fd, int
                 continue;
             }
             qCWarning(ScreenshotCaptureLog) << "read() failed:" << strerror(errno);
-            return {.success = false, .data = QByteArray()};
+            return false;
         }
 
         if (bytesRead == 0) {
             // EOF - compositor finished writing
-            qCDebug(ScreenshotCaptureLog) << "EOF reached, total bytes:" << imageData.size();
+            qCDebug(ScreenshotCaptureLog) << "EOF reached, total bytes:" << totalBytes;
             break;
         }
 
-        imageData.append(buffer.data(), bytesRead);
+        totalBytes += bytesRead;
+        if (!sink(buffer.data(), bytesRead)) {
+            break;
+        }
     }
 
-    if (imageData.isEmpty()) {
+    if (totalBytes == 0) {
         qCWarning(ScreenshotCaptureLog) << "No data received from pipe (timeout or empty)";
-        return {.success = false, .data = QByteArray()};
+        return false;
     }
 
-    qCDebug(ScreenshotCaptureLog) << "Received" << imageData.size() << "bytes";
+    qCDebug(ScreenshotCaptureLog) << "Received" << totalBytes << "bytes in" << timer.elapsed() << "ms";
+    return true;
+}
+
+ScreenshotCapturer::PipeReadResult ScreenshotCapturer::readPipeData(int fd, int timeout) noexcept
+{
+    QByteArray imageData;
+    const bool success = streamPipe(fd, timeout, [&imageData](const char *data, qsizetype size) {
+        imageData.append(data, size);
+        return true;
+    });
+
+    if (!success) {
+        return {.success = false, .data = QByteArray()};
+    }
     return {.success = true, .data = imageData};
 }
 
+QImage ScreenshotCapturer::readPipeLuminance(int fd,
+                                             int timeout,
+                                             int width,
+                                             int height,
+                                             int stride,
+                                             const QString &format) noexcept
+{
+    // RGBA8888 is byte-ordered R,G,B,A; ARGB32/RGB32 are native-endian 0xAARRGGBB words
+    const bool byteOrderedRgba = (format == QStringLiteral("RGBA8888"));
+
+    QImage luminance(width, height, QImage::Format_Grayscale8);
+    if (luminance.isNull()) {
+        qCWarning(ScreenshotCaptureLog) << "Failed to allocate luminance image" << width << "x" << height;
+        return {};
+    }
+
+    const auto convertRow = [&](const char *source, int row) {
+        uchar *target = luminance.scanLine(row);
+        for (int x = 0; x < width; ++x) {
+            const char *pixel = source + static_cast<ptrdiff_t>(x) * 4;
+            if (byteOrderedRgba) {
+                target[x] = static_cast<uchar>(qGray(static_cast<uchar>(pixel[0]),
+                                                     static_cast<uchar>(pixel[1]),
+                                                     static_cast<uchar>(pixel[2])));
+            } else {
+                QRgb rgb = 0;
+                memcpy(&rgb, pixel, sizeof(rgb));
+                target[x] = static_cast<uchar>(qGray(rgb));
+            }
+        }
+    };
+
+    // Carry buffer for a row split across two reads
+    QByteArray carry(stride, Qt::Uninitialized);
+    qsizetype carryFill = 0;
+    int row = 0;
+    bool overflow = false;
+
+    const bool success = streamPipe(fd, timeout, [&](const char *data, qsizetype size) {
+        while (size > 0) {
+            if (row >= height) {
+                overflow = true;
+                return false;
+            }
+
+            if (carryFill == 0 && size >= stride) {
+                // Fast path: whole row available in the chunk
+                convertRow(data, row++);
+                data += stride;
+                size -= stride;
+                continue;
+            }
+
+            const qsizetype take = std::min<qsizetype>(stride - carryFill, size);
+            memcpy(carry.data() + carryFill, data, static_cast<size_t>(take));
+            carryFill += take;
+            data += take;
+            size -= take;
+
+            if (carryFill == stride) {
+                convertRow(carry.constData(), row++);
+                carryFill = 0;
+            }
+        }
+        // All rows converted - no need to wait for EOF
+        return row < height;
+    });
+
+    if (!success || overflow || row != height || carryFill != 0) {
+        qCWarning(ScreenshotCaptureLog) << "Data size mismatch";
+        qCWarning(ScreenshotCaptureLog) << "  Expected:" << height << "rows of" << stride << "bytes";
+        qCWarning(ScreenshotCaptureLog) << "  Received:" << row << "full rows, overflow:" << overflow;
+        return {};
+    }
+
+    qCDebug(ScreenshotCaptureLog) << "Luminance screenshot streamed:" << width << "x" << height
+                                  << "(" << luminance.sizeInBytes() << "bytes instead of"
+                                  << static_cast<qint64>(stride) * height << ")";
+    return luminance;
+}
+
 QImage ScreenshotCapturer::imageFromData(const QByteArray& data,
                                          int width,
                                          int height,
@@ -188,7 +288,7 @@ QImage ScreenshotCapturer::imageFromData(const QByteArray& data,
     return image;
 }
 
-void ScreenshotCapturer::performCapture(int timeout)
+void ScreenshotCapturer::performCapture(int timeout, CaptureMode mode)
 {
     qCDebug(ScreenshotCaptureLog) << "Using KWin ScreenShot2 for async capture";
 
@@ -232,6 +332,13 @@ void ScreenshotCapturer::performCapture(int timeout)
     ScopedFileDescriptor readFd(pipeFds[0]);
     ScopedFileDescriptor writeFd(pipeFds[1]);
 
+#ifdef F_SETPIPE_SZ
+    // Larger pipe lets the compositor write ahead while rows are converted
+    if (fcntl(readFd.get(), F_SETPIPE_SZ, STREAM_PIPE_CAPACITY) < 0) {
+        qCDebug(ScreenshotCaptureLog) << "Could not enlarge pipe buffer:" << strerror(errno);
+    }
+#endif
+
     qCDebug(ScreenshotCaptureLog) << "Created pipe [read:" << readFd.get() << ", write:" << writeFd.get() << "]";
 
     // 3. Create D-Bus file descriptor (write end)
@@ -274,14 +381,16 @@ void ScreenshotCapturer::performCapture(int timeout)
     const int width = metadata.value(QStringLiteral("width")).toInt();
     const int height = metadata.value(QStringLiteral("height")).toInt();
     const QString format = metadata.value(QStringLiteral("format")).toString();
+    const int stride = metadata.value(QStringLiteral("stride"), width * 4).toInt();
 
     qCDebug(ScreenshotCaptureLog) << "Metadata from KWin:";
     qCDebug(ScreenshotCaptureLog) << "  - Width:" << width;
     qCDebug(ScreenshotCaptureLog) << "  - Height:" << height;
     qCDebug(ScreenshotCaptureLog) << "  - Format:" << format;
+    qCDebug(ScreenshotCaptureLog) << "  - Stride:" << stride;
 
-    if (width <= 0 || height <= 0) {
-        qCWarning(ScreenshotCaptureLog) << "Invalid dimensions:" << width << "x" << height;
+    if (width <= 0 || height <= 0 || stride < width * 4) {
+        qCWarning(ScreenshotCaptureLog) << "Invalid dimensions:" << width << "x" << height << "stride" << stride;
         Q_EMIT cancelled();
         return;
     }
@@ -294,12 +403,18 @@ void ScreenshotCapturer::performCapture(int timeout)
 
     // Simplified lambda using extracted methods
     const QFuture<QPair<bool, QImage>> future = QtConcurrent::run(
-        [fd, width, height, format, timeout]() -> QPair<bool, QImage>
+        [fd, width, height, stride, format, timeout, mode]() -> QPair<bool, QImage>
     {
         const ScopedFileDescriptor scopedFd(fd);  // RAII ensures cleanup
 
         qCDebug(ScreenshotCaptureLog) << "Background thread reading from pipe...";
 
+        if (mode == CaptureMode::Luminance) {
+            // Convert while streaming - no full-size RGBA buffer
+            const QImage luminance = readPipeLuminance(scopedFd.get(), timeout, width, height, stride, format);
+            return qMakePair(!luminance.isNull(), luminance);
+        }
+
         // Read raw pixel data from pipe
         auto [success, data] = readPipeData(scopedFd.get(), timeout);
         if (!success) {
@@ -359,7 +474,17 @@ void ScreenshotCapturer::captureFullscreen(int timeout)
     }
 
     // KWin ScreenShot2 is the only supported backend
-    performCapture(timeout);
+    performCapture(timeout, CaptureMode::Color);
+}
+
+void ScreenshotCapturer::captureLuminance(int timeout)
+{
+    if (timeout <= 0 || timeout > MAX_TIMEOUT_MS) {
+        qCWarning(ScreenshotCaptureLog) << "Invalid timeout" << timeout << "ms, using default" << DEFAULT_TIMEOUT_MS << "ms";
+        timeout = DEFAULT_TIMEOUT_MS;
+    }
+
+    performCapture(timeout, CaptureMode::Luminance);
 }
 
 } // namespace Daemon
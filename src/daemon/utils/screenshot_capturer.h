@@ -8,6 +8,7 @@
 #include <QObject>
 #include <QString>
 #include <QImage>
+#include <functional>
 #include "common/result.h"
 
 // Forward declarations
@@ -89,6 +90,18 @@ public:
      */
     void captureFullscreen(int timeout = 60000);
 
+    /**
+     * @brief Captures a fullscreen screenshot as 8-bit luminance (for QR decoding)
+     * @param timeout Timeout in milliseconds (default 60000 = 60 seconds)
+     *
+     * Same flow as captureFullscreen(), but pixels are converted to luminance
+     * row by row while streaming from the pipe. The full RGBA image is never
+     * held in memory - only a Format_Grayscale8 image (a quarter of the size)
+     * and one row of carry-over. Emits captured() with the grayscale image,
+     * which QrCodeParser consumes without further conversion.
+     */
+    void captureLuminance(int timeout = 60000);
+
 Q_SIGNALS:
     /**
      * @brief Emitted when screenshot capture completes
@@ -102,15 +115,41 @@ Q_SIGNALS:
     void cancelled();
 
 private:
+    /**
+     * @brief Output of a capture
+     */
+    enum class CaptureMode {
+        Color,      ///< Full-color QImage in compositor format
+        Luminance   ///< Format_Grayscale8, converted while streaming
+    };
+
     /**
      * @brief Performs the screenshot capture operation
      * @param timeout Timeout in milliseconds
+     * @param mode Output image kind
      *
      * Implementation: Creates Unix pipe, calls D-Bus CaptureWorkspace,
      * then reads pixel data in background thread.
      * Emits captured() or cancelled() signals.
      */
-    void performCapture(int timeout);
+    void performCapture(int timeout, CaptureMode mode);
+
+    /**
+     * @brief Receives pipe data chunks; returns false to stop reading
+     */
+    using ChunkSink = std::function<bool(const char *data, qsizetype size)>;
+
+    /**
+     * @brief Reads Unix pipe in chunks and hands each chunk to a sink
+     * @param fd File descriptor to read from
+     * @param timeout Timeout in milliseconds
+     * @param sink Chunk consumer
+     * @return true if any data was received and no I/O error occurred
+     *
+     * Reads until EOF, sink stop, timeout, or a quiet period after data.
+     * Uses select() for timeout handling and handles EAGAIN/EWOULDBLOCK.
+     */
+    static bool streamPipe(int fd, int timeout, const ChunkSink &sink) noexcept;
 
     /**
      * @brief Result of pipe reading operation
@@ -126,8 +165,7 @@ private:
      * @param timeout Timeout in milliseconds
      * @return Result with data on success, empty on failure
      *
-     * Reads data in chunks using select() for timeout handling.
-     * Automatically handles EAGAIN/EWOULDBLOCK and EOF.
+     * Accumulates all chunks from streamPipe() into one buffer.
      */
     static PipeReadResult readPipeData(int fd, int timeout) noexcept;
 
@@ -148,10 +186,31 @@ private:
                                 int height,
                                 const QString& format) noexcept;
 
+    /**
+     * @brief Streams pixel data from pipe directly into a luminance image
+     * @param fd File descriptor to read from
+     * @param timeout Timeout in milliseconds
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param stride Bytes per source row (>= width * 4)
+     * @param format KWin format string (e.g., "ARGB32", "RGBA8888")
+     * @return Format_Grayscale8 image, null QImage on failure or size mismatch
+     *
+     * Full rows are converted straight from the read chunk; only a row split
+     * across two reads is copied into a one-row carry buffer.
+     */
+    static QImage readPipeLuminance(int fd,
+                                    int timeout,
+                                    int width,
+                                    int height,
+                                    int stride,
+                                    const QString &format) noexcept;
+
     // Constants for timeouts and buffer sizes
     static constexpr int DEFAULT_TIMEOUT_MS = 60000;
     static constexpr int MAX_TIMEOUT_MS = 300000;  // 5 minutes
-    static constexpr int PIPE_BUFFER_SIZE = 4096;
+    static constexpr int STREAM_CHUNK_SIZE = 64 * 1024;     // Default Linux pipe capacity
+    static constexpr int STREAM_PIPE_CAPACITY = 1024 * 1024; // Requested via F_SETPIPE_SZ
     static constexpr int SELECT_TIMEOUT_SEC = 1;
 };
 
@@ -7,6 +7,9 @@
 
 #include <cstring>
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 // Check for explicit_bzero availability
 #if defined(__GLIBC__) && \
     (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 25))
@@ -86,5 +89,103 @@ void SecureMemory::wipeByteArray(QByteArray &data)
     data.clear();
 }
 
+SecureMemory::LockedSecretMap::LockedSecretMap(qsizetype capacityBytes)
+{
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const qsizetype page = pageSize > 0 ? static_cast<qsizetype>(pageSize) : 4096;
+    const qsizetype size = ((qMax<qsizetype>(capacityBytes, 1) + page - 1) / page) * page;
+
+    void *region = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return;
+    }
+
+    // Keep secrets out of swap; may fail under RLIMIT_MEMLOCK, region stays usable
+    m_locked = mlock(region, static_cast<size_t>(size)) == 0;
+#ifdef MADV_DONTDUMP
+    // Keep secrets out of core dumps
+    madvise(region, static_cast<size_t>(size), MADV_DONTDUMP);
+#endif
+
+    m_buffer = static_cast<QChar *>(region);
+    m_capacityBytes = size;
+}
+
+SecureMemory::LockedSecretMap::~LockedSecretMap()
+{
+    if (!m_buffer) {
+        return;
+    }
+
+    secure_zero(m_buffer, static_cast<size_t>(m_capacityBytes));
+    if (m_locked) {
+        munlock(m_buffer, static_cast<size_t>(m_capacityBytes));
+    }
+    munmap(m_buffer, static_cast<size_t>(m_capacityBytes));
+}
+
+bool SecureMemory::LockedSecretMap::insert(const QString &key, const QString &secret)
+{
+    remove(key);
+
+    if (!m_buffer) {
+        return false;
+    }
+
+    const qsizetype capacityChars = m_capacityBytes / static_cast<qsizetype>(sizeof(QChar));
+    if (m_usedChars + secret.length() > capacityChars) {
+        return false;
+    }
+
+    std::memcpy(m_buffer + m_usedChars, secret.constData(),
+                static_cast<size_t>(secret.length()) * sizeof(QChar));
+    m_slots.insert(key, Slot{m_usedChars, secret.length()});
+    m_usedChars += secret.length();
+    return true;
+}
+
+SecureMemory::SecureString SecureMemory::LockedSecretMap::value(const QString &key) const
+{
+    const auto it = m_slots.constFind(key);
+    if (it == m_slots.constEnd()) {
+        return {};
+    }
+    return SecureString(QString(m_buffer + it->offset, it->length));
+}
+
+void SecureMemory::LockedSecretMap::remove(const QString &key)
+{
+    const auto it = m_slots.constFind(key);
+    if (it == m_slots.constEnd()) {
+        return;
+    }
+
+    const Slot removed = *it;
+    m_slots.erase(it);
+
+    // Compact: move tail down over the removed secret, then wipe the freed end
+    const qsizetype tailChars = m_usedChars - (removed.offset + removed.length);
+    std::memmove(m_buffer + removed.offset, m_buffer + removed.offset + removed.length,
+                 static_cast<size_t>(tailChars) * sizeof(QChar));
+    m_usedChars -= removed.length;
+    secure_zero(m_buffer + m_usedChars, static_cast<size_t>(removed.length) * sizeof(QChar));
+
+    for (auto &slot : m_slots) {
+        if (slot.offset > removed.offset) {
+            slot.offset -= removed.length;
+        }
+    }
+}
+
+void SecureMemory::LockedSecretMap::clear()
+{
+    if (m_buffer) {
+        secure_zero(m_buffer, static_cast<size_t>(m_usedChars) * sizeof(QChar));
+    }
+    m_usedChars = 0;
+    m_slots.clear();
+}
+
 } // namespace Daemon
 } // namespace YubiKeyOath
@@ -7,6 +7,7 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QHash>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -109,6 +110,92 @@ public:
         QString m_data;
     };
 
+    /**
+     * @brief Key → secret map backed by a locked, non-dumpable memory region
+     *
+     * Secret characters live in a single page-aligned region that is
+     * mlock()ed (never swapped) and excluded from core dumps where the
+     * platform supports it. Removed entries are wiped and the region is
+     * compacted; the whole region is wiped before it is released.
+     *
+     * Keys are kept in a regular QHash - only the values are protected.
+     * Not thread-safe - owner must serialize access.
+     *
+     * Example:
+     * @code
+     * LockedSecretMap cache;
+     * cache.insert(QStringLiteral("device1"), password);
+     * const SecureString pw = cache.value(QStringLiteral("device1"));
+     * @endcode
+     */
+    class LockedSecretMap
+    {
+    public:
+        static constexpr qsizetype DEFAULT_CAPACITY_BYTES = 16 * 1024;
+
+        /**
+         * @brief Allocates and locks the secret region
+         * @param capacityBytes Region size (rounded up to whole pages)
+         */
+        explicit LockedSecretMap(qsizetype capacityBytes = DEFAULT_CAPACITY_BYTES);
+
+        /**
+         * @brief Destructor - wipes, unlocks and releases the region
+         */
+        ~LockedSecretMap();
+
+        LockedSecretMap(const LockedSecretMap &) = delete;
+        LockedSecretMap &operator=(const LockedSecretMap &) = delete;
+
+        /**
+         * @brief Stores secret for key (replaces existing value)
+         * @return false if the region is unavailable or full
+         */
+        bool insert(const QString &key, const QString &secret);
+
+        /**
+         * @brief Returns copy of secret for key (empty if not found)
+         */
+        SecureString value(const QString &key) const;
+
+        /**
+         * @brief Checks if key has a stored secret
+         */
+        bool contains(const QString &key) const { return m_slots.contains(key); }
+
+        /**
+         * @brief Wipes and removes secret for key
+         */
+        void remove(const QString &key);
+
+        /**
+         * @brief Wipes and removes all secrets
+         */
+        void clear();
+
+        /**
+         * @brief Number of stored secrets
+         */
+        qsizetype size() const { return m_slots.size(); }
+
+        /**
+         * @brief Whether the region is locked in RAM (mlock may fail under RLIMIT_MEMLOCK)
+         */
+        bool isLocked() const { return m_locked; }
+
+    private:
+        struct Slot {
+            qsizetype offset;  ///< Offset in QChars
+            qsizetype length;  ///< Length in QChars
+        };
+
+        QChar *m_buffer{nullptr};
+        qsizetype m_capacityBytes{0};
+        qsizetype m_usedChars{0};
+        QHash<QString, Slot> m_slots;
+        bool m_locked{false};
+    };
+
 private:
     SecureMemory() = delete;  // Static utility class
 };
@@ -31,22 +31,28 @@ int calculateNotificationDuration(const ConfigurationProvider *config)
 
 TimerProgress calculateTimerProgress(
     const QDateTime &expirationTime,
-    int totalSeconds)
+    int totalSeconds,
+    int frameMs)
 {
     TimerProgress progress{};
 
-    qint64 const now = QDateTime::currentSecsSinceEpoch();
-    qint64 const expiration = expirationTime.toSecsSinceEpoch();
+    qint64 const remainingMs = QDateTime::currentDateTime().msecsTo(expirationTime);
 
-    progress.remainingSeconds = static_cast<int>(expiration - now);
     progress.totalSeconds = totalSeconds;
-    progress.expired = progress.remainingSeconds <= 0;
+    progress.expired = remainingMs <= 0;
 
     if (progress.expired) {
         progress.progressPercent = 0;
         progress.remainingSeconds = 0;
     } else {
-        progress.progressPercent = (progress.remainingSeconds * 100) / totalSeconds;
+        // Round up: the countdown shows N until N seconds are left, and the
+        // progress bar holds its value for the whole frame
+        progress.remainingSeconds = static_cast<int>((remainingMs + 999) / 1000);
+        const qint64 frame = qMax(1, frameMs);
+        const qint64 shownMs = ((remainingMs + frame - 1) / frame) * frame;
+        progress.progressPercent = totalSeconds > 0
+            ? static_cast<int>(qMin<qint64>(100, (shownMs * 100) / (static_cast<qint64>(totalSeconds) * 1000)))
+            : 0;
     }
 
     return progress;
@@ -53,12 +53,15 @@ struct TimerProgress {
  *
  * @param expirationTime When the timer expires
  * @param totalSeconds Total duration of countdown
- * @return Progress information struct
+ * @param frameMs Progress granularity; the remaining time is rounded up to
+ *        whole frames, so the percentage is stable within a frame
+ * @return Progress information struct (remaining seconds rounded up)
  *
  * @note Thread-safe
  */
 TimerProgress calculateTimerProgress(const QDateTime &expirationTime,
-                                     int totalSeconds);
+                                     int totalSeconds,
+                                     int frameMs = 1000);
 
 } // namespace NotificationHelper
 
@@ -15,32 +15,35 @@
 #include <KNotification>
 #include <QTimer>
 #include <QDebug>
+#include <algorithm>
 
 namespace YubiKeyOath {
 namespace Daemon {
 using namespace YubiKeyOath::Shared;
 
+namespace {
+// Upper bound for the user-configured countdown frame rate
+constexpr int MAX_FRAME_RATE = 10;
+constexpr int MS_PER_SECOND = 1000;
+} // namespace
+
 NotificationOrchestrator::NotificationOrchestrator(DBusNotificationManager *notificationManager,
                                                    const ConfigurationProvider *config,
                                                    QObject *parent)
     : QObject(parent)
     , m_notificationManager(notificationManager)
     , m_config(config)
+    , m_ticker(new QTimer(this))
 {
-    // Initialize timers (owned by this QObject)
-    m_code.timer = new QTimer(this);
     m_code.urgency = NotificationUrgency::Critical;
-    m_touch.timer = new QTimer(this);
     m_touch.urgency = NotificationUrgency::Critical;
-    m_modifier.timer = new QTimer(this);
     m_modifier.urgency = NotificationUrgency::Normal;
-    m_reconnect.timer = new QTimer(this);
     m_reconnect.urgency = NotificationUrgency::Critical;
 
-    connect(m_code.timer, &QTimer::timeout, this, &NotificationOrchestrator::updateCodeNotification);
-    connect(m_touch.timer, &QTimer::timeout, this, &NotificationOrchestrator::updateTouchNotification);
-    connect(m_modifier.timer, &QTimer::timeout, this, &NotificationOrchestrator::updateModifierNotification);
-    connect(m_reconnect.timer, &QTimer::timeout, this, &NotificationOrchestrator::updateReconnectNotification);
+    // One ticker for all countdowns, re-armed for the next visible change
+    m_ticker->setSingleShot(true);
+    m_ticker->setTimerType(Qt::PreciseTimer);
+    connect(m_ticker, &QTimer::timeout, this, &NotificationOrchestrator::onTick);
 
     connect(m_notificationManager, &DBusNotificationManager::actionInvoked,
             this, &NotificationOrchestrator::onNotificationActionInvoked);
@@ -56,7 +59,69 @@ void NotificationOrchestrator::closeTimedNotification(TimedNotificationState &st
         m_notificationManager->closeNotification(state.id);
         state.id = 0;
     }
-    state.timer->stop();
+    state.counting = false;
+    scheduleTick();
+}
+
+void NotificationOrchestrator::startCountdown(TimedNotificationState &state, int totalSeconds)
+{
+    state.counting = true;
+    state.shownSeconds = totalSeconds;
+    state.shownPercent = 100;
+    scheduleTick();
+}
+
+void NotificationOrchestrator::scheduleTick()
+{
+    const int frameMs = frameIntervalMs();
+    const QDateTime now = QDateTime::currentDateTime();
+
+    int delayMs = -1;
+    for (const TimedNotificationState *state : {&m_code, &m_touch, &m_modifier, &m_reconnect}) {
+        if (!state->counting) {
+            continue;
+        }
+
+        // Frames are counted back from the expiration time, so the displayed
+        // seconds change exactly on a frame (next second boundary always wins)
+        const qint64 remainingMs = now.msecsTo(state->expirationTime);
+        int stateDelayMs = 0;
+        if (remainingMs > 0) {
+            const auto untilSecond = static_cast<int>(remainingMs % MS_PER_SECOND);
+            const auto untilFrame = static_cast<int>(remainingMs % frameMs);
+            stateDelayMs = std::min(untilSecond == 0 ? MS_PER_SECOND : untilSecond,
+                                    untilFrame == 0 ? frameMs : untilFrame);
+        }
+        delayMs = (delayMs < 0) ? stateDelayMs : std::min(delayMs, stateDelayMs);
+    }
+
+    if (delayMs < 0) {
+        m_ticker->stop();
+        return;
+    }
+    m_ticker->start(delayMs);
+}
+
+int NotificationOrchestrator::frameIntervalMs() const
+{
+    return MS_PER_SECOND / std::clamp(m_config->notificationFrameRate(), 1, MAX_FRAME_RATE);
+}
+
+void NotificationOrchestrator::onTick()
+{
+    if (m_code.counting) {
+        updateCodeNotification();
+    }
+    if (m_touch.counting) {
+        updateTouchNotification();
+    }
+    if (m_modifier.counting) {
+        updateModifierNotification();
+    }
+    if (m_reconnect.counting) {
+        updateReconnectNotification();
+    }
+    scheduleTick();
 }
 
 void NotificationOrchestrator::showCodeNotification(const QString &code,
@@ -109,8 +174,8 @@ void NotificationOrchestrator::showCodeNotification(const QString &code,
     qCDebug(NotificationOrchestratorLog) << "Code notification shown with ID:" << m_code.id
                                          << "device icon:" << iconName;
 
-    // Start timer to update notification every second with progress bar
-    m_code.timer->start(1000);
+    // Update countdown and progress bar via the shared ticker
+    startCountdown(m_code, expirationSeconds);
 }
 
 void NotificationOrchestrator::showTouchNotification(const QString &credentialName,
@@ -167,8 +232,8 @@ void NotificationOrchestrator::showTouchNotification(const QString &credentialNa
     qCDebug(NotificationOrchestratorLog) << "Touch notification shown with ID:" << m_touch.id
                                          << "device icon:" << iconName;
 
-    // Start timer to update notification every second with progress bar
-    m_touch.timer->start(1000);
+    // Update countdown and progress bar via the shared ticker
+    startCountdown(m_touch, timeoutSeconds);
 }
 
 void NotificationOrchestrator::closeTouchNotification()
@@ -290,8 +355,8 @@ void NotificationOrchestrator::showModifierReleaseNotification(const QStringList
 
     qCDebug(NotificationOrchestratorLog) << "Modifier notification shown with ID:" << m_modifier.id;
 
-    // Start timer to update notification every second with progress bar
-    m_modifier.timer->start(1000);
+    // Update countdown and progress bar via the shared ticker
+    startCountdown(m_modifier, timeoutSeconds);
 }
 
 void NotificationOrchestrator::closeModifierNotification()
@@ -375,8 +440,8 @@ void NotificationOrchestrator::showReconnectNotification(const QString &deviceNa
     qCDebug(NotificationOrchestratorLog) << "Reconnect notification shown with ID:" << m_reconnect.id
                                          << "device icon:" << iconName;
 
-    // Start timer to update notification every second with progress bar
-    m_reconnect.timer->start(1000);
+    // Update countdown and progress bar via the shared ticker
+    startCountdown(m_reconnect, timeoutSeconds);
 }
 
 void NotificationOrchestrator::closeReconnectNotification()
@@ -392,12 +457,13 @@ void NotificationOrchestrator::updateNotificationWithProgress(
     const std::function<void()>& onExpired)
 {
     if (state.id == 0 || !m_notificationManager) {
-        state.timer->stop();
+        state.counting = false;
         return;
     }
 
     // Calculate timer progress using helper
-    auto progress = NotificationHelper::calculateTimerProgress(state.expirationTime, totalSeconds);
+    auto progress = NotificationHelper::calculateTimerProgress(state.expirationTime, totalSeconds,
+                                                             frameIntervalMs());
 
     if (progress.expired) {
         // Time's up - handle expiration
@@ -408,11 +474,18 @@ void NotificationOrchestrator::updateNotificationWithProgress(
             qCDebug(NotificationOrchestratorLog) << "Notification expired, closing";
             m_notificationManager->closeNotification(state.id);
             state.id = 0;
-            state.timer->stop();
+            state.counting = false;
         }
         return;
     }
 
+    // Nothing visible changed since the last update - don't re-send
+    if (progress.remainingSeconds == state.shownSeconds && progress.progressPercent == state.shownPercent) {
+        return;
+    }
+    state.shownSeconds = progress.remainingSeconds;
+    state.shownPercent = progress.progressPercent;
+
     qCDebug(NotificationOrchestratorLog) << "Updating notification - remaining:" << progress.remainingSeconds
              << "progress:" << progress.progressPercent << "%"
              << "urgency:" << state.urgency;
@@ -460,7 +533,7 @@ void NotificationOrchestrator::updateTouchNotification()
         [this]() {
             // Custom expiration behavior: show timeout message
             qCDebug(NotificationOrchestratorLog) << "Touch timeout, showing timeout message";
-            m_touch.timer->stop();
+            m_touch.counting = false;
 
             QString const body = i18n("Operation cancelled");
             QVariantMap const hints = NotificationUtils::createNotificationHints(1, 0); // 0% - timeout reached
@@ -516,7 +589,7 @@ void NotificationOrchestrator::updateReconnectNotification()
         [this]() {
             // Custom expiration behavior: notification already handled by ReconnectWorkflowCoordinator
             qCDebug(NotificationOrchestratorLog) << "Reconnect timeout reached";
-            m_reconnect.timer->stop();
+            m_reconnect.counting = false;
         }
     );
 }
@@ -543,16 +616,17 @@ void NotificationOrchestrator::onNotificationClosed(uint id, uint reason)
     if (id == m_code.id) {
         qCDebug(NotificationOrchestratorLog) << "Code notification closed";
         m_code.id = 0;
-        m_code.timer->stop();
+        m_code.counting = false;
     } else if (id == m_touch.id) {
         qCDebug(NotificationOrchestratorLog) << "Touch notification closed";
         m_touch.id = 0;
-        m_touch.timer->stop();
+        m_touch.counting = false;
     } else if (id == m_modifier.id) {
         qCDebug(NotificationOrchestratorLog) << "Modifier notification closed";
         m_modifier.id = 0;
-        m_modifier.timer->stop();
+        m_modifier.counting = false;
     }
+    scheduleTick();
 }
 
 } // namespace Daemon
@@ -31,16 +31,18 @@ class DBusNotificationManager;
  * @brief Common state for a timed notification with countdown
  *
  * Groups the fields that every countdown-based notification needs:
- * ID, timer, expiration time, urgency, and icon name.
- * Type-specific fields (credential name, code text, etc.) remain
- * as separate members in NotificationOrchestrator.
+ * ID, countdown flag, expiration time, urgency, icon name and the values
+ * last sent to the server. Type-specific fields (credential name, code
+ * text, etc.) remain as separate members in NotificationOrchestrator.
  */
 struct TimedNotificationState {
     uint id = 0;                  ///< D-Bus notification ID (0 = inactive)
-    QTimer *timer = nullptr;      ///< Countdown update timer (owned by parent QObject)
+    bool counting = false;        ///< Countdown is driven by the shared ticker
     QDateTime expirationTime;     ///< When notification expires
     uchar urgency = 1;           ///< Urgency level (0=Low, 1=Normal, 2=Critical)
     QString iconName;             ///< Device-specific icon theme name
+    int shownSeconds = -1;        ///< Countdown value currently displayed
+    int shownPercent = -1;        ///< Progress bar value currently displayed
 
     [[nodiscard]] bool isActive() const { return id != 0; }
 };
@@ -58,7 +60,15 @@ struct TimedNotificationState {
  *
  * @par Design Pattern
  * Uses DBusNotificationManager for D-Bus communication, avoiding KNotification
- * server limitations. Implements manual countdown with QTimer for precise control.
+ * server limitations. Implements manual countdown for precise control.
+ *
+ * @par Countdown Updates
+ * All countdowns share one single-shot ticker that only runs while a countdown
+ * is active. It is re-armed for the next frame boundary of the nearest
+ * countdown (aligned to the displayed seconds), and a notification is re-sent
+ * only when its countdown text or progress value changed. The frame rate
+ * (ConfigurationProvider::notificationFrameRate()) trades update frequency for
+ * smoother progress bars; the number of updates is bounded by visible changes.
  *
  * @par Thread Safety
  * All public methods must be called from the main/UI thread (QObject-based).
@@ -275,6 +285,7 @@ Q_SIGNALS:
     void reconnectCancelled();
 
 private Q_SLOTS:
+    void onTick();
     void updateCodeNotification();
     void updateTouchNotification();
     void updateModifierNotification();
@@ -304,14 +315,33 @@ private:
     );
 
     /**
-     * @brief Closes a timed notification and stops its timer
+     * @brief Closes a timed notification and stops its countdown
      * @param state Notification state to close
      */
     void closeTimedNotification(TimedNotificationState &state);
 
+    /**
+     * @brief Starts the countdown of a just-shown notification
+     * @param state Notification state (id and expirationTime already set)
+     * @param totalSeconds Countdown value shown initially (progress 100%)
+     */
+    void startCountdown(TimedNotificationState &state, int totalSeconds);
+
+    /**
+     * @brief Arms the shared ticker for the next visible change, or stops it
+     */
+    void scheduleTick();
+
+    /**
+     * @brief Duration of one countdown frame from the configured frame rate
+     */
+    int frameIntervalMs() const;
+
     DBusNotificationManager *m_notificationManager;
     const ConfigurationProvider *m_config;
 
+    QTimer *m_ticker;                 ///< Shared countdown ticker (single-shot, re-armed per frame)
+
     // Code notification state
     TimedNotificationState m_code;    ///< urgency=Critical
     int m_codeTotalSeconds = 0;
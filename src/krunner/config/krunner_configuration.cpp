@@ -87,6 +87,12 @@ int KRunnerConfiguration::notificationExtraTime() const
     return readConfigEntry(ConfigKeys::NOTIFICATION_EXTRA_TIME, 15);
 }
 
+int KRunnerConfiguration::notificationFrameRate() const
+{
+    // NOTE: Notifications are shown by the daemon, not KRunner
+    return readConfigEntry(ConfigKeys::NOTIFICATION_FRAME_RATE, 1);
+}
+
 QString KRunnerConfiguration::primaryAction() const
 {
     return readConfigEntry(ConfigKeys::PRIMARY_ACTION, QStringLiteral("copy"));
@@ -120,6 +126,17 @@ bool KRunnerConfiguration::persistPortalSession() const
     return readConfigEntry(ConfigKeys::PERSIST_PORTAL_SESSION, true);
 }
 
+bool KRunnerConfiguration::persistPortalSessionConfigured() const
+{
+    return m_configGroup.hasKey(ConfigKeys::PERSIST_PORTAL_SESSION);
+}
+
+bool KRunnerConfiguration::burstTypeDigits() const
+{
+    // NOTE: Typing is done by the daemon, not KRunner
+    return readConfigEntry(ConfigKeys::BURST_TYPE_DIGITS, false);
+}
+
 void KRunnerConfiguration::onConfigFileChanged(const QString &path)
 {
     qDebug() << "KRunnerConfiguration: Config file changed:" << path;
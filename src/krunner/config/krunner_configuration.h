@@ -44,12 +44,15 @@ public:
     bool showDeviceNameOnlyWhenMultiple() const override;
     int touchTimeout() const override;
     int notificationExtraTime() const override;
+    int notificationFrameRate() const override;
     QString primaryAction() const override;
     int deviceReconnectTimeout() const override;
     bool enableCredentialsCache() const override;
     int credentialSaveRateLimit() const override;
     int pcscRateLimitMs() const override;
     bool persistPortalSession() const override;
+    bool persistPortalSessionConfigured() const override;
+    bool burstTypeDigits() const override;
 
 Q_SIGNALS:
     /**
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "code_prefetcher.h"
+#include "dbus/oath_credential_proxy.h"
+#include "../logging_categories.h"
+
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <utility>
+
+namespace YubiKeyOath {
+namespace Runner {
+
+CodePrefetcher::CodePrefetcher(QObject *parent, RequestFunction request)
+    : QObject(parent)
+    , m_request(std::move(request))
+{
+    if (!m_request) {
+        m_request = [](OathCredentialProxy *credential) {
+            credential->generateCode();  // Fire-and-forget async D-Bus call
+        };
+    }
+
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DEBOUNCE_MS);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &CodePrefetcher::flush);
+}
+
+CodePrefetcher::~CodePrefetcher() = default;
+
+void CodePrefetcher::schedule(const QList<OathCredentialProxy *> &ranked)
+{
+    const qint64 nowSecs = QDateTime::currentSecsSinceEpoch();
+    {
+        const QMutexLocker locker(&m_mutex);
+        m_statistics.debounced += static_cast<int>(m_pending.size());
+        m_statistics.scheduled += static_cast<int>(ranked.size());
+
+        m_pending.clear();
+        m_pending.reserve(ranked.size());
+        for (auto *credential : ranked) {
+            m_pending.append(credential);
+
+            if (credential->requiresTouch() || credential->type() != QStringLiteral("TOTP")) {
+                continue;
+            }
+            const qint64 period = nowSecs / std::max(1, credential->period());
+            auto it = m_requestedPeriods.find(credential->objectPath());
+            if (it == m_requestedPeriods.end()) {
+                m_requestedPeriods.insert(credential->objectPath(), period);
+                ++m_statistics.requested;
+            } else if (it.value() != period) {
+                it.value() = period;
+                ++m_statistics.requested;
+            }
+        }
+    }
+
+    // QTimer can only be restarted from its own thread
+    QMetaObject::invokeMethod(this, &CodePrefetcher::restartTimer, Qt::AutoConnection);
+}
+
+void CodePrefetcher::restartTimer()
+{
+    m_debounceTimer.start();
+}
+
+void CodePrefetcher::flush()
+{
+    QList<QPointer<OathCredentialProxy>> pending;
+    {
+        const QMutexLocker locker(&m_mutex);
+        pending.swap(m_pending);
+    }
+
+    // Drop in-flight markers whose reply never arrived
+    const qint64 now = QDeadlineTimer::current().deadline();
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end();) {
+        if (now - it.value() >= IN_FLIGHT_TIMEOUT_MS) {
+            it = m_inFlight.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    Statistics delta;
+    int considered = 0;
+    for (const auto &credential : std::as_const(pending)) {
+        if (!credential) {
+            continue; // Proxy removed since the query was ranked
+        }
+        if (considered >= PREFETCH_LIMIT) {
+            ++delta.skippedOverLimit;
+            continue;
+        }
+        ++considered;
+
+        if (credential->requiresTouch() || credential->type() != QStringLiteral("TOTP")) {
+            ++delta.skippedIneligible;
+            continue;
+        }
+
+        const QString path = credential->objectPath();
+        if (credential->isCacheValid()) {
+            m_inFlight.remove(path); // Reply arrived
+            ++delta.skippedCached;
+            continue;
+        }
+        if (m_inFlight.contains(path)) {
+            ++delta.skippedInFlight;
+            continue;
+        }
+
+        qCDebug(MatchBuilderLog) << "Pre-fetching code for credential:" << credential->fullName();
+        m_inFlight.insert(path, now);
+        m_request(credential.data());
+        ++delta.sent;
+    }
+
+    Statistics total;
+    {
+        const QMutexLocker locker(&m_mutex);
+        m_statistics.skippedOverLimit += delta.skippedOverLimit;
+        m_statistics.skippedIneligible += delta.skippedIneligible;
+        m_statistics.skippedCached += delta.skippedCached;
+        m_statistics.skippedInFlight += delta.skippedInFlight;
+        m_statistics.sent += delta.sent;
+        total = m_statistics;
+    }
+
+    qCDebug(MatchBuilderLog) << "Pre-fetch flush: sent" << delta.sent
+                             << "cached" << delta.skippedCached
+                             << "in-flight" << delta.skippedInFlight
+                             << "- total sent" << total.sent << "of" << total.requested
+                             << "requested," << total.avoided() << "requests avoided";
+}
+
+void CodePrefetcher::reset()
+{
+    QMetaObject::invokeMethod(this, [this]() { m_inFlight.clear(); }, Qt::AutoConnection);
+}
+
+CodePrefetcher::Statistics CodePrefetcher::statistics() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return m_statistics;
+}
+
+} // namespace Runner
+} // namespace YubiKeyOath
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+namespace YubiKeyOath {
+namespace Shared {
+class OathCredentialProxy;
+}
+
+namespace Runner {
+using Shared::OathCredentialProxy;
+
+/**
+ * @brief Throttled, deduplicated code pre-fetching for KRunner matches
+ *
+ * Single Responsibility: Decide which credentials are worth a GenerateCode
+ * round-trip while the user types
+ *
+ * Every keystroke runs match(), and pre-fetching every visible match turned
+ * a burst of typing into dozens of GenerateCode calls. This class applies
+ * the policy in front of the daemon:
+ *
+ * 1. Debounce: requests are only sent once the query has been stable for
+ *    DEBOUNCE_MS; intermediate rankings are dropped
+ * 2. Top-N cap: only the PREFETCH_LIMIT best ranked candidates are considered
+ * 3. Filter: touch-required, HOTP and already cached credentials are skipped
+ * 4. In-flight dedupe: a credential already requested is not requested
+ *    again until its code arrives or IN_FLIGHT_TIMEOUT_MS passes
+ *
+ * The daemon serves codes seeded from CALCULATE ALL out of its own cache, so
+ * a request that does reach it normally costs no card operation either.
+ *
+ * @par Thread Safety
+ * schedule() may be called from the KRunner worker thread. The timer and
+ * the proxies are only touched on the thread owning this object.
+ */
+class CodePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Pre-fetch counters (cumulative)
+     */
+    struct Statistics {
+        int scheduled{0};        ///< Candidates passed to schedule()
+        int requested{0};        ///< Distinct eligible (credential, TOTP period) pairs passed to schedule()
+        int debounced{0};        ///< Dropped because a newer query superseded them
+        int skippedOverLimit{0}; ///< Ranked below PREFETCH_LIMIT
+        int skippedIneligible{0};///< Touch-required or HOTP
+        int skippedCached{0};    ///< Code already cached in the proxy
+        int skippedInFlight{0};  ///< Request already pending
+        int sent{0};             ///< GenerateCode calls issued
+
+        /**
+         * @brief Lower bound of the GenerateCode calls saved against per-match pre-fetch
+         *
+         * Per-match pre-fetch requests each eligible credential at least once per
+         * period it is shown in; repeated keystrokes are not counted.
+         */
+        [[nodiscard]] int avoided() const { return std::max(0, requested - sent); }
+    };
+
+    using RequestFunction = std::function<void(OathCredentialProxy *)>;
+
+    /**
+     * @brief Constructs pre-fetcher
+     * @param parent Parent object (owner thread receives the timer)
+     * @param request Issues the request; defaults to OathCredentialProxy::generateCode()
+     */
+    explicit CodePrefetcher(QObject *parent = nullptr, RequestFunction request = {});
+    ~CodePrefetcher() override;
+
+    /**
+     * @brief Replaces pending candidates and restarts the debounce timer
+     * @param ranked Credentials sorted by descending relevance
+     *
+     * Thread-safe. Candidates of a previous, not yet flushed call are counted
+     * as debounced.
+     */
+    void schedule(const QList<OathCredentialProxy *> &ranked);
+
+    /**
+     * @brief Sends requests for the pending candidates immediately
+     *
+     * Called by the debounce timer. Must be called on the owner thread.
+     */
+    void flush();
+
+    /**
+     * @brief Forgets in-flight requests (e.g. after daemon restart)
+     */
+    void reset();
+
+    /**
+     * @brief Returns a snapshot of the counters
+     */
+    [[nodiscard]] Statistics statistics() const;
+
+    static constexpr int DEBOUNCE_MS = 250;
+    static constexpr int PREFETCH_LIMIT = 5;
+    static constexpr qint64 IN_FLIGHT_TIMEOUT_MS = 5000;
+
+private:
+    void restartTimer();
+
+    RequestFunction m_request;
+    QTimer m_debounceTimer;
+
+    mutable QMutex m_mutex;
+    QList<QPointer<OathCredentialProxy>> m_pending; // guarded by m_mutex
+    Statistics m_statistics;                        // guarded by m_mutex
+
+    // Object path -> last TOTP period counted in Statistics::requested; guarded by m_mutex
+    QHash<QString, qint64> m_requestedPeriods;
+
+    // Object path -> monotonic send time (ms); owner thread only
+    QHash<QString, qint64> m_inFlight;
+};
+
+} // namespace Runner
+} // namespace YubiKeyOath
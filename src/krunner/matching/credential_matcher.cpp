@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "credential_matcher.h"
+
+#include <algorithm>
+
+namespace YubiKeyOath {
+namespace Runner {
+
+namespace {
+
+// Scoring constants (modelled after fzf's v1 algorithm)
+constexpr int SCORE_MATCH = 16;
+constexpr int SCORE_GAP_START = -3;
+constexpr int SCORE_GAP_EXTENSION = -1;
+constexpr int BONUS_BOUNDARY = 8;
+constexpr int BONUS_CONSECUTIVE = 4;
+constexpr int BONUS_FIRST_CHAR_MULTIPLIER = 2;
+constexpr int BONUS_PREFIX = 8;
+
+// Account matches rank slightly below equivalent name/issuer matches
+constexpr int ACCOUNT_WEIGHT_PERCENT = 90;
+
+constexpr qreal MIN_RELEVANCE = 0.1;
+
+bool isWordBoundary(QStringView text, qsizetype pos)
+{
+    return pos == 0 || !text.at(pos - 1).isLetterOrNumber();
+}
+
+/**
+ * @brief Scores a greedy left-to-right match of needle starting at start
+ * @return Score or -1 if needle cannot be matched from start
+ */
+int scoreFrom(QStringView haystack, QStringView needle, qsizetype start)
+{
+    int score = 0;
+    qsizetype matched = 0;
+    qsizetype firstMatch = -1;
+    qsizetype lastMatch = -1;
+    bool inGap = false;
+
+    for (qsizetype i = start; i < haystack.size() && matched < needle.size(); ++i) {
+        if (haystack.at(i) == needle.at(matched)) {
+            int bonus = 0;
+            if (isWordBoundary(haystack, i)) {
+                bonus = BONUS_BOUNDARY;
+            } else if (lastMatch == i - 1) {
+                bonus = BONUS_CONSECUTIVE;
+            }
+            if (matched == 0) {
+                bonus *= BONUS_FIRST_CHAR_MULTIPLIER;
+                firstMatch = i;
+            }
+            score += SCORE_MATCH + bonus;
+            lastMatch = i;
+            inGap = false;
+            ++matched;
+        } else if (matched > 0) {
+            score += inGap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+            inGap = true;
+        }
+    }
+
+    if (matched < needle.size()) {
+        return -1;
+    }
+
+    if (firstMatch == 0) {
+        score += BONUS_PREFIX;
+    }
+
+    return score;
+}
+
+} // namespace
+
+void CredentialMatcher::setCandidates(const QList<CredentialInfo> &credentials)
+{
+    clearRefinementCache();
+    m_masks.clear();
+    m_entries.clear();
+    m_masks.reserve(credentials.size());
+    m_entries.reserve(credentials.size());
+
+    for (const auto &credential : credentials) {
+        Entry entry{
+            .name = credential.name.toLower(),
+            .issuer = credential.issuer.toLower(),
+            .account = credential.account.toLower()
+        };
+        m_masks.push_back(characterMask(entry.name)
+                          | characterMask(entry.issuer)
+                          | characterMask(entry.account));
+        m_entries.push_back(std::move(entry));
+    }
+}
+
+QList<CredentialMatcher::ScoredCandidate> CredentialMatcher::match(const QString &query, int limit)
+{
+    const QString needle = normalizeQuery(query);
+    if (needle.isEmpty()) {
+        m_lastScannedCount = 0;
+        return {};
+    }
+
+    // Find the longest cached query that needle extends (backspace pops entries)
+    while (!m_refinementStack.empty() && !needle.startsWith(m_refinementStack.back().query)) {
+        m_refinementStack.pop_back();
+    }
+    const std::vector<int> *cachedMatches = m_refinementStack.empty()
+        ? nullptr
+        : &m_refinementStack.back().matches;
+
+    // Prefilter: reject every candidate missing at least one query character
+    const quint64 queryMask = characterMask(needle);
+    std::vector<int> survivors;
+    if (cachedMatches) {
+        m_lastScannedCount = static_cast<int>(cachedMatches->size());
+        survivors.reserve(cachedMatches->size());
+        for (const int index : *cachedMatches) {
+            if ((m_masks[static_cast<size_t>(index)] & queryMask) == queryMask) {
+                survivors.push_back(index);
+            }
+        }
+    } else {
+        m_lastScannedCount = static_cast<int>(m_masks.size());
+        survivors.reserve(m_masks.size());
+        for (size_t i = 0; i < m_masks.size(); ++i) {
+            if ((m_masks[i] & queryMask) == queryMask) {
+                survivors.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    std::vector<ScoredCandidate> scored;
+    scored.reserve(survivors.size());
+    std::vector<int> matches;
+    matches.reserve(survivors.size());
+    for (const int index : survivors) {
+        const int score = scoreEntry(m_entries[static_cast<size_t>(index)], needle);
+        if (score >= 0) {
+            scored.push_back(ScoredCandidate{.index = index, .score = score, .relevance = 0.0});
+            matches.push_back(index);
+        }
+    }
+
+    // Remember the full match set so the next keystroke only rescans it
+    if (m_refinementStack.empty() || m_refinementStack.back().query != needle) {
+        if (m_refinementStack.size() >= MAX_REFINEMENT_DEPTH) {
+            m_refinementStack.erase(m_refinementStack.begin());
+        }
+        m_refinementStack.push_back(RefinementEntry{.query = needle, .matches = std::move(matches)});
+    }
+
+    // Higher score first; shorter names win ties (tighter match), then stable by index
+    const auto byRank = [this](const ScoredCandidate &a, const ScoredCandidate &b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        const auto lengthA = m_entries[static_cast<size_t>(a.index)].name.size();
+        const auto lengthB = m_entries[static_cast<size_t>(b.index)].name.size();
+        if (lengthA != lengthB) {
+            return lengthA < lengthB;
+        }
+        return a.index < b.index;
+    };
+
+    if (limit > 0 && static_cast<size_t>(limit) < scored.size()) {
+        std::partial_sort(scored.begin(), scored.begin() + limit, scored.end(), byRank);
+        scored.resize(static_cast<size_t>(limit));
+    } else {
+        std::sort(scored.begin(), scored.end(), byRank);
+    }
+
+    const auto best = static_cast<qreal>(maxScore(static_cast<int>(needle.size())));
+    QList<ScoredCandidate> results;
+    results.reserve(static_cast<qsizetype>(scored.size()));
+    for (auto &candidate : scored) {
+        const qreal normalized = std::min<qreal>(1.0, candidate.score / best);
+        candidate.relevance = MIN_RELEVANCE + ((1.0 - MIN_RELEVANCE) * normalized);
+        results.append(candidate);
+    }
+
+    return results;
+}
+
+void CredentialMatcher::clearRefinementCache()
+{
+    m_refinementStack.clear();
+}
+
+int CredentialMatcher::scoreField(QStringView haystack, QStringView needle)
+{
+    if (needle.isEmpty()) {
+        return 0;
+    }
+    if (needle.size() > haystack.size()) {
+        return -1;
+    }
+
+    // Contiguous occurrences: pick the best placed one (prefix / word boundary)
+    int best = -1;
+    for (qsizetype pos = haystack.indexOf(needle); pos >= 0; pos = haystack.indexOf(needle, pos + 1)) {
+        best = std::max(best, scoreFrom(haystack, needle, pos));
+    }
+    if (best >= 0) {
+        return best;
+    }
+
+    // Subsequence: forward scan finds the earliest end of a full match...
+    qsizetype matched = 0;
+    qsizetype end = -1;
+    for (qsizetype i = 0; i < haystack.size(); ++i) {
+        if (haystack.at(i) == needle.at(matched)) {
+            if (++matched == needle.size()) {
+                end = i;
+                break;
+            }
+        }
+    }
+    if (end < 0) {
+        return -1;
+    }
+
+    // ...backward scan from there finds the tightest start
+    qsizetype remaining = needle.size() - 1;
+    qsizetype start = end;
+    for (qsizetype i = end; i >= 0; --i) {
+        if (haystack.at(i) == needle.at(remaining)) {
+            start = i;
+            if (remaining-- == 0) {
+                break;
+            }
+        }
+    }
+
+    return scoreFrom(haystack, needle, start);
+}
+
+quint64 CredentialMatcher::characterMask(QStringView text)
+{
+    quint64 mask = 0;
+    for (const QChar ch : text) {
+        const char16_t c = ch.unicode();
+        if (c >= u'a' && c <= u'z') {
+            mask |= quint64{1} << (c - u'a');
+        } else if (c >= u'0' && c <= u'9') {
+            mask |= quint64{1} << (26 + (c - u'0'));
+        } else if (!ch.isSpace()) {
+            mask |= quint64{1} << (36 + (c % 28));
+        }
+    }
+    return mask;
+}
+
+int CredentialMatcher::maxScore(int queryLength)
+{
+    if (queryLength <= 0) {
+        return 1;
+    }
+    // Contiguous match at the start of the haystack
+    return (queryLength * SCORE_MATCH)
+        + (BONUS_BOUNDARY * BONUS_FIRST_CHAR_MULTIPLIER)
+        + ((queryLength - 1) * BONUS_CONSECUTIVE)
+        + BONUS_PREFIX;
+}
+
+QString CredentialMatcher::normalizeQuery(const QString &query)
+{
+    QString normalized;
+    normalized.reserve(query.size());
+    for (const QChar ch : query) {
+        if (!ch.isSpace()) {
+            normalized.append(ch.toLower());
+        }
+    }
+    return normalized;
+}
+
+int CredentialMatcher::scoreEntry(const Entry &entry, QStringView needle)
+{
+    int best = scoreField(entry.name, needle);
+    best = std::max(best, scoreField(entry.issuer, needle));
+
+    const int accountScore = scoreField(entry.account, needle);
+    if (accountScore >= 0) {
+        best = std::max(best, (accountScore * ACCOUNT_WEIGHT_PERCENT) / 100);
+    }
+
+    return best;
+}
+
+} // namespace Runner
+} // namespace YubiKeyOath
@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QStringView>
+#include <vector>
+#include "types/yubikey_value_types.h"
+
+namespace YubiKeyOath {
+namespace Runner {
+using Shared::CredentialInfo;
+
+/**
+ * @brief Fuzzy (subsequence) matching engine for KRunner credential queries
+ *
+ * Single Responsibility: Select and rank credentials for a search query
+ *
+ * @par Pipeline
+ * 1. Index: lowercased name/issuer/account keys and a 64-bit character
+ *    bitmask per credential are precomputed once in setCandidates()
+ * 2. Prefilter: candidates whose bitmask does not contain every query
+ *    character are rejected with a single AND/compare. Masks are stored
+ *    contiguously so the loop stays branch-light and vectorizable.
+ * 3. Scoring: fzf-style subsequence scoring (match, consecutive,
+ *    word-boundary and prefix bonuses, gap penalties) of the surviving
+ *    candidates
+ * 4. Selection: partial sort of the top-K candidates by score
+ *
+ * @par Incremental Refinement
+ * While the user types ("gi" → "git" → "gith"), every query extends the
+ * previous one. A candidate matching "gith" as a subsequence also matches
+ * "git", so match() keeps a prefix-keyed stack of previous queries and
+ * their full (pre top-K) match sets, and only rescans the survivors of the
+ * longest cached prefix. Backspace pops back to the matching stack entry.
+ * The stack is dropped whenever setCandidates() rebuilds the index.
+ *
+ * @par Relevance
+ * Scores are normalized against the best possible score for the query
+ * length (contiguous prefix match), giving a KRunner relevance in 0.1-1.0.
+ *
+ * @par Usage Example
+ * @code
+ * CredentialMatcher matcher;
+ * matcher.setCandidates(credentialInfos);
+ *
+ * const auto results = matcher.match(QStringLiteral("gthb"), 20);
+ * for (const auto &result : results) {
+ *     // credentialInfos.at(result.index) matched with result.relevance
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe. Callers sharing an instance between threads must
+ *       serialize access.
+ */
+class CredentialMatcher
+{
+public:
+    /**
+     * @brief Single ranked match result
+     */
+    struct ScoredCandidate {
+        int index{-1};          ///< Index into the list passed to setCandidates()
+        int score{0};           ///< Raw fuzzy score (higher is better)
+        qreal relevance{0.0};   ///< Normalized KRunner relevance (0.1-1.0)
+    };
+
+    CredentialMatcher() = default;
+
+    /**
+     * @brief Rebuilds the search index
+     * @param credentials Credentials to search; result indices refer to this list
+     */
+    void setCandidates(const QList<CredentialInfo> &credentials);
+
+    /**
+     * @brief Returns number of indexed credentials
+     */
+    [[nodiscard]] int candidateCount() const { return static_cast<int>(m_entries.size()); }
+
+    /**
+     * @brief Finds and ranks credentials matching query
+     * @param query Search query (case-insensitive, whitespace ignored)
+     * @param limit Maximum number of results (top-K); <= 0 returns all matches
+     * @return Matches sorted by descending score
+     *
+     * Narrows the candidate set incrementally when query extends a
+     * previously matched query (see Incremental Refinement).
+     */
+    [[nodiscard]] QList<ScoredCandidate> match(const QString &query, int limit);
+
+    /**
+     * @brief Drops cached candidate sets of previous queries
+     */
+    void clearRefinementCache();
+
+    /**
+     * @brief Returns number of candidates examined by the last match() call
+     *
+     * Equals candidateCount() for a full scan and the size of the cached
+     * candidate set for an incremental refinement.
+     */
+    [[nodiscard]] int lastScannedCount() const { return m_lastScannedCount; }
+
+    /**
+     * @brief Scores needle as a subsequence of haystack
+     * @param haystack Lowercased text to search in
+     * @param needle Lowercased query without whitespace
+     * @return Score (> 0) or -1 when needle is not a subsequence of haystack
+     */
+    [[nodiscard]] static int scoreField(QStringView haystack, QStringView needle);
+
+    /**
+     * @brief Computes character presence bitmask used by the prefilter
+     * @param text Lowercased text
+     * @return Bitmask: a-z in bits 0-25, 0-9 in bits 26-35, other characters hashed into 36-63
+     */
+    [[nodiscard]] static quint64 characterMask(QStringView text);
+
+    /**
+     * @brief Returns best achievable score for a query of given length
+     */
+    [[nodiscard]] static int maxScore(int queryLength);
+
+private:
+    struct Entry {
+        QString name;
+        QString issuer;
+        QString account;
+    };
+
+    [[nodiscard]] static QString normalizeQuery(const QString &query);
+    [[nodiscard]] static int scoreEntry(const Entry &entry, QStringView needle);
+
+    struct RefinementEntry {
+        QString query;              ///< Normalized query
+        std::vector<int> matches;   ///< All matching indices (ascending, before top-K)
+    };
+
+    // Kept separate from m_entries so the prefilter scans one dense array
+    std::vector<quint64> m_masks;
+    std::vector<Entry> m_entries;
+
+    // Prefix chain of recent queries, each entry extending the one below it
+    std::vector<RefinementEntry> m_refinementStack;
+    int m_lastScannedCount{0};
+
+    static constexpr size_t MAX_REFINEMENT_DEPTH = 32;
+};
+
+} // namespace Runner
+} // namespace YubiKeyOath
@@ -15,7 +15,6 @@
 
 #include <KLocalizedString>
 #include <QDebug>
-#include <QMap>
 
 namespace YubiKeyOath {
 namespace Runner {
@@ -30,34 +29,23 @@ MatchBuilder::MatchBuilder(KRunner::AbstractRunner *runner,
 {
 }
 
-KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *credentialProxy,
-                                                       const QString &query,
-                                                       OathManagerProxy *manager)
+MatchContext MatchBuilder::buildMatchContext(const OathManagerProxy *manager) const
 {
-    if (!credentialProxy) {
-        qCWarning(MatchBuilderLog) << "Cannot build match: credential proxy is null";
-        return KRunner::QueryMatch(m_runner);
-    }
-
-    qCDebug(MatchBuilderLog) << "Building match for credential:" << credentialProxy->fullName();
-
-    KRunner::QueryMatch match(m_runner);
+    MatchContext context;
 
     // Get display preferences from config
-    const bool showUsername = m_config->showUsername();
-    const bool showCode = m_config->showCode();
-    const bool showDeviceName = m_config->showDeviceName();
-    const bool showDeviceOnlyWhenMultiple = m_config->showDeviceNameOnlyWhenMultiple();
+    context.showUsername = m_config->showUsername();
+    context.showCode = m_config->showCode();
+    context.showDeviceName = m_config->showDeviceName();
+    context.showDeviceNameOnlyWhenMultiple = m_config->showDeviceNameOnlyWhenMultiple();
 
-    qCDebug(MatchBuilderLog) << "Display preferences - username:" << showUsername
-             << "code:" << showCode
-             << "deviceName:" << showDeviceName
-             << "onlyWhenMultiple:" << showDeviceOnlyWhenMultiple;
+    if (!manager) {
+        return context;
+    }
 
     // Get device information from manager
     const QList<OathDeviceProxy*> devices = manager->devices();
-    QMap<QString, QString> deviceIdToName;
-    int connectedDeviceCount = 0;
+    context.deviceNames.reserve(devices.size());
 
     for (const auto *device : devices) {
         // Use device ID from D-Bus (serial number or "dev_<hex>") as map key
@@ -65,18 +53,63 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
         // device->deviceId() returns D-Bus property "ID" which is either:
         // - Serial number as string (e.g., "20252879")
         // - "dev_<hexhash>" for devices without serial number
-        deviceIdToName[device->deviceId()] = device->name();
+        context.deviceNames.insert(device->deviceId(), device->name());
 
         // Get session proxy for connection state
         const auto *session = manager->getDeviceSession(device->deviceId());
         if (session && session->isConnected()) {
-            connectedDeviceCount++;
+            context.connectedDeviceCount++;
+        }
+        if (session && session->credentialsStale()) {
+            context.staleDeviceIds.insert(device->deviceId());
         }
     }
 
-    qCDebug(MatchBuilderLog) << "Found" << devices.size() << "devices,"
-             << connectedDeviceCount << "connected";
-    qCDebug(MatchBuilderLog) << "Device ID to name map:" << deviceIdToName;
+    qCDebug(MatchBuilderLog) << "Match context: display preferences - username:" << context.showUsername
+             << "code:" << context.showCode
+             << "deviceName:" << context.showDeviceName
+             << "onlyWhenMultiple:" << context.showDeviceNameOnlyWhenMultiple
+             << "-" << devices.size() << "devices," << context.connectedDeviceCount << "connected,"
+             << context.staleDeviceIds.size() << "with cached credentials";
+
+    return context;
+}
+
+KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *credentialProxy,
+                                                       const QString &query,
+                                                       const OathManagerProxy *manager)
+{
+    return buildCredentialMatch(credentialProxy, query, buildMatchContext(manager));
+}
+
+KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *credentialProxy,
+                                                       const QString &query,
+                                                       const MatchContext &context)
+{
+    if (!credentialProxy) {
+        qCWarning(MatchBuilderLog) << "Cannot build match: credential proxy is null";
+        return KRunner::QueryMatch(m_runner);
+    }
+
+    // Convert to CredentialInfo for relevance calculation
+    const qreal relevance = calculateRelevance(credentialProxy->toCredentialInfo(), query);
+    return buildCredentialMatch(credentialProxy, relevance, context);
+}
+
+KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *credentialProxy,
+                                                       qreal relevance,
+                                                       const MatchContext &context)
+{
+    if (!credentialProxy) {
+        qCWarning(MatchBuilderLog) << "Cannot build match: credential proxy is null";
+        return KRunner::QueryMatch(m_runner);
+    }
+
+    qCDebug(MatchBuilderLog) << "Building match for credential:" << credentialProxy->fullName();
+
+    KRunner::QueryMatch match(m_runner);
+
+    const bool showCode = context.showCode;
 
     // Prepare match data
     QStringList data;
@@ -86,14 +119,7 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
     const QString requiresTouch = credentialProxy->requiresTouch() ? QStringLiteral("true") : QStringLiteral("false");
     const QString isPasswordError = QStringLiteral("false");
 
-    // Pre-fetch code for non-touch TOTP credentials (populates daemon-side cache)
-    // This runs regardless of showCode - so when user selects a match, the code is already cached
-    if (!credentialProxy->requiresTouch()
-        && credentialProxy->type() == QStringLiteral("TOTP")
-        && !credentialProxy->isCacheValid()) {
-        qCDebug(MatchBuilderLog) << "Pre-fetching code for credential:" << credentialProxy->fullName();
-        credentialProxy->generateCode();  // Fire-and-forget async D-Bus call
-    }
+    // Code pre-fetching is throttled by OathRunner's CodePrefetcher, not done per match
 
     // Display code in match text if showCode is enabled
     if (showCode && !credentialProxy->requiresTouch()) {
@@ -111,7 +137,7 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
     // Use parentDeviceId() which extracts the public device ID from object path
     // This matches the device ID in our map (serial number or "dev_<hex>")
     const QString parentDeviceId = credentialProxy->parentDeviceId();
-    const QString deviceName = deviceIdToName.value(parentDeviceId, QString());
+    const QString deviceName = context.deviceNames.value(parentDeviceId);
 
     qCDebug(MatchBuilderLog) << "Device lookup for credential" << credentialProxy->fullName()
                                << "- parent device ID:" << parentDeviceId
@@ -129,11 +155,11 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
         // Use formatWithCode() when showCode is enabled
         // This handles both touch-required (shows 👆) and regular credentials (shows code)
         const FormatOptions options = FormatOptionsBuilder()
-            .withUsername(showUsername)
+            .withUsername(context.showUsername)
             .withCode(showCode)
-            .withDevice(deviceName, showDeviceName)
-            .withDeviceCount(connectedDeviceCount)
-            .onlyWhenMultipleDevices(showDeviceOnlyWhenMultiple)
+            .withDevice(deviceName, context.showDeviceName)
+            .withDeviceCount(context.connectedDeviceCount)
+            .onlyWhenMultipleDevices(context.showDeviceNameOnlyWhenMultiple)
             .build();
         displayName = CredentialFormatter::formatWithCode(
             tempCred,
@@ -143,11 +169,11 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
     } else {
         // Standard formatting without code
         const FormatOptions options = FormatOptionsBuilder()
-            .withUsername(showUsername)
+            .withUsername(context.showUsername)
             .withCode(false) // showCode=false to prevent showing code from credential.code field
-            .withDevice(deviceName, showDeviceName)
-            .withDeviceCount(connectedDeviceCount)
-            .onlyWhenMultipleDevices(showDeviceOnlyWhenMultiple)
+            .withDevice(deviceName, context.showDeviceName)
+            .withDeviceCount(context.connectedDeviceCount)
+            .onlyWhenMultipleDevices(context.showDeviceNameOnlyWhenMultiple)
             .build();
         displayName = CredentialFormatter::formatDisplayName(tempCred, options);
     }
@@ -161,18 +187,18 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
     data << credentialName << displayName << code << requiresTouch << isPasswordError << credentialProxy->deviceId();
     match.setData(data);
     match.setText(displayName);
-    match.setSubtext(i18n("YubiKey OATH TOTP/HOTP"));
+    // Cached list: the device has not confirmed this credential yet
+    const bool credentialsStale = context.staleDeviceIds.contains(parentDeviceId);
+    match.setSubtext(credentialsStale
+                         ? i18n("YubiKey OATH TOTP/HOTP (cached, not yet read from device)")
+                         : i18n("YubiKey OATH TOTP/HOTP"));
     match.setIconName(iconName);
     match.setId(QStringLiteral("yubikey_") + credentialProxy->fullName());
 
-    // Convert to CredentialInfo for relevance calculation
-    const CredentialInfo credentialInfo = credentialProxy->toCredentialInfo();
-
-    // Calculate and set relevance
-    const qreal relevance = calculateRelevance(credentialInfo, query);
-    qCDebug(MatchBuilderLog) << "Match relevance:" << relevance;
+    const qreal adjustedRelevance = adjustRelevance(relevance, credentialsStale);
+    qCDebug(MatchBuilderLog) << "Match relevance:" << adjustedRelevance;
 
-    match.setRelevance(relevance);
+    match.setRelevance(adjustedRelevance);
     match.setCategoryRelevance(KRunner::QueryMatch::CategoryRelevance::Highest);
     match.setActions(m_actions);
 
@@ -181,6 +207,11 @@ KRunner::QueryMatch MatchBuilder::buildCredentialMatch(OathCredentialProxy *cred
     return match;
 }
 
+qreal MatchBuilder::adjustRelevance(qreal relevance, bool credentialsStale)
+{
+    return credentialsStale ? relevance * STALE_RELEVANCE_FACTOR : relevance;
+}
+
 KRunner::QueryMatch MatchBuilder::buildPasswordErrorMatch(const DeviceInfo &device)
 {
     qCDebug(MatchBuilderLog) << "Building password error match for device:"
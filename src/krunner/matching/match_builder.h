@@ -7,6 +7,8 @@
 
 #include <KRunner/QueryMatch>
 #include <KRunner/Action>
+#include <QHash>
+#include <QSet>
 #include "types/yubikey_value_types.h"
 
 namespace YubiKeyOath {
@@ -23,6 +25,26 @@ using Shared::OathCredentialProxy;
 using Shared::CredentialInfo;
 using Shared::DeviceInfo;
 
+/**
+ * @brief Per-query state shared by all credential matches of one match() call
+ *
+ * Device names, the connected device count and display options do not
+ * change between the matches of a single query. Building them once per
+ * query (instead of once per match) avoids O(matches × devices) proxy
+ * lookups and QMap allocations.
+ *
+ * @see MatchBuilder::buildMatchContext()
+ */
+struct MatchContext {
+    QHash<QString, QString> deviceNames;        ///< Public device ID (serial or "dev_<hex>") → device name
+    int connectedDeviceCount{0};                ///< Devices with an open session
+    QSet<QString> staleDeviceIds;               ///< Public device IDs whose credential list is cached (CredentialsStale)
+    bool showUsername{false};                   ///< Display option snapshot from config
+    bool showCode{false};                       ///< Display option snapshot from config
+    bool showDeviceName{false};                 ///< Display option snapshot from config
+    bool showDeviceNameOnlyWhenMultiple{false}; ///< Display option snapshot from config
+};
+
 /**
  * @brief Builds KRunner QueryMatch objects from credentials
  *
@@ -34,11 +56,16 @@ using Shared::DeviceInfo;
  * - Password error matches: Special match that opens settings when authentication fails
  *
  * @par Relevance Scoring
- * Uses fuzzy matching algorithm to calculate relevance scores (0.0-1.0):
- * - Exact name match: 1.0
- * - Starts with query: 0.9
- * - Contains query: 0.7
- * - Partial match: 0.5-0.6
+ * OathRunner ranks credentials with CredentialMatcher and passes its
+ * relevance (0.1-1.0) to buildCredentialMatch(). The query overloads fall
+ * back to calculateRelevance():
+ * - Name starts with query: 1.0
+ * - Issuer starts with query: 0.9
+ * - Account starts with query: 0.8
+ * - Name contains query: 0.7
+ * - Anything else (or empty query): 0.5
+ * Credentials of devices still serving a cached list (CredentialsStale)
+ * are scaled by STALE_RELEVANCE_FACTOR and marked in the subtext.
  *
  * @par Display Format
  * Respects ConfigurationProvider settings for credential display format.
@@ -46,6 +73,7 @@ using Shared::DeviceInfo;
  * @par Usage Example
  * @code
  * MatchBuilder builder(runner, config, actions);
+ * const MatchContext matchContext = builder.buildMatchContext(manager);
  *
  * // Build match for credential
  * OathCredential cred;
@@ -53,12 +81,15 @@ using Shared::DeviceInfo;
  * cred.deviceId = "ABC123";
  * cred.type = OathType::TOTP;
  *
- * KRunner::QueryMatch match = builder.buildCredentialMatch(cred, "google", credProvider);
+ * KRunner::QueryMatch match = builder.buildCredentialMatch(cred, "google", matchContext);
  * // Creates match with:
  * // - Text: "Google: user@example.com"
  * // - Icon: YubiKey icon
  * // - Actions: Copy, Type
- * // - Relevance: 0.9 (starts with query)
+ * // - Relevance: 1.0 (name starts with query)
+ *
+ * // Relevance already ranked by CredentialMatcher (OathRunner path)
+ * KRunner::QueryMatch ranked = builder.buildCredentialMatch(cred, result.relevance, matchContext);
  *
  * // Build error match for authentication failure
  * KRunner::QueryMatch errorMatch = builder.buildPasswordErrorMatch(
@@ -80,6 +111,15 @@ public:
                          const ConfigurationProvider *config,
                          const KRunner::Actions &actions);
 
+    /**
+     * @brief Builds per-query match context
+     * @param manager Manager proxy for accessing device and session information
+     * @return Snapshot of device names, connected device count and display options
+     *
+     * Call once per query and pass the result to every buildCredentialMatch() call.
+     */
+    MatchContext buildMatchContext(const OathManagerProxy *manager) const;
+
     /**
      * @brief Builds KRunner match for a TOTP/HOTP credential
      *
@@ -92,7 +132,7 @@ public:
      *
      * @param credentialProxy Credential proxy object with full credential data
      * @param query User's search query for relevance calculation
-     * @param manager Manager proxy for accessing device information
+     * @param context Per-query context from buildMatchContext()
      *
      * @return Configured QueryMatch ready to display in KRunner.
      *         Can be activated to copy code or execute type/copy actions.
@@ -102,7 +142,31 @@ public:
      */
     KRunner::QueryMatch buildCredentialMatch(OathCredentialProxy *credentialProxy,
                                             const QString &query,
-                                            OathManagerProxy *manager);
+                                            const MatchContext &context);
+
+    /**
+     * @brief Builds KRunner match with a relevance ranked by the caller
+     *
+     * Same as the query overload, but skips calculateRelevance(): OathRunner
+     * already ranked the credential with CredentialMatcher.
+     *
+     * @param credentialProxy Credential proxy object with full credential data
+     * @param relevance Query match relevance (0.0 - 1.0), before the cached-list penalty
+     * @param context Per-query context from buildMatchContext()
+     */
+    KRunner::QueryMatch buildCredentialMatch(OathCredentialProxy *credentialProxy,
+                                            qreal relevance,
+                                            const MatchContext &context);
+
+    /**
+     * @brief Convenience overload building a one-off context from manager
+     *
+     * Prefer buildMatchContext() + the MatchContext overload when building
+     * more than one match per query.
+     */
+    KRunner::QueryMatch buildCredentialMatch(OathCredentialProxy *credentialProxy,
+                                            const QString &query,
+                                            const OathManagerProxy *manager);
 
     /**
      * @brief Builds special match for authentication errors
@@ -120,6 +184,20 @@ public:
      */
     KRunner::QueryMatch buildPasswordErrorMatch(const DeviceInfo &device);
 
+    /**
+     * @brief Applies the cached-list penalty to a relevance score
+     * @param relevance Relevance from query matching (0.0 - 1.0)
+     * @param credentialsStale Whether the credential comes from a cached list
+     * @return @p relevance, lowered by STALE_RELEVANCE_FACTOR for cached credentials
+     *
+     * Cached credentials may no longer exist on the device, so live
+     * credentials with the same match quality rank above them.
+     */
+    static qreal adjustRelevance(qreal relevance, bool credentialsStale);
+
+    /// Relevance multiplier for credentials from a cached (stale) list
+    static constexpr qreal STALE_RELEVANCE_FACTOR = 0.8;
+
 protected:
     /**
      * @brief Calculates relevance score for a match
@@ -22,9 +22,12 @@
 #include <QEventLoop>
 #include <QCoreApplication>
 #include <QMessageBox>
-#include <QDBusInterface>
 #include <QDBusConnection>
 #include <QIcon>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <memory>
 
 namespace YubiKeyOath {
 namespace Runner {
@@ -56,6 +59,9 @@ OathRunner::OathRunner(QObject *parent, const KPluginMetaData &metaData)
         m_actions
     );
 
+    // Debounced GenerateCode pre-fetch for top-ranked matches
+    m_codePrefetcher = std::make_unique<CodePrefetcher>();
+
     // Connect Manager proxy signals
     connect(m_manager, &OathManagerProxy::deviceConnected,
             this, &OathRunner::onDeviceConnected);
@@ -240,31 +246,57 @@ void OathRunner::match(KRunner::RunnerContext &context)
         return;
     }
 
-    // Get credentials from ALL devices (manager aggregates them)
-    const QList<OathCredentialProxy*> credentials = m_manager->getAllCredentials();
-    qCDebug(OathRunnerLog) << "Found" << credentials.size() << "total credentials";
+    // Rank credentials from ALL devices with the fuzzy matcher (index rebuilt only when stale).
+    // When query extends the previous one, the matcher only rescans the previous survivors.
+    QList<CredentialMatcher::ScoredCandidate> results;
+    QList<QPointer<OathCredentialProxy>> matchedCredentials;
+    {
+        const QMutexLocker locker(&m_credentialIndexMutex);
+        if (m_credentialIndexDirty) {
+            rebuildCredentialIndex();
+        }
+
+        if (m_indexedCredentials.isEmpty()) {
+            qCDebug(OathRunnerLog) << "No credentials available from any device";
+            return;
+        }
+
+        results = m_credentialMatcher.match(query, MAX_CREDENTIAL_MATCHES);
+        matchedCredentials.reserve(results.size());
+        for (const auto &result : std::as_const(results)) {
+            matchedCredentials.append(m_indexedCredentials.at(result.index));
+        }
+    }
 
-    if (credentials.isEmpty()) {
-        qCDebug(OathRunnerLog) << "No credentials available from any device";
+    if (results.isEmpty()) {
+        qCDebug(OathRunnerLog) << "No credentials match query";
         return;
     }
 
-    // Build matches for matching credentials from all working devices
+    // Device names, connected count and display options are shared by all matches
+    const MatchContext matchContext = m_matchBuilder->buildMatchContext(m_manager);
+
+    // Build matches for top-ranked credentials from all working devices
     int matchCount = 0;
-    for (auto *credential : credentials) {
-        const QString name = credential->fullName().toLower();
-        const QString issuer = credential->issuer().toLower();
-        const QString account = credential->username().toLower();
-
-        if (name.contains(query) || issuer.contains(query) || account.contains(query)) {
-            qCDebug(OathRunnerLog) << "Creating match for credential:" << credential->fullName();
-            const KRunner::QueryMatch match = m_matchBuilder->buildCredentialMatch(
-                credential, query, m_manager);
-            context.addMatch(match);
-            matchCount++;
+    QList<OathCredentialProxy*> liveCredentials;
+    liveCredentials.reserve(matchedCredentials.size());
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        OathCredentialProxy *credential = matchedCredentials.at(i);
+        if (!credential) {
+            continue;  // Removed since the index was read
         }
+        liveCredentials.append(credential);
+        qCDebug(OathRunnerLog) << "Creating match for credential:" << credential->fullName()
+                               << "score:" << results.at(i).score;
+        const KRunner::QueryMatch match = m_matchBuilder->buildCredentialMatch(
+            credential, results.at(i).relevance, matchContext);
+        context.addMatch(match);
+        matchCount++;
     }
 
+    // Warm the code cache once typing settles (throttled, top-N only)
+    m_codePrefetcher->schedule(liveCredentials);
+
     qCDebug(OathRunnerLog) << "Total credential matches:" << matchCount;
 }
 
@@ -273,6 +305,10 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
     Q_UNUSED(context)
     qCDebug(OathRunnerLog) << "run() called with match ID:" << match.id();
 
+    // Latency probe: Enter -> clipboard/typed output
+    QElapsedTimer enterTimer;
+    enterTimer.start();
+
     // Handle "Add OATH to {Device}" command
     if (match.id().startsWith(QStringLiteral("add-oath-to-"))) {
         qCDebug(OathRunnerLog) << "Starting Add OATH Credential workflow for device";
@@ -283,7 +319,7 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
 
         // Find the device proxy
         const QList<OathDeviceProxy*> devices = m_manager->devices();
-        const OathDeviceProxy *targetDevice = nullptr;
+        OathDeviceProxy *targetDevice = nullptr;
 
         for (auto *device : devices) {
             if (device->deviceId() == deviceId) {
@@ -302,16 +338,7 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
         // Use async call to prevent blocking KRunner UI
         qCDebug(OathRunnerLog) << "Calling AddCredential asynchronously on device:" << targetDevice->name();
 
-        QDBusInterface interface(
-            QStringLiteral("pl.jkolo.yubikey.oath.daemon"),
-            targetDevice->objectPath(),
-            QStringLiteral("pl.jkolo.yubikey.oath.Device"),
-            QDBusConnection::sessionBus()
-        );
-
-        // Fire-and-forget async call - don't wait for response
-        interface.asyncCall(
-            QStringLiteral("AddCredential"),
+        targetDevice->addCredential(
             QString(),  // name - empty triggers dialog
             QString(),  // secret - empty triggers dialog
             QString(),  // type - will default to TOTP
@@ -442,7 +469,7 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
 
         // Schedule execution: wait for KRunner to close (100ms delay - optimized)
         // Capture by value (QString is copy-on-write, safe for async execution)
-        QTimer::singleShot(100, this, [this, credentialName, deviceId]() {
+        QTimer::singleShot(100, this, [this, credentialName, deviceId, enterTimer]() {
             qCDebug(OathRunnerLog) << "Executing type action (async) after KRunner close:" << credentialName;
 
             // Re-find credential (proxy might have changed during delay)
@@ -460,6 +487,7 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
             }
 
             // Fire-and-forget async call with fallback to clipboard
+            probeActionLatency(cred, QStringLiteral("type"), enterTimer);
             cred->typeCode(true);
             // Result will be delivered via CodeTyped signal
             // TouchWorkflowCoordinator will show notifications if needed
@@ -470,6 +498,7 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
         return;
     } else {  // copy - fire-and-forget async call
         qCDebug(OathRunnerLog) << "Executing copy action (async) via credential proxy";
+        probeActionLatency(credential, QStringLiteral("copy"), enterTimer);
         credential->copyToClipboard();
         // Result will be delivered via ClipboardCopied signal
         // TouchWorkflowCoordinator will show notifications if needed
@@ -477,6 +506,48 @@ void OathRunner::run(const KRunner::RunnerContext &context, const KRunner::Query
     }
 }
 
+void OathRunner::probeActionLatency(OathCredentialProxy *credential,
+                                    const QString &actionId,
+                                    const QElapsedTimer &enterTimer)
+{
+    // One-shot: the first result signal or the timeout ends the measurement. All
+    // connections hang off a probe object, so deleting it drops them; run() may be
+    // on a worker thread, hence no parent - the probe lives on the runner's thread.
+    auto *probe = new QObject;
+    probe->moveToThread(thread());
+    connect(this, &QObject::destroyed, probe, &QObject::deleteLater);
+
+    const QPointer<OathCredentialProxy> source(credential);
+    const auto report = [this, probe, source, actionId, enterTimer](bool success) {
+        // Both result signals may be queued already - only the first one counts
+        if (source) {
+            QObject::disconnect(source, nullptr, probe, nullptr);
+        }
+        probe->deleteLater();
+        const qint64 elapsed = enterTimer.elapsed();
+
+        const QMutexLocker locker(&m_latencyMutex);
+        if (success) {
+            ++m_latencySamples;
+            m_latencyTotalMs += elapsed;
+            m_latencyMaxMs = std::max(m_latencyMaxMs, elapsed);
+        }
+        qCInfo(OathRunnerLog) << "[LATENCY] Enter ->" << actionId << "output:" << elapsed << "ms"
+                              << "success:" << success
+                              << "- avg:" << (m_latencySamples > 0 ? m_latencyTotalMs / m_latencySamples : 0) << "ms"
+                              << "max:" << m_latencyMaxMs << "ms over" << m_latencySamples << "actions";
+    };
+
+    connect(credential, &OathCredentialProxy::clipboardCopied, probe,
+            [report](bool success, const QString &) { report(success); });
+    connect(credential, &OathCredentialProxy::codeTyped, probe,
+            [report](bool success, const QString &) { report(success); });
+    QTimer::singleShot(LATENCY_PROBE_TIMEOUT_MS, probe, [probe, actionId]() {
+        qCDebug(OathRunnerLog) << "[LATENCY] No" << actionId << "result - probe dropped";
+        probe->deleteLater();
+    });
+}
+
 void OathRunner::showPasswordDialog(const QString &deviceId, const QString &deviceName)
 {
     qCDebug(OathRunnerLog) << "showPasswordDialog() for device:" << deviceId;
@@ -522,6 +593,9 @@ void OathRunner::reloadConfiguration()
 
 void OathRunner::onDeviceConnected(OathDeviceProxy *device)
 {
+    // New device proxy arrives with its initial credential proxies
+    invalidateCredentialIndex();
+
     if (device) {
         // Get session proxy for connection state
         const auto *session = m_manager->getDeviceSession(device->deviceId());
@@ -545,11 +619,14 @@ void OathRunner::onDeviceConnected(OathDeviceProxy *device)
 void OathRunner::onDeviceDisconnected(const QString &deviceId)
 {
     qCDebug(OathRunnerLog) << "Device disconnected:" << deviceId;
+    // Device proxy (and its credential proxies) is about to be deleted
+    invalidateCredentialIndex();
 }
 
 void OathRunner::onCredentialsUpdated()
 {
     qCDebug(OathRunnerLog) << "Credentials updated";
+    invalidateCredentialIndex();
 }
 
 void OathRunner::onDaemonUnavailable()
@@ -558,6 +635,8 @@ void OathRunner::onDaemonUnavailable()
     // Clear cache when daemon unavailable
     m_cachedReadyDevices = 0;
     m_cachedInitializingDevices = 0;
+    invalidateCredentialIndex();
+    m_codePrefetcher->reset();
 }
 
 void OathRunner::onDaemonAvailable()
@@ -565,6 +644,8 @@ void OathRunner::onDaemonAvailable()
     qCWarning(OathRunnerLog) << "Daemon became available - refreshing state";
     // Refresh device state cache when daemon is back
     updateDeviceStateCache();
+    invalidateCredentialIndex();
+    m_codePrefetcher->reset();
 }
 
 void OathRunner::onDevicePropertyChanged(OathDeviceProxy *device)
@@ -572,6 +653,12 @@ void OathRunner::onDevicePropertyChanged(OathDeviceProxy *device)
     Q_UNUSED(device)
     // Device property changed (could be state, password, etc.) - update cache
     updateDeviceStateCache();
+
+    // A state change (unlocked, became ready) usually precedes that device's credential
+    // list update - start the next query from a full scan, not from survivors of the
+    // previous keystroke, so the refined set never spans the change
+    const QMutexLocker locker(&m_credentialIndexMutex);
+    m_credentialMatcher.clearRefinementCache();
 }
 
 void OathRunner::updateDeviceStateCache()
@@ -605,6 +692,30 @@ void OathRunner::updateDeviceStateCache()
                               << m_cachedInitializingDevices << "initializing";
 }
 
+void OathRunner::invalidateCredentialIndex()
+{
+    const QMutexLocker locker(&m_credentialIndexMutex);
+    m_credentialIndexDirty = true;
+}
+
+void OathRunner::rebuildCredentialIndex()
+{
+    const QList<OathCredentialProxy*> credentials = m_manager->getAllCredentials();
+
+    m_indexedCredentials.clear();
+    m_indexedCredentials.reserve(credentials.size());
+    QList<CredentialInfo> infos;
+    infos.reserve(credentials.size());
+    for (auto *credential : credentials) {
+        m_indexedCredentials.append(credential);
+        infos.append(credential->toCredentialInfo());
+    }
+    m_credentialMatcher.setCandidates(infos);
+    m_credentialIndexDirty = false;
+
+    qCDebug(OathRunnerLog) << "Credential index rebuilt:" << m_indexedCredentials.size() << "credentials";
+}
+
 K_PLUGIN_CLASS_WITH_JSON(OathRunner, "yubikeyrunner.json")
 
 } // namespace Runner
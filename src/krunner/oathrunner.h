@@ -8,6 +8,9 @@
 // Qt includes
 #include <QObject>
 #include <QString>
+#include <QMutex>
+#include <QPointer>
+#include <QElapsedTimer>
 #include <memory>
 
 // KDE includes
@@ -21,6 +24,7 @@ namespace YubiKeyOath {
 namespace Shared {
 class OathManagerProxy;
 class OathDeviceProxy;
+class OathCredentialProxy;
 }
 }
 
@@ -28,6 +32,8 @@ class OathDeviceProxy;
 #include "config/krunner_configuration.h"
 #include "actions/action_manager.h"
 #include "matching/match_builder.h"
+#include "matching/credential_matcher.h"
+#include "matching/code_prefetcher.h"
 
 namespace YubiKeyOath {
 namespace Runner {
@@ -72,6 +78,34 @@ private:
     void reloadConfiguration() override;
     void updateDeviceStateCache();
 
+    /**
+     * @brief Marks the credential search index stale
+     *
+     * Called on any signal that may add, remove or delete credential proxies.
+     * The index is rebuilt lazily on the next match() call.
+     */
+    void invalidateCredentialIndex();
+
+    /**
+     * @brief Rebuilds the credential search index from the manager proxy
+     * @note Caller must hold m_credentialIndexMutex
+     */
+    void rebuildCredentialIndex();
+
+    /**
+     * @brief Logs time from Enter to the daemon's clipboard/typed result
+     * @param credential Credential the action was sent to
+     * @param actionId "copy" or "type"
+     * @param enterTimer Timer started when run() was entered
+     *
+     * Listens for the next ClipboardCopied or CodeTyped signal of credential
+     * and logs the latency along with running average and maximum. Gives up
+     * after LATENCY_PROBE_TIMEOUT_MS.
+     */
+    void probeActionLatency(Shared::OathCredentialProxy *credential,
+                            const QString &actionId,
+                            const QElapsedTimer &enterTimer);
+
     /**
      * @brief Shows password dialog for device authorization
      * @param deviceId Device ID requiring password
@@ -91,6 +125,7 @@ private:
     std::unique_ptr<KRunnerConfiguration> m_config;
     std::unique_ptr<ActionManager> m_actionManager;
     std::unique_ptr<MatchBuilder> m_matchBuilder;
+    std::unique_ptr<CodePrefetcher> m_codePrefetcher;
 
     // Actions
     KRunner::Actions m_actions;
@@ -101,6 +136,29 @@ private:
     // Device state cache (updated on device property changes)
     int m_cachedReadyDevices{0};
     int m_cachedInitializingDevices{0};
+
+    // Credential search index (rebuilt lazily after credential list changes).
+    // The matcher also caches per-prefix candidate sets for incremental typing;
+    // rebuilding the index or a device property change drops them.
+    // THREAD SAFETY: match() runs on KRunner worker thread, invalidation on D-Bus thread
+    QMutex m_credentialIndexMutex;
+    CredentialMatcher m_credentialMatcher;
+    // Aligned with matcher indices. QPointer: a device or credential may be removed
+    // on the D-Bus thread after match() copied entries out of the index.
+    QList<QPointer<Shared::OathCredentialProxy>> m_indexedCredentials;
+    bool m_credentialIndexDirty{true};
+
+    // Enter -> output latency probe (successful actions only)
+    QMutex m_latencyMutex;
+    int m_latencySamples{0};
+    qint64 m_latencyTotalMs{0};
+    qint64 m_latencyMaxMs{0};
+
+    // Maximum number of credential matches returned per query (top-K)
+    static constexpr int MAX_CREDENTIAL_MATCHES = 30;
+
+    // Latency probes without a result (daemon error, cancelled touch) give up after this
+    static constexpr int LATENCY_PROBE_TIMEOUT_MS = 60000;
 };
 
 } // namespace Runner
@@ -21,6 +21,7 @@ namespace ConfigKeys {
 // Notification settings
 constexpr const char *SHOW_NOTIFICATIONS = "ShowNotifications";
 constexpr const char *NOTIFICATION_EXTRA_TIME = "NotificationExtraTime";
+constexpr const char *NOTIFICATION_FRAME_RATE = "NotificationFrameRate";
 
 // Display settings
 constexpr const char *SHOW_USERNAME = "ShowUsername";
@@ -42,6 +43,10 @@ constexpr const char *PCSC_RATE_LIMIT_MS = "PcscRateLimitMs";
 
 // Portal session settings
 constexpr const char *PERSIST_PORTAL_SESSION = "PersistPortalSession";
+constexpr const char *BURST_TYPE_DIGITS = "BurstTypeDigits";
+
+// D-Bus object settings (daemon only)
+constexpr const char *VIRTUAL_CREDENTIAL_OBJECTS = "VirtualCredentialObjects";
 
 } // namespace ConfigKeys
 } // namespace Shared
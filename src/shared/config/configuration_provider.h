@@ -74,6 +74,15 @@ public:
      */
     virtual int notificationExtraTime() const = 0;
 
+    /**
+     * @brief Gets countdown notification refresh rate
+     * @return Updates per second for progress bars (1-10)
+     *
+     * Higher rates give smoother progress bars. Notifications are only
+     * re-sent when the visible countdown or progress actually changes.
+     */
+    virtual int notificationFrameRate() const = 0;
+
     /**
      * @brief Gets primary action preference
      * @return Primary action ID ("copy" or "type")
@@ -113,9 +122,29 @@ public:
      * @return true if Portal RemoteDesktop session should be kept alive across operations
      *
      * When enabled, the session is pre-created at daemon startup and reused.
-     * When disabled, a new session is created/destroyed per typing operation.
+     * When disabled, a new session is created/destroyed per typing operation
+     * until the portal has issued a restore token; from then on the session
+     * is reused as well, since recreating it no longer needs user consent.
      */
     virtual bool persistPortalSession() const = 0;
+
+    /**
+     * @brief Checks whether portal session persistence is set explicitly
+     * @return true if the PersistPortalSession key is present in the config
+     *
+     * When absent, persistence is decided by the text input provider
+     * (kept once a restore token exists).
+     */
+    virtual bool persistPortalSessionConfigured() const = 0;
+
+    /**
+     * @brief Gets zero-delay typing setting for digit-only codes
+     * @return true if numeric codes should be typed without any key spacing
+     *
+     * Off by default. Some applications drop repeated keystrokes that arrive
+     * without spacing, so this is opt-in.
+     */
+    virtual bool burstTypeDigits() const = 0;
 };
 
 } // namespace Shared
@@ -6,7 +6,10 @@
 #pragma once
 
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QObject>
+#include <utility>
 
 namespace YubiKeyOath {
 namespace Shared {
@@ -116,6 +119,39 @@ inline int connectSignals(
     return successCount;
 }
 
+/**
+ * @brief Invokes handler when an asynchronous D-Bus call finishes
+ *
+ * Wraps QDBusPendingCallWatcher boilerplate for asyncCall() results.
+ * The handler runs in context's thread and is dropped if context is
+ * destroyed before the reply arrives.
+ *
+ * @tparam Types Reply argument types (empty for void methods)
+ * @param call Pending call returned by QDBusAbstractInterface::asyncCall()
+ * @param context Lifetime guard and parent of the watcher
+ * @param handler Callable taking const QDBusPendingReply<Types...>&
+ *
+ * @par Example
+ * @code
+ * DBusConnectionHelper::onReply<bool>(
+ *     m_interface->asyncCall(QStringLiteral("ChangePassword"), oldPassword, newPassword),
+ *     this, [](const QDBusPendingReply<bool> &reply) {
+ *         if (reply.isError()) { ... }
+ *     });
+ * @endcode
+ */
+template<typename... Types, typename Handler>
+inline void onReply(const QDBusPendingCall &call, QObject *context, Handler &&handler)
+{
+    auto *watcher = new QDBusPendingCallWatcher(call, context);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, context,
+                     [handler = std::forward<Handler>(handler)](QDBusPendingCallWatcher *finished) {
+                         const QDBusPendingReply<Types...> reply = *finished;
+                         handler(reply);
+                         finished->deleteLater();
+                     });
+}
+
 } // namespace DBusConnectionHelper
 
 } // namespace Shared
@@ -4,6 +4,7 @@
  */
 
 #include "oath_credential_proxy.h"
+#include "types/oath_credential_data.h"
 #include <QDBusInterface>
 #include <QDBusReply>
 #include <QDBusConnection>
@@ -36,20 +37,7 @@ OathCredentialProxy::OathCredentialProxy(const QString &objectPath,
     , m_digits(6)
     , m_period(30)
 {
-    // Register D-Bus types
-    registerDBusTypes();
-    // Create D-Bus interface for method calls
-    m_interface = new QDBusInterface(QLatin1String(SERVICE_NAME),
-                                     objectPath,
-                                     QLatin1String(INTERFACE_NAME),
-                                     QDBusConnection::sessionBus(),
-                                     this);
-
-    if (!m_interface->isValid()) {
-        qCWarning(OathCredentialProxyLog) << "Failed to create D-Bus interface for credential at"
-                                              << objectPath
-                                              << "Error:" << m_interface->lastError().message();
-    }
+    createInterface();
 
     // Extract and cache properties from GetManagedObjects() result
     m_fullName = properties.value(QStringLiteral("FullName")).toString();
@@ -69,6 +57,46 @@ OathCredentialProxy::OathCredentialProxy(const QString &objectPath,
     connectToSignals();
 }
 
+OathCredentialProxy::OathCredentialProxy(const PackedCredential &credential, QObject *parent)
+    : QObject(parent)
+    , m_objectPath(credential.path.path())
+    , m_fullName(credential.fullName)
+    , m_issuer(credential.issuer)
+    , m_username(credential.username)
+    , m_requiresTouch(credential.requiresTouch)
+    , m_type(credential.type == static_cast<quint8>(OathType::TOTP) ? QStringLiteral("TOTP")
+                                                                     : QStringLiteral("HOTP"))
+    , m_algorithm(algorithmToString(static_cast<OathAlgorithm>(credential.algorithm)))
+    , m_digits(credential.digits)
+    , m_period(credential.period)
+    , m_deviceId(credential.deviceId)
+{
+    createInterface();
+
+    qCDebug(OathCredentialProxyLog) << "Created credential proxy for" << m_fullName
+                                       << "at" << m_objectPath << "(packed)";
+
+    connectToSignals();
+}
+
+void OathCredentialProxy::createInterface()
+{
+    // Register D-Bus types
+    registerDBusTypes();
+    // Create D-Bus interface for method calls
+    m_interface = new QDBusInterface(QLatin1String(SERVICE_NAME),
+                                     m_objectPath,
+                                     QLatin1String(INTERFACE_NAME),
+                                     QDBusConnection::sessionBus(),
+                                     this);
+
+    if (!m_interface->isValid()) {
+        qCWarning(OathCredentialProxyLog) << "Failed to create D-Bus interface for credential at"
+                                              << m_objectPath
+                                              << "Error:" << m_interface->lastError().message();
+    }
+}
+
 OathCredentialProxy::~OathCredentialProxy()
 {
     qCDebug(OathCredentialProxyLog) << "Destroying credential proxy for" << m_fullName;
@@ -83,6 +111,21 @@ QString OathCredentialProxy::deviceIdFromPath(const QString &credentialPath)
     return credentialPath.section(QLatin1Char('/'), 6, 6);
 }
 
+QString OathCredentialProxy::devicePathFromPath(const QString &credentialPath)
+{
+    // Path format: /pl/jkolo/yubikey/oath/devices/<deviceId>/credentials/<credentialId>
+    // Segments:     0   1     2       3    4       5           6            7            8
+    const QStringList segments = credentialPath.split(QLatin1Char('/'));
+    if (segments.size() != 9
+        || segments.at(5) != QLatin1String("devices")
+        || segments.at(7) != QLatin1String("credentials")
+        || segments.at(6).isEmpty()
+        || segments.at(8).isEmpty()) {
+        return {};
+    }
+    return credentialPath.section(QLatin1Char('/'), 0, 6);
+}
+
 QString OathCredentialProxy::parentDeviceId() const
 {
     return deviceIdFromPath(m_objectPath);
@@ -57,6 +57,16 @@ public:
                                   const QVariantMap &properties,
                                   QObject *parent = nullptr);
 
+    /**
+     * @brief Constructs credential proxy from a GetManagedObjectsPacked() entry
+     * @param credential Packed credential (object path and properties)
+     * @param parent Parent object (typically OathDeviceProxy)
+     *
+     * Same as the property-map constructor, without building a QVariantMap first.
+     */
+    explicit OathCredentialProxy(const PackedCredential &credential,
+                                  QObject *parent = nullptr);
+
     ~OathCredentialProxy() override;
 
     // ========== Static Helpers ==========
@@ -77,6 +87,18 @@ public:
      */
     [[nodiscard]] static QString deviceIdFromPath(const QString &credentialPath);
 
+    /**
+     * @brief Extracts parent device object path from credential object path
+     * @param credentialPath D-Bus object path of credential
+     * @return Device path (/pl/jkolo/yubikey/oath/devices/<deviceId>), or empty string
+     *         if credentialPath is not a credential path
+     *
+     * Follows the same segment layout as deviceIdFromPath(): segment 7 must be
+     * "credentials" and segment 8 the credential ID, which is the last segment
+     * (CredentialIdEncoder never emits '/').
+     */
+    [[nodiscard]] static QString devicePathFromPath(const QString &credentialPath);
+
     // ========== Cached Properties (read-only) ==========
 
     [[nodiscard]] QString objectPath() const { return m_objectPath; }
@@ -238,6 +260,7 @@ private Q_SLOTS:
     void onReconnectCompleted(bool success);
 
 private:  // NOLINT(readability-redundant-access-specifiers) - Required to close Q_SLOTS section for moc
+    void createInterface();
     void connectToSignals();
 
     QString m_objectPath;
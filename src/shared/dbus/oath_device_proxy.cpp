@@ -5,8 +5,11 @@
 
 #include "oath_device_proxy.h"
 #include "oath_device_session_proxy.h"
+#include "dbus_connection_helper.h"
+#include <QDBusArgument>
 #include <QDBusInterface>
-#include <QDBusReply>
+#include <QDBusMessage>
+#include <QDBusPendingReply>
 #include <QDBusConnection>
 #include <QDBusObjectPath>
 #include <QDBusVariant>
@@ -105,6 +108,25 @@ void OathDeviceProxy::connectToSignals()
         SLOT(onCredentialRemovedSignal(QDBusObjectPath))
     );
 
+    // Bulk variants emitted for credential list refreshes
+    QDBusConnection::sessionBus().connect(
+        QLatin1String(SERVICE_NAME),
+        m_objectPath,
+        QLatin1String(INTERFACE_NAME),
+        QStringLiteral("CredentialsAdded"),
+        this,
+        SLOT(onCredentialsAddedSignal(QDBusMessage))
+    );
+
+    QDBusConnection::sessionBus().connect(
+        QLatin1String(SERVICE_NAME),
+        m_objectPath,
+        QLatin1String(INTERFACE_NAME),
+        QStringLiteral("CredentialsRemoved"),
+        this,
+        SLOT(onCredentialsRemovedSignal(QList<QDBusObjectPath>))
+    );
+
     // Connect to PropertiesChanged for property updates
     QDBusConnection::sessionBus().connect(
         QLatin1String(SERVICE_NAME),
@@ -128,123 +150,155 @@ OathCredentialProxy* OathDeviceProxy::getCredential(const QString &credentialNam
 
 // Note: SavePassword() moved to OathDeviceSessionProxy
 
-bool OathDeviceProxy::changePassword(const QString &oldPassword, const QString &newPassword)
-{
-    QString errorMessage;  // Unused in this overload
-    return changePassword(oldPassword, newPassword, errorMessage);
-}
-
-bool OathDeviceProxy::changePassword(const QString &oldPassword, const QString &newPassword, QString &errorMessage)
+void OathDeviceProxy::changePassword(const QString &oldPassword, const QString &newPassword,
+                                     const ResultCallback &callback)
 {
     if (!m_interface || !m_interface->isValid()) {
-        errorMessage = QStringLiteral("D-Bus interface invalid");
+        const QString errorMessage = QStringLiteral("D-Bus interface invalid");
         qCWarning(OathDeviceProxyLog) << "Cannot change password:" << errorMessage;
-        return false;
-    }
-
-    const QDBusReply<bool> reply = m_interface->call(QStringLiteral("ChangePassword"),
-                                                oldPassword, newPassword);
-
-    if (!reply.isValid()) {
-        errorMessage = reply.error().message();
-        qCWarning(OathDeviceProxyLog) << "ChangePassword failed for" << m_name
-                                          << "Error:" << errorMessage;
-        return false;
-    }
-
-    bool const success = reply.value();
-    qCDebug(OathDeviceProxyLog) << "ChangePassword for" << m_name << "Result:" << success;
-
-    if (!success) {
-        // D-Bus call succeeded but operation failed
-        // Unfortunately, standard D-Bus doesn't provide error message when call succeeds but returns false
-        // We can only provide a generic message here
-        errorMessage = i18n("Password change failed. The current password may be incorrect, or the YubiKey may not be accessible.");
+        if (callback) {
+            callback(false, errorMessage);
+        }
+        return;
     }
 
-    return success;
+    DBusConnectionHelper::onReply<bool>(
+        m_interface->asyncCall(QStringLiteral("ChangePassword"), oldPassword, newPassword),
+        this, [this, callback](const QDBusPendingReply<bool> &reply) {
+            QString errorMessage;
+            bool success = false;
+
+            if (reply.isError()) {
+                errorMessage = reply.error().message();
+                qCWarning(OathDeviceProxyLog) << "ChangePassword failed for" << m_name
+                                                  << "Error:" << errorMessage;
+            } else {
+                success = reply.value();
+                qCDebug(OathDeviceProxyLog) << "ChangePassword for" << m_name << "Result:" << success;
+
+                if (!success) {
+                    // D-Bus call succeeded but operation failed
+                    // Unfortunately, standard D-Bus doesn't provide error message when call succeeds but returns false
+                    // We can only provide a generic message here
+                    errorMessage = i18n("Password change failed. The current password may be incorrect, or the YubiKey may not be accessible.");
+                }
+            }
+
+            if (callback) {
+                callback(success, errorMessage);
+            }
+        });
 }
 
-void OathDeviceProxy::forget()
+void OathDeviceProxy::forget(const ResultCallback &callback)
 {
     if (!m_interface || !m_interface->isValid()) {
         qCWarning(OathDeviceProxyLog) << "Cannot forget device: D-Bus interface invalid";
+        if (callback) {
+            callback(false, QStringLiteral("D-Bus interface invalid"));
+        }
         return;
     }
 
-    const QDBusReply<void> reply = m_interface->call(QStringLiteral("Forget"));
-
-    if (!reply.isValid()) {
-        qCWarning(OathDeviceProxyLog) << "Forget failed for" << m_name
-                                          << "Error:" << reply.error().message();
-        return;
-    }
-
-    qCDebug(OathDeviceProxyLog) << "Forgot device" << m_name;
+    // Proxy may be deleted when the device disappears - log with captured name
+    DBusConnectionHelper::onReply<>(
+        m_interface->asyncCall(QStringLiteral("Forget")),
+        this, [name = m_name, callback](const QDBusPendingReply<> &reply) {
+            if (reply.isError()) {
+                qCWarning(OathDeviceProxyLog) << "Forget failed for" << name
+                                                  << "Error:" << reply.error().message();
+            } else {
+                qCDebug(OathDeviceProxyLog) << "Forgot device" << name;
+            }
+
+            if (callback) {
+                callback(!reply.isError(), reply.isError() ? reply.error().message() : QString());
+            }
+        });
 }
 
-AddCredentialResult OathDeviceProxy::addCredential(const QString &name,
-                                                      const QString &secret,
-                                                      const QString &type,
-                                                      const QString &algorithm,
-                                                      int digits,
-                                                      int period,
-                                                      int counter,
-                                                      bool requireTouch)
+void OathDeviceProxy::addCredential(const QString &name,
+                                    const QString &secret,
+                                    const QString &type,
+                                    const QString &algorithm,
+                                    int digits,
+                                    int period,
+                                    int counter,
+                                    bool requireTouch,
+                                    const AddCredentialCallback &callback)
 {
     if (!m_interface || !m_interface->isValid()) {
         qCWarning(OathDeviceProxyLog) << "Cannot add credential: D-Bus interface invalid";
-        return AddCredentialResult{QStringLiteral("Error"), QStringLiteral("D-Bus interface invalid")};
-    }
-
-    const QDBusReply<AddCredentialResult> reply = m_interface->call(
-        QStringLiteral("AddCredential"),
-        name, secret, type, algorithm, digits, period, counter, requireTouch
-    );
-
-    if (!reply.isValid()) {
-        qCWarning(OathDeviceProxyLog) << "AddCredential failed for" << m_name
-                                          << "Error:" << reply.error().message();
-        return AddCredentialResult{QStringLiteral("Error"), reply.error().message()};
+        if (callback) {
+            callback(AddCredentialResult{QStringLiteral("Error"), QStringLiteral("D-Bus interface invalid")});
+        }
+        return;
     }
 
-    auto result = reply.value();
-    qCDebug(OathDeviceProxyLog) << "AddCredential for" << m_name
-                                    << "Status:" << result.status
-                                    << "PathOrMessage:" << result.message;
-    return result;
+    DBusConnectionHelper::onReply<AddCredentialResult>(
+        m_interface->asyncCall(QStringLiteral("AddCredential"),
+                               name, secret, type, algorithm, digits, period, counter, requireTouch),
+        this, [this, callback](const QDBusPendingReply<AddCredentialResult> &reply) {
+            AddCredentialResult result;
+            if (reply.isError()) {
+                qCWarning(OathDeviceProxyLog) << "AddCredential failed for" << m_name
+                                                  << "Error:" << reply.error().message();
+                result = AddCredentialResult{QStringLiteral("Error"), reply.error().message()};
+            } else {
+                result = reply.value();
+                qCDebug(OathDeviceProxyLog) << "AddCredential for" << m_name
+                                                << "Status:" << result.status
+                                                << "PathOrMessage:" << result.message;
+            }
+
+            if (callback) {
+                callback(result);
+            }
+        });
 }
 
-bool OathDeviceProxy::setName(const QString &newName)
+void OathDeviceProxy::setName(const QString &newName, const ResultCallback &callback)
 {
     if (!m_interface || !m_interface->isValid()) {
         qCWarning(OathDeviceProxyLog) << "Cannot set name: D-Bus interface invalid";
-        return false;
+        if (callback) {
+            callback(false, QStringLiteral("D-Bus interface invalid"));
+        }
+        return;
     }
 
     // Use D-Bus Properties interface to set Name property
-    QDBusInterface propsInterface(QLatin1String(SERVICE_NAME),
-                                   m_objectPath,
-                                   QLatin1String(PROPERTIES_INTERFACE),
-                                   QDBusConnection::sessionBus());
-
-    const QDBusReply<void> reply = propsInterface.call(QStringLiteral("Set"),
-                                                  QLatin1String(INTERFACE_NAME),
-                                                  QStringLiteral("Name"),
-                                                  QVariant::fromValue(QDBusVariant(newName)));
-
-    if (!reply.isValid()) {
-        qCWarning(OathDeviceProxyLog) << "setName failed for" << m_name
-                                          << "Error:" << reply.error().message();
-        return false;
-    }
-
-    // Update cached name (PropertiesChanged signal will also update it)
-    m_name = newName;
-    Q_EMIT nameChanged(newName);
-
-    qCDebug(OathDeviceProxyLog) << "Updated device name to" << newName;
-    return true;
+    QDBusMessage message = QDBusMessage::createMethodCall(QLatin1String(SERVICE_NAME),
+                                                          m_objectPath,
+                                                          QLatin1String(PROPERTIES_INTERFACE),
+                                                          QStringLiteral("Set"));
+    message << QLatin1String(INTERFACE_NAME)
+            << QStringLiteral("Name")
+            << QVariant::fromValue(QDBusVariant(newName));
+
+    DBusConnectionHelper::onReply<>(
+        QDBusConnection::sessionBus().asyncCall(message),
+        this, [this, newName, callback](const QDBusPendingReply<> &reply) {
+            if (reply.isError()) {
+                qCWarning(OathDeviceProxyLog) << "setName failed for" << m_name
+                                                  << "Error:" << reply.error().message();
+                if (callback) {
+                    callback(false, reply.error().message());
+                }
+                return;
+            }
+
+            // Update cached name (PropertiesChanged signal will also update it)
+            if (m_name != newName) {
+                m_name = newName;
+                Q_EMIT nameChanged(newName);
+            }
+
+            qCDebug(OathDeviceProxyLog) << "Updated device name to" << newName;
+            if (callback) {
+                callback(true, QString());
+            }
+        });
 }
 
 DeviceInfo OathDeviceProxy::toDeviceInfo(const OathDeviceSessionProxy *session) const
@@ -282,24 +336,31 @@ void OathDeviceProxy::onCredentialAddedSignal(const QDBusObjectPath &credentialP
     QString const path = credentialPath.path();
     qCDebug(OathDeviceProxyLog) << "CredentialAdded signal received for" << path;
 
-    // Fetch credential properties via D-Bus Properties interface
-    QDBusInterface propsInterface(QLatin1String(SERVICE_NAME),
-                                   path,
-                                   QLatin1String(PROPERTIES_INTERFACE),
-                                   QDBusConnection::sessionBus());
-
-    const QDBusReply<QVariantMap> reply = propsInterface.call(
-        QStringLiteral("GetAll"),
-        QStringLiteral("pl.jkolo.yubikey.oath.Credential")
-    );
-
-    if (!reply.isValid()) {
-        qCWarning(OathDeviceProxyLog) << "Failed to get credential properties for" << path
-                                          << "Error:" << reply.error().message();
-        return;
+    // Batches send CredentialsAdded first - those credentials already have a proxy
+    for (const auto *credential : std::as_const(m_credentials)) {
+        if (credential->objectPath() == path) {
+            return;
+        }
     }
 
-    addCredentialProxy(path, reply.value());
+    // Fetch credential properties via D-Bus Properties interface (non-blocking)
+    QDBusMessage message = QDBusMessage::createMethodCall(QLatin1String(SERVICE_NAME),
+                                                          path,
+                                                          QLatin1String(PROPERTIES_INTERFACE),
+                                                          QStringLiteral("GetAll"));
+    message << QStringLiteral("pl.jkolo.yubikey.oath.Credential");
+
+    DBusConnectionHelper::onReply<QVariantMap>(
+        QDBusConnection::sessionBus().asyncCall(message),
+        this, [this, path](const QDBusPendingReply<QVariantMap> &reply) {
+            if (reply.isError()) {
+                qCWarning(OathDeviceProxyLog) << "Failed to get credential properties for" << path
+                                                  << "Error:" << reply.error().message();
+                return;
+            }
+
+            addCredentialProxy(path, reply.value());
+        });
 }
 
 void OathDeviceProxy::onCredentialRemovedSignal(const QDBusObjectPath &credentialPath)
@@ -309,6 +370,34 @@ void OathDeviceProxy::onCredentialRemovedSignal(const QDBusObjectPath &credentia
     removeCredentialProxy(path);
 }
 
+void OathDeviceProxy::onCredentialsAddedSignal(const QDBusMessage &message)
+{
+    // Signature: a{oa{sv}} = Map<credential path, Credential interface properties>
+    const QList<QVariant> args = message.arguments();
+    if (args.isEmpty()) {
+        qCWarning(OathDeviceProxyLog) << "CredentialsAdded: Invalid message - no arguments";
+        return;
+    }
+
+    const auto credentials = qdbus_cast<CredentialPropertiesMap>(args.at(0).value<QDBusArgument>());
+    qCDebug(OathDeviceProxyLog) << "CredentialsAdded signal received for" << credentials.size()
+                                    << "credentials on" << m_objectPath;
+
+    // Properties are in the signal itself - no GetAll round-trip needed
+    for (auto it = credentials.constBegin(); it != credentials.constEnd(); ++it) {
+        addCredentialProxy(it.key().path(), it.value());
+    }
+}
+
+void OathDeviceProxy::onCredentialsRemovedSignal(const QList<QDBusObjectPath> &credentialPaths)
+{
+    qCDebug(OathDeviceProxyLog) << "CredentialsRemoved signal received for" << credentialPaths.size()
+                                    << "credentials on" << m_objectPath;
+    for (const auto &credentialPath : credentialPaths) {
+        removeCredentialProxy(credentialPath.path());
+    }
+}
+
 void OathDeviceProxy::onPropertiesChanged(const QString &interfaceName,
                                             const QVariantMap &changedProperties,
                                             const QStringList &invalidatedProperties)
@@ -361,6 +450,28 @@ void OathDeviceProxy::addCredentialProxy(const QString &objectPath,
     Q_EMIT credentialAdded(credential);
 }
 
+void OathDeviceProxy::addPackedCredentials(const QList<PackedCredential> &credentials)
+{
+    m_credentials.reserve(m_credentials.size() + credentials.size());
+    for (const PackedCredential &packed : credentials) {
+        if (packed.fullName.isEmpty() || m_credentials.contains(packed.fullName)) {
+            continue;
+        }
+
+        auto *credential = new OathCredentialProxy(packed, this);
+        m_credentials.insert(packed.fullName, credential);
+        Q_EMIT credentialAdded(credential);
+    }
+
+    qCDebug(OathDeviceProxyLog) << "Added" << credentials.size() << "packed credentials, total:"
+                                    << m_credentials.size();
+}
+
+void OathDeviceProxy::applyProperties(const QVariantMap &properties)
+{
+    onPropertiesChanged(QLatin1String(INTERFACE_NAME), properties, {});
+}
+
 void OathDeviceProxy::removeCredentialProxy(const QString &objectPath)
 {
     // Find credential by object path
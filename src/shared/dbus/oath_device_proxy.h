@@ -10,6 +10,8 @@
 #include <QString>
 #include <QHash>
 #include <QDateTime>
+#include <QDBusMessage>
+#include <functional>
 #include "types/yubikey_value_types.h"
 #include "types/device_state.h"
 #include "oath_credential_proxy.h"
@@ -104,26 +106,39 @@ public:
     // ========== D-Bus Methods ==========
     // Note: SavePassword() moved to OathDeviceSessionProxy
 
+    /**
+     * @brief Completion callback for asynchronous device methods
+     * @param success true if the daemon reported success
+     * @param errorMessage Human-readable error (empty on success)
+     */
+    using ResultCallback = std::function<void(bool success, const QString &errorMessage)>;
+
+    /**
+     * @brief Completion callback for addCredential()
+     */
+    using AddCredentialCallback = std::function<void(const AddCredentialResult &result)>;
+
     /**
      * @brief Changes device password
      * @param oldPassword Current password
      * @param newPassword New password
-     * @return true on success, false on failure
+     * @param callback Invoked with the result when the daemon replies
      *
-     * Synchronous D-Bus call to ChangePassword().
+     * Asynchronous D-Bus call to ChangePassword() - returns immediately.
      * Updates YubiKey password and KWallet entry.
      */
-    bool changePassword(const QString &oldPassword, const QString &newPassword);
-    bool changePassword(const QString &oldPassword, const QString &newPassword, QString &errorMessage);
+    void changePassword(const QString &oldPassword, const QString &newPassword,
+                        const ResultCallback &callback = {});
 
     /**
      * @brief Forgets device - removes from database and KWallet
+     * @param callback Invoked with the result when the daemon replies
      *
-     * Synchronous D-Bus call to Forget().
+     * Asynchronous D-Bus call to Forget() - returns immediately.
      * After successful forget, this proxy becomes invalid.
      * Parent ManagerProxy will emit deviceDisconnected signal.
      */
-    void forget();
+    void forget(const ResultCallback &callback = {});
 
     /**
      * @brief Adds credential to YubiKey
@@ -135,29 +150,31 @@ public:
      * @param period TOTP period in seconds (default 30)
      * @param counter Initial HOTP counter value (ignored for TOTP)
      * @param requireTouch Whether to require physical touch
-     * @return AddCredentialResult with (status, pathOrMessage)
+     * @param callback Invoked with AddCredentialResult (status, pathOrMessage)
      *
-     * Synchronous D-Bus call to AddCredential().
+     * Asynchronous D-Bus call to AddCredential() - returns immediately.
+     * Empty name/secret open the daemon's interactive dialog.
      * On success, credentialAdded signal will be emitted.
      */
-    AddCredentialResult addCredential(const QString &name,
-                                      const QString &secret,
-                                      const QString &type,
-                                      const QString &algorithm,
-                                      int digits,
-                                      int period,
-                                      int counter,
-                                      bool requireTouch);
+    void addCredential(const QString &name,
+                       const QString &secret,
+                       const QString &type,
+                       const QString &algorithm,
+                       int digits,
+                       int period,
+                       int counter,
+                       bool requireTouch,
+                       const AddCredentialCallback &callback = {});
 
     /**
      * @brief Sets device name
      * @param newName New friendly name for device
-     * @return true on success, false on failure
+     * @param callback Invoked with the result when the daemon replies
      *
-     * Updates D-Bus property Name.
+     * Asynchronously updates D-Bus property Name.
      * Emits nameChanged signal on success.
      */
-    bool setName(const QString &newName);
+    void setName(const QString &newName, const ResultCallback &callback = {});
 
     // ========== Value Type Conversion ==========
 
@@ -198,6 +215,8 @@ Q_SIGNALS:
 private Q_SLOTS:
     void onCredentialAddedSignal(const QDBusObjectPath &credentialPath);
     void onCredentialRemovedSignal(const QDBusObjectPath &credentialPath);
+    void onCredentialsAddedSignal(const QDBusMessage &message);
+    void onCredentialsRemovedSignal(const QList<QDBusObjectPath> &credentialPaths);
     void onPropertiesChanged(const QString &interfaceName,
                             const QVariantMap &changedProperties,
                             const QStringList &invalidatedProperties);
@@ -213,9 +232,32 @@ public:
      */
     void addCredentialProxy(const QString &objectPath, const QVariantMap &properties);
 
+    /**
+     * @brief Adds credential proxies from a GetManagedObjectsPacked() reply
+     * @param credentials Packed credentials belonging to this device
+     *
+     * Proxies are built straight from the packed structs. Existing names are
+     * skipped and credentialAdded is emitted per new proxy, like addCredentialProxy().
+     */
+    void addPackedCredentials(const QList<PackedCredential> &credentials);
+
+    /**
+     * @brief Removes a credential proxy by object path
+     * @param objectPath D-Bus object path of the credential
+     *
+     * Called internally from CredentialRemoved signal handlers and by
+     * OathManagerProxy when applying GetChangesSince() results.
+     */
+    void removeCredentialProxy(const QString &objectPath);
+
+    /**
+     * @brief Updates cached Device properties as if PropertiesChanged arrived
+     * @param properties Device interface properties (e.g. from GetChangesSince())
+     */
+    void applyProperties(const QVariantMap &properties);
+
 private:  // NOLINT(readability-redundant-access-specifiers) - Required to close Q_SLOTS section for moc
     void connectToSignals();
-    void removeCredentialProxy(const QString &objectPath);
 
     QString m_objectPath;
     QDBusInterface *m_interface;
@@ -4,8 +4,9 @@
  */
 
 #include "oath_device_session_proxy.h"
+#include "dbus_connection_helper.h"
 #include <QDBusInterface>
-#include <QDBusReply>
+#include <QDBusPendingReply>
 #include <QDBusConnection>
 #include <QLatin1String>
 #include <QLoggingCategory>
@@ -40,6 +41,7 @@ OathDeviceSessionProxy::OathDeviceSessionProxy(const QString &objectPath,
     m_state = static_cast<DeviceState>(stateValue);
     m_stateMessage = sessionProperties.value(QStringLiteral("StateMessage")).toString();
     m_hasValidPassword = sessionProperties.value(QStringLiteral("HasValidPassword")).toBool();
+    m_credentialsStale = sessionProperties.value(QStringLiteral("CredentialsStale")).toBool();
 
     // Extract last seen timestamp
     const qint64 lastSeenMsecs = sessionProperties.value(QStringLiteral("LastSeen")).toLongLong();
@@ -75,24 +77,38 @@ void OathDeviceSessionProxy::connectToSignals()
     );
 }
 
-bool OathDeviceSessionProxy::savePassword(const QString &password)
+void OathDeviceSessionProxy::savePassword(const QString &password,
+                                          const std::function<void(bool success)> &callback)
 {
     if (!m_interface || !m_interface->isValid()) {
         qCWarning(OathDeviceSessionProxyLog) << "Cannot save password: D-Bus interface invalid";
-        return false;
+        if (callback) {
+            callback(false);
+        }
+        return;
     }
 
-    const QDBusReply<bool> reply = m_interface->call(QStringLiteral("SavePassword"), password);
-
-    if (!reply.isValid()) {
-        qCWarning(OathDeviceSessionProxyLog) << "SavePassword failed for" << m_objectPath
-                                              << "Error:" << reply.error().message();
-        return false;
-    }
+    DBusConnectionHelper::onReply<bool>(
+        m_interface->asyncCall(QStringLiteral("SavePassword"), password),
+        this, [this, callback](const QDBusPendingReply<bool> &reply) {
+            bool success = false;
+            if (reply.isError()) {
+                qCWarning(OathDeviceSessionProxyLog) << "SavePassword failed for" << m_objectPath
+                                                      << "Error:" << reply.error().message();
+            } else {
+                success = reply.value();
+                qCDebug(OathDeviceSessionProxyLog) << "SavePassword for" << m_objectPath << "Result:" << success;
+            }
+
+            if (callback) {
+                callback(success);
+            }
+        });
+}
 
-    bool const success = reply.value();
-    qCDebug(OathDeviceSessionProxyLog) << "SavePassword for" << m_objectPath << "Result:" << success;
-    return success;
+void OathDeviceSessionProxy::applyProperties(const QVariantMap &properties)
+{
+    onPropertiesChanged(QLatin1String(INTERFACE_NAME), properties, {});
 }
 
 void OathDeviceSessionProxy::onPropertiesChanged(const QString &interfaceName,
@@ -125,6 +141,11 @@ void OathDeviceSessionProxy::onPropertiesChanged(const QString &interfaceName,
         Q_EMIT hasValidPasswordChanged(m_hasValidPassword);
     }
 
+    if (changedProperties.contains(QStringLiteral("CredentialsStale"))) {
+        m_credentialsStale = changedProperties.value(QStringLiteral("CredentialsStale")).toBool();
+        Q_EMIT credentialsStaleChanged(m_credentialsStale);
+    }
+
     if (changedProperties.contains(QStringLiteral("LastSeen"))) {
         const qint64 lastSeenMsecs = changedProperties.value(QStringLiteral("LastSeen")).toLongLong();
         m_lastSeen = QDateTime::fromMSecsSinceEpoch(lastSeenMsecs);
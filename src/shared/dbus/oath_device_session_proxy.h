@@ -9,6 +9,7 @@
 #include <QObject>
 #include <QString>
 #include <QDateTime>
+#include <functional>
 #include "types/device_state.h"
 
 // Forward declarations
@@ -84,6 +85,12 @@ public:
      */
     [[nodiscard]] bool hasValidPassword() const { return m_hasValidPassword; }
 
+    /**
+     * @brief Checks if device credentials are the cached last-known list
+     * @return true until the daemon has read the credentials from the card
+     */
+    [[nodiscard]] bool credentialsStale() const { return m_credentialsStale; }
+
     /**
      * @brief Gets last seen timestamp
      * @return DateTime when device was last detected by daemon
@@ -101,13 +108,19 @@ public:
     /**
      * @brief Saves password for device session
      * @param password Password to test and save to KWallet
-     * @return true on success (password valid and saved), false on failure
+     * @param callback Invoked with true on success (password valid and saved), false on failure
      *
-     * Synchronous D-Bus call to SavePassword().
+     * Asynchronous D-Bus call to SavePassword() - returns immediately.
      * Tests the password by attempting connection to device.
      * Only saves to KWallet if password is valid.
      */
-    bool savePassword(const QString &password);
+    void savePassword(const QString &password, const std::function<void(bool success)> &callback = {});
+
+    /**
+     * @brief Updates cached DeviceSession properties as if PropertiesChanged arrived
+     * @param properties DeviceSession interface properties (e.g. from GetChangesSince())
+     */
+    void applyProperties(const QVariantMap &properties);
 
 Q_SIGNALS:
     /**
@@ -128,6 +141,12 @@ Q_SIGNALS:
      */
     void hasValidPasswordChanged(bool hasValid);
 
+    /**
+     * @brief Emitted when credentialsStale property changes
+     * @param stale New credentialsStale state
+     */
+    void credentialsStaleChanged(bool stale);
+
     /**
      * @brief Emitted when lastSeen timestamp changes
      * @param timestamp New lastSeen timestamp
@@ -149,6 +168,7 @@ private:  // NOLINT(readability-redundant-access-specifiers) - Required to close
     DeviceState m_state{DeviceState::Disconnected}; // connection lifecycle state
     QString m_stateMessage; // state error/detail message
     bool m_hasValidPassword{false}; // whether daemon has valid password in KWallet
+    bool m_credentialsStale{false}; // credentials come from daemon's database cache
     QDateTime m_lastSeen; // last time device was detected
 
     static constexpr const char *SERVICE_NAME = "pl.jkolo.yubikey.oath.daemon";
@@ -5,9 +5,11 @@
 
 #include "oath_manager_proxy.h"
 #include "../../daemon/dbus/oath_manager_object.h"  // For ManagedObjectMap
+#include "dbus_connection_helper.h"
 #include <QDBusInterface>
 #include <QDBusReply>
 #include <QDBusConnection>
+#include <QDBusError>
 #include <QDBusObjectPath>
 #include <QDBusServiceWatcher>
 #include <QDBusMessage>
@@ -18,6 +20,7 @@
 #include <QDBusPendingReply>
 #include <QLatin1String>
 #include <QLoggingCategory>
+#include <utility>
 
 Q_LOGGING_CATEGORY(OathManagerProxyLog, "pl.jkolo.yubikey.oath.client.manager.proxy")
 
@@ -34,6 +37,11 @@ static void registerDBusTypes()
     if (!registered) {
         qDBusRegisterMetaType<ManagedObjectMap>();
         qDBusRegisterMetaType<InterfacePropertiesMap>();
+        qDBusRegisterMetaType<CredentialPropertiesMap>();
+        qDBusRegisterMetaType<PackedCredential>();
+        qDBusRegisterMetaType<QList<PackedCredential>>();
+        qDBusRegisterMetaType<PackedManagedObjects>();
+        qDBusRegisterMetaType<ManagedObjectChanges>();
         registered = true;
     }
 }
@@ -71,6 +79,14 @@ OathManagerProxy::OathManagerProxy(QObject *parent)
     // Setup service watcher for daemon availability
     setupServiceWatcher();
 
+    // Resume from suspend - delta refresh afterwards (logind may be absent, e.g. in tests)
+    QDBusConnection::systemBus().connect(QStringLiteral("org.freedesktop.login1"),
+                                         QStringLiteral("/org/freedesktop/login1"),
+                                         QStringLiteral("org.freedesktop.login1.Manager"),
+                                         QStringLiteral("PrepareForSleep"),
+                                         this,
+                                         SLOT(onPrepareForSleep(bool)));
+
     // Check initial daemon availability
     m_daemonAvailable = m_managerInterface->isValid() && m_objectManagerInterface->isValid();
 
@@ -145,6 +161,17 @@ void OathManagerProxy::refreshManagedObjects()
         return;
     }
 
+    // Fast path: packed credential array instead of one a{sa{sv}} per credential
+    if (!m_packedUnsupported) {
+        refreshManagedObjectsPacked();
+        return;
+    }
+
+    refreshManagedObjectsUnpacked();
+}
+
+void OathManagerProxy::refreshManagedObjectsUnpacked()
+{
     qCDebug(OathManagerProxyLog) << "Calling GetManagedObjects() asynchronously";
 
     // Call GetManagedObjects() asynchronously (non-blocking)
@@ -236,10 +263,7 @@ void OathManagerProxy::onGetManagedObjectsFinished(QDBusPendingCallWatcher *watc
 
             // Extract parent device path from credential path
             // Format: /pl/jkolo/yubikey/oath/devices/<deviceId>/credentials/<credentialId>
-            QString devicePath;
-            if (objectPath.contains(QLatin1String("/credentials/"))) {
-                devicePath = objectPath.section(QLatin1String("/credentials/"), 0, 0);
-            }
+            QString const devicePath = OathCredentialProxy::devicePathFromPath(objectPath);
 
             if (!devicePath.isEmpty()) {
                 credentialsByDevice[devicePath].insert(objectPath, credProps);
@@ -249,6 +273,81 @@ void OathManagerProxy::onGetManagedObjectsFinished(QDBusPendingCallWatcher *watc
         }
     }
 
+    applyManagedObjects(deviceObjects, sessionObjects, credentialsByDevice);
+}
+
+void OathManagerProxy::refreshManagedObjectsPacked()
+{
+    qCDebug(OathManagerProxyLog) << "Calling GetManagedObjectsPacked() asynchronously";
+
+    const QDBusMessage message = QDBusMessage::createMethodCall(QLatin1String(SERVICE_NAME),
+                                                                QLatin1String(MANAGER_PATH),
+                                                                QLatin1String(MANAGER_INTERFACE),
+                                                                QStringLiteral("GetManagedObjectsPacked"));
+
+    DBusConnectionHelper::onReply<PackedManagedObjects>(
+        QDBusConnection::sessionBus().asyncCall(message),
+        this, [this](const QDBusPendingReply<PackedManagedObjects> &reply) {
+            if (reply.isError()) {
+                if (reply.error().type() == QDBusError::UnknownMethod) {
+                    // Older or third-party daemon - use the standard ObjectManager call from now on
+                    qCDebug(OathManagerProxyLog) << "GetManagedObjectsPacked unavailable, falling back:"
+                                                     << reply.error().message();
+                    m_packedUnsupported = true;
+                } else {
+                    // Timeout, daemon restarting... - try the packed call again next time
+                    qCWarning(OathManagerProxyLog) << "GetManagedObjectsPacked failed, retrying unpacked:"
+                                                       << reply.error().message();
+                }
+                refreshManagedObjectsUnpacked();
+                return;
+            }
+
+            const PackedManagedObjects objects = reply.value();
+            if (objects.formatVersion != PackedManagedObjects::FORMAT_VERSION) {
+                qCWarning(OathManagerProxyLog) << "Unsupported packed format version"
+                                                   << objects.formatVersion << "- falling back";
+                m_packedUnsupported = true;
+                refreshManagedObjectsUnpacked();
+                return;
+            }
+
+            QHash<QString, QVariantMap> deviceObjects;
+            QHash<QString, QVariantMap> sessionObjects;
+            for (auto it = objects.devices.constBegin(); it != objects.devices.constEnd(); ++it) {
+                const QString path = it.key().path();
+                if (it.value().contains(QLatin1String(DEVICE_INTERFACE))) {
+                    deviceObjects.insert(path, it.value().value(QLatin1String(DEVICE_INTERFACE)));
+                }
+                if (it.value().contains(QLatin1String(DEVICE_SESSION_INTERFACE))) {
+                    sessionObjects.insert(path, it.value().value(QLatin1String(DEVICE_SESSION_INTERFACE)));
+                }
+            }
+
+            // Proxies are built from the packed structs directly, no per-credential QVariantMap
+            QHash<QString, QList<PackedCredential>> packedByDevice;
+            for (const PackedCredential &credential : objects.credentials) {
+                const QString path = credential.path.path();
+                const QString devicePath = OathCredentialProxy::devicePathFromPath(path);
+                if (!devicePath.isEmpty()) {
+                    packedByDevice[devicePath].append(credential);
+                }
+            }
+
+            m_generation = objects.generation;
+            qCDebug(OathManagerProxyLog) << "GetManagedObjectsPacked returned" << deviceObjects.size()
+                                             << "devices," << objects.credentials.size()
+                                             << "credentials at generation" << objects.generation;
+
+            applyManagedObjects(deviceObjects, sessionObjects, {}, packedByDevice);
+        });
+}
+
+void OathManagerProxy::applyManagedObjects(const QHash<QString, QVariantMap> &deviceObjects,
+                                           const QHash<QString, QVariantMap> &sessionObjects,
+                                           const QHash<QString, QHash<QString, QVariantMap>> &credentialsByDevice,
+                                           const QHash<QString, QList<PackedCredential>> &packedByDevice)
+{
     // Second pass: create device proxies with their sessions and credentials
     for (auto it = deviceObjects.constBegin(); it != deviceObjects.constEnd(); ++it) {
         const QString &devicePath = it.key();
@@ -256,7 +355,7 @@ void OathManagerProxy::onGetManagedObjectsFinished(QDBusPendingCallWatcher *watc
         const QVariantMap &sessionProps = sessionObjects.value(devicePath); // May be empty if session interface not found
         QHash<QString, QVariantMap> const credentials = credentialsByDevice.value(devicePath);
 
-        addDeviceProxy(devicePath, deviceProps, sessionProps, credentials);
+        addDeviceProxy(devicePath, deviceProps, sessionProps, credentials, packedByDevice.value(devicePath));
     }
 
     qCDebug(OathManagerProxyLog) << "Async refresh complete:"
@@ -267,9 +366,122 @@ void OathManagerProxy::onGetManagedObjectsFinished(QDBusPendingCallWatcher *watc
 void OathManagerProxy::refresh()
 {
     qCDebug(OathManagerProxyLog) << "Manual refresh requested";
+
+    // Known generation: ask only for what changed since (missed signals, resume)
+    if (m_generation > 0 && !m_packedUnsupported) {
+        refreshChangesSince(m_generation);
+        return;
+    }
     refreshManagedObjects();
 }
 
+void OathManagerProxy::refreshChangesSince(quint64 generation)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(QLatin1String(SERVICE_NAME),
+                                                          QLatin1String(MANAGER_PATH),
+                                                          QLatin1String(MANAGER_INTERFACE),
+                                                          QStringLiteral("GetChangesSince"));
+    message.setArguments({QVariant::fromValue(static_cast<qulonglong>(generation))});
+
+    DBusConnectionHelper::onReply<ManagedObjectChanges>(
+        QDBusConnection::sessionBus().asyncCall(message),
+        this, [this, generation](const QDBusPendingReply<ManagedObjectChanges> &reply) {
+            if (reply.isError()) {
+                qCDebug(OathManagerProxyLog) << "GetChangesSince unavailable, doing full refresh:"
+                                                 << reply.error().message();
+                m_generation = 0;
+                refreshManagedObjects();
+                return;
+            }
+
+            const ManagedObjectChanges changes = reply.value();
+            if (changes.fullResyncRequired) {
+                qCDebug(OathManagerProxyLog) << "Generation" << generation
+                                                 << "no longer in daemon journal, doing full refresh";
+                m_generation = 0;
+                refreshManagedObjects();
+                return;
+            }
+
+            qCDebug(OathManagerProxyLog) << "GetChangesSince(" << generation << ") returned"
+                                             << changes.changed.size() << "changed and"
+                                             << changes.removed.size() << "removed objects at generation"
+                                             << changes.generation;
+            m_generation = changes.generation;
+            applyChanges(changes);
+        });
+}
+
+void OathManagerProxy::applyChanges(const ManagedObjectChanges &changes)
+{
+    const auto findDevice = [this](const QString &devicePath) -> OathDeviceProxy * {
+        for (auto *device : std::as_const(m_devices)) {
+            if (device->objectPath() == devicePath) {
+                return device;
+            }
+        }
+        return nullptr;
+    };
+
+    // Removals first - a path may have been removed and re-added with the same name
+    for (const QDBusObjectPath &objectPath : changes.removed) {
+        const QString path = objectPath.path();
+        const QString devicePath = OathCredentialProxy::devicePathFromPath(path);
+        if (!devicePath.isEmpty()) {
+            if (auto *device = findDevice(devicePath)) {
+                device->removeCredentialProxy(path);
+            }
+        } else {
+            removeDeviceProxy(path);
+        }
+    }
+
+    QHash<QString, QVariantMap> deviceObjects;
+    QHash<QString, QVariantMap> sessionObjects;
+    QHash<QString, QHash<QString, QVariantMap>> credentialsByDevice;
+    for (auto it = changes.changed.constBegin(); it != changes.changed.constEnd(); ++it) {
+        const QString path = it.key().path();
+        const auto &interfaces = it.value();
+        if (interfaces.contains(QLatin1String(DEVICE_INTERFACE))) {
+            deviceObjects.insert(path, interfaces.value(QLatin1String(DEVICE_INTERFACE)));
+            sessionObjects.insert(path, interfaces.value(QLatin1String(DEVICE_SESSION_INTERFACE)));
+        } else if (interfaces.contains(QLatin1String(CREDENTIAL_INTERFACE))) {
+            const QString devicePath = OathCredentialProxy::devicePathFromPath(path);
+            if (!devicePath.isEmpty()) {
+                credentialsByDevice[devicePath].insert(path, interfaces.value(QLatin1String(CREDENTIAL_INTERFACE)));
+            }
+        }
+    }
+
+    // Known devices: update in place; credentials are added below
+    for (auto it = deviceObjects.begin(); it != deviceObjects.end();) {
+        const QString deviceId = it.value().value(QStringLiteral("ID")).toString();
+        if (auto *device = m_devices.value(deviceId)) {
+            device->applyProperties(it.value());
+            if (auto *session = m_deviceSessions.value(deviceId)) {
+                session->applyProperties(sessionObjects.value(it.key()));
+            }
+            it = deviceObjects.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // New devices get their credentials at construction
+    applyManagedObjects(deviceObjects, sessionObjects, credentialsByDevice);
+
+    for (auto it = credentialsByDevice.constBegin(); it != credentialsByDevice.constEnd(); ++it) {
+        if (deviceObjects.contains(it.key())) {
+            continue;
+        }
+        if (auto *device = findDevice(it.key())) {
+            for (auto credIt = it.value().constBegin(); credIt != it.value().constEnd(); ++credIt) {
+                device->addCredentialProxy(credIt.key(), credIt.value());
+            }
+        }
+    }
+}
+
 QList<OathDeviceProxy*> OathManagerProxy::devices() const
 {
     return m_devices.values();
@@ -368,20 +580,27 @@ void OathManagerProxy::onInterfacesAdded(const QDBusMessage &message)
 
         // Extract parent device path from credential path
         // Format: /pl/jkolo/yubikey/oath/devices/<deviceId>/credentials/<credentialId>
-        QString devicePath;
-        if (path.contains(QLatin1String("/credentials/"))) {
-            devicePath = path.section(QLatin1String("/credentials/"), 0, 0);
-        }
+        QString const devicePath = OathCredentialProxy::devicePathFromPath(path);
 
         if (!devicePath.isEmpty()) {
             // Find device proxy by path and add credential
+            OathDeviceProxy *owner = nullptr;
             for (auto *device : std::as_const(m_devices)) {
                 if (device->objectPath() == devicePath) {
-                    qCDebug(OathManagerProxyLog) << "Forwarding credential to device proxy:" << path;
-                    device->addCredentialProxy(path, credProps);
+                    owner = device;
                     break;
                 }
             }
+
+            if (owner) {
+                qCDebug(OathManagerProxyLog) << "Forwarding credential to device proxy:" << path;
+                owner->addCredentialProxy(path, credProps);
+            } else {
+                // The device's own InterfacesAdded never reached us - resync
+                qCWarning(OathManagerProxyLog) << "Credential" << path << "for unknown device"
+                                                   << devicePath << "- missed signals, refreshing";
+                scheduleRefresh();
+            }
         }
     }
 }
@@ -448,11 +667,15 @@ void OathManagerProxy::onDBusServiceRegistered(const QString &serviceName)
                                                    this);
 
     m_daemonAvailable = true;
+    // Restarted daemon may be a different build - probe the packed call again.
+    // Its generation counter is unrelated to the old instance's, so refresh() does a full fetch.
+    m_packedUnsupported = false;
+    m_generation = 0;
     Q_EMIT daemonAvailable();
 
     // Reconnect to signals and refresh objects with new interfaces
     connectToSignals();
-    refreshManagedObjects();
+    refresh();
 }
 
 void OathManagerProxy::onDBusServiceUnregistered(const QString &serviceName)
@@ -473,7 +696,8 @@ void OathManagerProxy::onDBusServiceUnregistered(const QString &serviceName)
 void OathManagerProxy::addDeviceProxy(const QString &devicePath,
                                         const QVariantMap &deviceProperties,
                                         const QVariantMap &sessionProperties,
-                                        const QHash<QString, QVariantMap> &credentialObjects)
+                                        const QHash<QString, QVariantMap> &credentialObjects,
+                                        const QList<PackedCredential> &packedCredentials)
 {
     // Extract device ID from properties (ID property contains last path segment: serialNumber or dev_<deviceId>)
     QString const deviceId = deviceProperties.value(QStringLiteral("ID")).toString();
@@ -491,29 +715,27 @@ void OathManagerProxy::addDeviceProxy(const QString &devicePath,
 
     // Create device proxy (this object becomes parent, so proxy is auto-deleted)
     auto *device = new OathDeviceProxy(devicePath, deviceProperties, credentialObjects, this);
+    device->addPackedCredentials(packedCredentials); // Before connecting - like constructor credentials
     m_devices.insert(deviceId, device);
 
     // Create device session proxy (this object becomes parent, so proxy is auto-deleted)
     auto *session = new OathDeviceSessionProxy(devicePath, sessionProperties, this);
     m_deviceSessions.insert(deviceId, session);
 
-    // Connect to device signals for credential changes
+    // Connect to device signals for credential changes (a bulk refresh adds many at once,
+    // listeners only need to rebuild once)
     connect(device, &OathDeviceProxy::credentialAdded,
-            this, &OathManagerProxy::credentialsChanged);
+            this, &OathManagerProxy::scheduleCredentialsChanged);
     connect(device, &OathDeviceProxy::credentialRemoved,
-            this, &OathManagerProxy::credentialsChanged);
+            this, &OathManagerProxy::scheduleCredentialsChanged);
 
-    // Forward device property changes (Device interface)
-    connect(device, &OathDeviceProxy::nameChanged,
-            this, [this, device]() { Q_EMIT devicePropertyChanged(device); });
-    connect(device, &OathDeviceProxy::requiresPasswordChanged,
-            this, [this, device]() { Q_EMIT devicePropertyChanged(device); });
-
-    // Forward session property changes (DeviceSession interface)
-    connect(session, &OathDeviceSessionProxy::stateChanged,
-            this, [this, device]() { Q_EMIT devicePropertyChanged(device); });
-    connect(session, &OathDeviceSessionProxy::hasValidPasswordChanged,
-            this, [this, device]() { Q_EMIT devicePropertyChanged(device); });
+    // Forward device property changes (Device + DeviceSession interfaces), coalesced per tick
+    const auto notify = [this, deviceId]() { scheduleDevicePropertyChanged(deviceId); };
+    connect(device, &OathDeviceProxy::nameChanged, this, notify);
+    connect(device, &OathDeviceProxy::requiresPasswordChanged, this, notify);
+    connect(session, &OathDeviceSessionProxy::stateChanged, this, notify);
+    connect(session, &OathDeviceSessionProxy::hasValidPasswordChanged, this, notify);
+    connect(session, &OathDeviceSessionProxy::credentialsStaleChanged, this, notify);
 
     qCDebug(OathManagerProxyLog) << "Added device and session proxies:" << deviceId
                                      << "Name:" << device->name()
@@ -522,6 +744,56 @@ void OathManagerProxy::addDeviceProxy(const QString &devicePath,
     Q_EMIT deviceConnected(device);
 }
 
+void OathManagerProxy::scheduleDevicePropertyChanged(const QString &deviceId)
+{
+    if (m_pendingDevicePropertyChanges.isEmpty()) {
+        QMetaObject::invokeMethod(this, &OathManagerProxy::flushDevicePropertyChanges, Qt::QueuedConnection);
+    }
+    m_pendingDevicePropertyChanges.insert(deviceId);
+}
+
+void OathManagerProxy::scheduleRefresh()
+{
+    if (!m_refreshScheduled) {
+        m_refreshScheduled = true;
+        QMetaObject::invokeMethod(this, [this]() {
+            m_refreshScheduled = false;
+            refresh();
+        }, Qt::QueuedConnection);
+    }
+}
+
+void OathManagerProxy::onPrepareForSleep(bool sleeping)
+{
+    // Signals emitted while suspended are lost - catch up on wake
+    if (!sleeping && m_daemonAvailable) {
+        qCDebug(OathManagerProxyLog) << "Resumed from suspend, refreshing";
+        scheduleRefresh();
+    }
+}
+
+void OathManagerProxy::scheduleCredentialsChanged()
+{
+    if (!m_credentialsChangedScheduled) {
+        m_credentialsChangedScheduled = true;
+        QMetaObject::invokeMethod(this, [this]() {
+            m_credentialsChangedScheduled = false;
+            Q_EMIT credentialsChanged();
+        }, Qt::QueuedConnection);
+    }
+}
+
+void OathManagerProxy::flushDevicePropertyChanges()
+{
+    const QSet<QString> pending = std::exchange(m_pendingDevicePropertyChanges, {});
+    for (const QString &deviceId : pending) {
+        // Device may have been removed in the meantime
+        if (auto *device = m_devices.value(deviceId)) {
+            Q_EMIT devicePropertyChanged(device);
+        }
+    }
+}
+
 void OathManagerProxy::removeDeviceProxy(const QString &devicePath)
 {
     // Find device by object path
@@ -10,9 +10,11 @@
 #include <QString>
 #include <QHash>
 #include <QMap>
+#include <QSet>
 #include "oath_device_proxy.h"
 #include "oath_device_session_proxy.h"
 #include "types/device_state.h"
+#include "types/yubikey_value_types.h"
 
 // Forward declarations
 class QDBusInterface;
@@ -119,9 +121,12 @@ public:
     /**
      * @brief Refreshes object tree from daemon
      *
-     * Calls GetManagedObjects() to refresh all devices and credentials.
+     * If a generation is known from an earlier refresh, only the changes since
+     * then are fetched via GetChangesSince(); otherwise (or if the daemon's journal
+     * no longer covers it) all devices and credentials are fetched again.
      * Emits appropriate signals for changes.
-     * Call this after daemon reconnects.
+     * Called automatically on resume from suspend, on daemon re-registration and
+     * when a signal refers to an object the proxy never saw (missed signals).
      */
     void refresh();
 
@@ -168,6 +173,7 @@ private Q_SLOTS:
                                    const QStringList &invalidatedProperties);
     void onDBusServiceRegistered(const QString &serviceName);
     void onDBusServiceUnregistered(const QString &serviceName);
+    void onPrepareForSleep(bool sleeping);
     void onGetManagedObjectsFinished(QDBusPendingCallWatcher *watcher);
 
 private:  // NOLINT(readability-redundant-access-specifiers) - Required to close Q_SLOTS section for moc
@@ -177,12 +183,68 @@ private:  // NOLINT(readability-redundant-access-specifiers) - Required to close
     void connectToSignals();
     void refreshManagedObjects();
 
+    /**
+     * @brief Refresh via ObjectManager.GetManagedObjects() (one a{sa{sv}} per object)
+     */
+    void refreshManagedObjectsUnpacked();
+
     void addDeviceProxy(const QString &devicePath,
                        const QVariantMap &deviceProperties,
                        const QVariantMap &sessionProperties,
-                       const QHash<QString, QVariantMap> &credentialObjects);
+                       const QHash<QString, QVariantMap> &credentialObjects,
+                       const QList<PackedCredential> &packedCredentials = {});
     void removeDeviceProxy(const QString &devicePath);
 
+    /**
+     * @brief Refresh via Manager.GetManagedObjectsPacked() (compact credential array)
+     *
+     * Falls back to GetManagedObjects() for good if the daemon lacks the method
+     * (UnknownMethod) or uses an unknown format version. Other errors fall back
+     * for this refresh only.
+     */
+    void refreshManagedObjectsPacked();
+
+    /**
+     * @brief Refresh via Manager.GetChangesSince() (delta since a known generation)
+     *
+     * Falls back to refreshManagedObjects() on error or when a full resync is required.
+     */
+    void refreshChangesSince(quint64 generation);
+
+    /**
+     * @brief Applies a GetChangesSince() delta to the existing proxies
+     */
+    void applyChanges(const ManagedObjectChanges &changes);
+
+    /**
+     * @brief Creates proxies for the given objects (shared by both refresh paths)
+     */
+    void applyManagedObjects(const QHash<QString, QVariantMap> &deviceObjects,
+                             const QHash<QString, QVariantMap> &sessionObjects,
+                             const QHash<QString, QHash<QString, QVariantMap>> &credentialsByDevice,
+                             const QHash<QString, QList<PackedCredential>> &packedByDevice = {});
+
+    /**
+     * @brief Queues devicePropertyChanged for a device
+     *
+     * A single PropertiesChanged message usually updates several properties
+     * (State, StateMessage, HasValidPassword...). Queued notifications are
+     * flushed once per event loop iteration, so listeners rebuild their view
+     * once per burst instead of once per property.
+     */
+    void scheduleDevicePropertyChanged(const QString &deviceId);
+    void flushDevicePropertyChanges();
+
+    /**
+     * @brief Queues credentialsChanged, emitted once per event loop iteration
+     */
+    void scheduleCredentialsChanged();
+
+    /**
+     * @brief Queues refresh(), run once per event loop iteration
+     */
+    void scheduleRefresh();
+
     // Singleton instance
     static OathManagerProxy *s_instance;
 
@@ -190,6 +252,8 @@ private:  // NOLINT(readability-redundant-access-specifiers) - Required to close
     QDBusInterface *m_objectManagerInterface{nullptr};
     QDBusServiceWatcher *m_serviceWatcher{nullptr};
     bool m_daemonAvailable{false};
+    bool m_packedUnsupported{false};   // Daemon lacks GetManagedObjectsPacked() (UnknownMethod)
+    quint64 m_generation{0};           // Manager generation of last packed refresh (0 = unknown)
 
     // Manager properties
     QString m_version;
@@ -197,6 +261,9 @@ private:  // NOLINT(readability-redundant-access-specifiers) - Required to close
     // Device and session proxies (owned by this object via Qt parent-child)
     QHash<QString, OathDeviceProxy*> m_devices; // key: device ID
     QHash<QString, OathDeviceSessionProxy*> m_deviceSessions; // key: device ID
+    QSet<QString> m_pendingDevicePropertyChanges; // device IDs awaiting devicePropertyChanged
+    bool m_credentialsChangedScheduled{false};
+    bool m_refreshScheduled{false};
 
     static constexpr const char *SERVICE_NAME = "pl.jkolo.yubikey.oath.daemon";
     static constexpr const char *MANAGER_PATH = "/pl/jkolo/yubikey/oath";
@@ -115,3 +115,61 @@ const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::A
     arg.endStructure();
     return arg;
 }
+
+// PackedCredential marshaling
+// D-Bus signature: (ossssbyyyq)
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::PackedCredential &credential)
+{
+    arg.beginStructure();
+    arg << credential.path << credential.fullName << credential.issuer << credential.username
+        << credential.deviceId << credential.requiresTouch << credential.type << credential.algorithm
+        << credential.digits << credential.period;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::PackedCredential &credential)
+{
+    arg.beginStructure();
+    arg >> credential.path >> credential.fullName >> credential.issuer >> credential.username
+        >> credential.deviceId >> credential.requiresTouch >> credential.type >> credential.algorithm
+        >> credential.digits >> credential.period;
+    arg.endStructure();
+    return arg;
+}
+
+// PackedManagedObjects marshaling
+// D-Bus signature: (uta{oa{sa{sv}}}a(ossssbyyyq))
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::PackedManagedObjects &objects)
+{
+    arg.beginStructure();
+    arg << objects.formatVersion << objects.generation << objects.devices << objects.credentials;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::PackedManagedObjects &objects)
+{
+    arg.beginStructure();
+    arg >> objects.formatVersion >> objects.generation >> objects.devices >> objects.credentials;
+    arg.endStructure();
+    return arg;
+}
+
+// ManagedObjectChanges marshaling
+// D-Bus signature: (tba{oa{sa{sv}}}ao)
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::ManagedObjectChanges &changes)
+{
+    arg.beginStructure();
+    arg << changes.generation << changes.fullResyncRequired << changes.changed << changes.removed;
+    arg.endStructure();
+    return arg;
+}
+
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::ManagedObjectChanges &changes)
+{
+    arg.beginStructure();
+    arg >> changes.generation >> changes.fullResyncRequired >> changes.changed >> changes.removed;
+    arg.endStructure();
+    return arg;
+}
@@ -11,6 +11,9 @@
 #include <QMetaType>
 #include <QDBusArgument>
 #include <QDateTime>
+#include <QDBusObjectPath>
+#include <QMap>
+#include <QVariantMap>
 #include "../utils/version.h"
 #include "yubikey_model.h"
 #include "device_state.h"
@@ -73,6 +76,66 @@ struct AddCredentialResult {
         : status(std::move(s)), message(std::move(m)) {}
 };
 
+/**
+ * @brief Credential properties keyed by object path
+ *
+ * Payload of the bulk Device.CredentialsAdded signal (D-Bus signature a{oa{sv}}).
+ * Carries the pl.jkolo.yubikey.oath.Credential properties of every new object,
+ * so clients don't need a GetAll round-trip per credential.
+ */
+using CredentialPropertiesMap = QMap<QDBusObjectPath, QVariantMap>;
+
+/**
+ * @brief Credential metadata in fixed field order for bulk transfer
+ *
+ * Same information as the Credential interface properties, but without
+ * per-field string keys and variants. Enum values are transported as bytes.
+ */
+struct PackedCredential {
+    QDBusObjectPath path;       ///< Credential object path
+    QString fullName;           ///< FullName property
+    QString issuer;             ///< Issuer property
+    QString username;           ///< Username property
+    QString deviceId;           ///< DeviceId property
+    bool requiresTouch{false};  ///< RequiresTouch property
+    quint8 type{0};             ///< OathType value (1 = HOTP, 2 = TOTP)
+    quint8 algorithm{0};        ///< OathAlgorithm value (1 = SHA1, 2 = SHA256, 3 = SHA512)
+    quint8 digits{6};           ///< Digits property
+    quint16 period{30};         ///< Period property (seconds)
+};
+
+/**
+ * @brief Reply of Manager.GetManagedObjectsPacked
+ *
+ * Device objects use the regular ObjectManager layout (there are few of them),
+ * credentials use PackedCredential. formatVersion is bumped whenever the
+ * layout changes; clients fall back to GetManagedObjects() on a mismatch.
+ */
+struct PackedManagedObjects {
+    static constexpr quint32 FORMAT_VERSION = 1;
+
+    quint32 formatVersion{FORMAT_VERSION};
+    quint64 generation{0};      ///< Manager generation the data was taken at
+    QMap<QDBusObjectPath, QMap<QString, QVariantMap>> devices; ///< Device paths → interfaces → properties
+    QList<PackedCredential> credentials;
+};
+
+/**
+ * @brief Reply of Manager.GetChangesSince
+ *
+ * Objects added or modified after the requested generation, with their
+ * current interfaces and properties, and objects removed since then.
+ * If fullResyncRequired is set the journal no longer covers the requested
+ * generation; changed/removed are empty and the client must call
+ * GetManagedObjects() instead.
+ */
+struct ManagedObjectChanges {
+    quint64 generation{0};              ///< Current generation (pass to the next call)
+    bool fullResyncRequired{false};     ///< Requested generation unknown or trimmed
+    QMap<QDBusObjectPath, QMap<QString, QVariantMap>> changed;  ///< Same layout as GetManagedObjects()
+    QList<QDBusObjectPath> removed;     ///< Objects that no longer exist
+};
+
 } // namespace Shared
 } // namespace YubiKeyOath
 
@@ -81,6 +144,10 @@ Q_DECLARE_METATYPE(YubiKeyOath::Shared::DeviceInfo)
 Q_DECLARE_METATYPE(YubiKeyOath::Shared::CredentialInfo)
 Q_DECLARE_METATYPE(YubiKeyOath::Shared::GenerateCodeResult)
 Q_DECLARE_METATYPE(YubiKeyOath::Shared::AddCredentialResult)
+Q_DECLARE_METATYPE(YubiKeyOath::Shared::CredentialPropertiesMap)
+Q_DECLARE_METATYPE(YubiKeyOath::Shared::PackedCredential)
+Q_DECLARE_METATYPE(YubiKeyOath::Shared::PackedManagedObjects)
+Q_DECLARE_METATYPE(YubiKeyOath::Shared::ManagedObjectChanges)
 
 // D-Bus marshaling operators
 QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::DeviceInfo &device);
@@ -95,4 +162,13 @@ const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::G
 QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::AddCredentialResult &result);
 const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::AddCredentialResult &result);
 
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::PackedCredential &credential);
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::PackedCredential &credential);
+
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::PackedManagedObjects &objects);
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::PackedManagedObjects &objects);
+
+QDBusArgument &operator<<(QDBusArgument &arg, const YubiKeyOath::Shared::ManagedObjectChanges &changes);
+const QDBusArgument &operator>>(const QDBusArgument &arg, YubiKeyOath::Shared::ManagedObjectChanges &changes);
+
 #endif // YUBIKEY_VALUE_TYPES_H
@@ -56,47 +56,47 @@ void showDialog(
                     return;
                 }
 
-                // Change password via device proxy (blocking call) - get detailed error message
-                QString errorMessage;
-                const bool success = device->changePassword(oldPassword, newPassword, errorMessage);
+                // Change password via device proxy (async call) - get detailed error message
+                device->changePassword(oldPassword, newPassword,
+                    [dialogPtr, devId, newPassword, onPasswordChangeSuccess](bool success, const QString &errorMessage) {
+                    // Check if dialog still exists before accessing it
+                    if (!dialogPtr) {
+                        qCDebug(YubiKeyUILog) << "Change password dialog was closed before operation completed";
+                        return;
+                    }
 
-                // Check if dialog still exists before accessing it
-                if (!dialogPtr) {
-                    qCDebug(YubiKeyUILog) << "Change password dialog was closed before operation completed";
-                    return;
-                }
+                    if (success) {
+                        if (newPassword.isEmpty()) {
+                            qCDebug(YubiKeyUILog) << "Password removed successfully for device:" << devId;
+                        } else {
+                            qCDebug(YubiKeyUILog) << "Password changed successfully for device:" << devId;
+                        }
 
-                if (success) {
-                    if (newPassword.isEmpty()) {
-                        qCDebug(YubiKeyUILog) << "Password removed successfully for device:" << devId;
+                        // Success - close dialog
+                        QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, onPasswordChangeSuccess]() {
+                            if (dialogPtr) {
+                                dialogPtr->accept();
+                            }
+                            // Invoke success callback (e.g., notification, model refresh)
+                            if (onPasswordChangeSuccess) {
+                                onPasswordChangeSuccess();
+                            }
+                        }, Qt::QueuedConnection);
                     } else {
-                        qCDebug(YubiKeyUILog) << "Password changed successfully for device:" << devId;
+                        // Failed - show detailed error in dialog, keep it open
+                        qCWarning(YubiKeyUILog) << "Password change failed for device:" << devId << "Error:" << errorMessage;
+                        QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, errorMessage]() {
+                            if (dialogPtr) {
+                                // Use detailed error message if available, otherwise use generic message
+                                const QString displayError = errorMessage.isEmpty()
+                                    ? i18n("Failed to change password.\n"
+                                           "The current password may be incorrect, or the YubiKey may not be accessible.")
+                                    : errorMessage;
+                                dialogPtr->showError(displayError);
+                            }
+                        }, Qt::QueuedConnection);
                     }
-
-                    // Success - close dialog
-                    QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, onPasswordChangeSuccess]() {
-                        if (dialogPtr) {
-                            dialogPtr->accept();
-                        }
-                        // Invoke success callback (e.g., notification, model refresh)
-                        if (onPasswordChangeSuccess) {
-                            onPasswordChangeSuccess();
-                        }
-                    }, Qt::QueuedConnection);
-                } else {
-                    // Failed - show detailed error in dialog, keep it open
-                    qCWarning(YubiKeyUILog) << "Password change failed for device:" << devId << "Error:" << errorMessage;
-                    QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, errorMessage]() {
-                        if (dialogPtr) {
-                            // Use detailed error message if available, otherwise use generic message
-                            const QString displayError = errorMessage.isEmpty()
-                                ? i18n("Failed to change password.\n"
-                                       "The current password may be incorrect, or the YubiKey may not be accessible.")
-                                : errorMessage;
-                            dialogPtr->showError(displayError);
-                        }
-                    }, Qt::QueuedConnection);
-                }
+                    });
             });
 
     // Show dialog (non-modal)
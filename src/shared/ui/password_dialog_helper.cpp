@@ -80,40 +80,40 @@ void showDialog(
                     return;
                 }
 
-                // Test and save password via session proxy (blocking call)
-                const bool success = session->savePassword(password);
+                // Test and save password via session proxy (async call)
+                session->savePassword(password, [dialogPtr, devId, onPasswordSuccess](bool success) {
+                    // Check if dialog still exists before accessing it
+                    if (!dialogPtr) {
+                        qCDebug(YubiKeyUILog) << "Password dialog was closed before verification completed";
+                        return;
+                    }
 
-                // Check if dialog still exists before accessing it
-                if (!dialogPtr) {
-                    qCDebug(YubiKeyUILog) << "Password dialog was closed before verification completed";
-                    return;
-                }
+                    if (success) {
+                        qCDebug(YubiKeyUILog) << "Password saved successfully for device:" << devId;
 
-                if (success) {
-                    qCDebug(YubiKeyUILog) << "Password saved successfully for device:" << devId;
-
-                    // Success - close dialog (queued to ensure execution in GUI thread)
-                    // Note: Device name is already updated via deviceNameChanged signal
-                    QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, onPasswordSuccess]() {
-                        if (dialogPtr) {
-                            dialogPtr->accept();
-                        }
-                        // Invoke success callback (e.g., notification, model refresh)
-                        if (onPasswordSuccess) {
-                            onPasswordSuccess();
-                        }
-                    }, Qt::QueuedConnection);
-                } else {
-                    // Invalid password - show error in dialog, keep it open
-                    // Use QueuedConnection to ensure UI manipulation happens in GUI thread
-                    qCWarning(YubiKeyUILog) << "Password test failed for device:" << devId;
-                    QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr]() {
-                        if (dialogPtr) {
-                            dialogPtr->showError(i18n("Invalid password. Please try again."));
-                            // showError() calls setVerifying(false) internally
-                        }
-                    }, Qt::QueuedConnection);
-                }
+                        // Success - close dialog (queued to ensure execution in GUI thread)
+                        // Note: Device name is already updated via deviceNameChanged signal
+                        QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr, onPasswordSuccess]() {
+                            if (dialogPtr) {
+                                dialogPtr->accept();
+                            }
+                            // Invoke success callback (e.g., notification, model refresh)
+                            if (onPasswordSuccess) {
+                                onPasswordSuccess();
+                            }
+                        }, Qt::QueuedConnection);
+                    } else {
+                        // Invalid password - show error in dialog, keep it open
+                        // Use QueuedConnection to ensure UI manipulation happens in GUI thread
+                        qCWarning(YubiKeyUILog) << "Password test failed for device:" << devId;
+                        QMetaObject::invokeMethod(dialogPtr.data(), [dialogPtr]() {
+                            if (dialogPtr) {
+                                dialogPtr->showError(i18n("Invalid password. Please try again."));
+                                // showError() calls setVerifying(false) internally
+                            }
+                        }, Qt::QueuedConnection);
+                    }
+                });
             });
 
     QObject::connect(dlg, &QDialog::rejected, parent,
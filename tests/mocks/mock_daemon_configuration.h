@@ -42,12 +42,15 @@ public:
         , m_showDeviceNameOnlyWhenMultiple(true)
         , m_touchTimeout(15)
         , m_notificationExtraTime(5)
+        , m_notificationFrameRate(1)
         , m_primaryAction(QStringLiteral("copy"))
         , m_deviceReconnectTimeout(30)
         , m_enableCredentialsCache(true)  // Default: cache enabled
         , m_credentialSaveRateLimit(1000)  // Default: 1 second
         , m_pcscRateLimitMs(0)  // Default: no delay
         , m_persistPortalSession(true)  // Default: persist session
+        , m_persistPortalSessionConfigured(true)
+        , m_burstTypeDigits(false)
     {
     }
 
@@ -84,6 +87,10 @@ public:
         return m_notificationExtraTime;
     }
 
+    int notificationFrameRate() const override {
+        return m_notificationFrameRate;
+    }
+
     QString primaryAction() const override {
         return m_primaryAction;
     }
@@ -109,6 +116,14 @@ public:
         return m_persistPortalSession;
     }
 
+    bool persistPortalSessionConfigured() const override {
+        return m_persistPortalSessionConfigured;
+    }
+
+    bool burstTypeDigits() const override {
+        return m_burstTypeDigits;
+    }
+
 Q_SIGNALS:
     void configurationChanged();
 
@@ -149,6 +164,11 @@ public:
         Q_EMIT configurationChanged();
     }
 
+    void setNotificationFrameRate(int value) {
+        m_notificationFrameRate = value;
+        Q_EMIT configurationChanged();
+    }
+
     void setPrimaryAction(const QString &value) {
         m_primaryAction = value;
         Q_EMIT configurationChanged();
@@ -177,6 +197,18 @@ public:
 
     void setPersistPortalSession(bool value) {
         m_persistPortalSession = value;
+        m_persistPortalSessionConfigured = true;
+        Q_EMIT configurationChanged();
+    }
+
+    void unsetPersistPortalSession() {
+        m_persistPortalSession = true;
+        m_persistPortalSessionConfigured = false;
+        Q_EMIT configurationChanged();
+    }
+
+    void setBurstTypeDigits(bool value) {
+        m_burstTypeDigits = value;
         Q_EMIT configurationChanged();
     }
 
@@ -189,12 +221,15 @@ public:
         m_showDeviceNameOnlyWhenMultiple = true;
         m_touchTimeout = 15;
         m_notificationExtraTime = 5;
+        m_notificationFrameRate = 1;
         m_primaryAction = QStringLiteral("copy");
         m_deviceReconnectTimeout = 30;
         m_enableCredentialsCache = true;
         m_credentialSaveRateLimit = 1000;
         m_pcscRateLimitMs = 0;
         m_persistPortalSession = true;
+        m_persistPortalSessionConfigured = true;
+        m_burstTypeDigits = false;
         Q_EMIT configurationChanged();
     }
 
@@ -207,6 +242,7 @@ private:
     bool m_showDeviceNameOnlyWhenMultiple;
     int m_touchTimeout;
     int m_notificationExtraTime;
+    int m_notificationFrameRate;
     QString m_primaryAction;
     int m_deviceReconnectTimeout;
 
@@ -215,6 +251,8 @@ private:
     int m_credentialSaveRateLimit;
     int m_pcscRateLimitMs;
     bool m_persistPortalSession;
+    bool m_persistPortalSessionConfigured;
+    bool m_burstTypeDigits;
 };
 
 } // namespace Daemon
@@ -243,6 +243,20 @@ public:
         return count;
     }
 
+    /**
+     * @brief Gets number of update notification calls
+     */
+    int updateCallCount() const
+    {
+        int count = 0;
+        for (const auto& call : m_calls) {
+            if (call.method == QStringLiteral("updateNotification")) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     /**
      * @brief Gets number of close notification calls
      */
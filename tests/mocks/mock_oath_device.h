@@ -136,6 +136,17 @@ public:
         return Shared::Result<void>::success();
     }
 
+    QList<Shared::Result<void>> addCredentials(const QList<Shared::OathCredentialData> &credentials) override
+    {
+        m_addCredentialsCallCount++;
+
+        QList<Shared::Result<void>> results;
+        for (const auto &data : credentials) {
+            results.append(addCredential(data));
+        }
+        return results;
+    }
+
     Shared::Result<void> deleteCredential(const QString &name) override
     {
         // If custom result is set, return it
@@ -154,6 +165,17 @@ public:
         return Shared::Result<void>::error(QStringLiteral("Credential not found"));
     }
 
+    QList<Shared::Result<void>> deleteCredentials(const QStringList &names) override
+    {
+        m_deleteCredentialsCallCount++;
+
+        QList<Shared::Result<void>> results;
+        for (const QString &name : names) {
+            results.append(deleteCredential(name));
+        }
+        return results;
+    }
+
     /**
      * @brief Authenticates with password
      * @param password Password to verify
@@ -324,6 +346,22 @@ public:
         return m_currentPassword;
     }
 
+    /**
+     * @brief Number of addCredentials() batches (one card transaction each)
+     */
+    int addCredentialsCallCount() const
+    {
+        return m_addCredentialsCallCount;
+    }
+
+    /**
+     * @brief Number of deleteCredentials() batches (one card transaction each)
+     */
+    int deleteCredentialsCallCount() const
+    {
+        return m_deleteCredentialsCallCount;
+    }
+
     /**
      * @brief Creates test credential
      */
@@ -372,6 +410,9 @@ private:
     std::optional<Shared::Result<QString>> m_mockGenerateCodeResult;
     std::optional<Shared::Result<void>> m_mockAddCredentialResult;
     std::optional<Shared::Result<void>> m_mockDeleteCredentialResult;
+
+    int m_addCredentialsCallCount{0};
+    int m_deleteCredentialsCallCount{0};
 };
 
 } // namespace Daemon
@@ -8,17 +8,17 @@
 namespace YubiKeyOath {
 namespace Daemon {
 
-MockService::MockService(QObject *parent)
-    : QObject(parent)
+MockOathService::MockOathService(QObject *parent)
+    : OathService(NoComponents{}, parent)
 {
 }
 
-QList<DeviceInfo> MockService::listDevices()
+QList<DeviceInfo> MockOathService::listDevices()
 {
     return m_devices.values();
 }
 
-QList<OathCredential> MockService::getCredentials(const QString &deviceId)
+QList<OathCredential> MockOathService::getCredentials(const QString &deviceId)
 {
     if (deviceId.isEmpty()) {
         return getCredentials();
@@ -27,7 +27,7 @@ QList<OathCredential> MockService::getCredentials(const QString &deviceId)
     return m_credentials.value(deviceId);
 }
 
-QList<OathCredential> MockService::getCredentials()
+QList<OathCredential> MockOathService::getCredentials()
 {
     QList<OathCredential> allCredentials;
 
@@ -38,64 +38,82 @@ QList<OathCredential> MockService::getCredentials()
     return allCredentials;
 }
 
-OathDevice* MockService::getDevice(const QString &deviceId)
+OathDevice* MockOathService::getDevice(const QString &deviceId)
 {
     Q_UNUSED(deviceId);
-    return nullptr;  // Not implemented in mock
+    return nullptr;  // No live devices in mock
 }
 
-void MockService::addMockDevice(const DeviceInfo &device)
+bool MockOathService::hasLiveCredentials(const QString &deviceId) const
+{
+    return m_liveCredentialDevices.contains(deviceId);
+}
+
+QDateTime MockOathService::getDeviceLastSeen(const QString &deviceId) const
+{
+    Q_UNUSED(deviceId);
+    return {};
+}
+
+void MockOathService::addMockDevice(const DeviceInfo &device)
 {
     m_devices.insert(device._internalDeviceId, device);
 }
 
-void MockService::removeMockDevice(const QString &deviceId)
+void MockOathService::removeMockDevice(const QString &deviceId)
 {
     m_devices.remove(deviceId);
     m_credentials.remove(deviceId);
+    m_liveCredentialDevices.remove(deviceId);
 }
 
-void MockService::addMockCredential(const QString &deviceId, const OathCredential &credential)
+void MockOathService::addMockCredential(const QString &deviceId, const OathCredential &credential)
 {
-    if (!m_credentials.contains(deviceId)) {
-        m_credentials.insert(deviceId, QList<OathCredential>());
-    }
-
     m_credentials[deviceId].append(credential);
 }
 
-void MockService::clearMockCredentials(const QString &deviceId)
+void MockOathService::clearMockCredentials(const QString &deviceId)
 {
     m_credentials.remove(deviceId);
 }
 
-void MockService::clear()
+void MockOathService::setLiveCredentials(const QString &deviceId, bool live)
+{
+    if (live) {
+        m_liveCredentialDevices.insert(deviceId);
+    } else {
+        m_liveCredentialDevices.remove(deviceId);
+    }
+}
+
+void MockOathService::clear()
 {
     m_devices.clear();
     m_credentials.clear();
+    m_liveCredentialDevices.clear();
 }
 
-int MockService::credentialCount(const QString &deviceId) const
+int MockOathService::credentialCount(const QString &deviceId) const
 {
-    return m_credentials.value(deviceId).size();
+    return static_cast<int>(m_credentials.value(deviceId).size());
 }
 
-void MockService::emitDeviceConnected(const QString &deviceId)
+void MockOathService::emitDeviceConnected(const QString &deviceId)
 {
     Q_EMIT deviceConnected(deviceId);
 }
 
-void MockService::emitDeviceDisconnected(const QString &deviceId)
+void MockOathService::emitDeviceDisconnected(const QString &deviceId)
 {
     Q_EMIT deviceDisconnected(deviceId);
 }
 
-void MockService::emitDeviceForgotten(const QString &deviceId)
+void MockOathService::emitDeviceForgotten(const QString &deviceId)
 {
     Q_EMIT deviceForgotten(deviceId);
 }
 
-void MockService::emitCredentialsUpdated(const QString &deviceId)
+void MockOathService::emitCredentialsUpdated(const QString &deviceId)
 {
     Q_EMIT credentialsUpdated(deviceId);
 }
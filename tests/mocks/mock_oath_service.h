@@ -9,79 +9,77 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QSet>
+#include "daemon/services/oath_service.h"
 #include "types/yubikey_value_types.h"
 #include "types/oath_credential.h"
 
-namespace YubiKeyOath {
-namespace Daemon {
-    class OathDeviceManager;
-    class CredentialService;
-    class OathDevice;
-}
-}
-
 namespace YubiKeyOath {
 namespace Daemon {
 
 using namespace YubiKeyOath::Shared;
 
 /**
- * @brief Mock implementation of YubiKeyService for testing D-Bus objects
+ * @brief Mock implementation of OathService for testing D-Bus objects
  *
- * Provides lightweight mock of YubiKeyService without requiring actual
- * PC/SC hardware or dependencies. Stores devices and credentials in memory.
+ * Inherits from OathService (constructed without components) so it can be
+ * passed to OathManagerObject, OathDeviceObject and CredentialObjectManager.
+ * Devices and credentials are stored in memory; no PC/SC, database or
+ * KWallet is touched.
  *
  * Used in tests for OathManagerObject, OathDeviceObject, OathCredentialObject.
  */
-class MockOathService : public QObject
+class MockOathService : public OathService
 {
     Q_OBJECT
 
 public:
-    explicit MockService(QObject *parent = nullptr);
-    ~MockService() override = default;
+    explicit MockOathService(QObject *parent = nullptr);
+    ~MockOathService() override = default;
 
     // ========================================================================
-    // YubiKeyService API (subset used by D-Bus objects)
+    // OathService API (subset used by D-Bus objects)
     // ========================================================================
 
     /**
-     * @brief Lists all mock devices
+     * @brief Lists all mock devices (overrides base class)
      * @return List of device information
      */
-    QList<DeviceInfo> listDevices();
+    QList<DeviceInfo> listDevices() override;
 
     /**
-     * @brief Gets credentials for specific device
+     * @brief Gets credentials for specific device (overrides base class)
      * @param deviceId Device ID (empty = all devices)
      * @return List of credentials
      */
-    QList<OathCredential> getCredentials(const QString &deviceId);
+    QList<OathCredential> getCredentials(const QString &deviceId) override;
 
     /**
-     * @brief Gets all credentials from all devices
+     * @brief Gets all credentials from all devices (overrides base class)
      * @return List of credentials from all devices
      */
-    QList<OathCredential> getCredentials();
+    QList<OathCredential> getCredentials() override;
 
     /**
      * @brief Gets device instance by ID (always returns nullptr in mock)
      * @param deviceId Device ID
-     * @return nullptr (not implemented in mock)
+     * @return nullptr (no live devices in mock)
      */
-    OathDevice* getDevice(const QString &deviceId);
+    OathDevice* getDevice(const QString &deviceId) override;
 
     /**
-     * @brief Gets device manager (always returns nullptr in mock)
-     * @return nullptr (not needed for D-Bus object tests)
+     * @brief Checks whether credentials of device are live (overrides base class)
+     * @param deviceId Device ID
+     * @return true if set with setLiveCredentials(), false (cached) by default
      */
-    OathDeviceManager* getDeviceManager() const { return nullptr; }
+    bool hasLiveCredentials(const QString &deviceId) const override;
 
     /**
-     * @brief Gets credential service (always returns nullptr in mock)
-     * @return nullptr (not needed for D-Bus object tests)
+     * @brief Gets last seen timestamp (always invalid in mock)
+     * @param deviceId Device ID
+     * @return Invalid QDateTime
      */
-    CredentialService* getCredentialService() const { return nullptr; }
+    QDateTime getDeviceLastSeen(const QString &deviceId) const override;
 
     // ========================================================================
     // Test Helper API
@@ -118,6 +116,13 @@ public:
      */
     void clearMockCredentials(const QString &deviceId);
 
+    /**
+     * @brief Marks credentials of device as read from the card (or cached)
+     * @param deviceId Device ID
+     * @param live true = live, false = database cache
+     */
+    void setLiveCredentials(const QString &deviceId, bool live);
+
     /**
      * @brief Clears all mock data
      */
@@ -127,7 +132,7 @@ public:
      * @brief Gets number of mock devices
      * @return Device count
      */
-    int deviceCount() const { return m_devices.size(); }
+    int deviceCount() const { return static_cast<int>(m_devices.size()); }
 
     /**
      * @brief Gets number of credentials for device
@@ -160,37 +165,15 @@ public:
      */
     void emitCredentialsUpdated(const QString &deviceId);
 
-Q_SIGNALS:
-    /**
-     * @brief Emitted when credentials are updated for a device
-     * @param deviceId Device ID
-     */
-    void credentialsUpdated(const QString &deviceId);
-
-    /**
-     * @brief Emitted when a device is connected
-     * @param deviceId Device ID
-     */
-    void deviceConnected(const QString &deviceId);
-
-    /**
-     * @brief Emitted when a device is disconnected
-     * @param deviceId Device ID
-     */
-    void deviceDisconnected(const QString &deviceId);
-
-    /**
-     * @brief Emitted when a device is forgotten
-     * @param deviceId Device ID
-     */
-    void deviceForgotten(const QString &deviceId);
-
 private:
     // Map: deviceId -> DeviceInfo
     QMap<QString, DeviceInfo> m_devices;
 
     // Map: deviceId -> list of credentials
     QMap<QString, QList<OathCredential>> m_credentials;
+
+    // Devices whose credentials count as read from the card
+    QSet<QString> m_liveCredentialDevices;
 };
 
 } // namespace Daemon
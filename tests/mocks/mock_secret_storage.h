@@ -9,6 +9,7 @@
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QMetaObject>
 
 namespace YubiKeyOath {
 namespace Daemon {
@@ -51,6 +52,20 @@ public:
         return SecureMemory::SecureString();
     }
 
+    /**
+     * @brief Delivers password from in-memory storage on next event loop iteration
+     * @param deviceId Device identifier
+     * @param context Callback is dropped if destroyed first
+     * @param callback Receives password (empty if not found)
+     */
+    void loadPasswordAsync(const QString &deviceId, QObject *context, PasswordCallback callback) override {
+        m_loadPasswordAsyncCalls[deviceId]++;
+        QMetaObject::invokeMethod(context, [this, deviceId, callback = std::move(callback)]() {
+            const SecureMemory::SecureString password = loadPasswordSync(deviceId);
+            callback(password);
+        }, Qt::QueuedConnection);
+    }
+
     /**
      * @brief Saves password to in-memory storage
      * @param password Password to save
@@ -143,6 +158,13 @@ public:
         return m_removePasswordCalls.value(deviceId, 0);
     }
 
+    /**
+     * @brief Gets number of times loadPasswordAsync() was called for device
+     */
+    int loadPasswordAsyncCallCount(const QString &deviceId) const {
+        return m_loadPasswordAsyncCalls.value(deviceId, 0);
+    }
+
     /**
      * @brief Directly sets password (for test setup)
      */
@@ -172,6 +194,7 @@ public:
         m_passwords.clear();
         m_savePasswordCalls.clear();
         m_removePasswordCalls.clear();
+        m_loadPasswordAsyncCalls.clear();
         m_restoreToken.clear();
         m_savePasswordResult = true;
         m_removePasswordResult = true;
@@ -188,6 +211,7 @@ private:
     QMap<QString, QString> m_passwords;
     QMap<QString, int> m_savePasswordCalls;
     QMap<QString, int> m_removePasswordCalls;
+    QMap<QString, int> m_loadPasswordAsyncCalls;
     QString m_restoreToken;
     bool m_savePasswordResult;
     bool m_removePasswordResult;
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "../src/daemon/oath/card_reset_recovery.h"
+
+#include <QtTest>
+
+using namespace YubiKeyOath::Daemon;
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Tests for the card reset re-run policy used by OathDevice
+ *
+ * A simulated card drives the helpers the way YkOathSession does: a reset
+ * fails the interrupted APDU and every later one until the card is
+ * reconnected.
+ */
+class TestCardResetRecovery : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // runWithCardResetRecovery()
+    void testRun_NoResetRunsOnce();
+    void testRun_RecoveredResetRerunsOnce();
+    void testRun_FailedRecoveryKeepsFirstResult();
+    void testRun_ResetDuringRerunIsNotRetried();
+
+    // BatchResend
+    void testBatch_FirstCallSendsAll();
+    void testBatch_RerunResendsOnlyFailedNames();
+    void testBatch_RerunWithoutFailuresSendsNothing();
+    void testBatch_DeleteRerunAfterResetMidBatch();
+
+private:
+    /// Card that resets before the APDU at index resetAt and refuses APDUs until reconnected
+    struct SimulatedCard {
+        QStringList stored;
+        int resetAt = -1;
+        int apdus = 0;
+        bool resetPending = false;
+        QStringList deleteRequests;
+
+        QList<Result<void>> deleteCredentials(const QStringList &names)
+        {
+            deleteRequests.append(names);
+            QList<Result<void>> results;
+            for (const QString &name : names) {
+                if (apdus++ == resetAt) {
+                    resetPending = true;
+                }
+                if (resetPending) {
+                    results.append(Result<void>::error(QStringLiteral("Card reset")));
+                } else if (stored.removeOne(name)) {
+                    results.append(Result<void>::success());
+                } else {
+                    results.append(Result<void>::error(QStringLiteral("No such object")));
+                }
+            }
+            return results;
+        }
+
+        bool reconnect()
+        {
+            resetPending = false;
+            return true;
+        }
+    };
+};
+
+void TestCardResetRecovery::testRun_NoResetRunsOnce()
+{
+    int runs = 0;
+    int recoveries = 0;
+    const int result = runWithCardResetRecovery(
+        [&]() { return ++runs; },
+        []() { return false; },
+        [&]() { ++recoveries; return true; });
+
+    QCOMPARE(result, 1);
+    QCOMPARE(runs, 1);
+    QCOMPARE(recoveries, 0);
+}
+
+void TestCardResetRecovery::testRun_RecoveredResetRerunsOnce()
+{
+    bool resetPending = false;
+    int runs = 0;
+    const auto result = runWithCardResetRecovery(
+        [&]() {
+            if (++runs == 1) {
+                resetPending = true;
+                return Result<QString>::error(QStringLiteral("Card reset"));
+            }
+            return Result<QString>::success(QStringLiteral("123456"));
+        },
+        [&]() { return resetPending; },
+        [&]() { resetPending = false; return true; });
+
+    QVERIFY(result.isSuccess());
+    QCOMPARE(result.value(), QStringLiteral("123456"));
+    QCOMPARE(runs, 2);
+}
+
+void TestCardResetRecovery::testRun_FailedRecoveryKeepsFirstResult()
+{
+    // Also the main-thread case: recovery is queued in the background and reports false
+    int runs = 0;
+    const auto result = runWithCardResetRecovery(
+        [&]() { ++runs; return Result<void>::error(QStringLiteral("Card reset")); },
+        []() { return true; },
+        []() { return false; });
+
+    QVERIFY(result.isError());
+    QCOMPARE(result.error(), QStringLiteral("Card reset"));
+    QCOMPARE(runs, 1);
+}
+
+void TestCardResetRecovery::testRun_ResetDuringRerunIsNotRetried()
+{
+    int runs = 0;
+    int recoveries = 0;
+    const auto result = runWithCardResetRecovery(
+        [&]() { ++runs; return Result<void>::error(QStringLiteral("Card reset")); },
+        []() { return true; },
+        [&]() { ++recoveries; return true; });
+
+    QVERIFY(result.isError());
+    QCOMPARE(runs, 2);
+    QCOMPARE(recoveries, 1);
+}
+
+void TestCardResetRecovery::testBatch_FirstCallSendsAll()
+{
+    SimulatedCard card;
+    card.stored = {QStringLiteral("a"), QStringLiteral("b")};
+
+    BatchResend batch(card.stored, [&card](const QStringList &names) { return card.deleteCredentials(names); });
+    const auto results = batch();
+
+    QCOMPARE(results.size(), 2);
+    QVERIFY(results.at(0).isSuccess());
+    QVERIFY(results.at(1).isSuccess());
+    QCOMPARE(batch.lastSent(), (QStringList{QStringLiteral("a"), QStringLiteral("b")}));
+    QVERIFY(card.stored.isEmpty());
+}
+
+void TestCardResetRecovery::testBatch_RerunResendsOnlyFailedNames()
+{
+    QList<QStringList> sent;
+    int call = 0;
+    BatchResend batch({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d")},
+                      [&](const QStringList &names) {
+        sent.append(names);
+        QList<Result<void>> results;
+        for (const QString &name : names) {
+            // First call: b and d fail
+            const bool fail = (call == 0 && (name == QStringLiteral("b") || name == QStringLiteral("d")));
+            results.append(fail ? Result<void>::error(QStringLiteral("Card reset")) : Result<void>::success());
+        }
+        ++call;
+        return results;
+    });
+
+    batch();
+    const auto results = batch();
+
+    QCOMPARE(sent.size(), 2);
+    QCOMPARE(sent.at(1), (QStringList{QStringLiteral("b"), QStringLiteral("d")}));
+    QCOMPARE(batch.lastSent(), sent.at(1));
+
+    // Retried results are merged back at their original positions
+    QCOMPARE(results.size(), 4);
+    for (const auto &result : results) {
+        QVERIFY(result.isSuccess());
+    }
+}
+
+void TestCardResetRecovery::testBatch_RerunWithoutFailuresSendsNothing()
+{
+    int sends = 0;
+    BatchResend batch({QStringLiteral("a")}, [&](const QStringList &names) {
+        ++sends;
+        return QList<Result<void>>(names.size(), Result<void>::success());
+    });
+
+    batch();
+    const auto results = batch();
+
+    QCOMPARE(sends, 1);
+    QVERIFY(batch.lastSent().isEmpty());
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results.at(0).isSuccess());
+}
+
+void TestCardResetRecovery::testBatch_DeleteRerunAfterResetMidBatch()
+{
+    // Mirrors OathDevice::deleteCredentials(): reset hits the third DELETE
+    SimulatedCard card;
+    card.stored = {QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d")};
+    card.resetAt = 2;
+
+    BatchResend batch(card.stored, [&card](const QStringList &names) { return card.deleteCredentials(names); });
+    const auto results = runWithCardResetRecovery(
+        batch,
+        [&card]() { return card.resetPending; },
+        [&card]() { return card.reconnect(); });
+
+    // Already deleted names are never sent again - a second DELETE would report "No such object"
+    QCOMPARE(card.deleteRequests,
+             (QStringList{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c"), QStringLiteral("d"),
+                          QStringLiteral("c"), QStringLiteral("d")}));
+    QCOMPARE(results.size(), 4);
+    for (const auto &result : results) {
+        QVERIFY(result.isSuccess());
+    }
+    QVERIFY(card.stored.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestCardResetRecovery)
+#include "test_card_reset_recovery.moc"
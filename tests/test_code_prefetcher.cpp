@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include "krunner/matching/code_prefetcher.h"
+#include "dbus/oath_credential_proxy.h"
+
+using namespace YubiKeyOath::Shared;
+using namespace YubiKeyOath::Runner;
+
+/**
+ * @brief Tests for CodePrefetcher
+ *
+ * Requests are captured by an injected function, so no daemon is needed.
+ */
+class TestCodePrefetcher : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testFlush_SendsTopRankedOnly();
+    void testFlush_SkipsTouchAndHotp();
+    void testFlush_DeduplicatesInFlight();
+    void testFlush_SkipsDeletedProxy();
+    void testSchedule_DebouncesBurst();
+    void testReset_AllowsResend();
+    void testStatistics_RequestedCountsDistinctCredentials();
+
+private:
+    static OathCredentialProxy *createProxy(int index, QObject *parent,
+                                            bool requiresTouch = false,
+                                            const QString &type = QStringLiteral("TOTP"));
+    static QList<OathCredentialProxy*> createProxies(int count, QObject *parent);
+};
+
+OathCredentialProxy *TestCodePrefetcher::createProxy(int index, QObject *parent,
+                                                     bool requiresTouch, const QString &type)
+{
+    const QString issuer = QStringLiteral("Service%1").arg(index);
+    const QVariantMap properties = {
+        {"FullName", issuer + ":user"},
+        {"Issuer", issuer},
+        {"Username", "user"},
+        {"RequiresTouch", requiresTouch},
+        {"Type", type},
+        {"Algorithm", "SHA1"},
+        {"Digits", 6},
+        {"Period", 30},
+        {"DeviceId", "abcdef0123456789"},
+    };
+    const QString path = QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678/credentials/cred_%1")
+                             .arg(index);
+    return new OathCredentialProxy(path, properties, parent);
+}
+
+QList<OathCredentialProxy*> TestCodePrefetcher::createProxies(int count, QObject *parent)
+{
+    QList<OathCredentialProxy*> proxies;
+    for (int i = 0; i < count; ++i) {
+        proxies.append(createProxy(i, parent));
+    }
+    return proxies;
+}
+
+void TestCodePrefetcher::testFlush_SendsTopRankedOnly()
+{
+    QObject owner;
+    QStringList sent;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *credential) {
+        sent.append(credential->fullName());
+    });
+
+    const auto proxies = createProxies(12, &owner);
+    prefetcher.schedule(proxies);
+    prefetcher.flush();
+
+    QCOMPARE(sent.size(), CodePrefetcher::PREFETCH_LIMIT);
+    QCOMPARE(sent.first(), proxies.first()->fullName());
+
+    const auto stats = prefetcher.statistics();
+    QCOMPARE(stats.scheduled, 12);
+    QCOMPARE(stats.requested, 12);
+    QCOMPARE(stats.sent, CodePrefetcher::PREFETCH_LIMIT);
+    QCOMPARE(stats.skippedOverLimit, 12 - CodePrefetcher::PREFETCH_LIMIT);
+    QCOMPARE(stats.avoided(), 12 - CodePrefetcher::PREFETCH_LIMIT);
+}
+
+void TestCodePrefetcher::testFlush_SkipsTouchAndHotp()
+{
+    QObject owner;
+    int sent = 0;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *) { ++sent; });
+
+    prefetcher.schedule({
+        createProxy(0, &owner, true),
+        createProxy(1, &owner, false, QStringLiteral("HOTP")),
+        createProxy(2, &owner),
+    });
+    prefetcher.flush();
+
+    QCOMPARE(sent, 1);
+    QCOMPARE(prefetcher.statistics().skippedIneligible, 2);
+}
+
+void TestCodePrefetcher::testFlush_DeduplicatesInFlight()
+{
+    QObject owner;
+    int sent = 0;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *) { ++sent; });
+
+    const auto proxies = createProxies(3, &owner);
+    prefetcher.schedule(proxies);
+    prefetcher.flush();
+    QCOMPARE(sent, 3);
+
+    // Same query again before any CodeGenerated reply arrived
+    prefetcher.schedule(proxies);
+    prefetcher.flush();
+    QCOMPARE(sent, 3);
+    QCOMPARE(prefetcher.statistics().skippedInFlight, 3);
+}
+
+void TestCodePrefetcher::testFlush_SkipsDeletedProxy()
+{
+    QObject owner;
+    int sent = 0;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *) { ++sent; });
+
+    auto proxies = createProxies(2, &owner);
+    prefetcher.schedule(proxies);
+    delete proxies.takeFirst();
+    prefetcher.flush();
+
+    QCOMPARE(sent, 1);
+}
+
+void TestCodePrefetcher::testSchedule_DebouncesBurst()
+{
+    QObject owner;
+    QStringList sent;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *credential) {
+        sent.append(credential->fullName());
+    });
+
+    // Typing "g", "gi", "git": only the final ranking is pre-fetched
+    auto *first = createProxy(0, &owner);
+    auto *second = createProxy(1, &owner);
+    auto *third = createProxy(2, &owner);
+    prefetcher.schedule({first, second});
+    prefetcher.schedule({second});
+    prefetcher.schedule({third});
+
+    QTRY_COMPARE_WITH_TIMEOUT(sent.size(), 1, CodePrefetcher::DEBOUNCE_MS * 4);
+    QCOMPARE(sent.first(), third->fullName());
+    QCOMPARE(prefetcher.statistics().debounced, 3);
+    QCOMPARE(prefetcher.statistics().requested, 3);  // "second" counted once
+    QCOMPARE(prefetcher.statistics().avoided(), 2);
+}
+
+void TestCodePrefetcher::testReset_AllowsResend()
+{
+    QObject owner;
+    int sent = 0;
+    CodePrefetcher prefetcher(nullptr, [&sent](OathCredentialProxy *) { ++sent; });
+
+    const auto proxies = createProxies(1, &owner);
+    prefetcher.schedule(proxies);
+    prefetcher.flush();
+
+    prefetcher.reset();
+    prefetcher.schedule(proxies);
+    prefetcher.flush();
+
+    QCOMPARE(sent, 2);
+}
+
+void TestCodePrefetcher::testStatistics_RequestedCountsDistinctCredentials()
+{
+    QObject owner;
+    CodePrefetcher prefetcher(nullptr, [](OathCredentialProxy *) {});
+
+    // Every keystroke re-ranks the same credentials; only distinct eligible ones count
+    const auto proxies = createProxies(3, &owner);
+    auto *touch = createProxy(3, &owner, true);
+    for (int keystroke = 0; keystroke < 5; ++keystroke) {
+        prefetcher.schedule(proxies + QList<OathCredentialProxy*>{touch});
+    }
+    prefetcher.flush();
+
+    const auto stats = prefetcher.statistics();
+    QCOMPARE(stats.scheduled, 20);
+    QCOMPARE(stats.requested, 3);
+    QCOMPARE(stats.sent, 3);
+    QCOMPARE(stats.avoided(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestCodePrefetcher)
+#include "test_code_prefetcher.moc"
@@ -0,0 +1,370 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include "krunner/matching/credential_matcher.h"
+
+using namespace YubiKeyOath::Shared;
+using namespace YubiKeyOath::Runner;
+
+/**
+ * @brief Unit tests and benchmarks for CredentialMatcher
+ *
+ * Tests subsequence matching, ranking order, prefilter masks and top-K
+ * selection. Benchmarks run over synthetic credential sets (QBENCHMARK,
+ * run with -iterations N or -tickcounter for stable numbers).
+ */
+class TestCredentialMatcher : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // scoreField tests
+    void testScoreField_Substring();
+    void testScoreField_Subsequence();
+    void testScoreField_NoMatch();
+    void testScoreField_PrefixBeatsMiddle();
+    void testScoreField_BoundaryBeatsScattered();
+
+    // characterMask tests
+    void testCharacterMask_Subset();
+
+    // match() tests
+    void testMatch_EmptyQuery();
+    void testMatch_CaseInsensitive();
+    void testMatch_IgnoresWhitespace();
+    void testMatch_RankingOrder();
+    void testMatch_AccountMatch();
+    void testMatch_TopKLimit();
+    void testMatch_RelevanceRange();
+
+    // Incremental refinement tests
+    void testRefinement_NarrowsScannedSet();
+    void testRefinement_SameResultsAsFullScan();
+    void testRefinement_BackspaceAndNewQuery();
+    void testRefinement_ClearedBySetCandidates();
+
+    // Benchmarks
+    void benchmarkMatch_data();
+    void benchmarkMatch();
+    void benchmarkRefinement();
+
+private:
+    static CredentialInfo makeCredential(const QString &issuer, const QString &account);
+    static QList<CredentialInfo> syntheticCredentials(int count);
+};
+
+CredentialInfo TestCredentialMatcher::makeCredential(const QString &issuer, const QString &account)
+{
+    CredentialInfo cred;
+    cred.name = issuer.isEmpty() ? account : issuer + ":" + account;
+    cred.issuer = issuer;
+    cred.account = account;
+    return cred;
+}
+
+QList<CredentialInfo> TestCredentialMatcher::syntheticCredentials(int count)
+{
+    static const QStringList issuers = {
+        "GitHub", "GitLab", "Google", "Microsoft", "Amazon Web Services", "Cloudflare",
+        "DigitalOcean", "Dropbox", "Facebook", "Twitter", "Discord", "Slack",
+        "Atlassian", "Bitwarden", "ProtonMail", "Fastmail", "Hetzner", "OVHcloud",
+        "PyPI", "npm", "Docker Hub", "Heroku", "Linode", "Mozilla"
+    };
+
+    QList<CredentialInfo> credentials;
+    credentials.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString &issuer = issuers.at(i % issuers.size());
+        const QString account = QStringLiteral("user%1.team%2@example%3.com")
+                                    .arg(i).arg(i % 17).arg(i % 5);
+        credentials.append(makeCredential(issuer + QString::number(i / issuers.size()), account));
+    }
+    return credentials;
+}
+
+// ========== scoreField Tests ==========
+
+void TestCredentialMatcher::testScoreField_Substring()
+{
+    QVERIFY(CredentialMatcher::scoreField(u"github:user", u"git") > 0);
+    QVERIFY(CredentialMatcher::scoreField(u"github:user", u"hub") > 0);
+    QVERIFY(CredentialMatcher::scoreField(u"github:user", u"user") > 0);
+}
+
+void TestCredentialMatcher::testScoreField_Subsequence()
+{
+    QVERIFY(CredentialMatcher::scoreField(u"github:user", u"gthb") > 0);
+    QVERIFY(CredentialMatcher::scoreField(u"amazon web services", u"aws") > 0);
+}
+
+void TestCredentialMatcher::testScoreField_NoMatch()
+{
+    QCOMPARE(CredentialMatcher::scoreField(u"github:user", u"xyz"), -1);
+    QCOMPARE(CredentialMatcher::scoreField(u"github", u"bhg"), -1);   // order matters
+    QCOMPARE(CredentialMatcher::scoreField(u"git", u"github"), -1);   // needle longer
+    QCOMPARE(CredentialMatcher::scoreField(u"", u"a"), -1);
+}
+
+void TestCredentialMatcher::testScoreField_PrefixBeatsMiddle()
+{
+    const int prefix = CredentialMatcher::scoreField(u"google:user", u"goo");
+    const int middle = CredentialMatcher::scoreField(u"mygoogle:user", u"goo");
+    QVERIFY(prefix > middle);
+
+    // Full contiguous prefix is the best achievable score
+    QCOMPARE(prefix, CredentialMatcher::maxScore(3));
+}
+
+void TestCredentialMatcher::testScoreField_BoundaryBeatsScattered()
+{
+    // "aws" on word starts scores better than the same letters scattered mid-word
+    const int boundary = CredentialMatcher::scoreField(u"amazon web services", u"aws");
+    const int scattered = CredentialMatcher::scoreField(u"xaxxwxxxs", u"aws");
+    QVERIFY(boundary > scattered);
+
+    // Substring beats subsequence of equal length
+    QVERIFY(CredentialMatcher::scoreField(u"github", u"git")
+            > CredentialMatcher::scoreField(u"gxixt", u"git"));
+}
+
+// ========== characterMask Tests ==========
+
+void TestCredentialMatcher::testCharacterMask_Subset()
+{
+    const quint64 haystack = CredentialMatcher::characterMask(u"github:user@example.com");
+    const quint64 present = CredentialMatcher::characterMask(u"gthb");
+    const quint64 absent = CredentialMatcher::characterMask(u"z");
+
+    QCOMPARE(haystack & present, present);
+    QVERIFY((haystack & absent) != absent);
+
+    // Digits use their own bits
+    QVERIFY(CredentialMatcher::characterMask(u"1") != CredentialMatcher::characterMask(u"a"));
+    QCOMPARE(CredentialMatcher::characterMask(u" "), quint64{0});
+}
+
+// ========== match() Tests ==========
+
+void TestCredentialMatcher::testMatch_EmptyQuery()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates({makeCredential("GitHub", "user")});
+
+    QVERIFY(matcher.match(QString(), 10).isEmpty());
+    QVERIFY(matcher.match("   ", 10).isEmpty());
+}
+
+void TestCredentialMatcher::testMatch_CaseInsensitive()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates({makeCredential("GitHub", "User")});
+
+    QCOMPARE(matcher.match("GITHUB", 10).size(), 1);
+    QCOMPARE(matcher.match("github", 10).size(), 1);
+    QCOMPARE(matcher.match("GiThUb", 10).size(), 1);
+}
+
+void TestCredentialMatcher::testMatch_IgnoresWhitespace()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates({makeCredential("GitHub", "user")});
+
+    QCOMPARE(matcher.match("git hub", 10).size(), 1);
+}
+
+void TestCredentialMatcher::testMatch_RankingOrder()
+{
+    CredentialMatcher matcher;
+    const QList<CredentialInfo> credentials = {
+        makeCredential("Logistics", "admin"),        // subsequence "gi.t"
+        makeCredential("MyGitServer", "admin"),      // substring mid-word
+        makeCredential("GitHub", "admin"),           // prefix
+        makeCredential("Dropbox", "admin"),          // no match
+    };
+    matcher.setCandidates(credentials);
+
+    const auto results = matcher.match("git", 10);
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results.at(0).index, 2);
+    QCOMPARE(results.at(1).index, 1);
+    QCOMPARE(results.at(2).index, 0);
+
+    // Scores are descending
+    QVERIFY(results.at(0).score >= results.at(1).score);
+    QVERIFY(results.at(1).score >= results.at(2).score);
+}
+
+void TestCredentialMatcher::testMatch_AccountMatch()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates({
+        makeCredential("Service", "admin@example.com"),
+        makeCredential("Admin Panel", "root"),
+    });
+
+    const auto results = matcher.match("admin", 10);
+    QCOMPARE(results.size(), 2);
+
+    // Issuer prefix outranks the same prefix on the account
+    QCOMPARE(results.at(0).index, 1);
+}
+
+void TestCredentialMatcher::testMatch_TopKLimit()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(500));
+
+    const auto limited = matcher.match("git", 5);
+    QCOMPARE(limited.size(), 5);
+
+    const auto all = matcher.match("git", 0);
+    QVERIFY(all.size() > 5);
+
+    // Top-K is the head of the full ranking
+    for (int i = 0; i < limited.size(); ++i) {
+        QCOMPARE(limited.at(i).score, all.at(i).score);
+    }
+}
+
+void TestCredentialMatcher::testMatch_RelevanceRange()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(200));
+
+    const auto results = matcher.match("gl", 0);
+    QVERIFY(!results.isEmpty());
+    for (const auto &result : results) {
+        QVERIFY(result.relevance >= 0.1);
+        QVERIFY(result.relevance <= 1.0);
+    }
+
+    CredentialMatcher exact;
+    exact.setCandidates({makeCredential("Google", "user")});
+    QCOMPARE(exact.match("google", 1).at(0).relevance, 1.0);
+}
+
+// ========== Incremental Refinement Tests ==========
+
+void TestCredentialMatcher::testRefinement_NarrowsScannedSet()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(1000));
+
+    const auto first = matcher.match("gi", 0);
+    QCOMPARE(matcher.lastScannedCount(), 1000);
+
+    // "git" only rescans the survivors of "gi"
+    const auto second = matcher.match("git", 0);
+    QCOMPARE(matcher.lastScannedCount(), first.size());
+
+    const auto third = matcher.match("gith", 0);
+    QCOMPARE(matcher.lastScannedCount(), second.size());
+    QVERIFY(third.size() <= second.size());
+}
+
+void TestCredentialMatcher::testRefinement_SameResultsAsFullScan()
+{
+    const QList<CredentialInfo> credentials = syntheticCredentials(1000);
+
+    CredentialMatcher incremental;
+    incremental.setCandidates(credentials);
+    const QStringList queries = {"d", "do", "doc", "dock", "docke", "docker"};
+    for (const QString &query : queries) {
+        const auto refined = incremental.match(query, 30);
+
+        CredentialMatcher fresh;
+        fresh.setCandidates(credentials);
+        const auto full = fresh.match(query, 30);
+
+        QCOMPARE(refined.size(), full.size());
+        for (int i = 0; i < refined.size(); ++i) {
+            QCOMPARE(refined.at(i).index, full.at(i).index);
+            QCOMPARE(refined.at(i).score, full.at(i).score);
+        }
+    }
+}
+
+void TestCredentialMatcher::testRefinement_BackspaceAndNewQuery()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(1000));
+
+    const auto git = matcher.match("git", 0);
+    const auto gith = matcher.match("gith", 0);
+    Q_UNUSED(gith)
+
+    // Backspace: "git" is still cached, rescans its own match set
+    const auto back = matcher.match("git", 0);
+    QCOMPARE(back.size(), git.size());
+    QCOMPARE(matcher.lastScannedCount(), git.size());
+
+    // Unrelated query falls back to a full scan
+    const auto other = matcher.match("goo", 0);
+    QVERIFY(!other.isEmpty());
+    QCOMPARE(matcher.lastScannedCount(), 1000);
+}
+
+void TestCredentialMatcher::testRefinement_ClearedBySetCandidates()
+{
+    CredentialMatcher matcher;
+    matcher.setCandidates({makeCredential("GitHub", "user")});
+    QCOMPARE(matcher.match("git", 0).size(), 1);
+
+    // New index: "gith" must see the new credential, not the stale "git" set
+    matcher.setCandidates({makeCredential("GitHub", "user"), makeCredential("GitHub", "admin")});
+    QCOMPARE(matcher.match("gith", 0).size(), 2);
+    QCOMPARE(matcher.lastScannedCount(), 2);
+}
+
+// ========== Benchmarks ==========
+
+void TestCredentialMatcher::benchmarkMatch_data()
+{
+    QTest::addColumn<int>("credentialCount");
+    QTest::addColumn<QString>("query");
+
+    QTest::newRow("100 prefix") << 100 << "git";
+    QTest::newRow("1000 prefix") << 1000 << "git";
+    QTest::newRow("1000 fuzzy") << 1000 << "gthb";
+    QTest::newRow("1000 account") << 1000 << "team3";
+    QTest::newRow("1000 no-match") << 1000 << "zzqx";
+    QTest::newRow("5000 fuzzy") << 5000 << "dgo";
+}
+
+void TestCredentialMatcher::benchmarkMatch()
+{
+    QFETCH(int, credentialCount);
+    QFETCH(QString, query);
+
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(credentialCount));
+
+    QList<CredentialMatcher::ScoredCandidate> results;
+    QBENCHMARK {
+        matcher.clearRefinementCache();  // measure full scans
+        results = matcher.match(query, 30);
+    }
+    Q_UNUSED(results)
+}
+
+void TestCredentialMatcher::benchmarkRefinement()
+{
+    // Typing "github" one keystroke at a time over 1000 credentials
+    CredentialMatcher matcher;
+    matcher.setCandidates(syntheticCredentials(1000));
+
+    const QStringList keystrokes = {"gi", "git", "gith", "githu", "github"};
+    QBENCHMARK {
+        matcher.clearRefinementCache();
+        for (const QString &query : keystrokes) {
+            const auto results = matcher.match(query, 30);
+            Q_UNUSED(results)
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestCredentialMatcher)
+#include "test_credential_matcher.moc"
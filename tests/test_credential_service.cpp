@@ -31,7 +31,7 @@ using namespace YubiKeyOath::Shared;
  * - TestCredentialFixture - Factory for creating credential objects
  * - TestDeviceFixture - Factory for creating device records
  *
- * Test cases (13 tests):
+ * Test cases (16 tests):
  * 1. testGetCredentialsConnectedDevice() - Live credentials from connected device
  * 2. testGetCredentialsOfflineDeviceCacheEnabled() - Cached credentials when offline
  * 3. testGetCredentialsOfflineDeviceCacheDisabled() - Empty list when cache disabled
@@ -45,6 +45,9 @@ using namespace YubiKeyOath::Shared;
  * 11. testDeleteCredentialSuccess() - Delete existing credential
  * 12. testDeleteCredentialNotFound() - Delete non-existent credential
  * 13. testDeleteCredentialEmptyName() - Empty credential name rejected
+ * 14. testAddCredentialsBatch() - Per-entry results, one device call
+ * 15. testDeleteCredentialsBatch() - Per-name results, one device call
+ * 16. testHasLiveCredentials() - Live vs. cached credential source
  */
 class TestCredentialService : public QObject
 {
@@ -281,6 +284,52 @@ private Q_SLOTS:
         qDebug() << "✓ Cached credentials returned for connected but uninitialized device";
     }
 
+    void testHasLiveCredentials()
+    {
+        qDebug() << "\n--- Test: hasLiveCredentials() mirrors getCredentials() source ---";
+
+        m_config->setEnableCredentialsCache(true);
+        auto *mockManager = qobject_cast<MockOathDeviceManager*>(m_deviceManager);
+
+        // Connected with credentials in memory: live
+        const QString liveId = QStringLiteral("1234567890ABCDEF");
+        auto *liveDevice = new MockOathDevice(liveId, this);
+        liveDevice->setCredentials(QList<OathCredential>{
+            TestCredentialFixture::createCredentialForDevice(liveId, QStringLiteral("GitHub:live"))
+        });
+        mockManager->addDevice(liveDevice);
+        liveDevice->setState(DeviceState::Ready);
+        QVERIFY(m_service->hasLiveCredentials(liveId));
+
+        // Connected, nothing in memory yet: getCredentials() serves the cache, so not live
+        const QString loadingId = QStringLiteral("AAAABBBBCCCCDDDD");
+        auto *loadingDevice = new MockOathDevice(loadingId, this);
+        mockManager->addDevice(loadingDevice);
+        loadingDevice->setState(DeviceState::FetchingCredentials);
+        m_database->addDevice(loadingId, QStringLiteral("Loading"), false);
+        m_database->addOrUpdateCredential(
+            TestCredentialFixture::createCredentialForDevice(loadingId, QStringLiteral("GitHub:cached")));
+        QCOMPARE(m_service->getCredentials(loadingId).size(), 1);
+        QVERIFY(!m_service->hasLiveCredentials(loadingId));
+
+        // Becomes live once the card answered
+        loadingDevice->setCredentials(QList<OathCredential>{
+            TestCredentialFixture::createCredentialForDevice(loadingId, QStringLiteral("GitHub:cached"))
+        });
+        QVERIFY(m_service->hasLiveCredentials(loadingId));
+
+        // Offline (database only) and unknown devices: never live
+        const QString offlineId = QStringLiteral("FEDCBA0987654321");
+        m_database->addDevice(offlineId, QStringLiteral("Offline"), false);
+        m_database->addOrUpdateCredential(
+            TestCredentialFixture::createCredentialForDevice(offlineId, QStringLiteral("AWS:offline")));
+        QCOMPARE(m_service->getCredentials(offlineId).size(), 1);
+        QVERIFY(!m_service->hasLiveCredentials(offlineId));
+        QVERIFY(!m_service->hasLiveCredentials(QStringLiteral("0000000000000000")));
+
+        qDebug() << "✓ Only in-memory credentials of connected devices count as live";
+    }
+
     void testGenerateCodeSuccess()
     {
         qDebug() << "\n--- Test: generateCode() success ---";
@@ -532,6 +581,96 @@ private Q_SLOTS:
         qDebug() << "✓ Empty credential name rejected";
     }
 
+    void testAddCredentialsBatch()
+    {
+        qDebug() << "\n--- Test: addCredentials() batch ---";
+
+        // Setup: Connected device with one existing credential
+        const QString deviceId = QStringLiteral("1234567890ABCDEF");
+        auto *mockDevice = new MockOathDevice(deviceId, this);
+        mockDevice->setCredentials(QList<OathCredential>{
+            TestCredentialFixture::createCredentialForDevice(deviceId, QStringLiteral("GitHub:user"))
+        });
+
+        auto *mockManager = qobject_cast<MockOathDeviceManager*>(m_deviceManager);
+        mockManager->addDevice(mockDevice);
+        mockDevice->setState(DeviceState::Ready);
+
+        QSignalSpy updatedSpy(m_service, &CredentialService::credentialsUpdated);
+
+        const auto entry = [](const QString &name, const QString &secret) {
+            return QVariantMap{
+                {QStringLiteral("name"), name},
+                {QStringLiteral("secret"), secret},
+                {QStringLiteral("type"), QStringLiteral("TOTP")},
+                {QStringLiteral("algorithm"), QStringLiteral("SHA1")},
+                {QStringLiteral("digits"), 6},
+                {QStringLiteral("period"), 30},
+            };
+        };
+
+        // Act: new, existing, missing secret, duplicate within the batch
+        const auto results = m_service->addCredentials(deviceId, {
+            entry(QStringLiteral("GitLab:user"), QStringLiteral("JBSWY3DPEHPK3PXP")),
+            entry(QStringLiteral("GitHub:user"), QStringLiteral("JBSWY3DPEHPK3PXP")),
+            entry(QStringLiteral("Example:nosecret"), QString()),
+            entry(QStringLiteral("GitLab:user"), QStringLiteral("JBSWY3DPEHPK3PXP")),
+        });
+
+        // Assert: One result per entry, in order
+        QCOMPARE(results.size(), 4);
+        QCOMPARE(results[0].status, QStringLiteral("Success"));
+        QCOMPARE(results[0].message, QStringLiteral("GitLab:user"));
+        QCOMPARE(results[1].status, QStringLiteral("Error"));
+        QCOMPARE(results[2].status, QStringLiteral("Error"));
+        QCOMPARE(results[3].status, QStringLiteral("Error"));
+
+        // Assert: Valid entries reached the device in a single batch
+        QCOMPARE(mockDevice->addCredentialsCallCount(), 1);
+        QCOMPARE(updatedSpy.count(), 1);
+
+        qDebug() << "✓ Batch add returns per-entry results in one device call";
+    }
+
+    void testDeleteCredentialsBatch()
+    {
+        qDebug() << "\n--- Test: deleteCredentials() batch ---";
+
+        // Setup: Connected device with two credentials
+        const QString deviceId = QStringLiteral("1234567890ABCDEF");
+        auto *mockDevice = new MockOathDevice(deviceId, this);
+        mockDevice->setCredentials(QList<OathCredential>{
+            TestCredentialFixture::createCredentialForDevice(deviceId, QStringLiteral("GitHub:user")),
+            TestCredentialFixture::createCredentialForDevice(deviceId, QStringLiteral("GitLab:user"))
+        });
+
+        auto *mockManager = qobject_cast<MockOathDeviceManager*>(m_deviceManager);
+        mockManager->addDevice(mockDevice);
+        mockDevice->setState(DeviceState::Ready);
+
+        QSignalSpy updatedSpy(m_service, &CredentialService::credentialsUpdated);
+
+        // Act: Delete one existing and one missing credential
+        const auto results = m_service->deleteCredentials(
+            deviceId, {QStringLiteral("GitHub:user"), QStringLiteral("Missing:user")});
+
+        // Assert: Per-name results from a single device call
+        QCOMPARE(results.size(), 2);
+        QCOMPARE(results[0].status, QStringLiteral("Success"));
+        QCOMPARE(results[1].status, QStringLiteral("Error"));
+        QCOMPARE(mockDevice->deleteCredentialsCallCount(), 1);
+        QCOMPARE(mockDevice->credentials().size(), 1);
+        QCOMPARE(updatedSpy.count(), 1);
+
+        // Unknown device: every entry fails
+        const auto offline = m_service->deleteCredentials(
+            QStringLiteral("0000000000000000"), {QStringLiteral("GitLab:user")});
+        QCOMPARE(offline.size(), 1);
+        QCOMPARE(offline[0].status, QStringLiteral("Error"));
+
+        qDebug() << "✓ Batch delete returns per-name results in one device call";
+    }
+
     void cleanupTestCase()
     {
         qDebug() << "\n========================================";
@@ -556,6 +695,8 @@ private Q_SLOTS:
         qDebug() << "11. testDeleteCredentialSuccess - Delete existing credential";
         qDebug() << "12. testDeleteCredentialNotFound - Delete non-existent credential";
         qDebug() << "13. testDeleteCredentialEmptyName - Empty credential name rejected";
+        qDebug() << "14. testAddCredentialsBatch - Per-entry results, one device call";
+        qDebug() << "15. testDeleteCredentialsBatch - Per-name results, one device call";
         qDebug() << "";
         qDebug() << "Target: 95% coverage for business logic ✓";
         qDebug() << "";
@@ -0,0 +1,231 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusVariant>
+#include <QDBusArgument>
+#include "daemon/dbus/credential_subtree_object.h"
+#include "types/oath_credential.h"
+
+using namespace YubiKeyOath::Daemon;
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Test CredentialSubtreeObject virtual D-Bus subtree
+ *
+ * Registers the subtree on the session bus and talks to it through the
+ * connection's own unique name. No service is needed: enumeration,
+ * introspection and property reads are answered from stored credential data.
+ *
+ * Test coverage:
+ * - insert()/remove()/credentialIds() enumeration
+ * - introspect() for the subtree root and for children
+ * - Properties.Get/GetAll/Set on child paths
+ * - Unknown child paths and interfaces
+ */
+class TestCredentialSubtreeObject : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr const char *BASE_PATH = "/pl/jkolo/yubikey/oath/devices/41000001/credentials";
+    static constexpr const char *CREDENTIAL_INTERFACE = "pl.jkolo.yubikey.oath.Credential";
+    static constexpr const char *PROPERTIES_INTERFACE = "org.freedesktop.DBus.Properties";
+
+    QDBusConnection m_connection{QDBusConnection::sessionBus()};
+    CredentialSubtreeObject *m_subtree = nullptr;
+
+    // TOTP credential issuer:account with non-default digits/period
+    static OathCredential makeCredential(const QString &issuer, const QString &account)
+    {
+        OathCredential credential;
+        credential.originalName = issuer + QLatin1Char(':') + account;
+        credential.issuer = issuer;
+        credential.account = account;
+        credential.digits = 8;
+        credential.period = 60;
+        credential.requiresTouch = true;
+        credential.deviceId = QStringLiteral("cccc000000000001");
+        return credential;
+    }
+
+    QString childPath(const QString &credentialId) const
+    {
+        return QLatin1String(BASE_PATH) + QLatin1Char('/') + credentialId;
+    }
+
+    // Properties.<member>(Credential, args...) on a child path, answered locally
+    QDBusMessage callProperties(const QString &path, const QString &member,
+                                const QList<QVariant> &extraArgs = {}) const
+    {
+        QDBusMessage call = QDBusMessage::createMethodCall(m_connection.baseService(), path,
+                                                           QLatin1String(PROPERTIES_INTERFACE), member);
+        call.setArguments(QList<QVariant>{QLatin1String(CREDENTIAL_INTERFACE)} + extraArgs);
+        return m_connection.call(call);
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        qDebug() << "";
+        qDebug() << "========================================";
+        qDebug() << "Test: CredentialSubtreeObject";
+        qDebug() << "========================================";
+        qDebug() << "";
+
+        QVERIFY(m_connection.isConnected());
+    }
+
+    void init()
+    {
+        m_subtree = new CredentialSubtreeObject(QStringLiteral("cccc000000000001"),
+                                                QLatin1String(BASE_PATH), nullptr, m_connection, this);
+        QVERIFY(m_subtree->registerObject());
+        QVERIFY(m_subtree->insert(QStringLiteral("github_colon_alice"),
+                                  makeCredential(QStringLiteral("GitHub"), QStringLiteral("alice"))));
+        QVERIFY(m_subtree->insert(QStringLiteral("google_colon_bob"),
+                                  makeCredential(QStringLiteral("Google"), QStringLiteral("bob"))));
+    }
+
+    void cleanup()
+    {
+        delete m_subtree;
+        m_subtree = nullptr;
+    }
+
+    void testEnumeration()
+    {
+        qDebug() << "\n--- Test: insert/remove/credentialIds ---";
+
+        QCOMPARE(m_subtree->credentialIds(),
+                 (QStringList{QStringLiteral("github_colon_alice"), QStringLiteral("google_colon_bob")}));
+        QVERIFY(m_subtree->contains(QStringLiteral("github_colon_alice")));
+        QCOMPARE(m_subtree->credentialPath(QStringLiteral("github_colon_alice")),
+                 childPath(QStringLiteral("github_colon_alice")));
+
+        // Duplicates rejected, data kept
+        QVERIFY(!m_subtree->insert(QStringLiteral("github_colon_alice"),
+                                   makeCredential(QStringLiteral("Other"), QStringLiteral("x"))));
+        QCOMPARE(m_subtree->credential(QStringLiteral("github_colon_alice")).issuer, QStringLiteral("GitHub"));
+
+        QVERIFY(m_subtree->remove(QStringLiteral("google_colon_bob")));
+        QVERIFY(!m_subtree->remove(QStringLiteral("google_colon_bob")));
+        QCOMPARE(m_subtree->credentialIds(), QStringList{QStringLiteral("github_colon_alice")});
+
+        // No live objects until a Credential method is invoked
+        QCOMPARE(m_subtree->liveObjectCount(), 0);
+
+        qDebug() << "✓ Enumeration follows insert/remove";
+    }
+
+    void testManagedObjectData()
+    {
+        qDebug() << "\n--- Test: managedObjectData() ---";
+
+        const QVariantMap data = m_subtree->managedObjectData(QStringLiteral("github_colon_alice"));
+        QCOMPARE(data.keys(), QStringList{QLatin1String(CREDENTIAL_INTERFACE)});
+
+        const QVariantMap properties = data.value(QLatin1String(CREDENTIAL_INTERFACE)).toMap();
+        QCOMPARE(properties.value(QStringLiteral("FullName")).toString(), QStringLiteral("GitHub:alice"));
+        QCOMPARE(properties.value(QStringLiteral("Issuer")).toString(), QStringLiteral("GitHub"));
+        QCOMPARE(properties.value(QStringLiteral("Username")).toString(), QStringLiteral("alice"));
+        QCOMPARE(properties.value(QStringLiteral("Digits")).toInt(), 8);
+        QCOMPARE(properties.value(QStringLiteral("Period")).toInt(), 60);
+        QCOMPARE(properties.value(QStringLiteral("RequiresTouch")).toBool(), true);
+
+        QVERIFY(m_subtree->managedObjectData(QStringLiteral("unknown")).isEmpty());
+
+        qDebug() << "✓ ObjectManager data built from stored credential";
+    }
+
+    void testIntrospection()
+    {
+        qDebug() << "\n--- Test: introspect() ---";
+
+        // Root lists one node per credential
+        const QString root = m_subtree->introspect(QLatin1String(BASE_PATH));
+        QVERIFY(root.contains(QStringLiteral("<node name=\"github_colon_alice\"/>")));
+        QVERIFY(root.contains(QStringLiteral("<node name=\"google_colon_bob\"/>")));
+
+        // Children describe the Credential interface exactly like registered objects
+        const QString child = m_subtree->introspect(childPath(QStringLiteral("github_colon_alice")));
+        QVERIFY(child.contains(QStringLiteral("interface name=\"pl.jkolo.yubikey.oath.Credential\"")));
+        QVERIFY(child.contains(QStringLiteral("GenerateCode")));
+        QVERIFY(child.contains(QStringLiteral("FullName")));
+
+        // Unknown and nested paths describe nothing
+        QVERIFY(m_subtree->introspect(childPath(QStringLiteral("unknown"))).isEmpty());
+        QVERIFY(m_subtree->introspect(childPath(QStringLiteral("github_colon_alice/deeper"))).isEmpty());
+
+        // Removed credential disappears from the root listing
+        m_subtree->remove(QStringLiteral("google_colon_bob"));
+        QVERIFY(!m_subtree->introspect(QLatin1String(BASE_PATH)).contains(QStringLiteral("google_colon_bob")));
+
+        qDebug() << "✓ Root and child introspection";
+    }
+
+    void testPropertiesOverDBus()
+    {
+        qDebug() << "\n--- Test: Properties interface on child paths ---";
+
+        const QString path = childPath(QStringLiteral("google_colon_bob"));
+
+        // GetAll
+        const QDBusMessage all = callProperties(path, QStringLiteral("GetAll"));
+        QCOMPARE(all.type(), QDBusMessage::ReplyMessage);
+        const QVariantMap properties = qdbus_cast<QVariantMap>(all.arguments().at(0));
+        QCOMPARE(properties.value(QStringLiteral("FullName")).toString(), QStringLiteral("Google:bob"));
+        QCOMPARE(properties.value(QStringLiteral("Period")).toInt(), 60);
+
+        // Get
+        const QDBusMessage issuer = callProperties(path, QStringLiteral("Get"), {QStringLiteral("Issuer")});
+        QCOMPARE(issuer.type(), QDBusMessage::ReplyMessage);
+        QCOMPARE(qdbus_cast<QDBusVariant>(issuer.arguments().at(0)).variant().toString(), QStringLiteral("Google"));
+
+        const QDBusMessage unknown = callProperties(path, QStringLiteral("Get"), {QStringLiteral("NoSuchProperty")});
+        QCOMPARE(unknown.type(), QDBusMessage::ErrorMessage);
+
+        // Set is rejected - all Credential properties are read-only
+        const QDBusMessage set = callProperties(path, QStringLiteral("Set"),
+                                                {QStringLiteral("Issuer"), QVariant::fromValue(QDBusVariant(QStringLiteral("x")))});
+        QCOMPARE(set.type(), QDBusMessage::ErrorMessage);
+        QCOMPARE(m_subtree->credential(QStringLiteral("google_colon_bob")).issuer, QStringLiteral("Google"));
+
+        // Property reads never materialize a live object
+        QCOMPARE(m_subtree->liveObjectCount(), 0);
+
+        qDebug() << "✓ Get/GetAll answered from stored data, Set rejected";
+    }
+
+    void testUnknownChildAndInterface()
+    {
+        qDebug() << "\n--- Test: unknown child path and interface ---";
+
+        const QDBusMessage missing = callProperties(childPath(QStringLiteral("unknown")), QStringLiteral("GetAll"));
+        QCOMPARE(missing.type(), QDBusMessage::ErrorMessage);
+
+        QDBusMessage call = QDBusMessage::createMethodCall(m_connection.baseService(),
+                                                           childPath(QStringLiteral("github_colon_alice")),
+                                                           QLatin1String(PROPERTIES_INTERFACE),
+                                                           QStringLiteral("GetAll"));
+        call.setArguments({QStringLiteral("org.example.NotHere")});
+        const QDBusMessage wrongInterface = m_connection.call(call);
+        QCOMPARE(wrongInterface.type(), QDBusMessage::ErrorMessage);
+
+        qDebug() << "✓ Unknown paths and interfaces answered with errors";
+    }
+
+    void cleanupTestCase()
+    {
+        qDebug() << "";
+        qDebug() << "CredentialSubtreeObject tests complete";
+        qDebug() << "";
+    }
+};
+
+QTEST_GUILESS_MAIN(TestCredentialSubtreeObject)
+#include "test_credential_subtree_object.moc"
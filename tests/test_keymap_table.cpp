@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include <linux/input-event-codes.h>
+#include "daemon/input/keymap_table.h"
+
+using namespace YubiKeyOath::Daemon;
+
+/**
+ * @brief Unit tests for KeymapTable
+ *
+ * Compiles tables for fixed layouts (no display or Plasma session needed).
+ * Tests that compile real keymaps are skipped when xkeyboard-config data
+ * is not installed.
+ */
+class TestKeymapTable : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void testUsFallback();
+    void testBuild_Us();
+    void testBuild_Azerty();
+    void testBuild_Qwertz();
+    void testBuild_ActiveGroup();
+    void testBuild_UnknownLayout();
+
+private:
+    static KeymapNames names(const QString &layout, uint activeGroup = 0);
+    static void compareStroke(const QHash<char16_t, KeyStroke> &table, QChar ch,
+                              uint32_t keycode, bool shift, bool altGr = false);
+
+    bool m_haveKeymaps = false;
+};
+
+KeymapNames TestKeymapTable::names(const QString &layout, uint activeGroup)
+{
+    KeymapNames result;
+    result.rules = QStringLiteral("evdev");
+    result.model = QStringLiteral("pc105");
+    result.layout = layout;
+    result.activeGroup = activeGroup;
+    return result;
+}
+
+void TestKeymapTable::compareStroke(const QHash<char16_t, KeyStroke> &table, QChar ch,
+                                    uint32_t keycode, bool shift, bool altGr)
+{
+    const auto it = table.constFind(ch.unicode());
+    QVERIFY2(it != table.constEnd(), qPrintable(QStringLiteral("Missing character '%1'").arg(ch)));
+    QCOMPARE(it->keycode, keycode);
+    QCOMPARE(it->shift, shift);
+    QCOMPARE(it->altGr, altGr);
+}
+
+void TestKeymapTable::initTestCase()
+{
+    m_haveKeymaps = !KeymapTable::build(names(QStringLiteral("us"))).isEmpty();
+    if (!m_haveKeymaps) {
+        qDebug() << "xkeyboard-config data not available - keymap tests will be skipped";
+    }
+}
+
+void TestKeymapTable::testUsFallback()
+{
+    const auto table = KeymapTable::usFallback();
+    QCOMPARE(table.size(), 26 * 2 + 10 + 35);
+
+    compareStroke(table, u'a', KEY_A, false);
+    compareStroke(table, u'Z', KEY_Z, true);
+    compareStroke(table, u'0', KEY_0, false);
+    compareStroke(table, u'!', KEY_1, true);
+    compareStroke(table, u'\n', KEY_ENTER, false);
+}
+
+void TestKeymapTable::testBuild_Us()
+{
+    if (!m_haveKeymaps) {
+        QSKIP("xkeyboard-config data not available");
+    }
+
+    const auto table = KeymapTable::build(names(QStringLiteral("us")));
+    const auto fallback = KeymapTable::usFallback();
+
+    // The compiled US layout agrees with the built-in table
+    for (auto it = fallback.cbegin(); it != fallback.cend(); ++it) {
+        compareStroke(table, QChar(it.key()), it->keycode, it->shift, it->altGr);
+    }
+}
+
+void TestKeymapTable::testBuild_Azerty()
+{
+    if (!m_haveKeymaps) {
+        QSKIP("xkeyboard-config data not available");
+    }
+
+    const auto table = KeymapTable::build(names(QStringLiteral("fr")));
+    compareStroke(table, u'a', KEY_Q, false);
+    compareStroke(table, u'q', KEY_A, false);
+    compareStroke(table, u'z', KEY_W, false);
+    compareStroke(table, u'm', KEY_SEMICOLON, false);
+    compareStroke(table, u'1', KEY_1, true);   // Digits need Shift on AZERTY
+    compareStroke(table, u'@', KEY_0, false, true);
+}
+
+void TestKeymapTable::testBuild_Qwertz()
+{
+    if (!m_haveKeymaps) {
+        QSKIP("xkeyboard-config data not available");
+    }
+
+    const auto table = KeymapTable::build(names(QStringLiteral("de")));
+    compareStroke(table, u'z', KEY_Y, false);
+    compareStroke(table, u'Y', KEY_Z, true);
+    compareStroke(table, u'7', KEY_7, false);
+    compareStroke(table, u'@', KEY_Q, false, true);
+}
+
+void TestKeymapTable::testBuild_ActiveGroup()
+{
+    if (!m_haveKeymaps) {
+        QSKIP("xkeyboard-config data not available");
+    }
+
+    compareStroke(KeymapTable::build(names(QStringLiteral("us,de"), 0)), u'z', KEY_Z, false);
+    compareStroke(KeymapTable::build(names(QStringLiteral("us,de"), 1)), u'z', KEY_Y, false);
+}
+
+void TestKeymapTable::testBuild_UnknownLayout()
+{
+    QVERIFY(KeymapTable::build(names(QStringLiteral("no-such-layout"))).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestKeymapTable)
+#include "test_keymap_table.moc"
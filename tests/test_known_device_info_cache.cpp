@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "../src/daemon/oath/known_device_info_cache.h"
+#include "../src/daemon/oath/extended_device_info_fetcher.h"
+
+#include <QtTest>
+
+using namespace YubiKeyOath::Daemon;
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Tests for KnownDeviceInfoCache
+ *
+ * Verifies fingerprint matching, probe cost accounting for probed and
+ * database-seeded entries, and forgetting devices.
+ */
+class TestKnownDeviceInfoCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // Lookup
+    void testLookup_UnknownDevice();
+    void testLookup_MatchingFingerprint();
+    void testLookup_ChangedFingerprint();
+    void testRemember_IgnoresEntriesWithoutSerial();
+    void testRemember_ReplacesEntry();
+
+    // Probe cost accounting
+    void testRecordReuse_ProbedEntryKeepsCount();
+    void testRecordReuse_SeededEntryUsesProbeSequenceCost();
+
+    // Forget
+    void testForget_DropsEntry();
+
+private:
+    static ExtendedDeviceInfo makeInfo(quint32 serial, int probeApduCount = 0)
+    {
+        ExtendedDeviceInfo info;
+        info.firmwareVersion = Version(5, 4, 3);
+        info.serialNumber = serial;
+        info.formFactor = 1;
+        info.probeApduCount = probeApduCount;
+        return info;
+    }
+};
+
+void TestKnownDeviceInfoCache::testLookup_UnknownDevice()
+{
+    const KnownDeviceInfoCache cache;
+    QVERIFY(!cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3)).has_value());
+}
+
+void TestKnownDeviceInfoCache::testLookup_MatchingFingerprint()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(12345678, 5));
+
+    const auto info = cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3));
+    QVERIFY(info.has_value());
+    QCOMPARE(info->serialNumber, 12345678U);
+    QCOMPARE(info->formFactor, quint8(1));
+    QCOMPARE(info->probeApduCount, 5);
+}
+
+void TestKnownDeviceInfoCache::testLookup_ChangedFingerprint()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(12345678));
+
+    // Different SELECT firmware (e.g. NEO applet version vs stored firmware) re-probes
+    QVERIFY(!cache.lookup(QStringLiteral("abcd"), Version(4, 3, 7)).has_value());
+
+    // Re-probed info fingerprinted by SELECT firmware is reused from then on
+    cache.remember(QStringLiteral("abcd"), Version(4, 3, 7), makeInfo(12345678, 7));
+    QVERIFY(cache.lookup(QStringLiteral("abcd"), Version(4, 3, 7)).has_value());
+    QVERIFY(!cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3)).has_value());
+}
+
+void TestKnownDeviceInfoCache::testRemember_IgnoresEntriesWithoutSerial()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(0, 4));
+    cache.remember(QString(), Version(5, 4, 3), makeInfo(12345678, 4));
+
+    QVERIFY(!cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3)).has_value());
+    QVERIFY(!cache.lookup(QString(), Version(5, 4, 3)).has_value());
+}
+
+void TestKnownDeviceInfoCache::testRemember_ReplacesEntry()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(11111111));
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(22222222));
+
+    QCOMPARE(cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3))->serialNumber, 22222222U);
+}
+
+void TestKnownDeviceInfoCache::testRecordReuse_ProbedEntryKeepsCount()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(12345678, 6));
+    QCOMPARE(cache.probeApdusSaved(), 0);
+
+    const auto info = cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3));
+    QVERIFY(info.has_value());
+    QCOMPARE(cache.recordReuse(*info), 6);
+    QCOMPARE(cache.recordReuse(*info), 12);
+    QCOMPARE(cache.probeApdusSaved(), 12);
+}
+
+void TestKnownDeviceInfoCache::testRecordReuse_SeededEntryUsesProbeSequenceCost()
+{
+    // Database records carry no probe count
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(12345678));
+
+    const auto info = cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3));
+    QVERIFY(info.has_value());
+    QCOMPARE(info->probeApduCount, ExtendedDeviceInfoFetcher::MANAGEMENT_PROBE_APDU_COUNT);
+    QCOMPARE(cache.recordReuse(*info), qint64(ExtendedDeviceInfoFetcher::MANAGEMENT_PROBE_APDU_COUNT));
+}
+
+void TestKnownDeviceInfoCache::testForget_DropsEntry()
+{
+    KnownDeviceInfoCache cache;
+    cache.remember(QStringLiteral("abcd"), Version(5, 4, 3), makeInfo(12345678));
+    cache.remember(QStringLiteral("efgh"), Version(5, 4, 3), makeInfo(87654321));
+
+    cache.forget(QStringLiteral("abcd"));
+    QVERIFY(!cache.lookup(QStringLiteral("abcd"), Version(5, 4, 3)).has_value());
+    QVERIFY(cache.lookup(QStringLiteral("efgh"), Version(5, 4, 3)).has_value());
+}
+
+QTEST_GUILESS_MAIN(TestKnownDeviceInfoCache)
+#include "test_known_device_info_cache.moc"
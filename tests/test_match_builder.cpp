@@ -9,6 +9,12 @@
 #include "krunner/matching/match_builder.h"
 #include "mocks/mock_configuration_provider.h"
 #include "shared/types/oath_credential.h"
+#include "dbus/oath_manager_proxy.h"
+#include "dbus/oath_credential_proxy.h"
+#include "../src/daemon/dbus/oath_manager_object.h"  // For ManagedObjectMap type
+#include <QDBusAbstractAdaptor>
+#include <QDBusConnection>
+#include <QDBusMetaType>
 
 using namespace YubiKeyOath::Shared;
 using namespace YubiKeyOath::Runner;
@@ -48,6 +54,81 @@ private:
     }
 };
 
+/**
+ * @brief Mock daemon exporting connected devices for the benchmarks
+ *
+ * Registers on the session bus like the mock service in test_proxy_unit, so
+ * OathManagerProxy::instance() holds device and session proxies and the
+ * per-match context path pays its real per-device cost.
+ */
+class SeededOathDaemon : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "pl.jkolo.yubikey.oath.Manager")
+
+    Q_PROPERTY(QString Version READ version CONSTANT)
+
+public:
+    explicit SeededOathDaemon(int deviceCount, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_deviceCount(deviceCount)
+    {
+    }
+
+    QString version() const { return QStringLiteral("2.0.0-mock"); }
+
+    ManagedObjectMap managedObjects() const
+    {
+        ManagedObjectMap result;
+        for (int i = 0; i < m_deviceCount; ++i) {
+            // Same IDs as the credential proxies from createCredentialProxies()
+            const QString deviceId = QString::number(12345678 + i);
+
+            QVariantMap deviceProps;
+            deviceProps[QStringLiteral("ID")] = deviceId;
+            deviceProps[QStringLiteral("Name")] = QStringLiteral("Mock YubiKey %1").arg(i + 1);
+            deviceProps[QStringLiteral("SerialNumber")] = QVariant::fromValue<quint32>(12345678 + i);
+            deviceProps[QStringLiteral("RequiresPassword")] = false;
+
+            QVariantMap sessionProps;
+            sessionProps[QStringLiteral("State")] = QVariant::fromValue<quint8>(0x04);  // Ready
+            sessionProps[QStringLiteral("HasValidPassword")] = true;
+            sessionProps[QStringLiteral("CredentialsStale")] = false;
+
+            InterfacePropertiesMap interfaces;
+            interfaces[QStringLiteral("pl.jkolo.yubikey.oath.Device")] = deviceProps;
+            interfaces[QStringLiteral("pl.jkolo.yubikey.oath.DeviceSession")] = sessionProps;
+            result[QDBusObjectPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/%1").arg(deviceId))] = interfaces;
+        }
+        return result;
+    }
+
+private:
+    int m_deviceCount;
+};
+
+/**
+ * @brief ObjectManager interface of SeededOathDaemon
+ */
+class SeededObjectManagerAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.DBus.ObjectManager")
+
+public:
+    explicit SeededObjectManagerAdaptor(SeededOathDaemon *parent)
+        : QDBusAbstractAdaptor(parent)
+        , m_daemon(parent)
+    {
+    }
+
+public Q_SLOTS:
+    ManagedObjectMap GetManagedObjects() { return m_daemon->managedObjects(); }
+
+private:
+    SeededOathDaemon *m_daemon;
+};
+
 /**
  * @brief Test helper class to access protected calculateRelevance()
  */
@@ -100,7 +181,28 @@ private Q_SLOTS:
     // Real-world scenarios
     void testRelevanceScoring_RealWorldQueries();
 
+    // MatchContext tests
+    void testBuildMatchContext_ReadsConfig();
+    void testBuildCredentialMatch_UsesContextDeviceName();
+    void testBuildCredentialMatch_StaleDeviceMarked();
+    void testBuildCredentialMatch_UsesRankedRelevance();
+
+    // Benchmarks: building 100 matches with per-match vs shared context
+    void benchmarkBuild100Matches_PerMatchContext();
+    void benchmarkBuild100Matches_SharedContext();
+
 private:
+    QList<OathCredentialProxy*> createCredentialProxies(int count, QObject *parent);
+
+    /**
+     * @brief Manager proxy populated from SeededOathDaemon
+     * @return nullptr if the mock daemon cannot be registered (no session bus, real daemon running)
+     */
+    const OathManagerProxy *seededManager();
+
+    static constexpr int SEEDED_DEVICE_COUNT = 8;
+    SeededOathDaemon *m_seededDaemon = nullptr;
+
     MinimalRunner *m_runner = nullptr;
     MockConfigurationProvider *m_config = nullptr;
     TestableMatchBuilder *m_builder = nullptr;
@@ -116,6 +218,13 @@ void TestMatchBuilder::initTestCase()
 
 void TestMatchBuilder::cleanupTestCase()
 {
+    if (m_seededDaemon) {
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        bus.unregisterObject(QStringLiteral("/pl/jkolo/yubikey/oath"));
+        bus.unregisterService(QStringLiteral("pl.jkolo.yubikey.oath.daemon"));
+        delete m_seededDaemon;
+        m_seededDaemon = nullptr;
+    }
     delete m_builder;
     delete m_config;
     delete m_runner;
@@ -352,5 +461,191 @@ void TestMatchBuilder::testRelevanceScoring_RealWorldQueries()
     }
 }
 
+// ========== MatchContext Tests ==========
+
+QList<OathCredentialProxy*> TestMatchBuilder::createCredentialProxies(int count, QObject *parent)
+{
+    // Proxies need no running daemon - properties come from the map
+    QList<OathCredentialProxy*> proxies;
+    proxies.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString issuer = QStringLiteral("Service%1").arg(i);
+        const QString account = QStringLiteral("user%1@example.com").arg(i);
+        const QVariantMap properties = {
+            {"FullName", issuer + ":" + account},
+            {"Issuer", issuer},
+            {"Username", account},
+            {"RequiresTouch", i % 4 == 0},
+            {"Type", "TOTP"},
+            {"Algorithm", "SHA1"},
+            {"Digits", 6},
+            {"Period", 30},
+            {"DeviceId", "abcdef0123456789"},
+        };
+        const QString path = QStringLiteral("/pl/jkolo/yubikey/oath/devices/%1/credentials/cred_%2")
+                                 .arg(12345678 + (i % 4)).arg(i);
+        proxies.append(new OathCredentialProxy(path, properties, parent));
+    }
+    return proxies;
+}
+
+void TestMatchBuilder::testBuildMatchContext_ReadsConfig()
+{
+    m_config->setShowUsername(false);
+    m_config->setShowCode(true);
+    m_config->setShowDeviceName(true);
+    m_config->setShowDeviceNameOnlyWhenMultiple(false);
+
+    const MatchContext context = m_builder->buildMatchContext(nullptr);
+    QCOMPARE(context.showUsername, false);
+    QCOMPARE(context.showCode, true);
+    QCOMPARE(context.showDeviceName, true);
+    QCOMPARE(context.showDeviceNameOnlyWhenMultiple, false);
+    QVERIFY(context.deviceNames.isEmpty());
+    QCOMPARE(context.connectedDeviceCount, 0);
+
+    // Restore defaults for other tests
+    m_config->setShowUsername(true);
+    m_config->setShowCode(false);
+    m_config->setShowDeviceName(false);
+    m_config->setShowDeviceNameOnlyWhenMultiple(true);
+}
+
+void TestMatchBuilder::testBuildCredentialMatch_UsesContextDeviceName()
+{
+    QObject owner;
+    const auto proxies = createCredentialProxies(1, &owner);
+
+    MatchContext context;
+    context.showDeviceName = true;
+    context.showDeviceNameOnlyWhenMultiple = false;
+    context.connectedDeviceCount = 1;
+    context.deviceNames.insert(proxies.first()->parentDeviceId(), "Work Key");
+
+    const KRunner::QueryMatch match = m_builder->buildCredentialMatch(proxies.first(), "service", context);
+    QVERIFY(match.text().contains("Work Key"));
+    QCOMPARE(match.data().toStringList().at(0), proxies.first()->fullName());
+}
+
+void TestMatchBuilder::testBuildCredentialMatch_StaleDeviceMarked()
+{
+    QObject owner;
+    const auto proxies = createCredentialProxies(1, &owner);
+
+    MatchContext liveContext;
+    const KRunner::QueryMatch live = m_builder->buildCredentialMatch(proxies.first(), "service", liveContext);
+
+    MatchContext staleContext;
+    staleContext.staleDeviceIds.insert(proxies.first()->parentDeviceId());
+    const KRunner::QueryMatch stale = m_builder->buildCredentialMatch(proxies.first(), "service", staleContext);
+
+    // Same credential, cached list: marked in subtext and ranked lower
+    QVERIFY(stale.subtext() != live.subtext());
+    QVERIFY(stale.relevance() < live.relevance());
+    QCOMPARE(stale.relevance(), live.relevance() * MatchBuilder::STALE_RELEVANCE_FACTOR);
+
+    // Other devices in the stale set do not affect this credential
+    MatchContext otherContext;
+    otherContext.staleDeviceIds.insert(QStringLiteral("99999999"));
+    const KRunner::QueryMatch other = m_builder->buildCredentialMatch(proxies.first(), "service", otherContext);
+    QCOMPARE(other.subtext(), live.subtext());
+    QCOMPARE(other.relevance(), live.relevance());
+
+    QCOMPARE(MatchBuilder::adjustRelevance(0.9, false), 0.9);
+}
+
+void TestMatchBuilder::testBuildCredentialMatch_UsesRankedRelevance()
+{
+    QObject owner;
+    const auto proxies = createCredentialProxies(1, &owner);
+
+    // Relevance from CredentialMatcher is used as-is, not recalculated from a query
+    MatchContext liveContext;
+    const KRunner::QueryMatch live = m_builder->buildCredentialMatch(proxies.first(), 0.42, liveContext);
+    QCOMPARE(live.relevance(), 0.42);
+
+    // Cached-list penalty still applies
+    MatchContext staleContext;
+    staleContext.staleDeviceIds.insert(proxies.first()->parentDeviceId());
+    const KRunner::QueryMatch stale = m_builder->buildCredentialMatch(proxies.first(), 0.42, staleContext);
+    QCOMPARE(stale.relevance(), 0.42 * MatchBuilder::STALE_RELEVANCE_FACTOR);
+}
+
+// ========== Benchmarks ==========
+//
+// The manager proxy is seeded with SEEDED_DEVICE_COUNT connected devices, so
+// the per-match path pays a QHash insert and a session lookup per device for
+// every match, as on a real system.
+
+const OathManagerProxy *TestMatchBuilder::seededManager()
+{
+    if (!m_seededDaemon) {
+        qDBusRegisterMetaType<InterfacePropertiesMap>();
+        qDBusRegisterMetaType<ManagedObjectMap>();
+
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        if (!bus.isConnected() || !bus.registerService(QStringLiteral("pl.jkolo.yubikey.oath.daemon"))) {
+            qWarning() << "Cannot register mock daemon:" << bus.lastError().message();
+            return nullptr;
+        }
+
+        m_seededDaemon = new SeededOathDaemon(SEEDED_DEVICE_COUNT);
+        new SeededObjectManagerAdaptor(m_seededDaemon);
+        if (!bus.registerObject(QStringLiteral("/pl/jkolo/yubikey/oath"),
+                                m_seededDaemon,
+                                QDBusConnection::ExportAdaptors |
+                                QDBusConnection::ExportAllProperties)) {
+            qWarning() << "Cannot register mock manager object:" << bus.lastError().message();
+            return nullptr;
+        }
+    }
+
+    OathManagerProxy *manager = OathManagerProxy::instance(this);
+    if (manager->deviceCount() != SEEDED_DEVICE_COUNT) {
+        manager->refresh();
+        if (!QTest::qWaitFor([manager]() { return manager->deviceCount() == SEEDED_DEVICE_COUNT; }, 5000)) {
+            qWarning() << "Manager proxy did not pick up the mock devices:" << manager->deviceCount();
+            return nullptr;
+        }
+    }
+    return manager;
+}
+
+void TestMatchBuilder::benchmarkBuild100Matches_PerMatchContext()
+{
+    QObject owner;
+    const auto proxies = createCredentialProxies(100, &owner);
+    const OathManagerProxy *manager = seededManager();
+    if (!manager) {
+        QSKIP("Mock daemon not available on the session bus");
+    }
+    QCOMPARE(m_builder->buildMatchContext(manager).connectedDeviceCount, SEEDED_DEVICE_COUNT);
+
+    QBENCHMARK {
+        for (auto *proxy : proxies) {
+            const KRunner::QueryMatch match = m_builder->buildCredentialMatch(proxy, "service", manager);
+            Q_UNUSED(match)
+        }
+    }
+}
+
+void TestMatchBuilder::benchmarkBuild100Matches_SharedContext()
+{
+    QObject owner;
+    const auto proxies = createCredentialProxies(100, &owner);
+    const OathManagerProxy *manager = seededManager();
+    if (!manager) {
+        QSKIP("Mock daemon not available on the session bus");
+    }
+
+    QBENCHMARK {
+        const MatchContext context = m_builder->buildMatchContext(manager);
+        for (auto *proxy : proxies) {
+            const KRunner::QueryMatch match = m_builder->buildCredentialMatch(proxy, "service", context);
+            Q_UNUSED(match)
+        }
+    }
+}
+
 QTEST_MAIN(TestMatchBuilder)
 #include "test_match_builder.moc"
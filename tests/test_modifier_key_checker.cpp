@@ -6,6 +6,7 @@
 #include <QtTest>
 #include <QTest>
 #include <QGuiApplication>
+#include <QSignalSpy>
 #include <QString>
 #include "daemon/input/modifier_key_checker.h"
 
@@ -33,6 +34,10 @@ private Q_SLOTS:
     void testWaitForModifierRelease_ImmediateReturn();
     void testWaitForModifierRelease_Timeout();
 
+    // ModifierReleaseWatcher tests
+    void testReleaseWatcher_SignalsOnceFromEventLoop();
+    void testReleaseWatcher_Cancel();
+
     // Integration tests
     void testModifierNames_NotEmpty();
 };
@@ -127,6 +132,47 @@ void TestModifierKeyChecker::testWaitForModifierRelease_Timeout()
     }
 }
 
+// ========== ModifierReleaseWatcher Tests ==========
+
+void TestModifierKeyChecker::testReleaseWatcher_SignalsOnceFromEventLoop()
+{
+    ModifierReleaseWatcher watcher;
+    QSignalSpy releasedSpy(&watcher, &ModifierReleaseWatcher::released);
+    QSignalSpy timedOutSpy(&watcher, &ModifierReleaseWatcher::timedOut);
+
+    watcher.start(200);
+
+    // Never emitted from within start()
+    QVERIFY(watcher.isActive());
+    QCOMPARE(releasedSpy.count() + timedOutSpy.count(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(releasedSpy.count() + timedOutSpy.count(), 1, 1000);
+    QVERIFY(!watcher.isActive());
+
+    // No second signal after the first one
+    QTest::qWait(300);
+    QCOMPARE(releasedSpy.count() + timedOutSpy.count(), 1);
+
+    if (!ModifierKeyChecker::hasModifiersPressed()) {
+        QCOMPARE(releasedSpy.count(), 1);
+    }
+}
+
+void TestModifierKeyChecker::testReleaseWatcher_Cancel()
+{
+    ModifierReleaseWatcher watcher;
+    QSignalSpy releasedSpy(&watcher, &ModifierReleaseWatcher::released);
+    QSignalSpy timedOutSpy(&watcher, &ModifierReleaseWatcher::timedOut);
+
+    watcher.start(100);
+    watcher.cancel();
+    QVERIFY(!watcher.isActive());
+
+    QTest::qWait(200);
+    QCOMPARE(releasedSpy.count(), 0);
+    QCOMPARE(timedOutSpy.count(), 0);
+}
+
 // ========== Integration Tests ==========
 
 void TestModifierKeyChecker::testModifierNames_NotEmpty()
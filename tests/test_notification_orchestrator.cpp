@@ -71,11 +71,12 @@ private Q_SLOTS:
 
     // ========== Constructor Tests ==========
 
-    void testConstructor_InitializesTimers()
+    void testConstructor_InitializesTicker()
     {
-        // Verify timers are created (they exist as children)
+        // One shared countdown ticker, idle while no notification is shown
         auto timers = m_orchestrator->findChildren<QTimer*>();
-        QVERIFY(timers.size() >= 4); // code, touch, modifier, reconnect
+        QCOMPARE(timers.size(), 1);
+        QVERIFY(!timers.first()->isActive());
     }
 
     // ========== Code Notification Tests ==========
@@ -124,7 +125,7 @@ private Q_SLOTS:
         auto timers = m_orchestrator->findChildren<QTimer*>();
         bool foundActiveTimer = false;
         for (auto *timer : timers) {
-            if (timer->isActive() && timer->interval() == 1000) {
+            if (timer->isActive()) {
                 foundActiveTimer = true;
                 break;
             }
@@ -199,7 +200,7 @@ private Q_SLOTS:
         auto timers = m_orchestrator->findChildren<QTimer*>();
         bool foundActiveTimer = false;
         for (auto *timer : timers) {
-            if (timer->isActive() && timer->interval() == 1000) {
+            if (timer->isActive()) {
                 foundActiveTimer = true;
                 break;
             }
@@ -228,9 +229,7 @@ private Q_SLOTS:
         // Verify no active timers
         auto timers = m_orchestrator->findChildren<QTimer*>();
         for (auto *timer : timers) {
-            if (timer->interval() == 1000) {
-                QVERIFY(!timer->isActive());
-            }
+            QVERIFY(!timer->isActive());
         }
     }
 
@@ -348,7 +347,7 @@ private Q_SLOTS:
         auto timers = m_orchestrator->findChildren<QTimer*>();
         bool foundActiveTimer = false;
         for (auto *timer : timers) {
-            if (timer->isActive() && timer->interval() == 1000) {
+            if (timer->isActive()) {
                 foundActiveTimer = true;
                 break;
             }
@@ -420,7 +419,7 @@ private Q_SLOTS:
         auto timers = m_orchestrator->findChildren<QTimer*>();
         bool foundActiveTimer = false;
         for (auto *timer : timers) {
-            if (timer->isActive() && timer->interval() == 1000) {
+            if (timer->isActive()) {
                 foundActiveTimer = true;
                 break;
             }
@@ -457,6 +456,48 @@ private Q_SLOTS:
         QVERIFY(activeCount < 4);
     }
 
+    // ========== Countdown Update Tests ==========
+
+    void testCountdown_OneUpdatePerSecondByDefault()
+    {
+        m_mockNotificationManager->setNextNotificationId(1500);
+        m_orchestrator->showCodeNotification(QStringLiteral("123456"),
+                                            QStringLiteral("Test"), 3, DeviceModel{});
+
+        // Shown at 3s, updated at 2s and 1s, closed at 0s
+        QTRY_COMPARE_WITH_TIMEOUT(m_mockNotificationManager->closeCallCount(), 1, 5000);
+        QCOMPARE(m_mockNotificationManager->updateCallCount(), 2);
+        QVERIFY(m_mockNotificationManager->lastBody().contains(QStringLiteral("1s")));
+
+        // Ticker stops once no countdown is active
+        QVERIFY(!m_orchestrator->findChildren<QTimer*>().first()->isActive());
+    }
+
+    void testCountdown_HigherFrameRateSendsOnlyChanges()
+    {
+        m_mockConfig->setNotificationFrameRate(4);
+        m_mockNotificationManager->setNextNotificationId(1600);
+        m_orchestrator->showCodeNotification(QStringLiteral("123456"),
+                                            QStringLiteral("Test"), 2, DeviceModel{});
+
+        QTRY_COMPARE_WITH_TIMEOUT(m_mockNotificationManager->closeCallCount(), 1, 4000);
+
+        // 2s at 4 frames/s: at most 7 frames between show and close
+        const int updates = m_mockNotificationManager->updateCallCount();
+        QVERIFY(updates > 2);
+        QVERIFY(updates <= 7);
+
+        // Every update changes the countdown or the progress bar
+        const auto calls = m_mockNotificationManager->callsForNotification(1600);
+        for (int i = 1; i < calls.size(); ++i) {
+            if (calls[i].method != QStringLiteral("updateNotification")) {
+                continue;
+            }
+            QVERIFY(calls[i].body != calls[i - 1].body
+                    || calls[i].hints.value(QStringLiteral("value")) != calls[i - 1].hints.value(QStringLiteral("value")));
+        }
+    }
+
     // ========== Action Invoked Signal Tests ==========
 
     void testOnNotificationActionInvoked_TouchCancel_EmitsSignal()
@@ -7,20 +7,42 @@
 #include <QSignalSpy>
 #include <QDBusConnection>
 #include <QDBusObjectPath>
+#include <QDBusMessage>
+#include <QDBusArgument>
 #include "daemon/dbus/oath_manager_object.h"
+#include "daemon/dbus/oath_device_object.h"
 #include "mocks/mock_oath_service.h"
 #include "types/device_state.h"
 #include "utils/version.h"
 #include "types/yubikey_model.h"
+#include "types/oath_credential.h"
+#include "version.h"  // Generated daemon version header
 
 using namespace YubiKeyOath::Daemon;
 using namespace YubiKeyOath::Shared;
 
+/**
+ * @brief Records PropertiesChanged signals received for one object path
+ */
+class PropertiesChangedRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    QList<QDBusMessage> messages;
+
+public Q_SLOTS:
+    void onPropertiesChanged(const QDBusMessage &message)
+    {
+        messages.append(message);
+    }
+};
+
 /**
  * @brief Test OathManagerObject D-Bus interface
  *
  * Tests the Manager D-Bus object which implements ObjectManager pattern.
- * Uses MockService to avoid requiring real PC/SC hardware.
+ * Uses MockOathService to avoid requiring real PC/SC hardware.
  *
  * Test coverage:
  * - GetManagedObjects() method
@@ -34,10 +56,47 @@ class TestOathManagerObject : public QObject
     Q_OBJECT
 
 private:
-    YubiKeyService *m_service = nullptr;
+    MockOathService *m_mockService = nullptr;
     OathManagerObject *m_managerObject = nullptr;
     QDBusConnection m_testConnection{QDBusConnection::sessionBus()};
 
+    // Ready device with the given internal ID and serial number
+    static DeviceInfo makeDevice(const QString &deviceId, quint32 serialNumber)
+    {
+        DeviceInfo device;
+        device._internalDeviceId = deviceId;
+        device.deviceName = QStringLiteral("YubiKey 5C NFC");
+        device.firmwareVersion = Version(5, 4, 3);
+        device.serialNumber = serialNumber;
+        device.deviceModel = QStringLiteral("YubiKey 5C NFC");
+        device.state = DeviceState::Ready;
+        return device;
+    }
+
+    // TOTP credential issuer:account on the given device
+    static OathCredential makeCredential(const QString &deviceId, const QString &issuer, const QString &account)
+    {
+        OathCredential credential;
+        credential.originalName = issuer + QLatin1Char(':') + account;
+        credential.issuer = issuer;
+        credential.account = account;
+        credential.deviceId = deviceId;
+        return credential;
+    }
+
+    // Credential object paths in a GetManagedObjects() reply
+    static QStringList credentialPathsIn(const ManagedObjectMap &objects)
+    {
+        QStringList paths;
+        for (auto it = objects.constBegin(); it != objects.constEnd(); ++it) {
+            if (it.value().contains(QStringLiteral("pl.jkolo.yubikey.oath.Credential"))) {
+                paths.append(it.key().path());
+            }
+        }
+        paths.sort();
+        return paths;
+    }
+
 private Q_SLOTS:
     void initTestCase()
     {
@@ -54,11 +113,11 @@ private Q_SLOTS:
 
     void init()
     {
-        // Create real service (NOTE: requires full daemon infrastructure)
-        m_service = new YubiKeyService(this);
+        // Mock service: in-memory devices and credentials, no PC/SC or database
+        m_mockService = new MockOathService(this);
 
         // Create manager object
-        m_managerObject = new OathManagerObject(m_service, m_testConnection, this);
+        m_managerObject = new OathManagerObject(m_mockService, m_testConnection, this);
     }
 
     void cleanup()
@@ -66,8 +125,8 @@ private Q_SLOTS:
         delete m_managerObject;
         m_managerObject = nullptr;
 
-        delete m_service;
-        m_service = nullptr;
+        delete m_mockService;
+        m_mockService = nullptr;
     }
 
     void testConstruction()
@@ -80,7 +139,7 @@ private Q_SLOTS:
         // Verify version property
         const QString version = m_managerObject->version();
         QVERIFY(!version.isEmpty());
-        QCOMPARE(version, QStringLiteral("1.0"));
+        QCOMPARE(version, QString::fromLatin1(DAEMON_VERSION));
 
         qDebug() << "✓ Manager object constructed successfully";
         qDebug() << "✓ Version property:" << version;
@@ -255,23 +314,424 @@ private Q_SLOTS:
         m_managerObject->addDevice(device1._internalDeviceId);
         m_managerObject->addDevice(device2._internalDeviceId);
 
-        // Act: Get managed objects and device states
+        // Act: Get managed objects and device objects
         const ManagedObjectMap objects = m_managerObject->GetManagedObjects();
-        const QMap<QString, quint8> states = m_managerObject->GetDeviceStates();
+        OathDeviceObject *deviceObj1 = m_managerObject->getDevice(device1._internalDeviceId);
+        OathDeviceObject *deviceObj2 = m_managerObject->getDevice(device2._internalDeviceId);
+
+        // Assert: Two device objects at distinct paths
+        QCOMPARE(objects.size(), 2);
+        QVERIFY(deviceObj1 != nullptr);
+        QVERIFY(deviceObj2 != nullptr);
+        QVERIFY(objects.contains(QDBusObjectPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/11111111"))));
+        QVERIFY(objects.contains(QDBusObjectPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/22222222"))));
+
+        // Assert: States tracked per device (mock has no live OathDevice - both start disconnected)
+        QCOMPARE(deviceObj1->state(), static_cast<quint8>(DeviceState::Disconnected));
+        deviceObj2->setState(static_cast<quint8>(DeviceState::Connecting), QString());
+        QCOMPARE(deviceObj1->state(), static_cast<quint8>(DeviceState::Disconnected));
+        QCOMPARE(deviceObj2->state(), static_cast<quint8>(DeviceState::Connecting));
+
+        qDebug() << "✓ Multiple devices managed correctly";
+        qDebug() << "✓ Device states tracked independently";
+    }
+
+    void testGetManagedObjectsSnapshotGeneration()
+    {
+        qDebug() << "\n--- Test: GetManagedObjects() snapshot and generation ---";
+
+        const quint64 initial = m_managerObject->generation();
+
+        // Reads never bump the generation and return identical content
+        const ManagedObjectMap first = m_managerObject->GetManagedObjects();
+        const ManagedObjectMap second = m_managerObject->GetManagedObjects();
+        QCOMPARE(m_managerObject->generation(), initial);
+        QCOMPARE(second, first);
+
+        // Structural change bumps the generation and invalidates the snapshot
+        const DeviceInfo device = makeDevice(QStringLiteral("bbbb000000000001"), 32000001);
+        m_mockService->addMockDevice(device);
+        m_managerObject->addDevice(device._internalDeviceId);
+
+        const quint64 afterAdd = m_managerObject->generation();
+        QVERIFY(afterAdd > initial);
+        const ManagedObjectMap withDevice = m_managerObject->GetManagedObjects();
+        QCOMPARE(withDevice.size(), first.size() + 1);
+        QCOMPARE(m_managerObject->GetManagedObjects(), withDevice);
+        QCOMPARE(m_managerObject->generation(), afterAdd);
+
+        // Property change on a device object invalidates it as well
+        m_managerObject->getDevice(device._internalDeviceId)
+            ->setState(static_cast<quint8>(DeviceState::Connecting), QStringLiteral("reconnecting"));
+        QVERIFY(m_managerObject->generation() > afterAdd);
+
+        const ManagedObjectMap afterState = m_managerObject->GetManagedObjects();
+        const QVariantMap session = afterState.value(QDBusObjectPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/32000001")))
+                                        .value(QStringLiteral("pl.jkolo.yubikey.oath.DeviceSession"));
+        QCOMPARE(session.value(QStringLiteral("State")).toInt(), static_cast<int>(DeviceState::Connecting));
+        QCOMPARE(session.value(QStringLiteral("StateMessage")).toString(), QStringLiteral("reconnecting"));
+
+        qDebug() << "✓ Snapshot reused between changes, generation" << initial << "→" << m_managerObject->generation();
+    }
 
-        // Assert: Two device objects returned
-        QVERIFY(objects.size() >= 2); // At least 2 device objects
+    void testPropertiesChangedCoalescedPerTick()
+    {
+        qDebug() << "\n--- Test: PropertiesChanged coalesced per event loop tick ---";
 
-        // Assert: Two device states returned
-        QCOMPARE(states.size(), 2);
-        QVERIFY(states.contains(device1._internalDeviceId));
-        QVERIFY(states.contains(device2._internalDeviceId));
+        const DeviceInfo device = makeDevice(QStringLiteral("bbbb000000000002"), 32000002);
+        m_mockService->addMockDevice(device);
+        OathDeviceObject *deviceObj = m_managerObject->addDevice(device._internalDeviceId);
+        QVERIFY(deviceObj != nullptr);
 
-        QCOMPARE(states.value(device1._internalDeviceId), static_cast<quint8>(DeviceState::Ready));
-        QCOMPARE(states.value(device2._internalDeviceId), static_cast<quint8>(DeviceState::Connecting));
+        PropertiesChangedRecorder recorder;
+        QVERIFY(m_testConnection.connect(QString(), deviceObj->objectPath(),
+                                         QStringLiteral("org.freedesktop.DBus.Properties"),
+                                         QStringLiteral("PropertiesChanged"),
+                                         &recorder, SLOT(onPropertiesChanged(QDBusMessage))));
+        QCoreApplication::processEvents(); // Drop anything queued by addDevice()
+        recorder.messages.clear();
+
+        // Burst within one tick: 4 property changes on DeviceSession
+        deviceObj->setState(static_cast<quint8>(DeviceState::Connecting), QStringLiteral("first"));
+        deviceObj->setState(static_cast<quint8>(DeviceState::Authenticating), QStringLiteral("second"));
+        QVERIFY(recorder.messages.isEmpty()); // Nothing sent before the event loop runs
+
+        QTRY_COMPARE(recorder.messages.size(), 1);
+        QTest::qWait(50);
+        QCOMPARE(recorder.messages.size(), 1); // No stragglers
+
+        // One message, latest values only
+        const QList<QVariant> args = recorder.messages.first().arguments();
+        QCOMPARE(args.at(0).toString(), QStringLiteral("pl.jkolo.yubikey.oath.DeviceSession"));
+        const QVariantMap changed = qdbus_cast<QVariantMap>(args.at(1));
+        QCOMPARE(changed.value(QStringLiteral("State")).toInt(), static_cast<int>(DeviceState::Authenticating));
+        QCOMPARE(changed.value(QStringLiteral("StateMessage")).toString(), QStringLiteral("second"));
+
+        // Change in a later tick is not swallowed by the previous flush
+        deviceObj->setState(static_cast<quint8>(DeviceState::Ready), QString());
+        QTRY_COMPARE(recorder.messages.size(), 2);
+        const QVariantMap later = qdbus_cast<QVariantMap>(recorder.messages.last().arguments().at(1));
+        QCOMPARE(later.value(QStringLiteral("State")).toInt(), static_cast<int>(DeviceState::Ready));
+
+        m_testConnection.disconnect(QString(), deviceObj->objectPath(),
+                                    QStringLiteral("org.freedesktop.DBus.Properties"),
+                                    QStringLiteral("PropertiesChanged"),
+                                    &recorder, SLOT(onPropertiesChanged(QDBusMessage)));
+
+        qDebug() << "✓ Burst of state changes sent as one PropertiesChanged, next tick as another";
+    }
 
-        qDebug() << "✓ Multiple devices managed correctly";
-        qDebug() << "✓ Device states tracked independently";
+    void testCredentialRefreshUsesBulkSignals()
+    {
+        qDebug() << "\n--- Test: credential refresh emits bulk and singular credential signals ---";
+
+        const DeviceInfo device = makeDevice(QStringLiteral("bbbb000000000003"), 32000003);
+        m_mockService->addMockDevice(device);
+        OathDeviceObject *deviceObj = m_managerObject->addDevice(device._internalDeviceId);
+        QVERIFY(deviceObj != nullptr);
+
+        QSignalSpy singleAdded(deviceObj, &OathDeviceObject::CredentialAdded);
+        QSignalSpy bulkAdded(deviceObj, &OathDeviceObject::CredentialsAdded);
+        QSignalSpy singleRemoved(deviceObj, &OathDeviceObject::CredentialRemoved);
+        QSignalSpy bulkRemoved(deviceObj, &OathDeviceObject::CredentialsRemoved);
+
+        // Order of emission: bulk signal first, so clients can skip the singular ones
+        QStringList order;
+        connect(deviceObj, &OathDeviceObject::CredentialsAdded, this, [&order]() { order.append(QStringLiteral("bulk")); });
+        connect(deviceObj, &OathDeviceObject::CredentialAdded, this, [&order]() { order.append(QStringLiteral("single")); });
+
+        // Batch of three: one bulk signal carrying all properties, then one singular signal per path
+        for (const QString &issuer : {QStringLiteral("GitHub"), QStringLiteral("GitLab"), QStringLiteral("Google")}) {
+            m_mockService->addMockCredential(device._internalDeviceId,
+                                             makeCredential(device._internalDeviceId, issuer, QStringLiteral("dave")));
+        }
+        deviceObj->updateCredentials();
+
+        QCOMPARE(bulkAdded.count(), 1);
+        QCOMPARE(singleAdded.count(), 3);
+        QCOMPARE(order, (QStringList{QStringLiteral("bulk"), QStringLiteral("single"),
+                                     QStringLiteral("single"), QStringLiteral("single")}));
+        const auto added = bulkAdded.first().at(0).value<CredentialPropertiesMap>();
+        QCOMPARE(added.size(), 3);
+        for (auto it = added.constBegin(); it != added.constEnd(); ++it) {
+            QVERIFY(it.key().path().startsWith(deviceObj->objectPath() + QStringLiteral("/credentials/")));
+            QVERIFY(!it.value().value(QStringLiteral("FullName")).toString().isEmpty());
+        }
+        QStringList singlePaths;
+        for (const QList<QVariant> &args : std::as_const(singleAdded)) {
+            singlePaths.append(args.at(0).value<QDBusObjectPath>().path());
+        }
+        singlePaths.sort();
+        QStringList bulkPaths;
+        for (auto it = added.constBegin(); it != added.constEnd(); ++it) {
+            bulkPaths.append(it.key().path());
+        }
+        bulkPaths.sort();
+        QCOMPARE(singlePaths, bulkPaths);
+
+        // Single credential: singular signal, no bulk
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("Amazon"), QStringLiteral("dave")));
+        deviceObj->updateCredentials();
+        QCOMPARE(singleAdded.count(), 4);
+        QCOMPARE(bulkAdded.count(), 1);
+
+        // All gone at once: one bulk removal plus the singular ones
+        m_mockService->clearMockCredentials(device._internalDeviceId);
+        deviceObj->updateCredentials();
+        QCOMPARE(bulkRemoved.count(), 1);
+        QCOMPARE(singleRemoved.count(), 4);
+        QCOMPARE(bulkRemoved.first().at(0).value<QList<QDBusObjectPath>>().size(), 4);
+        QVERIFY(deviceObj->credentialPaths().isEmpty());
+
+        qDebug() << "✓ 3 added, 1 added, 4 removed with 1 + 1 + 1 bulk and 3 + 1 + 4 singular signals";
+    }
+
+    void testCredentialsStaleFollowsCredentialSource()
+    {
+        qDebug() << "\n--- Test: CredentialsStale set for cached lists, cleared when live or empty ---";
+
+        // Mock service has no live OathDevice, so every listed credential is a cached one
+        const DeviceInfo device = makeDevice(QStringLiteral("bbbb000000000004"), 32000004);
+        m_mockService->addMockDevice(device);
+        OathDeviceObject *deviceObj = m_managerObject->addDevice(device._internalDeviceId);
+        QVERIFY(deviceObj != nullptr);
+        QVERIFY(!deviceObj->credentialsStale()); // Nothing published - nothing stale
+
+        QSignalSpy staleSpy(deviceObj, &OathDeviceObject::credentialsStaleChanged);
+        const QDBusObjectPath devicePath(deviceObj->objectPath());
+        const auto publishedStale = [this, &devicePath]() {
+            return m_managerObject->GetManagedObjects().value(devicePath)
+                .value(QStringLiteral("pl.jkolo.yubikey.oath.DeviceSession"))
+                .value(QStringLiteral("CredentialsStale")).toBool();
+        };
+
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("GitHub"), QStringLiteral("frank")));
+        deviceObj->updateCredentials();
+        QVERIFY(deviceObj->credentialsStale());
+        QCOMPARE(staleSpy.count(), 1);
+        QCOMPARE(staleSpy.last().at(0).toBool(), true);
+        QVERIFY(publishedStale());
+
+        // Re-sync with the same source: no change signalled
+        deviceObj->updateCredentials();
+        QCOMPARE(staleSpy.count(), 1);
+
+        // Device came back and read its credentials: same list, no longer stale
+        m_mockService->setLiveCredentials(device._internalDeviceId, true);
+        deviceObj->updateCredentials();
+        QVERIFY(!deviceObj->credentialsStale());
+        QCOMPARE(staleSpy.count(), 2);
+        QCOMPARE(staleSpy.last().at(0).toBool(), false);
+        QVERIFY(!publishedStale());
+
+        // Device gone again: back to the cache
+        m_mockService->setLiveCredentials(device._internalDeviceId, false);
+        deviceObj->updateCredentials();
+        QVERIFY(deviceObj->credentialsStale());
+        QCOMPARE(staleSpy.count(), 3);
+
+        // Empty list is never stale
+        m_mockService->clearMockCredentials(device._internalDeviceId);
+        deviceObj->updateCredentials();
+        QVERIFY(!deviceObj->credentialsStale());
+        QCOMPARE(staleSpy.count(), 4);
+        QVERIFY(!publishedStale());
+
+        qDebug() << "✓ CredentialsStale follows the published credential source";
+    }
+
+    void testGetManagedObjectsPackedMatchesUnpacked()
+    {
+        qDebug() << "\n--- Test: GetManagedObjectsPacked() mirrors GetManagedObjects() ---";
+
+        const DeviceInfo device = makeDevice(QStringLiteral("aaaa000000000001"), 31000001);
+        m_mockService->addMockDevice(device);
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("GitHub"), QStringLiteral("alice")));
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("Google"), QStringLiteral("bob")));
+        m_managerObject->addDevice(device._internalDeviceId);
+
+        const ManagedObjectMap objects = m_managerObject->GetManagedObjects();
+        const PackedManagedObjects packed = m_managerObject->GetManagedObjectsPacked();
+
+        // Same generation, same devices, same credential paths
+        QCOMPARE(packed.formatVersion, PackedManagedObjects::FORMAT_VERSION);
+        QCOMPARE(packed.generation, m_managerObject->generation());
+        QCOMPARE(packed.devices.size(), 1);
+        QCOMPARE(packed.devices.constBegin().value(), objects.value(packed.devices.constBegin().key()));
+
+        QStringList packedPaths;
+        for (const PackedCredential &credential : packed.credentials) {
+            packedPaths.append(credential.path.path());
+
+            // Fixed-order fields carry the Credential interface properties
+            const QVariantMap properties = objects.value(credential.path)
+                                               .value(QStringLiteral("pl.jkolo.yubikey.oath.Credential"));
+            QCOMPARE(credential.fullName, properties.value(QStringLiteral("FullName")).toString());
+            QCOMPARE(credential.issuer, properties.value(QStringLiteral("Issuer")).toString());
+            QCOMPARE(credential.username, properties.value(QStringLiteral("Username")).toString());
+            QCOMPARE(static_cast<int>(credential.digits), properties.value(QStringLiteral("Digits")).toInt());
+            QCOMPARE(static_cast<int>(credential.period), properties.value(QStringLiteral("Period")).toInt());
+        }
+        packedPaths.sort();
+        QCOMPARE(packedPaths, credentialPathsIn(objects));
+        QCOMPARE(packedPaths.size(), 2);
+
+        qDebug() << "✓ Packed reply has" << packed.credentials.size() << "credentials at generation" << packed.generation;
+    }
+
+    void testGetManagedObjectsPackedInvalidatedWithSnapshot()
+    {
+        qDebug() << "\n--- Test: GetManagedObjectsPacked() cache follows generation ---";
+
+        const DeviceInfo device = makeDevice(QStringLiteral("aaaa000000000002"), 31000002);
+        m_mockService->addMockDevice(device);
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("GitLab"), QStringLiteral("carol")));
+        m_managerObject->addDevice(device._internalDeviceId);
+
+        const PackedManagedObjects first = m_managerObject->GetManagedObjectsPacked();
+        const PackedManagedObjects cached = m_managerObject->GetManagedObjectsPacked();
+        QCOMPARE(cached.generation, first.generation);
+        QCOMPARE(cached.credentials.size(), first.credentials.size());
+
+        m_managerObject->removeDevice(device._internalDeviceId);
+
+        const PackedManagedObjects after = m_managerObject->GetManagedObjectsPacked();
+        QVERIFY(after.generation > first.generation);
+        QVERIFY(after.devices.isEmpty());
+        QVERIFY(after.credentials.isEmpty());
+
+        qDebug() << "✓ Packed snapshot rebuilt after removeDevice()";
+    }
+
+    void testGetChangesSinceDelta()
+    {
+        qDebug() << "\n--- Test: GetChangesSince() returns journaled changes ---";
+
+        const quint64 start = m_managerObject->generation();
+
+        const DeviceInfo device = makeDevice(QStringLiteral("dddd000000000001"), 34000001);
+        m_mockService->addMockDevice(device);
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("GitHub"), QStringLiteral("erin")));
+        m_managerObject->addDevice(device._internalDeviceId);
+        const QString devicePath = QStringLiteral("/pl/jkolo/yubikey/oath/devices/34000001");
+
+        // Everything added since start: device plus its credential, with current data
+        const ManagedObjectChanges added = m_managerObject->GetChangesSince(start);
+        QVERIFY(!added.fullResyncRequired);
+        QCOMPARE(added.generation, m_managerObject->generation());
+        QVERIFY(added.changed.contains(QDBusObjectPath(devicePath)));
+        QCOMPARE(credentialPathsIn(added.changed), credentialPathsIn(m_managerObject->GetManagedObjects()));
+        QVERIFY(added.removed.isEmpty());
+
+        // Up to date: empty delta
+        const ManagedObjectChanges none = m_managerObject->GetChangesSince(added.generation);
+        QVERIFY(!none.fullResyncRequired);
+        QVERIFY(none.changed.isEmpty());
+        QVERIFY(none.removed.isEmpty());
+
+        // Removal shows up in removed, not changed
+        const QStringList credentialPaths = credentialPathsIn(m_managerObject->GetManagedObjects());
+        m_managerObject->removeDevice(device._internalDeviceId);
+        const ManagedObjectChanges removed = m_managerObject->GetChangesSince(added.generation);
+        QVERIFY(!removed.fullResyncRequired);
+        QVERIFY(removed.changed.isEmpty());
+        QVERIFY(removed.removed.contains(QDBusObjectPath(devicePath)));
+        for (const QString &path : credentialPaths) {
+            QVERIFY(removed.removed.contains(QDBusObjectPath(path)));
+        }
+
+        qDebug() << "✓ Delta:" << added.changed.size() << "changed," << removed.removed.size() << "removed";
+    }
+
+    void testGetChangesSinceOnlyChangedObjects()
+    {
+        qDebug() << "\n--- Test: GetChangesSince() after a property change ---";
+
+        const DeviceInfo device = makeDevice(QStringLiteral("dddd000000000003"), 34000003);
+        m_mockService->addMockDevice(device);
+        m_mockService->addMockCredential(device._internalDeviceId,
+                                         makeCredential(device._internalDeviceId, QStringLiteral("GitHub"), QStringLiteral("grace")));
+        OathDeviceObject *deviceObj = m_managerObject->addDevice(device._internalDeviceId);
+        QVERIFY(deviceObj != nullptr);
+        const quint64 synced = m_managerObject->generation();
+
+        // State change touches the device object only - its credentials are not resent
+        deviceObj->setState(static_cast<quint8>(DeviceState::Connecting), QString());
+        const ManagedObjectChanges delta = m_managerObject->GetChangesSince(synced);
+        QVERIFY(!delta.fullResyncRequired);
+        QCOMPARE(delta.changed.size(), 1);
+        QVERIFY(delta.changed.contains(QDBusObjectPath(deviceObj->objectPath())));
+        QVERIFY(credentialPathsIn(delta.changed).isEmpty());
+        QVERIFY(delta.removed.isEmpty());
+
+        qDebug() << "✓ Property change delta carries 1 object";
+    }
+
+    void testGetChangesSinceUnknownGeneration()
+    {
+        qDebug() << "\n--- Test: GetChangesSince() with a generation from elsewhere ---";
+
+        // Newer than ours - e.g. from a previous daemon instance
+        const ManagedObjectChanges future = m_managerObject->GetChangesSince(m_managerObject->generation() + 100);
+        QVERIFY(future.fullResyncRequired);
+        QCOMPARE(future.generation, m_managerObject->generation());
+        QVERIFY(future.changed.isEmpty());
+        QVERIFY(future.removed.isEmpty());
+
+        // 0 means "never synced" and is below the journal floor
+        QVERIFY(m_managerObject->GetChangesSince(0).fullResyncRequired);
+
+        // Current generation is always answerable
+        QVERIFY(!m_managerObject->GetChangesSince(m_managerObject->generation()).fullResyncRequired);
+
+        qDebug() << "✓ Unknown generations require a full resync";
+    }
+
+    void testGetChangesSinceJournalTrim()
+    {
+        qDebug() << "\n--- Test: GetChangesSince() journal trimming raises the floor ---";
+
+        const quint64 start = m_managerObject->generation();
+        QVERIFY(!m_managerObject->GetChangesSince(start).fullResyncRequired);
+
+        // Each add/remove journals at least one path per change - well beyond the 1024 entry bound
+        const DeviceInfo device = makeDevice(QStringLiteral("dddd000000000002"), 34000002);
+        m_mockService->addMockDevice(device);
+        for (int i = 0; i < 600; ++i) {
+            m_managerObject->addDevice(device._internalDeviceId);
+            m_managerObject->removeDevice(device._internalDeviceId);
+        }
+        const quint64 current = m_managerObject->generation();
+        QVERIFY(current - start >= 1200);
+
+        // Oldest generations were trimmed away
+        const ManagedObjectChanges old = m_managerObject->GetChangesSince(start);
+        QVERIFY(old.fullResyncRequired);
+        QCOMPARE(old.generation, current);
+
+        // Recent ones are still served as deltas
+        const ManagedObjectChanges recent = m_managerObject->GetChangesSince(current - 2);
+        QVERIFY(!recent.fullResyncRequired);
+        QVERIFY(recent.removed.contains(QDBusObjectPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/34000002"))));
+
+        // Floor is monotonic: exactly one boundary between resync and delta
+        quint64 floor = start;
+        while (floor < current && m_managerObject->GetChangesSince(floor).fullResyncRequired) {
+            ++floor;
+        }
+        QVERIFY(floor > start);
+        QVERIFY(floor < current);
+        for (quint64 generation = floor; generation <= current; generation += 97) {
+            QVERIFY(!m_managerObject->GetChangesSince(generation).fullResyncRequired);
+        }
+
+        qDebug() << "✓ Journal floor moved from" << start << "to" << floor << "at generation" << current;
     }
 
     // NOTE: testDevicePathGeneration() skipped - devicePath() is private implementation detail
@@ -294,9 +754,19 @@ private Q_SLOTS:
         qDebug() << "4. testGetManagedObjectsWithDevice - Object enumeration";
         qDebug() << "5. testRemoveDevice - Device removal and signals";
         qDebug() << "6. testMultipleDevices - Multi-device support";
+        qDebug() << "7. testGetManagedObjectsSnapshotGeneration - Snapshot reuse and invalidation";
+        qDebug() << "8. testPropertiesChangedCoalescedPerTick - One PropertiesChanged per burst";
+        qDebug() << "9. testCredentialRefreshUsesBulkSignals - Bulk credential signals";
+        qDebug() << "10. testGetManagedObjectsPackedMatchesUnpacked - Packed reply content";
+        qDebug() << "11. testGetManagedObjectsPackedInvalidatedWithSnapshot - Packed cache invalidation";
+        qDebug() << "12. testGetChangesSinceDelta - Changed and removed objects";
+        qDebug() << "13. testGetChangesSinceUnknownGeneration - Resync for foreign generations";
+        qDebug() << "14. testGetChangesSinceJournalTrim - Journal bound and floor";
+        qDebug() << "15. testCredentialsStaleFollowsCredentialSource - CredentialsStale property";
+        qDebug() << "16. testGetChangesSinceOnlyChangedObjects - Property change delta";
         qDebug() << "";
-        qDebug() << "NOTE: Requires full YubiKeyService infrastructure (PC/SC, database, etc.)";
-        qDebug() << "      Consider using E2E test (test_e2e_device_lifecycle) for comprehensive D-Bus testing";
+        qDebug() << "NOTE: Uses MockOathService - device state transitions of live devices";
+        qDebug() << "      are covered by the E2E test (test_e2e_device_lifecycle)";
         qDebug() << "";
     }
 };
@@ -0,0 +1,245 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include <QUrl>
+#include "daemon/utils/otpauth_uri_parser.h"
+
+using namespace YubiKeyOath::Daemon;
+using namespace YubiKeyOath::Shared;
+
+/**
+ * @brief Unit tests for OtpauthUriParser
+ *
+ * Covers single otpauth:// URIs and Google Authenticator otpauth-migration://
+ * batch exports. Migration payloads are encoded by hand in protobuf wire format.
+ */
+class TestOtpauthUriParser : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // parse() tests
+    void testParse_Totp();
+    void testParse_InvalidScheme();
+
+    // parseMigration() tests
+    void testParseMigration_SingleTotp();
+    void testParseMigration_Batch();
+    void testParseMigration_SkipsUnsupportedEntries();
+    void testParseMigration_Malformed();
+    void testParseMigration_InvalidScheme();
+
+    // parseAll() tests
+    void testParseAll_Dispatch();
+
+private:
+    struct OtpEntry {
+        QByteArray secret;
+        QByteArray name;
+        QByteArray issuer;
+        int algorithm = 1;
+        int digits = 1;
+        int type = 2;
+        int counter = 0;
+    };
+
+    static QByteArray varint(quint64 value);
+    static QByteArray lengthDelimited(int field, const QByteArray &bytes);
+    static QByteArray varintField(int field, quint64 value);
+    static QByteArray encodeEntry(const OtpEntry &entry);
+    static QString migrationUri(const QList<OtpEntry> &entries);
+};
+
+namespace {
+// "Hello!" followed by 0xDEADBEEF - Base32 "JBSWY3DPEHPK3PXP"
+const QByteArray SECRET_BYTES = QByteArray("Hello!") + QByteArray::fromHex("deadbeef");
+const QString SECRET_BASE32 = QStringLiteral("JBSWY3DPEHPK3PXP");
+} // namespace
+
+QByteArray TestOtpauthUriParser::varint(quint64 value)
+{
+    QByteArray bytes;
+    do {
+        quint8 byte = value & 0x7F;
+        value >>= 7;
+        if (value != 0) {
+            byte |= 0x80;
+        }
+        bytes.append(static_cast<char>(byte));
+    } while (value != 0);
+    return bytes;
+}
+
+QByteArray TestOtpauthUriParser::lengthDelimited(int field, const QByteArray &bytes)
+{
+    return varint((static_cast<quint64>(field) << 3) | 2) + varint(bytes.size()) + bytes;
+}
+
+QByteArray TestOtpauthUriParser::varintField(int field, quint64 value)
+{
+    return varint(static_cast<quint64>(field) << 3) + varint(value);
+}
+
+QByteArray TestOtpauthUriParser::encodeEntry(const OtpEntry &entry)
+{
+    QByteArray message = lengthDelimited(1, entry.secret) + lengthDelimited(2, entry.name);
+    if (!entry.issuer.isEmpty()) {
+        message += lengthDelimited(3, entry.issuer);
+    }
+    message += varintField(4, entry.algorithm);
+    message += varintField(5, entry.digits);
+    message += varintField(6, entry.type);
+    if (entry.counter != 0) {
+        message += varintField(7, entry.counter);
+    }
+    return message;
+}
+
+QString TestOtpauthUriParser::migrationUri(const QList<OtpEntry> &entries)
+{
+    QByteArray payload;
+    for (const auto &entry : entries) {
+        payload += lengthDelimited(1, encodeEntry(entry));
+    }
+    // version, batch_size, batch_index, batch_id
+    payload += varintField(2, 1) + varintField(3, 1) + varintField(4, 0) + varintField(5, 123456);
+
+    return QStringLiteral("otpauth-migration://offline?data=")
+        + QString::fromLatin1(QUrl::toPercentEncoding(QString::fromLatin1(payload.toBase64())));
+}
+
+// ========== parse() ==========
+
+void TestOtpauthUriParser::testParse_Totp()
+{
+    const auto result = OtpauthUriParser::parse(
+        QStringLiteral("otpauth://totp/Example:alice@example.com?secret=JBSWY3DPEHPK3PXP&issuer=Example&period=60"));
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value().name, QStringLiteral("Example:alice@example.com"));
+    QCOMPARE(result.value().secret, SECRET_BASE32);
+    QCOMPARE(result.value().period, 60);
+}
+
+void TestOtpauthUriParser::testParse_InvalidScheme()
+{
+    QVERIFY(OtpauthUriParser::parse(QStringLiteral("https://example.com")).isError());
+}
+
+// ========== parseMigration() ==========
+
+void TestOtpauthUriParser::testParseMigration_SingleTotp()
+{
+    OtpEntry entry;
+    entry.secret = SECRET_BYTES;
+    entry.name = "alice@example.com";
+    entry.issuer = "Example";
+
+    const auto result = OtpauthUriParser::parseMigration(migrationUri({entry}));
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value().size(), 1);
+
+    const auto &data = result.value().constFirst();
+    QCOMPARE(data.name, QStringLiteral("Example:alice@example.com"));
+    QCOMPARE(data.issuer, QStringLiteral("Example"));
+    QCOMPARE(data.account, QStringLiteral("alice@example.com"));
+    QCOMPARE(data.secret, SECRET_BASE32);
+    QCOMPARE(data.type, OathType::TOTP);
+    QCOMPARE(data.algorithm, OathAlgorithm::SHA1);
+    QCOMPARE(data.digits, 6);
+    QCOMPARE(data.period, 30);
+}
+
+void TestOtpauthUriParser::testParseMigration_Batch()
+{
+    OtpEntry totp;
+    totp.secret = SECRET_BYTES;
+    totp.name = "GitHub:alice";
+
+    OtpEntry hotp;
+    hotp.secret = QByteArray(20, '\x42');
+    hotp.name = "bob";
+    hotp.issuer = "ACME";
+    hotp.algorithm = 2;
+    hotp.digits = 2;
+    hotp.type = 1;
+    hotp.counter = 300;
+
+    const auto result = OtpauthUriParser::parseMigration(migrationUri({totp, hotp}));
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value().size(), 2);
+
+    const auto &first = result.value().at(0);
+    QCOMPARE(first.issuer, QStringLiteral("GitHub"));
+    QCOMPARE(first.account, QStringLiteral("alice"));
+
+    const auto &second = result.value().at(1);
+    QCOMPARE(second.name, QStringLiteral("ACME:bob"));
+    QCOMPARE(second.type, OathType::HOTP);
+    QCOMPARE(second.algorithm, OathAlgorithm::SHA256);
+    QCOMPARE(second.digits, 8);
+    QCOMPARE(second.counter, quint32(300));
+    QCOMPARE(second.secret.size(), 32); // 20 bytes -> 32 Base32 characters
+}
+
+void TestOtpauthUriParser::testParseMigration_SkipsUnsupportedEntries()
+{
+    OtpEntry md5;
+    md5.secret = SECRET_BYTES;
+    md5.name = "Legacy:md5";
+    md5.algorithm = 4;
+
+    OtpEntry supported;
+    supported.secret = SECRET_BYTES;
+    supported.name = "Example:alice";
+
+    const auto result = OtpauthUriParser::parseMigration(migrationUri({md5, supported}));
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value().size(), 1);
+    QCOMPARE(result.value().constFirst().name, QStringLiteral("Example:alice"));
+
+    // Nothing usable left
+    QVERIFY(OtpauthUriParser::parseMigration(migrationUri({md5})).isError());
+}
+
+void TestOtpauthUriParser::testParseMigration_Malformed()
+{
+    // Length prefix points past the end of the payload
+    const QByteArray truncated = varint((1 << 3) | 2) + varint(50) + QByteArray("short");
+    const QString uri = QStringLiteral("otpauth-migration://offline?data=")
+        + QString::fromLatin1(QUrl::toPercentEncoding(QString::fromLatin1(truncated.toBase64())));
+    QVERIFY(OtpauthUriParser::parseMigration(uri).isError());
+
+    QVERIFY(OtpauthUriParser::parseMigration(QStringLiteral("otpauth-migration://offline")).isError());
+    QVERIFY(OtpauthUriParser::parseMigration(QStringLiteral("otpauth-migration://offline?data=%%%")).isError());
+}
+
+void TestOtpauthUriParser::testParseMigration_InvalidScheme()
+{
+    QVERIFY(OtpauthUriParser::parseMigration(
+        QStringLiteral("otpauth://totp/Example:alice?secret=JBSWY3DPEHPK3PXP")).isError());
+}
+
+// ========== parseAll() ==========
+
+void TestOtpauthUriParser::testParseAll_Dispatch()
+{
+    const auto single = OtpauthUriParser::parseAll(
+        QStringLiteral("otpauth://totp/Example:alice?secret=JBSWY3DPEHPK3PXP"));
+    QVERIFY2(single.isSuccess(), qPrintable(single.error()));
+    QCOMPARE(single.value().size(), 1);
+
+    OtpEntry entry;
+    entry.secret = SECRET_BYTES;
+    entry.name = "Example:alice";
+    const auto batch = OtpauthUriParser::parseAll(migrationUri({entry, entry}));
+    QVERIFY2(batch.isSuccess(), qPrintable(batch.error()));
+    QCOMPARE(batch.value().size(), 2);
+
+    QVERIFY(OtpauthUriParser::parseAll(QStringLiteral("https://example.com")).isError());
+}
+
+QTEST_GUILESS_MAIN(TestOtpauthUriParser)
+#include "test_otpauth_uri_parser.moc"
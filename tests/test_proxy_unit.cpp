@@ -30,6 +30,7 @@
 #include "../src/shared/dbus/oath_device_proxy.h"
 #include "../src/shared/dbus/oath_credential_proxy.h"
 #include "../src/shared/types/yubikey_value_types.h"
+#include "../src/shared/types/oath_credential_data.h"
 #include "../src/daemon/dbus/oath_manager_object.h"  // For ManagedObjectMap type
 
 using namespace YubiKeyOath::Shared;
@@ -326,6 +327,8 @@ private Q_SLOTS:
     // YubiKeyCredentialProxy tests
     void testCredentialProxyConstruction();
     void testCredentialProxyProperties();
+    void testCredentialProxyFromPacked();
+    void testCredentialProxyDevicePathFromPath();
     void testCredentialProxyGenerateCode();
     void testCredentialProxyCopyToClipboard();
     void testCredentialProxyTypeCode();
@@ -525,6 +528,77 @@ void TestProxyUnit::testCredentialProxyProperties()
     qDebug() << "✅ All credential properties accessible";
 }
 
+void TestProxyUnit::testCredentialProxyFromPacked()
+{
+    qDebug() << "\n=== Test: CredentialProxy from packed credential ===";
+
+    const QString path = QStringLiteral("/pl/jkolo/yubikey/oath/devices/mock_device_1/credentials/google_3ajdoe");
+
+    PackedCredential packed;
+    packed.path = QDBusObjectPath(path);
+    packed.fullName = QStringLiteral("Google:jdoe");
+    packed.issuer = QStringLiteral("Google");
+    packed.username = QStringLiteral("jdoe");
+    packed.deviceId = QStringLiteral("mock_device_1");
+    packed.requiresTouch = true;
+    packed.type = static_cast<quint8>(OathType::TOTP);
+    packed.algorithm = static_cast<quint8>(OathAlgorithm::SHA256);
+    packed.digits = 8;
+    packed.period = 60;
+
+    QVariantMap properties;
+    properties[QStringLiteral("FullName")] = QStringLiteral("Google:jdoe");
+    properties[QStringLiteral("Issuer")] = QStringLiteral("Google");
+    properties[QStringLiteral("Username")] = QStringLiteral("jdoe");
+    properties[QStringLiteral("Type")] = QStringLiteral("TOTP");
+    properties[QStringLiteral("Algorithm")] = QStringLiteral("SHA256");
+    properties[QStringLiteral("Digits")] = 8;
+    properties[QStringLiteral("Period")] = 60;
+    properties[QStringLiteral("RequiresTouch")] = true;
+    properties[QStringLiteral("DeviceId")] = QStringLiteral("mock_device_1");
+
+    const OathCredentialProxy fromPacked(packed);
+    const OathCredentialProxy fromMap(path, properties);
+
+    // Packed path must produce exactly what GetManagedObjects() properties produce
+    QCOMPARE(fromPacked.objectPath(), fromMap.objectPath());
+    QCOMPARE(fromPacked.fullName(), fromMap.fullName());
+    QCOMPARE(fromPacked.issuer(), fromMap.issuer());
+    QCOMPARE(fromPacked.username(), fromMap.username());
+    QCOMPARE(fromPacked.requiresTouch(), fromMap.requiresTouch());
+    QCOMPARE(fromPacked.type(), fromMap.type());
+    QCOMPARE(fromPacked.algorithm(), fromMap.algorithm());
+    QCOMPARE(fromPacked.digits(), fromMap.digits());
+    QCOMPARE(fromPacked.period(), fromMap.period());
+    QCOMPARE(fromPacked.deviceId(), fromMap.deviceId());
+    QCOMPARE(fromPacked.parentDeviceId(), QStringLiteral("mock_device_1"));
+
+    packed.type = static_cast<quint8>(OathType::HOTP);
+    QCOMPARE(OathCredentialProxy(packed).type(), QStringLiteral("HOTP"));
+
+    qDebug() << "✅ Packed credential proxy matches property-map proxy";
+}
+
+void TestProxyUnit::testCredentialProxyDevicePathFromPath()
+{
+    qDebug() << "\n=== Test: CredentialProxy devicePathFromPath ===";
+
+    QCOMPARE(OathCredentialProxy::devicePathFromPath(
+                 QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678/credentials/github_colon_alice")),
+             QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678"));
+
+    // Device objects and anything not shaped like a credential path
+    QVERIFY(OathCredentialProxy::devicePathFromPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678")).isEmpty());
+    QVERIFY(OathCredentialProxy::devicePathFromPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678/credentials")).isEmpty());
+    QVERIFY(OathCredentialProxy::devicePathFromPath(QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678/credentials/")).isEmpty());
+    QVERIFY(OathCredentialProxy::devicePathFromPath(
+                QStringLiteral("/pl/jkolo/yubikey/oath/devices/12345678/credentials/a/b")).isEmpty());
+    QVERIFY(OathCredentialProxy::devicePathFromPath(
+                QStringLiteral("/pl/jkolo/yubikey/oath/other/12345678/credentials/x")).isEmpty());
+
+    qDebug() << "✅ Device path extracted only from credential paths";
+}
+
 void TestProxyUnit::testCredentialProxyGenerateCode()
 {
     qDebug() << "\n=== Test: CredentialProxy GenerateCode ===";
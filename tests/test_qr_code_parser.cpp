@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: 2024 YubiKey KRunner Plugin Contributors
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+#include <ZXing/BitMatrix.h>
+#include <ZXing/MultiFormatWriter.h>
+#include "daemon/utils/qr_code_parser.h"
+
+using namespace YubiKeyOath::Daemon;
+
+/**
+ * @brief Unit tests and benchmarks for QrCodeParser
+ *
+ * Decodes QR codes placed into synthetic screenshots (1080p, 4K and a
+ * dual-4K desktop). Benchmarks run over the same corpus (QBENCHMARK,
+ * run with -iterations N for stable numbers).
+ */
+class TestQrCodeParser : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    // parse() tests
+    void testParse_NullImage();
+    void testParse_SmallImage();
+    void testParse_Screenshot_data();
+    void testParse_Screenshot();
+    void testParse_NoQrCode();
+
+    // parseAll() tests
+    void testParseAll_MultipleCodes_data();
+    void testParseAll_MultipleCodes();
+
+    // Benchmarks
+    void benchmarkParse_data();
+    void benchmarkParse();
+
+private:
+    static QImage makeQrImage(const QString &text, int size);
+    static QImage makeScreenshot(const QSize &screenSize, const QImage &qr, const QPoint &position);
+};
+
+namespace {
+const QString OTPAUTH_URI = QStringLiteral(
+    "otpauth://totp/Example:alice@example.com?secret=JBSWY3DPEHPK3PXP&issuer=Example");
+const QString SECOND_OTPAUTH_URI = QStringLiteral(
+    "otpauth://hotp/ACME:bob@example.com?secret=HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ&issuer=ACME&counter=0");
+} // namespace
+
+QImage TestQrCodeParser::makeQrImage(const QString &text, int size)
+{
+    const ZXing::BitMatrix matrix = ZXing::MultiFormatWriter(ZXing::BarcodeFormat::QRCode)
+                                        .setMargin(4)
+                                        .encode(text.toStdString(), size, size);
+
+    QImage image(matrix.width(), matrix.height(), QImage::Format_Grayscale8);
+    for (int y = 0; y < matrix.height(); ++y) {
+        uchar *line = image.scanLine(y);
+        for (int x = 0; x < matrix.width(); ++x) {
+            line[x] = matrix.get(x, y) ? 0 : 255;
+        }
+    }
+    return image;
+}
+
+QImage TestQrCodeParser::makeScreenshot(const QSize &screenSize, const QImage &qr, const QPoint &position)
+{
+    QImage screenshot(screenSize, QImage::Format_ARGB32);
+    screenshot.fill(QColor(0xEF, 0xF0, 0xF1));
+
+    // Desktop clutter: window frames and text-like bars
+    QPainter painter(&screenshot);
+    for (int y = 40; y < screenSize.height(); y += 90) {
+        for (int x = 30; x < screenSize.width(); x += 310) {
+            painter.fillRect(x, y, 260, 8, QColor(0x23, 0x26, 0x29));
+            painter.fillRect(x, y + 20, 180, 6, QColor(0x7F, 0x8C, 0x8D));
+        }
+    }
+    painter.fillRect(QRect(position - QPoint(40, 40), qr.size() + QSize(80, 80)), Qt::white);
+    if (!qr.isNull()) {
+        painter.drawImage(position, qr);
+    }
+    painter.end();
+
+    return screenshot;
+}
+
+// ========== parse() ==========
+
+void TestQrCodeParser::testParse_NullImage()
+{
+    const auto result = QrCodeParser::parse(QImage());
+    QVERIFY(result.isError());
+}
+
+void TestQrCodeParser::testParse_SmallImage()
+{
+    const auto result = QrCodeParser::parse(makeQrImage(OTPAUTH_URI, 300));
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value(), OTPAUTH_URI);
+}
+
+void TestQrCodeParser::testParse_Screenshot_data()
+{
+    QTest::addColumn<QSize>("screenSize");
+    QTest::addColumn<int>("qrSize");
+    QTest::addColumn<QPoint>("position");
+
+    QTest::newRow("1080p centered") << QSize(1920, 1080) << 240 << QPoint(840, 420);
+    QTest::newRow("4K bottom right") << QSize(3840, 2160) << 240 << QPoint(3300, 1700);
+    QTest::newRow("4K large") << QSize(3840, 2160) << 900 << QPoint(400, 300);
+    QTest::newRow("2x4K second monitor") << QSize(7680, 2160) << 200 << QPoint(6900, 900);
+    QTest::newRow("2x4K small on tile border") << QSize(7680, 2160) << 160 << QPoint(700, 700);
+}
+
+void TestQrCodeParser::testParse_Screenshot()
+{
+    QFETCH(QSize, screenSize);
+    QFETCH(int, qrSize);
+    QFETCH(QPoint, position);
+
+    const QImage screenshot = makeScreenshot(screenSize, makeQrImage(OTPAUTH_URI, qrSize), position);
+    const auto result = QrCodeParser::parse(screenshot);
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value(), OTPAUTH_URI);
+}
+
+void TestQrCodeParser::testParse_NoQrCode()
+{
+    const QImage screenshot = makeScreenshot(QSize(3840, 2160), QImage(), QPoint(100, 100));
+    QVERIFY(QrCodeParser::parse(screenshot).isError());
+}
+
+// ========== parseAll() ==========
+
+void TestQrCodeParser::testParseAll_MultipleCodes_data()
+{
+    QTest::addColumn<QSize>("screenSize");
+    QTest::addColumn<int>("qrSize");
+
+    QTest::newRow("1080p") << QSize(1920, 1080) << 300;
+    QTest::newRow("4K") << QSize(3840, 2160) << 300;
+}
+
+void TestQrCodeParser::testParseAll_MultipleCodes()
+{
+    QFETCH(QSize, screenSize);
+    QFETCH(int, qrSize);
+
+    // Two codes, e.g. a bulk export page
+    QImage screenshot = makeScreenshot(screenSize, makeQrImage(OTPAUTH_URI, qrSize), QPoint(200, 200));
+    QPainter painter(&screenshot);
+    const QPoint secondPosition(screenSize.width() - qrSize - 200, screenSize.height() - qrSize - 200);
+    painter.fillRect(QRect(secondPosition - QPoint(40, 40), QSize(qrSize + 80, qrSize + 80)), Qt::white);
+    painter.drawImage(secondPosition, makeQrImage(SECOND_OTPAUTH_URI, qrSize));
+    painter.end();
+
+    const auto result = QrCodeParser::parseAll(screenshot);
+    QVERIFY2(result.isSuccess(), qPrintable(result.error()));
+    QCOMPARE(result.value().size(), 2);
+    QVERIFY(result.value().contains(OTPAUTH_URI));
+    QVERIFY(result.value().contains(SECOND_OTPAUTH_URI));
+
+    // parse() still returns a single code
+    QVERIFY(QrCodeParser::parse(screenshot).isSuccess());
+}
+
+// ========== Benchmarks ==========
+
+void TestQrCodeParser::benchmarkParse_data()
+{
+    QTest::addColumn<QSize>("screenSize");
+    QTest::addColumn<bool>("withQr");
+
+    QTest::newRow("1080p") << QSize(1920, 1080) << true;
+    QTest::newRow("4K") << QSize(3840, 2160) << true;
+    QTest::newRow("2x4K") << QSize(7680, 2160) << true;
+    QTest::newRow("2x4K no QR") << QSize(7680, 2160) << false;
+}
+
+void TestQrCodeParser::benchmarkParse()
+{
+    QFETCH(QSize, screenSize);
+    QFETCH(bool, withQr);
+
+    const QImage qr = withQr ? makeQrImage(OTPAUTH_URI, 220) : QImage();
+    const QPoint position(screenSize.width() - 600, screenSize.height() / 2);
+    const QImage screenshot = makeScreenshot(screenSize, qr, position);
+
+    bool found = false;
+    QBENCHMARK {
+        found = QrCodeParser::parse(screenshot).isSuccess();
+    }
+    QCOMPARE(found, withQr);
+}
+
+QTEST_GUILESS_MAIN(TestQrCodeParser)
+#include "test_qr_code_parser.moc"
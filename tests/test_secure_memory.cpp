@@ -44,6 +44,13 @@ private Q_SLOTS:
     void testSecureString_IsEmpty();
     void testSecureString_DataAccess();
 
+    // LockedSecretMap tests
+    void testLockedSecretMap_InsertAndValue();
+    void testLockedSecretMap_ReplaceValue();
+    void testLockedSecretMap_RemoveCompacts();
+    void testLockedSecretMap_CapacityExceeded();
+    void testLockedSecretMap_Clear();
+
 private:
     /**
      * @brief Helper to verify QString is cleared
@@ -293,5 +300,78 @@ void TestSecureMemory::testSecureString_DataAccess()
     qDebug() << "  data() returns const reference";
 }
 
+void TestSecureMemory::testLockedSecretMap_InsertAndValue()
+{
+    qDebug() << "\n=== Test: LockedSecretMap insert/value ===";
+
+    SecureMemory::LockedSecretMap map;
+    QVERIFY(map.insert(QStringLiteral("device1"), QStringLiteral("secret1")));
+    QVERIFY(map.insert(QStringLiteral("device2"), QStringLiteral("zażółć")));
+
+    QCOMPARE(map.size(), 2);
+    QVERIFY(map.contains(QStringLiteral("device1")));
+    QCOMPARE(map.value(QStringLiteral("device1")).data(), QStringLiteral("secret1"));
+    QCOMPARE(map.value(QStringLiteral("device2")).data(), QStringLiteral("zażółć"));
+    QVERIFY(map.value(QStringLiteral("missing")).isEmpty());
+}
+
+void TestSecureMemory::testLockedSecretMap_ReplaceValue()
+{
+    qDebug() << "\n=== Test: LockedSecretMap replace ===";
+
+    SecureMemory::LockedSecretMap map;
+    QVERIFY(map.insert(QStringLiteral("device1"), QStringLiteral("old")));
+    QVERIFY(map.insert(QStringLiteral("device1"), QStringLiteral("new-password")));
+
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.value(QStringLiteral("device1")).data(), QStringLiteral("new-password"));
+}
+
+void TestSecureMemory::testLockedSecretMap_RemoveCompacts()
+{
+    qDebug() << "\n=== Test: LockedSecretMap remove keeps other entries intact ===";
+
+    SecureMemory::LockedSecretMap map;
+    QVERIFY(map.insert(QStringLiteral("a"), QStringLiteral("first")));
+    QVERIFY(map.insert(QStringLiteral("b"), QStringLiteral("second")));
+    QVERIFY(map.insert(QStringLiteral("c"), QStringLiteral("third")));
+
+    map.remove(QStringLiteral("a"));
+
+    QVERIFY(!map.contains(QStringLiteral("a")));
+    QCOMPARE(map.value(QStringLiteral("b")).data(), QStringLiteral("second"));
+    QCOMPARE(map.value(QStringLiteral("c")).data(), QStringLiteral("third"));
+
+    // Space freed by removal is reusable
+    QVERIFY(map.insert(QStringLiteral("d"), QStringLiteral("fourth")));
+    QCOMPARE(map.value(QStringLiteral("d")).data(), QStringLiteral("fourth"));
+}
+
+void TestSecureMemory::testLockedSecretMap_CapacityExceeded()
+{
+    qDebug() << "\n=== Test: LockedSecretMap rejects secrets beyond capacity ===";
+
+    // Capacity is rounded up to a whole page
+    SecureMemory::LockedSecretMap map(1);
+    const QString huge(1024 * 1024, QLatin1Char('x'));
+
+    QVERIFY(!map.insert(QStringLiteral("huge"), huge));
+    QVERIFY(!map.contains(QStringLiteral("huge")));
+    QVERIFY(map.insert(QStringLiteral("small"), QStringLiteral("fits")));
+}
+
+void TestSecureMemory::testLockedSecretMap_Clear()
+{
+    qDebug() << "\n=== Test: LockedSecretMap clear ===";
+
+    SecureMemory::LockedSecretMap map;
+    QVERIFY(map.insert(QStringLiteral("device1"), QStringLiteral("secret1")));
+    map.clear();
+
+    QCOMPARE(map.size(), 0);
+    QVERIFY(map.value(QStringLiteral("device1")).isEmpty());
+    QVERIFY(map.insert(QStringLiteral("device1"), QStringLiteral("again")));
+}
+
 QTEST_MAIN(TestSecureMemory)
 #include "test_secure_memory.moc"